@@ -29,6 +29,7 @@ option(ENABLE_AVX    "Enable compile-time AVX support."    ON)
 option(ENABLE_AVX2   "Enable compile-time AVX2 support."   ON)
 option(ENABLE_FMA    "Enable compile-time FMA support."    ON)
 option(ENABLE_AVX512 "Enable compile-time AVX512 support." ON)
+option(ENABLE_PCLMUL "Enable compile-time PCLMULQDQ support." ON)
 
 if (ENABLE_SSE)
     #
@@ -156,6 +157,30 @@ if (ENABLE_SSE)
         endif()
     endif()
 
+    if (ENABLE_PCLMUL)
+
+        #
+        # Check compiler for carry-less multiplication intrinsics
+        #
+        if (CMAKE_COMPILER_IS_GNUCC OR (CMAKE_C_COMPILER_ID MATCHES "Clang") OR (CMAKE_CXX_COMPILER_ID MATCHES "Clang"))
+            set(CMAKE_REQUIRED_FLAGS "-msse4.1 -mpclmul")
+            check_c_source_runs("
+            #include <immintrin.h>
+            int main()
+            {
+              __m128i a = _mm_set_epi64x(0, 0x3);
+              __m128i b = _mm_set_epi64x(0, 0x5);
+              __m128i r = _mm_clmulepi64_si128(a, b, 0x00);
+              return (_mm_cvtsi128_si32(r) == 0xf) ? 0 : -1;
+            }"
+                    HAVE_PCLMUL)
+        endif()
+
+        if (HAVE_PCLMUL)
+            message(STATUS "PCLMULQDQ is enabled - target CPU must support it")
+        endif()
+    endif()
+
     if (ENABLE_AVX512)
 
         #
@@ -207,4 +232,4 @@ if (ENABLE_SSE)
 
 endif()
 
-mark_as_advanced(HAVE_SSE, HAVE_AVX, HAVE_AVX2, HAVE_FMA, HAVE_AVX512)
+mark_as_advanced(HAVE_SSE, HAVE_AVX, HAVE_AVX2, HAVE_FMA, HAVE_PCLMUL, HAVE_AVX512)
@@ -22,6 +22,7 @@
 #ifndef SRSRAN_DYN_BITSET_H
 #define SRSRAN_DYN_BITSET_H
 
+#include "srsran/adt/interval.h"
 #include "srsran/srslog/bundled/fmt/format.h"
 #include "srsran/support/srsran_assert.h"
 #include <cstdint>
@@ -126,6 +127,21 @@ struct zerobit_counter<Integer, 8> {
 };
 #endif
 
+template <typename Integer>
+size_t count_ones(Integer value)
+{
+#ifdef __GNUC__ // clang and gcc
+  return __builtin_popcountll(value);
+#else
+  // Note: use an "int" for count triggers popcount optimization if SSE instructions are enabled.
+  int c = 0;
+  for (; value > 0; c++) {
+    value &= value - 1;
+  }
+  return c;
+#endif
+}
+
 } // namespace detail
 
 /// uses lsb as zero position
@@ -218,14 +234,15 @@ public:
   bounded_bitset<N, reversed>& fill(size_t startpos, size_t endpos, bool value = true)
   {
     assert_range_bounds_(startpos, endpos);
-    // NOTE: can be optimized
-    if (value) {
-      for (size_t i = startpos; i < endpos; ++i) {
-        set_(i);
-      }
-    } else {
-      for (size_t i = startpos; i < endpos; ++i) {
-        reset_(i);
+    if (startpos == endpos) {
+      return *this;
+    }
+    size_t lo = get_range_lo_(startpos, endpos), hi = lo + (endpos - startpos);
+    for (size_t i = lo / bits_per_word; i <= (hi - 1) / bits_per_word; ++i) {
+      if (value) {
+        buffer[i] |= range_mask_(i, lo, hi);
+      } else {
+        buffer[i] &= ~range_mask_(i, lo, hi);
       }
     }
     return *this;
@@ -273,9 +290,12 @@ public:
   {
     assert_within_bounds_(start, false);
     assert_within_bounds_(stop, false);
-    // NOTE: can be optimized
-    for (size_t i = start; i < stop; ++i) {
-      if (test_(i)) {
+    if (start >= stop) {
+      return false;
+    }
+    size_t lo = get_range_lo_(start, stop), hi = lo + (stop - start);
+    for (size_t i = lo / bits_per_word; i <= (hi - 1) / bits_per_word; ++i) {
+      if ((buffer[i] & range_mask_(i, lo, hi)) != static_cast<word_t>(0)) {
         return true;
       }
     }
@@ -288,17 +308,58 @@ public:
   {
     size_t result = 0;
     for (size_t i = 0; i < nof_words_(); i++) {
-      //      result += __builtin_popcountl(buffer[i]);
-      // Note: use an "int" for count triggers popcount optimization if SSE instructions are enabled.
-      int c = 0;
-      for (word_t w = buffer[i]; w > 0; c++) {
-        w &= w - 1;
-      }
-      result += c;
+      result += detail::count_ones(buffer[i]);
     }
     return result;
   }
 
+  /// Counts the number of bits set within the range [startpos, endpos)
+  size_t count(size_t startpos, size_t endpos) const noexcept
+  {
+    assert_range_bounds_(startpos, endpos);
+    if (startpos == endpos) {
+      return 0;
+    }
+    size_t result = 0;
+    size_t lo     = get_range_lo_(startpos, endpos), hi = lo + (endpos - startpos);
+    for (size_t i = lo / bits_per_word; i <= (hi - 1) / bits_per_word; ++i) {
+      result += detail::count_ones(buffer[i] & range_mask_(i, lo, hi));
+    }
+    return result;
+  }
+
+  /**
+   * Finds the lowest run of "len" contiguous bits equal to "value" within the range [startpos, endpos). Runs are
+   * delimited with word-level searches, so that empty or full words are skipped at once.
+   * @return found run. If no run of length "len" exists, the longest run is returned instead. If no bit is equal to
+   *         "value", an empty interval is returned
+   */
+  interval<uint32_t> find_lowest_run(size_t startpos, size_t endpos, size_t len, bool value = false) const noexcept
+  {
+    assert_range_bounds_(startpos, endpos);
+    interval<uint32_t> max_run;
+    if (len == 0) {
+      return max_run;
+    }
+    while (startpos < endpos) {
+      int run_start = find_lowest(startpos, endpos, value);
+      if (run_start < 0) {
+        break;
+      }
+      size_t             max_pos = std::min(endpos, run_start + len);
+      int                run_end = find_lowest(run_start + 1, max_pos, not value);
+      interval<uint32_t> run(run_start, run_end < 0 ? max_pos : static_cast<size_t>(run_end));
+      if (run.length() >= len) {
+        return run;
+      }
+      if (run.length() > max_run.length()) {
+        max_run = run;
+      }
+      startpos = run.stop();
+    }
+    return max_run;
+  }
+
   bool operator==(const bounded_bitset<N, reversed>& other) const noexcept
   {
     if (size() != other.size()) {
@@ -455,6 +516,22 @@ private:
                   size());
   }
 
+  /// Lowest bit index of the range [startpos, endpos) of positions, as stored in the buffer
+  size_t get_range_lo_(size_t startpos, size_t endpos) const noexcept { return reversed ? size() - endpos : startpos; }
+
+  /// Mask with the bits of the word "word_idx" that fall within the bit index range [lo, hi)
+  static word_t range_mask_(size_t word_idx, size_t lo, size_t hi) noexcept
+  {
+    word_t mask = ~static_cast<word_t>(0);
+    if (word_idx == lo / bits_per_word) {
+      mask &= mask_lsb_zeros<word_t>(lo % bits_per_word);
+    }
+    if (word_idx == (hi - 1) / bits_per_word) {
+      mask &= mask_lsb_ones<word_t>((hi - 1) % bits_per_word + 1);
+    }
+    return mask;
+  }
+
   static word_t maskbit(size_t pos) noexcept { return (static_cast<word_t>(1)) << (pos % bits_per_word); }
 
   static size_t max_nof_words_() noexcept { return (N - 1) / bits_per_word + 1; }
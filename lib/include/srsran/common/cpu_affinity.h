@@ -0,0 +1,135 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_CPU_AFFINITY_H
+#define SRSRAN_CPU_AFFINITY_H
+
+#include "srsran/adt/singleton.h"
+#include "srsran/common/threads.h"
+#include "srsran/srslog/srslog.h"
+#include <array>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace srsran {
+
+/// Logical CPU as described by the kernel topology.
+struct cpu_info_t {
+  uint32_t id;
+  uint32_t package_id; ///< Physical socket
+  uint32_t core_id;    ///< Physical core within the socket, shared by the SMT siblings
+  uint32_t node_id;    ///< NUMA node
+};
+
+/// CPU topology of the system, read from sysfs.
+struct cpu_topology {
+  std::vector<cpu_info_t> cpus;     ///< Online CPUs, sorted by id
+  std::vector<uint32_t>   isolated; ///< CPUs isolated from the kernel scheduler (isolcpus)
+
+  /// Reads the topology from the given sysfs system directory.
+  bool detect(const std::string& sysfs_root = "/sys/devices/system");
+
+  /// Returns the CPU with the given id or nullptr if it is not online.
+  const cpu_info_t* find(uint32_t id) const;
+};
+
+/// Parses a Linux CPU list, e.g. "0-3,8,10-11". Returns false if the list is not valid.
+bool parse_cpu_list(const std::string& list, std::vector<uint32_t>& cpus);
+
+/// Converts a list of CPU ids to a Linux CPU list.
+std::string cpu_list_to_string(const std::vector<uint32_t>& cpus);
+
+/// Returns the CPUs of a thread_pool worker mask, or an empty list if the mask does not restrict the workers.
+std::vector<uint32_t> get_cpu_mask_cpus(int32_t mask);
+
+/// Runs a task in a temporary thread restricted to the given CPUs and waits for it. The kernel allocates the memory
+/// the task touches first in the NUMA node of those CPUs. With an empty list the task runs in the calling thread.
+/// Returns false if the thread could not be restricted, the task is run anyway.
+bool run_on_cpus(const std::vector<uint32_t>& cpus, const std::function<void()>& task);
+
+/// Classes of threads with their own set of CPUs. Any other thread is a housekeeping thread.
+enum class cpu_thread_class { radio = 0, phy, stack, nof_classes };
+
+struct cpu_affinity_args_t {
+  std::string mode      = "none"; ///< none, auto or manual
+  int32_t     numa_node = -1;     ///< NUMA node used in auto mode, -1 selects it from the isolated CPUs or node 0
+  std::string radio_cpus;         ///< CPU list of the radio thread in manual mode
+  std::string phy_cpus;           ///< CPU list of the PHY workers in manual mode
+  std::string stack_cpus;         ///< CPU list of the stack thread in manual mode
+  std::string housekeeping_cpus;  ///< CPU list of the other threads, empty for all the CPUs not used above
+};
+
+/**
+ * Assigns CPUs to the real-time threads and keeps every other thread away from them. In auto mode the real-time
+ * threads use one logical CPU per physical core of a single NUMA node, the isolated CPUs if there are any, and the SMT
+ * siblings of those cores are left idle. Threads of the same class are pinned to the class CPUs in round robin.
+ */
+class cpu_affinity_policy : public singleton_t<cpu_affinity_policy>
+{
+public:
+  /// Configures the policy for the CPU topology of the system.
+  bool init(const cpu_affinity_args_t& args);
+
+  /// Configures the policy for a given CPU topology.
+  bool init(const cpu_affinity_args_t& args, const cpu_topology& topology);
+
+  bool is_enabled() const { return enabled; }
+
+  /// Pins a started thread to the next CPU of the class, it does nothing if the policy is not enabled.
+  bool pin(thread& t, cpu_thread_class c);
+
+  /// Runs a task with run_on_cpus() in the CPU the next pin() of the class will use, so a thread can initialise its
+  /// buffers in the CPU it will run on. The task runs in the calling thread if the policy is not enabled.
+  bool run_on_next_cpu(cpu_thread_class c, const std::function<void()>& task) const;
+
+  /// Restricts a started thread to all the CPUs of the class, it does nothing if the policy is not enabled.
+  bool pin_class(thread& t, cpu_thread_class c);
+
+  /// Restricts the calling thread to the housekeeping CPUs. The threads it creates afterwards inherit them, so it must
+  /// be called from the main thread before any other thread is started.
+  bool apply_housekeeping();
+
+  const std::vector<uint32_t>& get_cpus(cpu_thread_class c) const { return cpus[(size_t)c]; }
+  const std::vector<uint32_t>& get_housekeeping_cpus() const { return housekeeping; }
+
+  std::string to_string() const;
+
+protected:
+  cpu_affinity_policy() = default;
+
+private:
+  bool init_auto(const cpu_affinity_args_t& args, const cpu_topology& topology);
+  bool init_manual(const cpu_affinity_args_t& args, const cpu_topology& topology);
+
+  static constexpr size_t nof_classes = (size_t)cpu_thread_class::nof_classes;
+
+  srslog::basic_logger&                          logger  = srslog::fetch_basic_logger("COMN");
+  bool                                           enabled = false;
+  std::array<std::vector<uint32_t>, nof_classes> cpus;
+  std::vector<uint32_t>                          housekeeping;
+  std::array<std::atomic<uint32_t>, nof_classes> next_cpu = {};
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_CPU_AFFINITY_H
@@ -33,6 +33,7 @@
 #include "srsran/adt/move_callback.h"
 #include "srsran/srslog/srslog.h"
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <memory>
@@ -85,8 +86,16 @@ public:
   uint32_t    get_nof_workers();
   std::string get_id();
 
+  /// Lets wait_worker() hand out only as many workers as the load needs. The inactive workers are never handed out:
+  /// while all the active ones are busy, wait_worker() waits for one of them and activates another worker only if none
+  /// becomes idle within max_wait_us. A worker is deactivated when, over a window of wait_worker() calls, there was
+  /// always more than one idle. The inactive workers keep their threads and buffers, they are simply not scheduled.
+  void     set_adaptive(uint32_t min_workers, uint32_t window, uint32_t max_wait_us);
+  uint32_t get_nof_active_workers();
+
 private:
   bool find_finished_worker(uint32_t tti, uint32_t* id);
+  void update_active_workers();
 
   typedef enum { STOP, IDLE, START_WORK, WORKER_READY, WORKING } worker_status;
 
@@ -99,6 +108,14 @@ private:
   std::mutex                           mutex_queue = {};
   std::vector<worker_status>           status      = {};
   std::vector<std::condition_variable> cvar_worker = {};
+
+  // Adaptive number of active workers, disabled if min_active_workers is 0
+  uint32_t                  nof_active_workers = 0;
+  uint32_t                  min_active_workers = 0;
+  uint32_t                  adaptive_window    = 0;
+  std::chrono::microseconds adaptive_max_wait  = {};
+  uint32_t                  window_count       = 0;
+  uint32_t                  window_max_busy    = 0;
 };
 
 class task_thread_pool
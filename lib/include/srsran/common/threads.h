@@ -79,6 +79,9 @@ public:
     return threads_new_rt_mask(&_thread, thread_function_entry, this, mask, prio);
   }
 
+  /// Changes the CPU affinity of the started thread
+  bool set_affinity(const cpu_set_t* cpuset) { return pthread_setaffinity_np(_thread, sizeof(cpu_set_t), cpuset) == 0; }
+
   void print_priority() { threads_print_self(); }
 
   void set_name(const std::string& name_)
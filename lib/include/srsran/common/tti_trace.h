@@ -0,0 +1,206 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_TTI_TRACE_H
+#define SRSRAN_TTI_TRACE_H
+
+#include "srsran/common/threads.h"
+#include "srsran/srslog/srslog.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace srsran {
+
+/// Maximum number of processing stages traced per TTI.
+constexpr uint32_t tti_trace_max_stages = 8;
+
+/// Maximum length of a stage name in the trace file, including the terminating null character.
+constexpr uint32_t tti_trace_stage_name_len = 16;
+
+/// Per-TTI record of a worker, every stage holds the time spent on it.
+struct tti_trace_record {
+  uint32_t tti;
+  uint32_t worker_id;
+  uint64_t start_ns; ///< Steady clock time when the worker started the TTI
+  uint32_t stage_ns[tti_trace_max_stages];
+};
+
+/// Trace file header, it is followed by the records in the order they were exported.
+struct tti_trace_file_header {
+  char     magic[8];
+  uint32_t version;
+  uint32_t nof_stages;
+  char     stage_names[tti_trace_max_stages][tti_trace_stage_name_len];
+};
+
+constexpr char     tti_trace_file_magic[8] = {'S', 'R', 'S', 'T', 'T', 'I', 'T', 'R'};
+constexpr uint32_t tti_trace_file_version  = 1;
+
+/// Lock-free ring buffer of records with a single producer and a single consumer. Records are dropped when it is full,
+/// so the producer never blocks.
+class tti_trace_ring
+{
+public:
+  explicit tti_trace_ring(uint32_t capacity);
+
+  bool push(const tti_trace_record& record)
+  {
+    uint32_t w = write_idx.load(std::memory_order_relaxed);
+    if (w - read_idx.load(std::memory_order_acquire) >= buffer.size()) {
+      nof_dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    buffer[w & mask] = record;
+    write_idx.store(w + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(tti_trace_record& record)
+  {
+    uint32_t r = read_idx.load(std::memory_order_relaxed);
+    if (r == write_idx.load(std::memory_order_acquire)) {
+      return false;
+    }
+    record = buffer[r & mask];
+    read_idx.store(r + 1, std::memory_order_release);
+    return true;
+  }
+
+  uint64_t get_nof_dropped() const { return nof_dropped.load(std::memory_order_relaxed); }
+
+private:
+  std::vector<tti_trace_record> buffer;
+  uint32_t                      mask;
+  std::atomic<uint32_t>         write_idx{0};
+  char                          padding[64]; ///< Keeps the producer and consumer indexes in different cache lines
+  std::atomic<uint32_t>         read_idx{0};
+  std::atomic<uint64_t>         nof_dropped{0};
+};
+
+/// Per-worker tracer, it must only be used from the worker thread. A tracer without ring does nothing.
+class tti_tracer
+{
+public:
+  tti_tracer() = default;
+  tti_tracer(uint32_t worker_id, tti_trace_ring* ring_) : ring(ring_) { record.worker_id = worker_id; }
+
+  /// Starts the record of a new TTI.
+  void begin(uint32_t tti)
+  {
+    if (ring == nullptr) {
+      return;
+    }
+    last_ns         = now_ns();
+    record.tti      = tti;
+    record.start_ns = last_ns;
+    std::fill(std::begin(record.stage_ns), std::end(record.stage_ns), 0);
+  }
+
+  /// Adds the time elapsed since the previous mark to the given stage. A stage may be marked several times per TTI,
+  /// e.g. once per carrier.
+  void stage(uint32_t idx)
+  {
+    if (ring == nullptr) {
+      return;
+    }
+    uint64_t t = now_ns();
+    record.stage_ns[idx] += (uint32_t)(t - last_ns);
+    last_ns = t;
+  }
+
+  /// Pushes the record of the current TTI to the ring buffer.
+  void end()
+  {
+    if (ring == nullptr) {
+      return;
+    }
+    ring->push(record);
+  }
+
+private:
+  static uint64_t now_ns()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  tti_trace_ring*  ring    = nullptr;
+  uint64_t         last_ns = 0;
+  tti_trace_record record  = {};
+};
+
+/// Collects the per-stage TTI records of a pool of workers and periodically exports them to a binary file from a low
+/// priority thread. The workers only write to their own ring buffer, so tracing can be left enabled in deployments.
+class tti_trace : public thread
+{
+public:
+  tti_trace() : thread("TTI_TRACE"), logger(srslog::fetch_basic_logger("COMN")) {}
+  ~tti_trace() override;
+
+  /// Opens the trace file and starts the export thread.
+  /// @param filename Trace file name
+  /// @param stage_names Name of every stage, at most tti_trace_max_stages
+  /// @param nof_workers Number of workers, every worker gets its own ring buffer
+  /// @param ring_capacity Number of records of every ring buffer, rounded up to a power of two
+  /// @param period_ms Export period in milliseconds
+  bool init(const std::string&              filename,
+            const std::vector<std::string>& stage_names,
+            uint32_t                        nof_workers,
+            uint32_t                        ring_capacity = 1024,
+            uint32_t                        period_ms     = 100);
+
+  /// Exports the remaining records, stops the export thread and closes the file.
+  void stop();
+
+  /// Returns the tracer of a worker, it does nothing if tracing is not enabled.
+  tti_tracer& get_tracer(uint32_t worker_id)
+  {
+    return (worker_id < tracers.size()) ? tracers[worker_id] : disabled_tracer;
+  }
+
+  /// Total number of records dropped because a ring buffer was full.
+  uint64_t get_nof_dropped() const;
+
+private:
+  void run_thread() override;
+  void export_records();
+
+  srslog::basic_logger&                        logger;
+  FILE*                                        f         = nullptr;
+  uint32_t                                     period_ms = 0;
+  bool                                         running   = false;
+  std::mutex                                   mutex;
+  std::condition_variable                      cvar;
+  std::vector<std::unique_ptr<tti_trace_ring>> rings;
+  std::vector<tti_tracer>                      tracers;
+  tti_tracer                                   disabled_tracer;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_TTI_TRACE_H
@@ -35,6 +35,9 @@ struct mac_args_t {
   uint32_t                      nof_prealloc_ues; ///< Number of UE resources to pre-allocate at eNB startup
   uint32_t                      max_nof_kos;
   int                           rlf_min_ul_snr_estim;
+  uint32_t                      nof_pdu_workers; ///< Number of threads assembling DL MAC PDUs (0 to disable)
+  uint32_t                      ul_softbuffer_pool_mb; ///< Memory of the shared UL code block pool (0 to disable)
+  uint32_t                      ul_softbuffer_llr_bits = 16; ///< Width of the stored UL soft bits: 16, 8 or 4
 };
 
 /* Interface PHY -> MAC */
@@ -42,7 +42,8 @@ inline bool operator==(const srsran_prach_cfg_t& a, const srsran_prach_cfg_t& b)
   return (a.config_idx == b.config_idx && a.root_seq_idx == b.root_seq_idx && a.zero_corr_zone == b.zero_corr_zone &&
           a.freq_offset == b.freq_offset && a.num_ra_preambles == b.num_ra_preambles && a.hs_flag == b.hs_flag &&
           a.tdd_config == b.tdd_config && a.enable_successive_cancellation == b.enable_successive_cancellation &&
-          a.enable_freq_domain_offset_calc == b.enable_freq_domain_offset_calc);
+          a.enable_freq_domain_offset_calc == b.enable_freq_domain_offset_calc &&
+          a.enable_batch_detection == b.enable_batch_detection);
 }
 
 inline bool operator!=(const srsran_prach_cfg_t& a, const srsran_prach_cfg_t& b)
@@ -42,6 +42,8 @@ struct cfr_args_t {
   float             strength         = 1.0f;
   float             auto_target_papr = 7.0f;
   float             ema_alpha        = 1.0f / (float)SRSRAN_CP_NORM_NSYMB;
+  uint32_t          iterations       = 1;
+  float             max_evm          = 0.0f;
 };
 
 struct phy_args_t {
@@ -53,8 +55,9 @@ struct phy_args_t {
   std::vector<uint32_t> dl_earfcn_list = {3400}; // vectorized version of dl_earfcn that gets populated during init
   std::map<uint32_t, uint32_t> ul_earfcn_map;    // Map linking DL EARFCN and UL EARFCN
 
-  int force_N_id_2 = -1; // Cell identity within the identity group (PSS) to filter.
-  int force_N_id_1 = -1; // Cell identity group (SSS) to filter.
+  int  force_N_id_2         = -1;    // Cell identity within the identity group (PSS) to filter.
+  int  force_N_id_1         = -1;    // Cell identity group (SSS) to filter.
+  bool cell_search_parallel = false; // Search all PSS in parallel threads over the same received samples.
 
   float dl_freq = -1.0f;
   float ul_freq = -1.0f;
@@ -100,6 +103,7 @@ struct phy_args_t {
   float       rx_gain_offset               = 62;
   bool        pdsch_csi_enabled            = true;
   bool        pdsch_8bit_decoder           = false;
+  bool        pdcch_early_abort            = false;
   uint32_t    intra_freq_meas_len_ms       = 20;
   uint32_t    intra_freq_meas_period_ms    = 200;
   float       force_ul_amplitude           = 0.0f;
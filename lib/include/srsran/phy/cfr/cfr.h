@@ -51,6 +51,10 @@ typedef struct SRSRAN_API {
   float    alpha;     ///< Alpha parameter of the clipping algorithm
   bool     dc_sc;     ///< Take into account the DC subcarrier for the filter BW
 
+  // Optional parameters
+  uint32_t nof_iterations; ///< Number of clipping and filtering iterations, 0 is equivalent to 1
+  float    max_evm;        ///< Maximum EVM introduced in every OFDM symbol (0 to 1), 0 for no limit
+
   // SRSRAN_CFR_THR_MANUAL mode parameters
   float manual_thr; ///< Fixed threshold used in SRSRAN_CFR_THR_MANUAL mode
 
@@ -71,7 +75,7 @@ typedef struct SRSRAN_API {
 
   float* abs_buffer_in;  ///< Store the input absolute value
   float* abs_buffer_out; ///< Store the output absolute value
-  cf_t*  peak_buffer;
+  cf_t*  peak_buffer;    ///< Store the peak signal or a copy of the input for the EVM limit
 
   float pwr_avg_in;  ///< store the avg. input power with MA or EMA averaging
   float pwr_avg_out; ///< store the avg. output power with MA or EMA averaging
@@ -29,8 +29,12 @@
 #include "rlf.h"
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/srslog/srslog.h"
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace srsran {
 
@@ -39,7 +43,9 @@ class channel
 public:
   struct args_t {
     // General
-    bool enable = false;
+    bool     enable      = false;
+    uint32_t nof_threads = 1; // Threads running the channels and their fading segments, including the caller
+    uint32_t seed        = 0; // Offset to the random seeds, makes the channels of different emulators independent
 
     // AWGN options
     bool  awgn_enable            = false;
@@ -76,18 +82,49 @@ public:
   void run(cf_t* in[SRSRAN_MAX_CHANNELS], cf_t* out[SRSRAN_MAX_CHANNELS], uint32_t len, const srsran_timestamp_t& t);
 
 private:
-  srslog::basic_logger&    logger;
-  float                    hst_init_phase              = 0.0f;
-  srsran_channel_fading_t* fading[SRSRAN_MAX_CHANNELS] = {};
-  srsran_channel_delay_t*  delay[SRSRAN_MAX_CHANNELS]  = {};
-  srsran_channel_awgn_t*   awgn                        = nullptr;
-  srsran_channel_hst_t*    hst                         = nullptr;
-  srsran_channel_rlf_t*    rlf                         = nullptr;
-  cf_t*                    buffer_in                   = nullptr;
-  cf_t*                    buffer_out                  = nullptr;
-  uint32_t                 nof_channels                = 0;
-  uint32_t                 current_srate               = 0;
-  args_t                   args                        = {};
+  typedef void (channel::*task_t)(uint32_t thread_idx, uint32_t task_idx);
+
+  int  fading_alloc();
+  void fading_free();
+  void run_tasks(task_t task, uint32_t nof_tasks);
+  void run_head(uint32_t thread_idx, uint32_t i);
+  void run_fading(uint32_t thread_idx, uint32_t task_idx);
+  void run_tail(uint32_t thread_idx, uint32_t i);
+  void worker_loop(uint32_t worker_idx);
+  void log_state(const srsran_timestamp_t& t);
+
+  srslog::basic_logger&                        logger;
+  float                                        hst_init_phase      = 0.0f;
+  std::vector<srsran_channel_fading_t*>        fading;
+  std::vector<srsran_channel_delay_t*>         delay;
+  std::vector<srsran_channel_awgn_t*>          awgn;
+  std::vector<srsran_channel_hst_t*>           hst;
+  srsran_channel_rlf_t*                        rlf                 = nullptr;
+  std::vector<cf_t*>                           buffer_in;
+  std::vector<cf_t*>                           buffer_out;
+  std::vector<cf_t*>                           fading_response;         // N samples per fading segment
+  std::vector<srsran_channel_fading_scratch_t> fading_scratch;          // One per thread
+  uint32_t                                     fading_nof_segments = 0; // Fading segments per channel in the job
+  uint32_t                                     nof_channels        = 0;
+  uint32_t                                     current_srate       = 0;
+  args_t                                       args                = {};
+
+  // Workers, every thread runs the tasks i with i % nof_threads equal to its index. The caller has index 0. A run takes
+  // three jobs: the stages before fading per channel, the fading segments of all channels and the rest per channel
+  uint32_t                  nof_threads = 1;
+  std::vector<std::thread>  workers;
+  std::mutex                worker_mutex;
+  std::condition_variable   worker_cvar;
+  std::condition_variable   done_cvar;
+  uint64_t                  job_count     = 0;
+  uint32_t                  job_pending   = 0;
+  bool                      job_quit      = false;
+  task_t                    job_task      = nullptr;
+  uint32_t                  job_nof_tasks = 0;
+  cf_t* const*              job_in        = nullptr;
+  cf_t* const*              job_out       = nullptr;
+  uint32_t                  job_len       = 0;
+  const srsran_timestamp_t* job_t         = nullptr;
 };
 
 typedef std::unique_ptr<channel> channel_ptr;
@@ -66,6 +66,16 @@ typedef struct {
   cf_t* state; // To save impulse response of the filter
 } srsran_channel_fading_t;
 
+/**
+ * Buffers and DFT plans of a thread filtering segments, so the segments of a channel can be filtered in parallel
+ */
+typedef struct {
+  srsran_dft_plan_t fft;    // DFT to frequency domain
+  srsran_dft_plan_t ifft;   // DFT to time domain
+  cf_t*             h_freq; // Channel frequency response, length fft_size
+  cf_t*             y_freq; // Intermediate frequency domain buffer
+} srsran_channel_fading_scratch_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -80,6 +90,33 @@ SRSRAN_API double srsran_channel_fading_execute(srsran_channel_fading_t* q,
                                                 uint32_t                 nof_samples,
                                                 double                   init_time);
 
+/*
+ * Parallel execution: srsran_channel_fading_execute() splits the samples in segments of up to N/2 samples that are
+ * filtered independently and then overlapped. srsran_channel_fading_filter() computes the N samples response of one
+ * segment, so different threads can compute them with their own scratch. srsran_channel_fading_overlap_add() adds the
+ * responses, one every N samples, and gives the same output and time as srsran_channel_fading_execute().
+ */
+SRSRAN_API int srsran_channel_fading_scratch_init(srsran_channel_fading_scratch_t* s,
+                                                  const srsran_channel_fading_t*   q);
+
+SRSRAN_API void srsran_channel_fading_scratch_free(srsran_channel_fading_scratch_t* s);
+
+SRSRAN_API uint32_t srsran_channel_fading_nof_segments(const srsran_channel_fading_t* q, uint32_t nsamples);
+
+SRSRAN_API void srsran_channel_fading_filter(srsran_channel_fading_t*         q,
+                                             srsran_channel_fading_scratch_t* s,
+                                             const cf_t*                      in,
+                                             uint32_t                         nsamples,
+                                             uint32_t                         idx,
+                                             double                           init_time,
+                                             cf_t*                            response);
+
+SRSRAN_API double srsran_channel_fading_overlap_add(srsran_channel_fading_t* q,
+                                                    cf_t*                    responses,
+                                                    cf_t*                    out,
+                                                    uint32_t                 nof_samples,
+                                                    double                   init_time);
+
 #ifdef __cplusplus
 }
 #endif
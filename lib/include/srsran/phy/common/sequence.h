@@ -83,6 +83,79 @@ SRSRAN_API void srsran_sequence_apply_packed(const uint8_t* in, uint8_t* out, ui
 
 SRSRAN_API void srsran_sequence_apply_bit(const uint8_t* in, uint8_t* out, uint32_t length, uint32_t seed);
 
+/**
+ * Cached pseudo-random sequence. The sequence bits are stored packed in 32 bit words, LSB first. The generator state is
+ * kept so the sequence can be extended if a longer length is requested later
+ */
+typedef struct SRSRAN_API {
+  uint32_t  seed;
+  uint32_t  len;       ///< Number of generated bits
+  uint64_t  last_used; ///< Last cache access tick, 0 if the entry is empty
+  uint32_t  x1;
+  uint32_t  x2;
+  uint32_t* words;
+} srsran_sequence_cache_entry_t;
+
+/**
+ * Least recently used cache of pseudo-random sequences keyed by their seed. For PDSCH/PUSCH the seed is a function of
+ * the RNTI, slot, cell and codeword, so the sequences repeat every radio frame (LTE) or every slot (NR) for a given UE.
+ * It is not thread-safe; each physical channel object owns its own cache. The sequence buffers are allocated the first
+ * time an entry is used, so the memory follows the number of active seeds rather than the cache size.
+ */
+typedef struct SRSRAN_API {
+  srsran_sequence_cache_entry_t* entry;
+  uint32_t                      nof_entries;
+  uint32_t                      max_len;
+  uint64_t                      tick;
+  uint64_t                      nof_hits;
+  uint64_t                      nof_misses;
+} srsran_sequence_cache_t;
+
+/**
+ * @brief Initialises a sequence cache
+ * @param q Sequence cache object
+ * @param nof_entries Number of sequences
+ * @param max_len Maximum sequence length in bits. Longer requests bypass the cache
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_sequence_cache_init(srsran_sequence_cache_t* q, uint32_t nof_entries, uint32_t max_len);
+
+SRSRAN_API void srsran_sequence_cache_free(srsran_sequence_cache_t* q);
+
+/**
+ * @brief Drops all the cached sequences, for example after a cell change
+ * @param q Sequence cache object
+ */
+SRSRAN_API void srsran_sequence_cache_reset(srsran_sequence_cache_t* q);
+
+/**
+ * The following functions are equivalent to their srsran_sequence_apply_* counterparts. They fall back to them if the
+ * cache is not initialised or the length exceeds the cache maximum length
+ */
+SRSRAN_API void srsran_sequence_cache_apply_s(srsran_sequence_cache_t* q,
+                                              const int16_t*           in,
+                                              int16_t*                 out,
+                                              uint32_t                 length,
+                                              uint32_t                 seed);
+
+SRSRAN_API void srsran_sequence_cache_apply_c(srsran_sequence_cache_t* q,
+                                              const int8_t*            in,
+                                              int8_t*                  out,
+                                              uint32_t                 length,
+                                              uint32_t                 seed);
+
+SRSRAN_API void srsran_sequence_cache_apply_packed(srsran_sequence_cache_t* q,
+                                                   const uint8_t*           in,
+                                                   uint8_t*                 out,
+                                                   uint32_t                 length,
+                                                   uint32_t                 seed);
+
+SRSRAN_API void srsran_sequence_cache_apply_bit(srsran_sequence_cache_t* q,
+                                                const uint8_t*           in,
+                                                uint8_t*                 out,
+                                                uint32_t                 length,
+                                                uint32_t                 seed);
+
 SRSRAN_API int srsran_sequence_pbch(srsran_sequence_t* seq, srsran_cp_t cp, uint32_t cell_id);
 
 SRSRAN_API int srsran_sequence_pcfich(srsran_sequence_t* seq, uint32_t nslot, uint32_t cell_id);
@@ -91,6 +164,8 @@ SRSRAN_API int srsran_sequence_phich(srsran_sequence_t* seq, uint32_t nslot, uin
 
 SRSRAN_API int srsran_sequence_pdcch(srsran_sequence_t* seq, uint32_t nslot, uint32_t cell_id, uint32_t len);
 
+SRSRAN_API uint32_t srsran_sequence_pdsch_seed(uint16_t rnti, int q, uint32_t nslot, uint32_t cell_id);
+
 SRSRAN_API int
 srsran_sequence_pdsch(srsran_sequence_t* seq, uint16_t rnti, int q, uint32_t nslot, uint32_t cell_id, uint32_t len);
 
@@ -126,6 +201,8 @@ SRSRAN_API void srsran_sequence_pdsch_apply_c(const int8_t* in,
                                               uint32_t      cell_id,
                                               uint32_t      len);
 
+SRSRAN_API uint32_t srsran_sequence_pusch_seed(uint16_t rnti, uint32_t nslot, uint32_t cell_id);
+
 SRSRAN_API int
 srsran_sequence_pusch(srsran_sequence_t* seq, uint16_t rnti, uint32_t nslot, uint32_t cell_id, uint32_t len);
 
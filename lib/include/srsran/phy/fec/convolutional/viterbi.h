@@ -34,6 +34,9 @@
 #include "srsran/config.h"
 #include <stdbool.h>
 
+/* Maximum number of codewords decoded together by srsran_viterbi_decode_f_multi() */
+#define SRSRAN_VITERBI_MAX_MULTI 32
+
 typedef enum { SRSRAN_VITERBI_27 = 0, SRSRAN_VITERBI_29, SRSRAN_VITERBI_37, SRSRAN_VITERBI_39 } srsran_viterbi_type_t;
 
 typedef struct SRSRAN_API {
@@ -52,6 +55,8 @@ typedef struct SRSRAN_API {
   uint16_t* tmp_s;
   uint8_t*  symbols_uc;
   uint16_t* symbols_us;
+  void*     ptr_multi;
+  uint16_t* symbols_multi;
 } srsran_viterbi_t;
 
 SRSRAN_API int srsran_viterbi_init(srsran_viterbi_t*     q,
@@ -68,12 +73,37 @@ SRSRAN_API void srsran_viterbi_free(srsran_viterbi_t* q);
 
 SRSRAN_API int srsran_viterbi_decode_f(srsran_viterbi_t* q, float* symbols, uint8_t* data, uint32_t frame_length);
 
+/**
+ * @brief Decodes several codewords of the same length. The decoders supporting it (AVX512) decode all of them at the
+ * same time, each one in a different SIMD lane. Otherwise, they are decoded one after the other.
+ * @param q Viterbi decoder object
+ * @param symbols Real-valued symbols of each codeword
+ * @param data Decoded bits of each codeword
+ * @param nof_cw Number of codewords, up to SRSRAN_VITERBI_MAX_MULTI
+ * @param frame_length Number of bits of each codeword
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_viterbi_decode_f_multi(srsran_viterbi_t* q,
+                                             float*            symbols[SRSRAN_VITERBI_MAX_MULTI],
+                                             uint8_t*          data[SRSRAN_VITERBI_MAX_MULTI],
+                                             uint32_t          nof_cw,
+                                             uint32_t          frame_length);
+
 SRSRAN_API int srsran_viterbi_decode_s(srsran_viterbi_t* q, int16_t* symbols, uint8_t* data, uint32_t frame_length);
 
 SRSRAN_API int srsran_viterbi_decode_us(srsran_viterbi_t* q, uint16_t* symbols, uint8_t* data, uint32_t frame_length);
 
 SRSRAN_API int srsran_viterbi_decode_uc(srsran_viterbi_t* q, uint8_t* symbols, uint8_t* data, uint32_t frame_length);
 
+/**
+ * @brief Initializes the portable (scalar) decoder regardless of the CPU, it is the reference of the SIMD decoders
+ */
+SRSRAN_API int srsran_viterbi_init_port(srsran_viterbi_t*     q,
+                                        srsran_viterbi_type_t type,
+                                        int                   poly[3],
+                                        uint32_t              max_frame_length,
+                                        bool                  tail_bitting);
+
 SRSRAN_API int srsran_viterbi_init_sse(srsran_viterbi_t*     q,
                                        srsran_viterbi_type_t type,
                                        int                   poly[3],
@@ -92,4 +122,16 @@ SRSRAN_API int srsran_viterbi_init_avx2(srsran_viterbi_t*     q,
                                         uint32_t              max_frame_length,
                                         bool                  tail_bitting);
 
+SRSRAN_API int srsran_viterbi_init_avx2_16bit(srsran_viterbi_t*     q,
+                                              srsran_viterbi_type_t type,
+                                              int                   poly[3],
+                                              uint32_t              max_frame_length,
+                                              bool                  tail_bitting);
+
+SRSRAN_API int srsran_viterbi_init_avx512(srsran_viterbi_t*     q,
+                                          srsran_viterbi_type_t type,
+                                          int                   poly[3],
+                                          uint32_t              max_frame_length,
+                                          bool                  tail_bitting);
+
 #endif // SRSRAN_VITERBI_H
@@ -44,6 +44,8 @@ typedef struct SRSRAN_API {
   uint64_t crcmask;
   uint64_t crchighbit;
   uint32_t srsran_crc_out;
+  uint64_t fold_128[2]; // x^128 and x^192 modulo the polynomial, folds one 128 bit block
+  uint64_t fold_512[2]; // x^512 and x^576 modulo the polynomial, folds four 128 bit blocks in parallel
 } srsran_crc_t;
 
 SRSRAN_API int srsran_crc_init(srsran_crc_t* h, uint32_t srsran_crc_poly, int srsran_crc_order);
@@ -78,6 +80,15 @@ static inline uint64_t srsran_crc_checksum_get(srsran_crc_t* h)
   return (h->crcinit & h->crcmask);
 }
 
+/**
+ * @brief Feeds packed bytes into the CRC register, continuing from the current value. It allows computing the checksum
+ * of a message stored in several buffers, for example while the code blocks of a transport block are concatenated.
+ * @param h CRC object
+ * @param data Packed bytes
+ * @param nof_bytes Number of bytes
+ */
+SRSRAN_API void srsran_crc_checksum_put_bytes(srsran_crc_t* h, const uint8_t* data, uint32_t nof_bytes);
+
 SRSRAN_API uint32_t srsran_crc_checksum_byte(srsran_crc_t* h, const uint8_t* data, int len);
 
 SRSRAN_API uint32_t srsran_crc_checksum(srsran_crc_t* h, uint8_t* data, int len);
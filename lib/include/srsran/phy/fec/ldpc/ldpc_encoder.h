@@ -33,6 +33,7 @@
 #define SRSRAN_LDPCENCODER_H
 
 #include "srsran/phy/fec/ldpc/base_graph.h"
+#include "srsran/phy/utils/cpu.h"
 
 /*!
  * \brief Types of LDPC encoder.
@@ -42,9 +43,9 @@ typedef enum SRSRAN_API {
 #if LV_HAVE_AVX2
   SRSRAN_LDPC_ENCODER_AVX2, /*!< \brief SIMD-optimized encoder. */
 #endif                      // LV_HAVE_AVX2
-#if LV_HAVE_AVX512
+#if SRSRAN_AVX512_KERNELS
   SRSRAN_LDPC_ENCODER_AVX512, /*!< \brief SIMD-optimized encoder. */
-#endif                        // LV_HAVE_AVX512
+#endif                        // SRSRAN_AVX512_KERNELS
 } srsran_ldpc_encoder_type_t;
 
 /*!
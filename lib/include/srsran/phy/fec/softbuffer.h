@@ -32,19 +32,66 @@
 #define SRSRAN_SOFTBUFFER_H
 
 #include "srsran/config.h"
+#include <pthread.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * Width of the soft bits stored by an Rx soft-buffer. The 8-bit and 4-bit formats can only be used with the int8_t
+ * decoders, i.e. LDPC and the 8-bit turbo decoder. The 4-bit format packs two soft bits per byte, quantized in steps of
+ * SRSRAN_SOFTBUFFER_LLR_4BIT_STEP, they are combined and decoded in 8-bit and only compressed when they are stored.
+ */
+typedef enum SRSRAN_API {
+  SRSRAN_SOFTBUFFER_LLR_16BIT = 0,
+  SRSRAN_SOFTBUFFER_LLR_8BIT,
+  SRSRAN_SOFTBUFFER_LLR_4BIT,
+} srsran_softbuffer_llr_t;
+
+#define SRSRAN_SOFTBUFFER_LLR_4BIT_STEP 8
+
+/**
+ * Pool of Rx code block buffers shared by the softbuffers of many HARQ processes. The memory is requested from the
+ * system in 2 MB chunks, backed by huge pages when available, as the code blocks are needed, and every chunk is split in
+ * contiguous code block slots, each one holding the soft bits followed by the decoded data.
+ */
 typedef struct SRSRAN_API {
-  uint32_t  max_cb;
-  uint32_t  max_cb_size;
-  int16_t** buffer_f;
-  uint8_t** data;
-  bool*     cb_crc;
-  bool      tb_crc;
+  uint32_t                max_cb_size; ///< Number of soft bits of every code block
+  srsran_softbuffer_llr_t llr_format;  ///< Width of the soft bits
+  uint32_t                slot_size;   ///< Bytes of every code block slot
+  uint32_t                max_chunks;  ///< Maximum number of chunks the pool can request
+  uint32_t                nof_chunks;
+  uint8_t**               chunks;
+  bool*                   chunk_huge; ///< Whether each chunk is backed by explicit huge pages
+  void**                  free_slots; ///< Stack of free slots
+  uint32_t                nof_free;
+  uint32_t                nof_slots; ///< Slots carved out of the chunks so far
+  uint32_t                max_used;  ///< Maximum number of slots in use at the same time
+  uint64_t                nof_failures;
+  pthread_mutex_t         mutex;
+} srsran_softbuffer_pool_t;
+
+typedef struct SRSRAN_API {
+  uint32_t nof_cb_used;  ///< Code blocks currently attached to a softbuffer
+  uint32_t max_cb_used;  ///< Peak of nof_cb_used
+  uint64_t nof_bytes;    ///< Memory requested from the system
+  uint32_t nof_chunks;   ///< Number of 2 MB chunks requested from the system
+  uint32_t nof_huge;     ///< Number of chunks backed by explicit huge pages
+  uint64_t nof_failures; ///< Code blocks that could not be allocated because the pool was exhausted
+} srsran_softbuffer_pool_metrics_t;
+
+typedef struct SRSRAN_API {
+  uint32_t                  max_cb;
+  uint32_t                  max_cb_size;
+  int16_t**                 buffer_f; ///< Soft bits of every code block, stored as given by llr_format
+  uint8_t**                 data;
+  bool*                     cb_crc;
+  bool                      tb_crc;
+  srsran_softbuffer_pool_t* pool; ///< Pool the code blocks are taken from, NULL if they are owned by the softbuffer
+  srsran_softbuffer_llr_t   llr_format;
 } srsran_softbuffer_rx_t;
 
 typedef struct SRSRAN_API {
@@ -67,6 +114,45 @@ SRSRAN_API int srsran_softbuffer_rx_init(srsran_softbuffer_rx_t* q, uint32_t nof
  */
 SRSRAN_API int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size);
 
+/**
+ * @brief Same as srsran_softbuffer_rx_init_guru() storing the soft bits with a given width
+ * @param llr_format The width of the stored soft bits
+ */
+SRSRAN_API int srsran_softbuffer_rx_init_guru_llr(srsran_softbuffer_rx_t* q,
+                                                  uint32_t                max_cb,
+                                                  uint32_t                max_cb_size,
+                                                  srsran_softbuffer_llr_t llr_format);
+
+/**
+ * @brief Number of bytes taken by a number of soft bits stored with a given width
+ */
+SRSRAN_API uint32_t srsran_softbuffer_llr_nof_bytes(srsran_softbuffer_llr_t llr_format, uint32_t nof_llr);
+
+/**
+ * @brief Converts a number of bits (16, 8 or 4) to a soft bit width
+ * @return SRSRAN_SUCCESS if the number of bits is valid, otherwise SRSRAN_ERROR
+ */
+SRSRAN_API int srsran_softbuffer_llr_from_nof_bits(uint32_t nof_bits, srsran_softbuffer_llr_t* llr_format);
+
+/**
+ * @brief Expands the first nof_llr soft bits of a code block stored in 8-bit or 4-bit
+ * @param q Rx soft-buffer object
+ * @param cb_idx Code block index
+ * @param llr Output soft bits, it must hold nof_llr values
+ * @param nof_llr Number of soft bits, no more than max_cb_size
+ * @return SRSRAN_SUCCESS if the soft bits are expanded, otherwise SRSRAN_ERROR
+ */
+SRSRAN_API int
+srsran_softbuffer_rx_cb_unpack(const srsran_softbuffer_rx_t* q, uint32_t cb_idx, int8_t* llr, uint32_t nof_llr);
+
+/**
+ * @brief Stores the first nof_llr soft bits of a code block in 8-bit or 4-bit. The 4-bit format rounds the soft bits to
+ * the nearest multiple of SRSRAN_SOFTBUFFER_LLR_4BIT_STEP and saturates them.
+ * @return SRSRAN_SUCCESS if the soft bits are stored, otherwise SRSRAN_ERROR
+ */
+SRSRAN_API int
+srsran_softbuffer_rx_cb_pack(srsran_softbuffer_rx_t* q, uint32_t cb_idx, const int8_t* llr, uint32_t nof_llr);
+
 SRSRAN_API void srsran_softbuffer_rx_reset(srsran_softbuffer_rx_t* p);
 
 SRSRAN_API void srsran_softbuffer_rx_reset_tbs(srsran_softbuffer_rx_t* q, uint32_t tbs);
@@ -84,6 +170,46 @@ SRSRAN_API void srsran_softbuffer_rx_free(srsran_softbuffer_rx_t* p);
  */
 SRSRAN_API void srsran_softbuffer_rx_reset_cb_crc(srsran_softbuffer_rx_t* q, uint32_t nof_cb);
 
+/**
+ * @brief Initialises a code block pool
+ * @param q The pool pointer
+ * @param max_cb_size The number of soft bits of every code block
+ * @param llr_format The width of the soft bits, it is inherited by the soft-buffers using the pool
+ * @param max_bytes The maximum memory the pool can request from the system, rounded up to 2 MB chunks
+ * @return SRSRAN_SUCCESS if the pool is initialised, otherwise SRSRAN_ERROR
+ */
+SRSRAN_API int srsran_softbuffer_pool_init(srsran_softbuffer_pool_t* q,
+                                           uint32_t                  max_cb_size,
+                                           srsran_softbuffer_llr_t   llr_format,
+                                           uint64_t                  max_bytes);
+
+SRSRAN_API void srsran_softbuffer_pool_free(srsran_softbuffer_pool_t* q);
+
+SRSRAN_API void srsran_softbuffer_pool_get_metrics(srsran_softbuffer_pool_t* q, srsran_softbuffer_pool_metrics_t* m);
+
+/**
+ * @brief Initialises an Rx soft-buffer whose code blocks are taken from a pool only while they are in use. The code
+ * blocks are attached by srsran_softbuffer_rx_reserve() and returned by srsran_softbuffer_rx_release() or by a reset.
+ * @param q The Rx soft-buffer pointer
+ * @param max_cb The maximum number of code blocks
+ * @param pool The code block pool, it must outlive the soft-buffer
+ * @return SRSRAN_SUCCESS if the soft-buffer is initialised, otherwise SRSRAN_ERROR
+ */
+SRSRAN_API int srsran_softbuffer_rx_init_pool(srsran_softbuffer_rx_t* q, uint32_t max_cb, srsran_softbuffer_pool_t* pool);
+
+/**
+ * @brief Makes sure the first nof_cb code blocks have memory, the ones taken from the pool are zeroed. It does nothing
+ * for soft-buffers that own their code blocks.
+ * @return SRSRAN_SUCCESS if all the code blocks are available, otherwise SRSRAN_ERROR
+ */
+SRSRAN_API int srsran_softbuffer_rx_reserve(srsran_softbuffer_rx_t* q, uint32_t nof_cb);
+
+/**
+ * @brief Returns the code blocks of an idle soft-buffer to its pool and resets its CRCs. It does nothing for
+ * soft-buffers that own their code blocks, they are reset by the next transmission.
+ */
+SRSRAN_API void srsran_softbuffer_rx_release(srsran_softbuffer_rx_t* q);
+
 SRSRAN_API int srsran_softbuffer_tx_init(srsran_softbuffer_tx_t* q, uint32_t nof_prb);
 
 /**
@@ -47,6 +47,20 @@
 
 typedef enum SRSRAN_API { SEARCH_UE, SEARCH_COMMON } srsran_pdcch_search_mode_t;
 
+/* Candidates with a lower mean absolute LLR are considered empty and are not decoded */
+#define SRSRAN_PDCCH_MIN_LLR_MEAN 0.3f
+
+/* Maximum number of decoded candidates kept in the PDCCH object until the next LLR extraction */
+#define SRSRAN_PDCCH_MAX_DECODED_CACHE 64
+
+/* Decoded candidate, reused if the same location is decoded again with the same payload size */
+typedef struct SRSRAN_API {
+  srsran_dci_location_t location;
+  uint32_t              nof_bits;
+  uint16_t              crc_rem;
+  uint8_t               payload[SRSRAN_DCI_MAX_BITS];
+} srsran_pdcch_decoded_t;
+
 /* PDCCH object */
 typedef struct SRSRAN_API {
   srsran_cell_t cell;
@@ -66,6 +80,11 @@ typedef struct SRSRAN_API {
   uint8_t* e;
   float    rm_f[3 * (SRSRAN_DCI_MAX_BITS + 16)];
   float*   llr;
+  float*   cce_llr_abs; // Sum of the absolute LLR of each CCE
+
+  /* decoded candidates in the current subframe */
+  srsran_pdcch_decoded_t decoded[SRSRAN_PDCCH_MAX_DECODED_CACHE];
+  uint32_t               nof_decoded;
 
   /* tx & rx objects */
   srsran_modem_table_t mod;
@@ -100,6 +119,14 @@ SRSRAN_API int srsran_pdcch_extract_llr(srsran_pdcch_t*        q,
                                         srsran_chest_dl_res_t* channel,
                                         cf_t*                  sf_symbols[SRSRAN_MAX_PORTS]);
 
+/**
+ * @brief Computes the mean absolute LLR of a candidate location from the LLRs extracted by srsran_pdcch_extract_llr
+ * @param q PDCCH object
+ * @param location Candidate location
+ * @return The mean absolute LLR, 0 if the location is not valid
+ */
+SRSRAN_API float srsran_pdcch_candidate_energy(const srsran_pdcch_t* q, const srsran_dci_location_t* location);
+
 /* Decoding functions: Try to decode a DCI message after calling srsran_pdcch_extract_llr */
 SRSRAN_API int
 srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dci_cfg_t* dci_cfg, srsran_dci_msg_t* msg);
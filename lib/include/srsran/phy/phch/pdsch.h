@@ -72,6 +72,9 @@ typedef struct SRSRAN_API {
   srsran_evm_buffer_t* evm_buffer[SRSRAN_MAX_CODEWORDS];
   float                avg_evm;
 
+  // Scrambling sequence caches, one for each codeword (avoid concurrency issue with coworker)
+  srsran_sequence_cache_t seq_cache[SRSRAN_MAX_CODEWORDS];
+
   srsran_sch_t dl_sch;
 
   void* coworker_ptr;
@@ -91,6 +94,9 @@ SRSRAN_API int srsran_pdsch_init_enb(srsran_pdsch_t* q, uint32_t max_prb);
 
 SRSRAN_API void srsran_pdsch_free(srsran_pdsch_t* q);
 
+/* Sizes the scrambling sequence caches for nof_rnti RNTIs, by default 2 */
+SRSRAN_API int srsran_pdsch_set_seq_cache_nof_rnti(srsran_pdsch_t* q, uint32_t nof_rnti);
+
 /* These functions modify the state of the object and may take some time */
 SRSRAN_API int srsran_pdsch_enable_coworker(srsran_pdsch_t* q);
 
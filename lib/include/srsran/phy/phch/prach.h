@@ -119,6 +119,15 @@ typedef struct SRSRAN_API {
   cf_t                        sub[839 * 2];
   float                       phase[839];
 
+  // Batched detection, all the root sequences are transformed back to time domain with a single IFFT
+  bool              batch_detection;
+  uint32_t          batch_nof_roots; // Number of root sequences the batched IFFT is planned for
+  uint32_t          batch_N_zc;      // Sequence length the batched IFFT is planned for
+  cf_t*             batch_corr_spec;
+  cf_t*             batch_corr_time;
+  float*            batch_corr;
+  srsran_dft_plan_t batch_ifft;
+
 } srsran_prach_t;
 
 typedef struct SRSRAN_API {
@@ -157,6 +166,7 @@ typedef struct {
   srsran_tdd_config_t tdd_config;
   bool                enable_successive_cancellation;
   bool                enable_freq_domain_offset_calc;
+  bool                enable_batch_detection; // Correlates all the root sequences with one batched IFFT
 } srsran_prach_cfg_t;
 
 typedef struct SRSRAN_API {
@@ -70,6 +70,9 @@ typedef struct SRSRAN_API {
   srsran_modem_table_t mod[SRSRAN_MOD_NITEMS];
   srsran_sch_t         ul_sch;
 
+  // Scrambling sequence cache, the same sequence is used for descrambling and for the UCI decoder
+  srsran_sequence_cache_t seq_cache;
+
   // EVM buffer
   srsran_evm_buffer_t* evm_buffer;
 
@@ -95,6 +98,9 @@ SRSRAN_API int srsran_pusch_init_enb(srsran_pusch_t* q, uint32_t max_prb);
 
 SRSRAN_API void srsran_pusch_free(srsran_pusch_t* q);
 
+/* Sizes the scrambling sequence cache for nof_rnti RNTIs, by default 2 */
+SRSRAN_API int srsran_pusch_set_seq_cache_nof_rnti(srsran_pusch_t* q, uint32_t nof_rnti);
+
 /* These functions modify the state of the object and may take some time */
 SRSRAN_API int srsran_pusch_set_cell(srsran_pusch_t* q, srsran_cell_t cell);
 
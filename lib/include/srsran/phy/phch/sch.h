@@ -61,6 +61,7 @@ typedef struct SRSRAN_API {
   uint8_t*         parity_bits;
   void*            e;
   uint8_t*         temp_g_bits;
+  int8_t*          temp_cb_llr; // Code block soft bits of 4-bit soft-buffers while they are combined and decoded
   uint32_t*        ul_interleaver;
   srsran_uci_bit_t ack_ri_bits[57600]; // 4*M_sc*Qm_max for RI and ACK
 
@@ -59,6 +59,7 @@ typedef struct SRSRAN_API {
 
   /// Temporal data buffers
   uint8_t* temp_cb;
+  int8_t*  temp_llr; ///< Code block soft bits of 4-bit soft-buffers while they are combined and decoded
 
   /// CRC generators
   srsran_crc_t crc_tb_24;
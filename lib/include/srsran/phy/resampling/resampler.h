@@ -106,6 +106,94 @@ SRSRAN_API void srsran_resampler_fft_run(srsran_resampler_fft_t* q, const cf_t*
  */
 SRSRAN_API void srsran_resampler_fft_free(srsran_resampler_fft_t* q);
 
+/**
+ * Number of polyphase filter taps per phase, it must be a multiple of the largest SIMD register size in complex samples
+ */
+#define SRSRAN_RESAMPLER_POLY_NOF_TAPS 32
+
+/**
+ * Maximum interpolation and decimation factors after reducing the ratio
+ */
+#define SRSRAN_RESAMPLER_POLY_MAX_FACTOR 1024
+
+/**
+ * @brief Polyphase resampler internal state. It resamples by the rational ratio interp/decim and keeps the state
+ * between calls, so it can be used for continuous streams processed in blocks of any size.
+ */
+typedef struct {
+  uint32_t interp; ///< Interpolation factor (L)
+  uint32_t decim;  ///< Decimation factor (M)
+  uint32_t phase;  ///< Filter phase of the next output sample, in the range [0, interp)
+  uint32_t offset; ///< Index of the newest input sample used by the next output sample, relative to the next input
+  float*   filter; ///< Filter phases with reversed taps, each tap is repeated for the real and imaginary parts
+  cf_t     state[2 * SRSRAN_RESAMPLER_POLY_NOF_TAPS]; ///< Last input samples followed by the next input samples
+} srsran_resampler_poly_t;
+
+/**
+ * @brief Initialises a polyphase resampler for the ratio interp/decim. The ratio is reduced, so the sampling rates in
+ * Hz can be given directly as long as their reduced factors do not exceed SRSRAN_RESAMPLER_POLY_MAX_FACTOR.
+ *
+ * @note The resampler is not re-initialised if the reduced ratio is not changed
+ *
+ * @param q Object pointer
+ * @param interp Interpolation factor or output sampling rate
+ * @param decim Decimation factor or input sampling rate
+ * @return SRSRAN_SUCCESS if no error, otherwise an SRSRAN error code
+ */
+SRSRAN_API int srsran_resampler_poly_init(srsran_resampler_poly_t* q, uint32_t interp, uint32_t decim);
+
+/**
+ * @brief Resets the internal state of the resampler as if it had just been initialised
+ * @param q Object pointer
+ */
+SRSRAN_API void srsran_resampler_poly_reset_state(srsran_resampler_poly_t* q);
+
+/**
+ * @brief Get the delay introduced by the resampler filter
+ * @param q Object pointer
+ * @return The delay in number of output samples
+ */
+SRSRAN_API float srsran_resampler_poly_get_delay(const srsran_resampler_poly_t* q);
+
+/**
+ * @brief Get the number of input samples that produce exactly a given number of output samples from the current state
+ * @param q Object pointer
+ * @param nof_output Number of output samples
+ * @return The number of input samples
+ */
+SRSRAN_API uint32_t srsran_resampler_poly_nof_input(const srsran_resampler_poly_t* q, uint32_t nof_output);
+
+/**
+ * @brief Get the number of output samples that a given number of input samples produces from the current state
+ * @param q Object pointer
+ * @param nof_input Number of input samples
+ * @return The number of output samples
+ */
+SRSRAN_API uint32_t srsran_resampler_poly_nof_output(const srsran_resampler_poly_t* q, uint32_t nof_input);
+
+/**
+ * @brief Runs the polyphase resampler over a block of input samples
+ *
+ * @note Setting the input to NULL is equivalent of feeding zeroes
+ * @note Setting the output to NULL is equivalent of dropping output samples, the state is updated anyway
+ *
+ * @param q Object pointer, make sure it has been initialised
+ * @param input Points at the input complex buffer
+ * @param output Points at the output complex buffer, it must fit srsran_resampler_poly_nof_output() samples
+ * @param nof_input Number of input samples
+ * @return The number of output samples
+ */
+SRSRAN_API uint32_t srsran_resampler_poly_run(srsran_resampler_poly_t* q,
+                                              const cf_t*              input,
+                                              cf_t*                    output,
+                                              uint32_t                 nof_input);
+
+/**
+ * Free polyphase resampler buffers
+ * @param q  Object pointer
+ */
+SRSRAN_API void srsran_resampler_poly_free(srsran_resampler_poly_t* q);
+
 #ifdef __cplusplus
 }
 #endif
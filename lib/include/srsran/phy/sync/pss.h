@@ -137,6 +137,14 @@ SRSRAN_API int srsran_pss_set_N_id_2(srsran_pss_t* q, uint32_t N_id_2);
 
 SRSRAN_API int srsran_pss_find_pss(srsran_pss_t* q, const cf_t* input, float* corr_peak_value);
 
+SRSRAN_API int srsran_pss_find_pss_all(srsran_pss_t* q,
+                                       const cf_t*   input,
+                                       int           peak_pos[SRSRAN_NOF_NID_2],
+                                       float         corr_peak_value[SRSRAN_NOF_NID_2]);
+
+SRSRAN_API int
+srsran_pss_find_pss_multi(srsran_pss_t* q[], uint32_t nof_pss, const cf_t* input, int* peak_pos, float* corr_peak_value);
+
 SRSRAN_API int srsran_pss_chest(srsran_pss_t* q, const cf_t* input, cf_t ce[SRSRAN_PSS_LEN]);
 
 SRSRAN_API float srsran_pss_cfo_compute(srsran_pss_t* q, const cf_t* pss_recv);
@@ -314,4 +314,74 @@ SRSRAN_API uint32_t srsran_ssb_candidate_sf_offset(const srsran_ssb_t* q, uint32
 
 SRSRAN_API uint32_t srsran_ssb_cfg_to_str(const srsran_ssb_cfg_t* cfg, char* str, uint32_t str_len);
 
+/**
+ * @brief Maximum number of SSB center frequency and subcarrier spacing hypotheses searched together
+ */
+#define SRSRAN_SSB_MULTI_MAX_NOF_HYP 16
+
+/**
+ * @brief Describes an SSB searcher for several SSB center frequency and subcarrier spacing hypotheses within the same
+ * base-band signal. Every correlation window of the input is transformed into the frequency domain once and correlated
+ * with the PSS of every hypothesis
+ */
+typedef struct SRSRAN_API {
+  srsran_ssb_args_t args; ///< Stores initialization arguments
+
+  /// Hypotheses, each one is demodulated and decoded by its own SSB object configured when the hypotheses are set
+  srsran_ssb_t ssb[SRSRAN_SSB_MULTI_MAX_NOF_HYP];           ///< SSB object of each hypothesis
+  bool         ssb_initiated[SRSRAN_SSB_MULTI_MAX_NOF_HYP]; ///< Indicates the SSB objects that are initialised
+  uint32_t     nof_hyp;                                     ///< Number of configured hypotheses
+
+  /// Common correlation parameters
+  uint32_t max_corr_sz; ///< Maximum correlation size
+  uint32_t corr_sz;     ///< Correlation size
+  uint32_t corr_window; ///< Correlation window length
+  uint32_t symbol_sz;   ///< Largest symbol size among the hypotheses
+
+  /// Internal Objects
+  srsran_dft_plan_t fft_corr;  ///< FFT for correlation
+  srsran_dft_plan_t ifft_corr; ///< IFFT for correlation
+
+  /// Frequency/Time domain temporal data
+  cf_t* tmp_freq;                                                   ///< Temporal frequency domain buffer
+  cf_t* tmp_time;                                                   ///< Temporal time domain buffer
+  cf_t* tmp_corr;                                                   ///< Temporal correlation frequency domain buffer
+  cf_t* pss_seq[SRSRAN_SSB_MULTI_MAX_NOF_HYP][SRSRAN_NOF_NID_2_NR]; ///< Frequency domain PSS of each hypothesis
+} srsran_ssb_multi_t;
+
+/**
+ * @brief Initialises the multiple hypotheses SSB searcher
+ * @param q SSB multiple hypotheses searcher object
+ * @param args SSB initialization arguments, search and decode are always enabled
+ * @return SRSRAN_SUCCESS if the parameters are valid, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_ssb_multi_init(srsran_ssb_multi_t* q, const srsran_ssb_args_t* args);
+
+/**
+ * @brief Frees the multiple hypotheses SSB searcher
+ * @param q SSB multiple hypotheses searcher object
+ */
+SRSRAN_API void srsran_ssb_multi_free(srsran_ssb_multi_t* q);
+
+/**
+ * @brief Sets the hypotheses to search
+ * @note All the hypotheses must have the same sampling rate and base-band center frequency
+ * @param q SSB multiple hypotheses searcher object
+ * @param cfg SSB configuration of each hypothesis, e.g. one for each GSCN and subcarrier spacing in the bandwidth
+ * @param nof_cfg Number of hypotheses, up to SRSRAN_SSB_MULTI_MAX_NOF_HYP
+ * @return SRSRAN_SUCCESS if the parameters are valid, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_ssb_multi_set_cfg(srsran_ssb_multi_t* q, const srsran_ssb_cfg_t* cfg, uint32_t nof_cfg);
+
+/**
+ * @brief Searches for an SSB transmission of each hypothesis and decodes its PBCH message
+ * @param q SSB multiple hypotheses searcher object
+ * @param in Input baseband buffer
+ * @param nof_samples Number of samples available in the buffer
+ * @param res SSB search result of each hypothesis, in the order they were configured
+ * @return SRSRAN_SUCCESS if the parameters are valid, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int
+srsran_ssb_multi_search(srsran_ssb_multi_t* q, const cf_t* in, uint32_t nof_samples, srsran_ssb_search_res_t* res);
+
 #endif // SRSRAN_SSB_H
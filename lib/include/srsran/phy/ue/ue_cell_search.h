@@ -32,6 +32,10 @@
  *                (SRSRAN_CS_SAMP_FREQ constant) before calling to
  *                srsran_ue_cellsearch_scan() functions.
  *
+ *                Optionally, srsran_ue_cellsearch_scan() can capture the samples
+ *                once and search the 3 N_id_2 hypotheses over them in parallel
+ *                threads (see srsran_ue_cellsearch_enable_parallel()).
+ *
  *  Reference:
  *****************************************************************************/
 
@@ -74,6 +78,8 @@ typedef struct SRSRAN_API {
   uint8_t*  mode_counted;
 
   srsran_ue_cellsearch_result_t* candidates;
+
+  void* parallel_ptr; // N_id_2 hypotheses searched in parallel, NULL if disabled
 } srsran_ue_cellsearch_t;
 
 SRSRAN_API int srsran_ue_cellsearch_init(srsran_ue_cellsearch_t* q,
@@ -101,5 +107,16 @@ SRSRAN_API int srsran_ue_cellsearch_set_nof_valid_frames(srsran_ue_cellsearch_t*
 
 SRSRAN_API void srsran_set_detect_cp(srsran_ue_cellsearch_t* q, bool enable);
 
+/* Enables searching the 3 N_id_2 hypotheses in parallel threads in srsran_ue_cellsearch_scan(). The samples are received
+ * only once and replayed to a separate ue_sync object per hypothesis, so a frequency is scanned in the time of a single
+ * hypothesis.
+ */
+SRSRAN_API int srsran_ue_cellsearch_enable_parallel(srsran_ue_cellsearch_t* q, bool enable);
+
+/* Returns the ue_sync object used to search the given N_id_2, so that it can be configured. It is the common ue_sync
+ * object if the parallel search is disabled.
+ */
+SRSRAN_API srsran_ue_sync_t* srsran_ue_cellsearch_get_ue_sync(srsran_ue_cellsearch_t* q, uint32_t N_id_2);
+
 #endif // SRSRAN_UE_CELL_SEARCH_H
 
@@ -107,6 +107,9 @@ typedef struct SRSRAN_API {
 
   srsran_dci_location_t allocated_locations[SRSRAN_MAX_DCI_MSG];
   uint32_t              nof_allocated_locations;
+
+  // Blind search ranks the candidates by energy and stops as soon as the expected DCIs are found
+  bool dci_early_abort;
 } srsran_ue_dl_t;
 
 // Downlink config (includes common and dedicated variables)
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         cpu.h
+ *
+ *  Description:  Runtime detection of the instruction set extensions supported
+ *                by the CPU. When the library is built with ENABLE_MULTI_ISA,
+ *                the AVX512 kernels are built alongside the baseline ones and
+ *                selected with these functions at startup.
+ *
+ *  Reference:
+ *****************************************************************************/
+
+#ifndef SRSRAN_CPU_H
+#define SRSRAN_CPU_H
+
+#include "srsran/config.h"
+#include <stdbool.h>
+
+// AVX512 kernels are available, either because the whole library is built for AVX512 or as runtime selected variants
+#if defined(LV_HAVE_AVX512) || defined(SRSRAN_MULTI_ISA_AVX512)
+#define SRSRAN_AVX512_KERNELS 1
+#endif
+
+typedef enum SRSRAN_API {
+  SRSRAN_CPU_ISA_GENERIC = 0,
+  SRSRAN_CPU_ISA_SSE,    // SSE4.1
+  SRSRAN_CPU_ISA_AVX,    // AVX
+  SRSRAN_CPU_ISA_AVX2,   // AVX2 and FMA
+  SRSRAN_CPU_ISA_AVX512, // AVX512 F, CD, BW and DQ
+} srsran_cpu_isa_t;
+
+/**
+ * @brief Detects the highest instruction set level supported by the CPU and the OS. It does not depend on any other
+ * symbol, so it can be used from ifunc resolvers before the relocations are done.
+ */
+static inline srsran_cpu_isa_t srsran_cpu_detect_isa(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512cd") && __builtin_cpu_supports("avx512bw") &&
+      __builtin_cpu_supports("avx512dq")) {
+    return SRSRAN_CPU_ISA_AVX512;
+  }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return SRSRAN_CPU_ISA_AVX2;
+  }
+  if (__builtin_cpu_supports("avx")) {
+    return SRSRAN_CPU_ISA_AVX;
+  }
+  if (__builtin_cpu_supports("sse4.1")) {
+    return SRSRAN_CPU_ISA_SSE;
+  }
+#endif
+  return SRSRAN_CPU_ISA_GENERIC;
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Highest instruction set level supported by the CPU, detected once
+SRSRAN_API srsran_cpu_isa_t srsran_cpu_get_isa();
+
+SRSRAN_API bool srsran_cpu_has_avx512();
+
+SRSRAN_API const char* srsran_cpu_isa_string(srsran_cpu_isa_t isa);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_CPU_H
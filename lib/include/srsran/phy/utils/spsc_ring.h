@@ -0,0 +1,144 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         spsc_ring.h
+ *
+ *  Description:  Lock-free single-producer single-consumer ring buffer for
+ *                baseband samples. Exactly one thread may write and exactly one
+ *                thread may read. Besides the copying read and write, it
+ *                provides zero-copy reserve/commit for the producer and
+ *                peek/release for the consumer, so drivers can receive straight
+ *                into the ring and the PHY can convert straight out of it.
+ *
+ *  Reference:
+ *****************************************************************************/
+
+#ifndef SRSRAN_SPSC_RING_H
+#define SRSRAN_SPSC_RING_H
+
+#include "srsran/config.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SRSRAN_SPSC_RING_CACHE_LINE 64
+
+typedef struct SRSRAN_API {
+  uint8_t* buffer;      // capacity bytes, followed by max_reserve bytes of overrun area
+  uint32_t capacity;    // Number of bytes the ring can hold
+  uint32_t max_reserve; // Maximum number of bytes that can be reserved at once
+  bool     active;      // Cleared by stop, waits return immediately when false
+
+  // Written by the producer only, each side on its own cache line to avoid false sharing
+  uint64_t write_idx __attribute__((aligned(SRSRAN_SPSC_RING_CACHE_LINE)));
+  uint64_t read_idx_cache;
+
+  // Written by the consumer only
+  uint64_t read_idx __attribute__((aligned(SRSRAN_SPSC_RING_CACHE_LINE)));
+  uint64_t write_idx_cache;
+} srsran_spsc_ring_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Initialises the ring
+ * @param q Ring object
+ * @param capacity Number of bytes the ring can hold
+ * @param max_reserve Maximum number of bytes the producer can reserve at once, 0 if reserve is not used
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR otherwise
+ */
+SRSRAN_API int srsran_spsc_ring_init(srsran_spsc_ring_t* q, uint32_t capacity, uint32_t max_reserve);
+
+SRSRAN_API void srsran_spsc_ring_free(srsran_spsc_ring_t* q);
+
+/**
+ * @brief Discards all the data in the ring. It must not be called while the producer or the consumer are using it.
+ */
+SRSRAN_API void srsran_spsc_ring_reset(srsran_spsc_ring_t* q);
+
+/**
+ * @brief Stops the ring, any pending or future wait returns SRSRAN_ERROR
+ */
+SRSRAN_API void srsran_spsc_ring_stop(srsran_spsc_ring_t* q);
+
+// Number of bytes available for reading
+SRSRAN_API uint32_t srsran_spsc_ring_status(srsran_spsc_ring_t* q);
+
+// Number of bytes available for writing
+SRSRAN_API uint32_t srsran_spsc_ring_space(srsran_spsc_ring_t* q);
+
+/**
+ * @brief Waits until nof_bytes can be written. A positive timeout_ms bounds the wait, 0 does not wait and a negative
+ * value waits forever.
+ * @return SRSRAN_SUCCESS if there is enough space, SRSRAN_ERROR_TIMEOUT if the timeout expired, SRSRAN_ERROR if the
+ * ring was stopped
+ */
+SRSRAN_API int srsran_spsc_ring_wait_write(srsran_spsc_ring_t* q, uint32_t nof_bytes, int32_t timeout_ms);
+
+/**
+ * @brief Waits until nof_bytes can be read, with the same timeout_ms semantics than srsran_spsc_ring_wait_write()
+ */
+SRSRAN_API int srsran_spsc_ring_wait_read(srsran_spsc_ring_t* q, uint32_t nof_bytes, int32_t timeout_ms);
+
+/**
+ * @brief Producer side zero-copy write. Returns a contiguous region of nof_bytes where the producer can write, or NULL
+ * if there is not enough space or nof_bytes exceeds the maximum reserve. The data becomes visible to the consumer
+ * after srsran_spsc_ring_commit().
+ */
+SRSRAN_API void* srsran_spsc_ring_reserve(srsran_spsc_ring_t* q, uint32_t nof_bytes);
+
+/**
+ * @brief Publishes the first nof_bytes of the last reserved region
+ */
+SRSRAN_API void srsran_spsc_ring_commit(srsran_spsc_ring_t* q, uint32_t nof_bytes);
+
+/**
+ * @brief Copies nof_bytes into the ring waiting for space as srsran_spsc_ring_wait_write()
+ * @return nof_bytes if the data was written, a negative error code otherwise
+ */
+SRSRAN_API int
+srsran_spsc_ring_write_timed(srsran_spsc_ring_t* q, const void* ptr, uint32_t nof_bytes, int32_t timeout_ms);
+
+/**
+ * @brief Consumer side zero-copy read. Returns the contiguous region of data that can be read and writes its size in
+ * nof_bytes, which may be less than the data available if it wraps around the end of the ring. Returns NULL if the
+ * ring is empty.
+ */
+SRSRAN_API const void* srsran_spsc_ring_peek(srsran_spsc_ring_t* q, uint32_t* nof_bytes);
+
+/**
+ * @brief Frees the first nof_bytes of the data, after they have been consumed with srsran_spsc_ring_peek()
+ */
+SRSRAN_API void srsran_spsc_ring_release(srsran_spsc_ring_t* q, uint32_t nof_bytes);
+
+/**
+ * @brief Copies nof_bytes out of the ring waiting for data as srsran_spsc_ring_wait_read(). A NULL ptr discards them.
+ * @return nof_bytes if the data was read, a negative error code otherwise
+ */
+SRSRAN_API int srsran_spsc_ring_read_timed(srsran_spsc_ring_t* q, void* ptr, uint32_t nof_bytes, int32_t timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_SPSC_RING_H
@@ -136,6 +136,11 @@ SRSRAN_API uint8_t* srsran_vec_u8_malloc(uint32_t nsamples);
 
 SRSRAN_API void* srsran_vec_realloc(void* ptr, uint32_t old_size, uint32_t new_size);
 
+/* Transparent huge pages for the allocations of at least 2 MB made by the calling thread with srsran_vec_malloc().
+ * The NUMA node of the buffers is the one of the CPU that touches them first, so workers initialise their buffers in
+ * the CPU they will run on. */
+SRSRAN_API void srsran_vec_malloc_set_huge_pages(bool enable);
+
 /* Zero memory */
 SRSRAN_API void srsran_vec_zero(void* ptr, uint32_t nsamples);
 SRSRAN_API void srsran_vec_cf_zero(cf_t* ptr, uint32_t nsamples);
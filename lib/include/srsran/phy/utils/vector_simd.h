@@ -138,6 +138,9 @@ SRSRAN_API void srsran_vec_apply_cfo_simd(const cf_t* x, float cfo, cf_t* z, int
 
 SRSRAN_API float srsran_vec_estimate_frequency_simd(const cf_t* x, int len);
 
+SRSRAN_API void
+srsran_vec_gen_clip_env_simd(const float* x_abs, const float thres, const float alpha, float* env, const int len);
+
 /* SIMD Find Max functions */
 SRSRAN_API uint32_t srsran_vec_max_fi_simd(const float* x, const int len);
 
@@ -95,21 +95,23 @@ public:
   static void rf_msg_callback(void* arg, srsran_rf_error_t error);
 
 private:
-  std::vector<srsran_rf_t>                                rf_devices  = {};
-  std::vector<srsran_rf_info_t>                           rf_info     = {};
-  std::vector<int32_t>                                    rx_offset_n = {};
-  rf_metrics_t                                            rf_metrics  = {};
-  std::mutex                                              metrics_mutex;
-  srslog::basic_logger&                                   logger = srslog::fetch_basic_logger("RF", false);
-  phy_interface_radio*                                    phy    = nullptr;
-  std::vector<cf_t>                                       zeros;
-  std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>      dummy_buffers;
-  std::mutex                                              tx_mutex;
-  std::mutex                                              rx_mutex;
-  std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>      tx_buffer;
-  std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>      rx_buffer;
-  std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS> interpolators = {};
-  std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS> decimators    = {};
+  std::vector<srsran_rf_t>                                 rf_devices  = {};
+  std::vector<srsran_rf_info_t>                            rf_info     = {};
+  std::vector<int32_t>                                     rx_offset_n = {};
+  rf_metrics_t                                             rf_metrics  = {};
+  std::mutex                                               metrics_mutex;
+  srslog::basic_logger&                                    logger = srslog::fetch_basic_logger("RF", false);
+  phy_interface_radio*                                     phy    = nullptr;
+  std::vector<cf_t>                                        zeros;
+  std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>       dummy_buffers;
+  std::mutex                                               tx_mutex;
+  std::mutex                                               rx_mutex;
+  std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>       tx_buffer;
+  std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>       rx_buffer;
+  std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS>  interpolators = {};
+  std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS>  decimators    = {};
+  std::array<srsran_resampler_poly_t, SRSRAN_MAX_CHANNELS> tx_resamplers = {}; ///< Used for non-integer ratios
+  std::array<srsran_resampler_poly_t, SRSRAN_MAX_CHANNELS> rx_resamplers = {}; ///< Used for non-integer ratios
   std::atomic<bool> decimator_busy = {false}; ///< Indicates the decimator is changing the rate
 
   rf_timestamp_t    end_of_burst_time = {};
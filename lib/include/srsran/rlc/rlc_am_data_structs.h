@@ -22,6 +22,7 @@
 #ifndef SRSRAN_RLC_AM_DATA_STRUCTS_H
 #define SRSRAN_RLC_AM_DATA_STRUCTS_H
 
+#include "srsran/adt/bounded_bitset.h"
 #include "srsran/adt/circular_buffer.h"
 #include "srsran/adt/circular_map.h"
 #include "srsran/adt/intrusive_list.h"
@@ -216,6 +217,12 @@ struct rlc_ringbuffer_base {
   virtual bool   full() const              = 0;
   virtual void   clear()                   = 0;
   virtual bool   has_sn(uint32_t sn) const = 0;
+
+  /// Returns the number of consecutive SNs, starting at sn and up to max_len, for which has_sn() equals present.
+  /// The scan is done a whole bitmap word at a time and assumes all SNs in the window belong to the same window span.
+  virtual uint32_t sn_run_length(uint32_t sn, uint32_t max_len, bool present) const = 0;
+  /// Returns the number of SNs in [sn, sn + len) for which has_sn() equals present.
+  virtual uint32_t count_sn(uint32_t sn, uint32_t len, bool present) const = 0;
 };
 
 template <class T, std::size_t WINDOW_SIZE>
@@ -226,21 +233,64 @@ struct rlc_ringbuffer_t : public rlc_ringbuffer_base<T> {
   {
     srsran_expect(not has_sn(sn), "The same SN=%zd should not be added twice", sn);
     window.overwrite(sn, T(sn));
+    present_mask.set(sn % WINDOW_SIZE);
     return window[sn];
   }
   void remove_pdu(size_t sn) override
   {
     srsran_expect(has_sn(sn), "The removed SN=%zd is not in the window", sn);
     window.erase(sn);
+    present_mask.reset(sn % WINDOW_SIZE);
   }
   T&     operator[](size_t sn) override { return window[sn]; }
   size_t size() const override { return window.size(); }
   bool   full() const override { return window.full(); }
   bool   empty() const override { return window.empty(); }
-  void   clear() override { window.clear(); }
+  void   clear() override
+  {
+    window.clear();
+    present_mask.reset();
+  }
 
   bool has_sn(uint32_t sn) const override { return window.contains(sn); }
 
+  uint32_t sn_run_length(uint32_t sn, uint32_t max_len, bool present) const override
+  {
+    max_len        = std::min(max_len, static_cast<uint32_t>(WINDOW_SIZE));
+    uint32_t start = sn % WINDOW_SIZE;
+    uint32_t stop  = std::min(start + max_len, static_cast<uint32_t>(WINDOW_SIZE));
+    // Look for the first slot whose state differs from the requested one
+    int pos = present_mask.find_lowest(start, stop, not present);
+    if (pos >= 0) {
+      return pos - start;
+    }
+    uint32_t run = stop - start;
+    if (run < max_len) {
+      // Wrap around the end of the bitmap
+      pos = present_mask.find_lowest(0, max_len - run, not present);
+      run += (pos >= 0) ? pos : max_len - run;
+    }
+    return run;
+  }
+
+  uint32_t count_sn(uint32_t sn, uint32_t len, bool present) const override
+  {
+    uint32_t count = 0;
+    while (len > 0) {
+      uint32_t run = sn_run_length(sn, len, present);
+      count += run;
+      sn  = sn + run;
+      len = len - run;
+      if (len > 0) {
+        // Skip the run with the opposite state
+        run = sn_run_length(sn, len, not present);
+        sn  = sn + run;
+        len = len - run;
+      }
+    }
+    return count;
+  }
+
   // Return the sum data bytes of all active PDUs (check PDU is non-null)
   uint32_t get_buffered_bytes()
   {
@@ -255,6 +305,8 @@ struct rlc_ringbuffer_t : public rlc_ringbuffer_base<T> {
 
 private:
   srsran::static_circular_map<uint32_t, T, WINDOW_SIZE> window;
+  /// One bit per window slot (SN modulo WINDOW_SIZE), set while the slot holds a PDU
+  srsran::bounded_bitset<WINDOW_SIZE> present_mask{WINDOW_SIZE};
 };
 
 template <typename HeaderType>
@@ -92,6 +92,7 @@ constexpr uint32_t rlc_am_nr_status_pdu_sizeof_nack_sn_ext_12bit_sn = 2; ///< NA
 constexpr uint32_t rlc_am_nr_status_pdu_sizeof_nack_sn_ext_18bit_sn = 3; ///< NACK SN and extension fields (18 bit SN)
 constexpr uint32_t rlc_am_nr_status_pdu_sizeof_nack_so              = 4; ///< NACK segment offsets (start and end)
 constexpr uint32_t rlc_am_nr_status_pdu_sizeof_nack_range           = 1; ///< NACK range (nof consecutively lost SDUs)
+constexpr uint32_t rlc_am_nr_status_pdu_max_nack_range              = 255; ///< Largest value of the 8 bit NACK range
 
 /// AM NR Status PDU header
 class rlc_am_nr_status_pdu_t
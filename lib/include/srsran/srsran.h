@@ -39,6 +39,7 @@ extern "C" {
 #include "srsran/phy/utils/convolution.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/ringbuffer.h"
+#include "srsran/phy/utils/spsc_ring.h"
 #include "srsran/phy/utils/vector.h"
 
 #include "srsran/phy/common/phy_common.h"
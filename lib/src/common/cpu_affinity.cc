@@ -0,0 +1,469 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/cpu_affinity.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <fstream>
+#include <set>
+#include <thread>
+#include <utility>
+
+namespace srsran {
+
+static bool read_line(const std::string& path, std::string& line)
+{
+  std::ifstream f(path);
+  if (not f.is_open()) {
+    return false;
+  }
+  std::getline(f, line);
+  return true;
+}
+
+static bool read_uint(const std::string& path, uint32_t& value)
+{
+  std::string line;
+  if (not read_line(path, line) or line.empty()) {
+    return false;
+  }
+  value = (uint32_t)strtoul(line.c_str(), nullptr, 10);
+  return true;
+}
+
+bool parse_cpu_list(const std::string& list, std::vector<uint32_t>& cpus)
+{
+  cpus.clear();
+
+  size_t pos = 0;
+  while (pos < list.size()) {
+    size_t      end   = std::min(list.find(',', pos), list.size());
+    std::string range = list.substr(pos, end - pos);
+    pos               = end + 1;
+
+    // Ignore the trailing new line and spaces
+    range.erase(std::remove_if(range.begin(), range.end(), ::isspace), range.end());
+    if (range.empty()) {
+      continue;
+    }
+
+    char*         str_end = nullptr;
+    unsigned long first   = strtoul(range.c_str(), &str_end, 10);
+    unsigned long last    = first;
+    if (str_end == range.c_str()) {
+      return false;
+    }
+    if (*str_end == '-') {
+      const char* last_str = str_end + 1;
+      last                 = strtoul(last_str, &str_end, 10);
+      if (str_end == last_str or last < first) {
+        return false;
+      }
+    }
+    if (*str_end != '\0' or last >= CPU_SETSIZE) {
+      return false;
+    }
+    for (unsigned long cpu = first; cpu <= last; cpu++) {
+      cpus.push_back((uint32_t)cpu);
+    }
+  }
+
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  return true;
+}
+
+std::string cpu_list_to_string(const std::vector<uint32_t>& cpus)
+{
+  std::vector<uint32_t> sorted = cpus;
+  std::sort(sorted.begin(), sorted.end());
+
+  std::string str;
+  for (size_t i = 0; i < sorted.size();) {
+    size_t j = i;
+    while (j + 1 < sorted.size() and sorted[j + 1] == sorted[j] + 1) {
+      j++;
+    }
+    if (not str.empty()) {
+      str += ",";
+    }
+    str += std::to_string(sorted[i]);
+    if (j > i) {
+      str += "-" + std::to_string(sorted[j]);
+    }
+    i = j + 1;
+  }
+  return str;
+}
+
+bool cpu_topology::detect(const std::string& sysfs_root)
+{
+  cpus.clear();
+  isolated.clear();
+
+  std::string           line;
+  std::vector<uint32_t> online;
+  if (not read_line(sysfs_root + "/cpu/online", line) or not parse_cpu_list(line, online) or online.empty()) {
+    return false;
+  }
+
+  for (uint32_t id : online) {
+    std::string topology_dir = sysfs_root + "/cpu/cpu" + std::to_string(id) + "/topology/";
+    cpu_info_t  cpu          = {};
+    cpu.id                   = id;
+    if (not read_uint(topology_dir + "physical_package_id", cpu.package_id)) {
+      cpu.package_id = 0;
+    }
+    // Without topology every logical CPU is a physical core of its own
+    if (not read_uint(topology_dir + "core_id", cpu.core_id)) {
+      cpu.core_id = id;
+    }
+    cpus.push_back(cpu);
+  }
+
+  // Systems without NUMA support do not have node directories, all the CPUs stay in node 0
+  DIR* dir = opendir((sysfs_root + "/node").c_str());
+  if (dir != nullptr) {
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+      uint32_t node_id = 0;
+      if (sscanf(entry->d_name, "node%u", &node_id) != 1) {
+        continue;
+      }
+      std::vector<uint32_t> node_cpus;
+      if (not read_line(sysfs_root + "/node/" + entry->d_name + "/cpulist", line) or
+          not parse_cpu_list(line, node_cpus)) {
+        continue;
+      }
+      for (cpu_info_t& cpu : cpus) {
+        if (std::binary_search(node_cpus.begin(), node_cpus.end(), cpu.id)) {
+          cpu.node_id = node_id;
+        }
+      }
+    }
+    closedir(dir);
+  }
+
+  std::vector<uint32_t> isolated_cpus;
+  if (read_line(sysfs_root + "/cpu/isolated", line) and parse_cpu_list(line, isolated_cpus)) {
+    for (uint32_t id : isolated_cpus) {
+      if (find(id) != nullptr) {
+        isolated.push_back(id);
+      }
+    }
+  }
+
+  return true;
+}
+
+const cpu_info_t* cpu_topology::find(uint32_t id) const
+{
+  auto it = std::find_if(cpus.begin(), cpus.end(), [id](const cpu_info_t& cpu) { return cpu.id == id; });
+  return it != cpus.end() ? &(*it) : nullptr;
+}
+
+std::vector<uint32_t> get_cpu_mask_cpus(int32_t mask)
+{
+  // Same convention as thread_pool::init_worker(): the 8 LSB select the CPUs, 255 or a negative mask leave them free
+  std::vector<uint32_t> ids;
+  if (mask <= 0 or mask == 255) {
+    return ids;
+  }
+  for (uint32_t i = 0; i < 8; i++) {
+    if (((uint32_t)mask >> i) & 1U) {
+      ids.push_back(i);
+    }
+  }
+  return ids;
+}
+
+bool cpu_affinity_policy::init(const cpu_affinity_args_t& args)
+{
+  if (args.mode == "none") {
+    enabled = false;
+    return true;
+  }
+
+  cpu_topology topology;
+  if (not topology.detect()) {
+    logger.error("Error reading the CPU topology, CPU affinity is disabled");
+    enabled = false;
+    return false;
+  }
+  return init(args, topology);
+}
+
+bool cpu_affinity_policy::init(const cpu_affinity_args_t& args, const cpu_topology& topology)
+{
+  enabled = false;
+  for (size_t i = 0; i < nof_classes; i++) {
+    cpus[i].clear();
+    next_cpu[i] = 0;
+  }
+  housekeeping.clear();
+
+  bool ret = true;
+  if (args.mode == "none") {
+    return true;
+  } else if (args.mode == "auto") {
+    ret = init_auto(args, topology);
+  } else if (args.mode == "manual") {
+    ret = init_manual(args, topology);
+  } else {
+    logger.error("Invalid CPU affinity mode '%s', valid modes are none, auto and manual", args.mode.c_str());
+    ret = false;
+  }
+  if (not ret) {
+    return false;
+  }
+
+  // Auto mode leaves the policy disabled if the system is too small for it
+  enabled = not cpus[(size_t)cpu_thread_class::radio].empty();
+  if (enabled) {
+    logger.info("CPU affinity: %s", to_string().c_str());
+  }
+  return true;
+}
+
+bool cpu_affinity_policy::init_auto(const cpu_affinity_args_t& args, const cpu_topology& topology)
+{
+  if (topology.cpus.empty()) {
+    return false;
+  }
+
+  // Keep all the real-time threads in a single NUMA node, the one of the isolated CPUs if none is given
+  uint32_t node = topology.cpus.front().node_id;
+  if (args.numa_node >= 0) {
+    node = (uint32_t)args.numa_node;
+  } else if (not topology.isolated.empty() and topology.find(topology.isolated.front()) != nullptr) {
+    node = topology.find(topology.isolated.front())->node_id;
+  }
+
+  std::vector<const cpu_info_t*> node_cpus;
+  for (const cpu_info_t& cpu : topology.cpus) {
+    if (cpu.node_id == node) {
+      node_cpus.push_back(&cpu);
+    }
+  }
+  if (node_cpus.empty()) {
+    logger.error("NUMA node %d has no online CPUs", node);
+    return false;
+  }
+
+  // Use the isolated CPUs of the node or, if there are none, every core but the first one, which is left to the OS
+  std::vector<const cpu_info_t*> candidates;
+  for (const cpu_info_t* cpu : node_cpus) {
+    if (std::binary_search(topology.isolated.begin(), topology.isolated.end(), cpu->id)) {
+      candidates.push_back(cpu);
+    }
+  }
+  if (candidates.empty()) {
+    for (const cpu_info_t* cpu : node_cpus) {
+      if (cpu->package_id != node_cpus.front()->package_id or cpu->core_id != node_cpus.front()->core_id) {
+        candidates.push_back(cpu);
+      }
+    }
+  }
+
+  // A single logical CPU per physical core, the SMT siblings would compete with it for the execution units
+  std::set<std::pair<uint32_t, uint32_t> > rt_cores;
+  std::vector<uint32_t>                    primaries;
+  for (const cpu_info_t* cpu : candidates) {
+    if (rt_cores.insert({cpu->package_id, cpu->core_id}).second) {
+      primaries.push_back(cpu->id);
+    }
+  }
+  if (primaries.size() < 2) {
+    logger.warning("Not enough physical cores in NUMA node %d for the real-time threads, CPU affinity is disabled",
+                   node);
+    return true;
+  }
+
+  // The radio and stack threads get a core of their own, the PHY workers share the rest. With two cores only, the
+  // stack thread shares its core with the PHY workers.
+  cpus[(size_t)cpu_thread_class::radio].push_back(primaries.front());
+  cpus[(size_t)cpu_thread_class::stack].push_back(primaries.back());
+  if (primaries.size() > 2) {
+    cpus[(size_t)cpu_thread_class::phy].assign(primaries.begin() + 1, primaries.end() - 1);
+  } else {
+    cpus[(size_t)cpu_thread_class::phy].push_back(primaries.back());
+  }
+
+  // Everything else runs in the cores left, on any node
+  for (const cpu_info_t& cpu : topology.cpus) {
+    if (rt_cores.count({cpu.package_id, cpu.core_id}) == 0) {
+      housekeeping.push_back(cpu.id);
+    }
+  }
+  if (housekeeping.empty()) {
+    for (const cpu_info_t& cpu : topology.cpus) {
+      if (std::find(primaries.begin(), primaries.end(), cpu.id) == primaries.end()) {
+        housekeeping.push_back(cpu.id);
+      }
+    }
+  }
+  if (housekeeping.empty()) {
+    logger.warning("No CPUs left for the housekeeping threads, they share the real-time CPUs");
+    for (const cpu_info_t& cpu : topology.cpus) {
+      housekeeping.push_back(cpu.id);
+    }
+  }
+
+  return true;
+}
+
+bool cpu_affinity_policy::init_manual(const cpu_affinity_args_t& args, const cpu_topology& topology)
+{
+  const std::array<std::pair<const char*, const std::string*>, nof_classes> lists = {
+      {{"radio", &args.radio_cpus}, {"phy", &args.phy_cpus}, {"stack", &args.stack_cpus}}};
+
+  std::vector<uint32_t> rt_cpus;
+  for (size_t i = 0; i < nof_classes; i++) {
+    if (not parse_cpu_list(*lists[i].second, cpus[i]) or cpus[i].empty()) {
+      logger.error("Invalid %s CPU list '%s'", lists[i].first, lists[i].second->c_str());
+      return false;
+    }
+    for (uint32_t id : cpus[i]) {
+      if (topology.find(id) == nullptr) {
+        logger.error("CPU %d of the %s CPU list is not online", id, lists[i].first);
+        return false;
+      }
+    }
+    rt_cpus.insert(rt_cpus.end(), cpus[i].begin(), cpus[i].end());
+  }
+
+  if (not args.housekeeping_cpus.empty()) {
+    if (not parse_cpu_list(args.housekeeping_cpus, housekeeping) or housekeeping.empty()) {
+      logger.error("Invalid housekeeping CPU list '%s'", args.housekeeping_cpus.c_str());
+      return false;
+    }
+    return true;
+  }
+
+  for (const cpu_info_t& cpu : topology.cpus) {
+    if (std::find(rt_cpus.begin(), rt_cpus.end(), cpu.id) == rt_cpus.end()) {
+      housekeeping.push_back(cpu.id);
+    }
+  }
+  if (housekeeping.empty()) {
+    logger.warning("No CPUs left for the housekeeping threads, they share the real-time CPUs");
+    for (const cpu_info_t& cpu : topology.cpus) {
+      housekeeping.push_back(cpu.id);
+    }
+  }
+  return true;
+}
+
+static void fill_cpuset(const std::vector<uint32_t>& cpus, cpu_set_t& cpuset)
+{
+  CPU_ZERO(&cpuset);
+  for (uint32_t id : cpus) {
+    CPU_SET(id, &cpuset);
+  }
+}
+
+bool run_on_cpus(const std::vector<uint32_t>& cpus, const std::function<void()>& task)
+{
+  if (cpus.empty()) {
+    task();
+    return true;
+  }
+
+  bool        ret = false;
+  std::thread t([&cpus, &task, &ret]() {
+    cpu_set_t cpuset;
+    fill_cpuset(cpus, cpuset);
+    ret = (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) == 0);
+    task();
+  });
+  t.join();
+  return ret;
+}
+
+bool cpu_affinity_policy::pin(thread& t, cpu_thread_class c)
+{
+  if (not enabled) {
+    return true;
+  }
+  const std::vector<uint32_t>& class_cpus = cpus[(size_t)c];
+  uint32_t                     cpu        = class_cpus[next_cpu[(size_t)c]++ % class_cpus.size()];
+
+  cpu_set_t cpuset;
+  fill_cpuset({cpu}, cpuset);
+  if (not t.set_affinity(&cpuset)) {
+    logger.warning("Error pinning thread to CPU %d", cpu);
+    return false;
+  }
+  return true;
+}
+
+bool cpu_affinity_policy::run_on_next_cpu(cpu_thread_class c, const std::function<void()>& task) const
+{
+  if (not enabled) {
+    return run_on_cpus({}, task);
+  }
+  const std::vector<uint32_t>& class_cpus = cpus[(size_t)c];
+  return run_on_cpus({class_cpus[next_cpu[(size_t)c] % class_cpus.size()]}, task);
+}
+
+bool cpu_affinity_policy::pin_class(thread& t, cpu_thread_class c)
+{
+  if (not enabled) {
+    return true;
+  }
+  cpu_set_t cpuset;
+  fill_cpuset(cpus[(size_t)c], cpuset);
+  if (not t.set_affinity(&cpuset)) {
+    logger.warning("Error setting thread affinity to CPUs %s", cpu_list_to_string(cpus[(size_t)c]).c_str());
+    return false;
+  }
+  return true;
+}
+
+bool cpu_affinity_policy::apply_housekeeping()
+{
+  if (not enabled) {
+    return true;
+  }
+  cpu_set_t cpuset;
+  fill_cpuset(housekeeping, cpuset);
+  if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) != 0) {
+    logger.warning("Error setting the housekeeping CPUs %s", cpu_list_to_string(housekeeping).c_str());
+    return false;
+  }
+  return true;
+}
+
+std::string cpu_affinity_policy::to_string() const
+{
+  if (not enabled) {
+    return "disabled";
+  }
+  return "radio=" + cpu_list_to_string(cpus[(size_t)cpu_thread_class::radio]) +
+         " phy=" + cpu_list_to_string(cpus[(size_t)cpu_thread_class::phy]) +
+         " stack=" + cpu_list_to_string(cpus[(size_t)cpu_thread_class::stack]) +
+         " housekeeping=" + cpu_list_to_string(housekeeping);
+}
+
+} // namespace srsran
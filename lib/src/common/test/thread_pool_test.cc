@@ -23,6 +23,7 @@
 #include "srsran/common/tti_sempahore.h"
 #include "srsran/phy/utils/random.h"
 #include "srsran/srslog/srslog.h"
+#include "srsran/support/srsran_test.h"
 
 class dummy_radio
 {
@@ -114,6 +115,141 @@ protected:
   }
 };
 
+// Holds the gated workers until the test opens it
+class worker_gate
+{
+public:
+  void open()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    is_open = true;
+    cvar.notify_all();
+  }
+
+  void close()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    is_open = false;
+  }
+
+  void wait()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!is_open) {
+      cvar.wait(lock);
+    }
+  }
+
+private:
+  std::mutex              mutex;
+  std::condition_variable cvar;
+  bool                    is_open = true;
+};
+
+class gated_worker : public srsran::thread_pool::worker
+{
+public:
+  explicit gated_worker(worker_gate* gate_) : gate(gate_) {}
+
+protected:
+  void work_imp() override { gate->wait(); }
+
+private:
+  worker_gate* gate = nullptr;
+};
+
+// Hands out nof_busy workers per TTI and waits for all of them to finish before the next TTI. Returns the highest
+// worker id handed out
+static uint32_t run_load(srsran::thread_pool& pool, worker_gate& gate, uint32_t nof_busy, uint32_t nof_tti)
+{
+  std::vector<uint32_t> ids(nof_busy);
+  uint32_t              max_id = 0;
+  for (uint32_t tti = 0; tti < nof_tti; tti++) {
+    gate.close();
+    for (uint32_t i = 0; i < nof_busy; i++) {
+      srsran::thread_pool::worker* w = pool.wait_worker(tti);
+      ids[i]                         = w->get_id();
+      max_id                         = std::max(max_id, ids[i]);
+      pool.start_worker(w);
+    }
+    gate.open();
+    // Wait for the workers to be idle again and give them back
+    for (uint32_t i = 0; i < nof_busy; i++) {
+      pool.wait_worker_id(ids[i])->release();
+    }
+  }
+  return max_id;
+}
+
+int test_adaptive()
+{
+  const uint32_t nof_workers = 4;
+  const uint32_t min_workers = 1;
+  const uint32_t window      = 8;
+  const uint32_t max_wait_us = 200000;
+
+  worker_gate                                 gate;
+  srsran::thread_pool                         pool(nof_workers);
+  std::vector<std::unique_ptr<gated_worker> > workers;
+  for (uint32_t i = 0; i < nof_workers; i++) {
+    workers.emplace_back(new gated_worker(&gate));
+    pool.init_worker(i, workers.back().get());
+  }
+  pool.set_adaptive(min_workers, window, max_wait_us);
+  TESTASSERT(pool.get_nof_active_workers() == nof_workers);
+
+  // Low load: one worker is deactivated every window, down to the minimum
+  run_load(pool, gate, 1, window);
+  TESTASSERT(pool.get_nof_active_workers() == nof_workers - 1);
+  run_load(pool, gate, 1, 10 * window);
+  TESTASSERT(pool.get_nof_active_workers() == min_workers);
+
+  // The only active worker is busy and becomes idle before the maximum wait: the inactive workers are not handed out
+  gate.close();
+  srsran::thread_pool::worker* w = pool.wait_worker(0);
+  TESTASSERT(w->get_id() == 0);
+  pool.start_worker(w);
+  std::thread opener([&gate]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    gate.open();
+  });
+  w = pool.wait_worker(1);
+  opener.join();
+  TESTASSERT(w->get_id() == 0);
+  TESTASSERT(pool.get_nof_active_workers() == min_workers);
+  w->release();
+
+  // The active workers stay busy for longer than the maximum wait: one more worker is activated every time
+  gate.close();
+  pool.start_worker(pool.wait_worker(2));
+  for (uint32_t id = 1; id < 3; id++) {
+    auto t0 = std::chrono::steady_clock::now();
+    w       = pool.wait_worker(2 + id);
+    auto t1 = std::chrono::steady_clock::now();
+    TESTASSERT(w->get_id() == id);
+    TESTASSERT(pool.get_nof_active_workers() == id + 1);
+    TESTASSERT(t1 - t0 >= std::chrono::microseconds(max_wait_us));
+    pool.start_worker(w);
+  }
+  gate.open();
+  for (uint32_t i = 0; i < 3; i++) {
+    pool.wait_worker_id(i)->release();
+  }
+
+  // Three busy workers per TTI fit in the active workers: the fourth one is never handed out
+  TESTASSERT(run_load(pool, gate, 3, 10 * window) == 2);
+  TESTASSERT(pool.get_nof_active_workers() == 3);
+
+  // Back to low load, only the first worker is handed out once the others are deactivated
+  run_load(pool, gate, 1, 10 * window);
+  TESTASSERT(pool.get_nof_active_workers() == min_workers);
+  TESTASSERT(run_load(pool, gate, 1, window) == 0);
+
+  pool.stop();
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   int ret = SRSRAN_SUCCESS;
@@ -180,5 +316,7 @@ int main(int argc, char** argv)
   pool.stop();
   srsran_random_free(random_gen);
 
+  TESTASSERT(test_adaptive() == SRSRAN_SUCCESS);
+
   return ret;
 }
@@ -21,6 +21,7 @@
 
 #include "srsran/common/thread_pool.h"
 #include "srsran/srslog/srslog.h"
+#include <algorithm>
 #include <assert.h>
 #include <chrono>
 #include <stdio.h>
@@ -160,7 +161,8 @@ bool thread_pool::worker::is_stopped() const
 
 bool thread_pool::find_finished_worker(uint32_t tti, uint32_t* id)
 {
-  for (uint32_t i = 0; i < nof_workers; i++) {
+  uint32_t nof_candidates = (min_active_workers > 0) ? std::min(nof_active_workers, nof_workers) : nof_workers;
+  for (uint32_t i = 0; i < nof_candidates; i++) {
     if (status[i] == IDLE) {
       *id = i;
       return true;
@@ -197,7 +199,22 @@ thread_pool::worker* thread_pool::wait_worker(uint32_t tti)
   thread_pool::worker* ret = nullptr;
   uint32_t             id  = 0;
 
+  if (min_active_workers > 0) {
+    update_active_workers();
+  }
+
+  auto deadline = std::chrono::steady_clock::now() + adaptive_max_wait;
   while (!find_finished_worker(tti, &id) && running) {
+    if (min_active_workers > 0 && nof_active_workers < nof_workers) {
+      // All the active workers are busy. Activate another one only if none of them becomes idle in time
+      if (cvar_queue.wait_until(lock, deadline) == std::cv_status::timeout) {
+        nof_active_workers++;
+        window_count    = 0;
+        window_max_busy = 0;
+        deadline        = std::chrono::steady_clock::now() + adaptive_max_wait;
+      }
+      continue;
+    }
     cvar_queue.wait(lock);
   }
   if (running) {
@@ -208,6 +225,45 @@ thread_pool::worker* thread_pool::wait_worker(uint32_t tti)
   return ret;
 }
 
+void thread_pool::update_active_workers()
+{
+  uint32_t nof_busy = 0;
+  for (uint32_t i = 0; i < nof_workers; i++) {
+    if (status[i] == START_WORK || status[i] == WORKER_READY || status[i] == WORKING) {
+      nof_busy++;
+    }
+  }
+  window_max_busy = std::max(window_max_busy, nof_busy);
+
+  if (++window_count < adaptive_window) {
+    return;
+  }
+
+  // Keep one spare worker on top of the peak load of the window
+  if (window_max_busy + 1 < nof_active_workers && nof_active_workers > min_active_workers) {
+    nof_active_workers--;
+  }
+  window_count    = 0;
+  window_max_busy = 0;
+}
+
+void thread_pool::set_adaptive(uint32_t min_workers, uint32_t window, uint32_t max_wait_us)
+{
+  std::lock_guard<std::mutex> lock(mutex_queue);
+  min_active_workers = std::min(min_workers, max_workers);
+  adaptive_window    = std::max(window, 1u);
+  adaptive_max_wait  = std::chrono::microseconds(max_wait_us);
+  nof_active_workers = nof_workers;
+  window_count       = 0;
+  window_max_busy    = 0;
+}
+
+uint32_t thread_pool::get_nof_active_workers()
+{
+  std::lock_guard<std::mutex> lock(mutex_queue);
+  return (min_active_workers > 0) ? std::min(nof_active_workers, nof_workers) : nof_workers;
+}
+
 thread_pool::worker* thread_pool::wait_worker_nb(uint32_t tti)
 {
   std::unique_lock<std::mutex> lock(mutex_queue);
@@ -0,0 +1,145 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/tti_trace.h"
+#include <cerrno>
+#include <cinttypes>
+#include <cstring>
+
+namespace srsran {
+
+tti_trace_ring::tti_trace_ring(uint32_t capacity)
+{
+  uint32_t size = 1;
+  while (size < capacity) {
+    size <<= 1U;
+  }
+  buffer.resize(size);
+  mask = size - 1;
+}
+
+tti_trace::~tti_trace()
+{
+  stop();
+}
+
+bool tti_trace::init(const std::string&              filename,
+                     const std::vector<std::string>& stage_names,
+                     uint32_t                        nof_workers,
+                     uint32_t                        ring_capacity,
+                     uint32_t                        period_ms_)
+{
+  if (running) {
+    logger.error("TTI trace is already running");
+    return false;
+  }
+  if (stage_names.size() > tti_trace_max_stages) {
+    logger.error("Number of TTI trace stages (%zd) exceeds the maximum (%d)", stage_names.size(), tti_trace_max_stages);
+    return false;
+  }
+
+  f = fopen(filename.c_str(), "wb");
+  if (f == nullptr) {
+    logger.error("Error opening TTI trace file %s: %s", filename.c_str(), strerror(errno));
+    return false;
+  }
+
+  tti_trace_file_header header = {};
+  memcpy(header.magic, tti_trace_file_magic, sizeof(header.magic));
+  header.version    = tti_trace_file_version;
+  header.nof_stages = stage_names.size();
+  for (uint32_t i = 0; i < stage_names.size(); i++) {
+    strncpy(header.stage_names[i], stage_names[i].c_str(), tti_trace_stage_name_len - 1);
+  }
+  fwrite(&header, sizeof(header), 1, f);
+
+  rings.clear();
+  tracers.clear();
+  for (uint32_t i = 0; i < nof_workers; i++) {
+    rings.emplace_back(new tti_trace_ring(ring_capacity));
+    tracers.emplace_back(i, rings.back().get());
+  }
+
+  period_ms = period_ms_;
+  running   = true;
+  start();
+
+  logger.info("Tracing %d workers into %s", nof_workers, filename.c_str());
+
+  return true;
+}
+
+void tti_trace::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (not running) {
+      return;
+    }
+    running = false;
+  }
+  cvar.notify_all();
+  wait_thread_finish();
+
+  // Export anything written after the last period
+  export_records();
+
+  uint64_t nof_dropped = get_nof_dropped();
+  if (nof_dropped > 0) {
+    logger.warning("TTI trace dropped %" PRIu64 " records", nof_dropped);
+  }
+
+  fclose(f);
+  f = nullptr;
+
+  // The workers may still hold their tracers, so they are not released
+}
+
+uint64_t tti_trace::get_nof_dropped() const
+{
+  uint64_t nof_dropped = 0;
+  for (const auto& r : rings) {
+    nof_dropped += r->get_nof_dropped();
+  }
+  return nof_dropped;
+}
+
+void tti_trace::run_thread()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  while (running) {
+    cvar.wait_for(lock, std::chrono::milliseconds(period_ms));
+    export_records();
+  }
+}
+
+void tti_trace::export_records()
+{
+  tti_trace_record record;
+  for (auto& r : rings) {
+    while (r->pop(record)) {
+      fwrite(&record, sizeof(record), 1, f);
+    }
+  }
+  fflush(f);
+}
+
+} // namespace srsran
@@ -0,0 +1,181 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * Renders the per-stage latency histograms of a TTI trace file and lists the TTIs which exceeded the latency budget.
+ */
+
+#include "srsran/common/tti_trace.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace srsran;
+
+// Histogram bins of 2^i microseconds
+static const uint32_t nof_bins  = 16;
+static const uint32_t bar_width = 50;
+
+static void usage(const char* prog)
+{
+  printf("Usage: %s trace_file [budget_us] [nof_worst]\n", prog);
+  printf("\tbudget_us: TTI latency budget in microseconds [Default 1000]\n");
+  printf("\tnof_worst: Number of TTIs above the budget to list [Default 10]\n");
+}
+
+static double percentile(const std::vector<uint32_t>& sorted, double p)
+{
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  size_t idx = std::min(sorted.size() - 1, (size_t)(p * (double)sorted.size()));
+  return sorted[idx] / 1000.0;
+}
+
+static void print_stage(const std::string& name, std::vector<uint32_t>& values_ns)
+{
+  std::sort(values_ns.begin(), values_ns.end());
+
+  double sum = 0.0;
+  for (uint32_t v : values_ns) {
+    sum += v;
+  }
+  double mean = values_ns.empty() ? 0.0 : sum / values_ns.size() / 1000.0;
+
+  printf("%s: mean=%.1fus p50=%.1fus p99=%.1fus p99.9=%.1fus max=%.1fus\n",
+         name.c_str(),
+         mean,
+         percentile(values_ns, 0.5),
+         percentile(values_ns, 0.99),
+         percentile(values_ns, 0.999),
+         values_ns.empty() ? 0.0 : values_ns.back() / 1000.0);
+
+  uint64_t bins[nof_bins] = {};
+  for (uint32_t v : values_ns) {
+    uint32_t us  = v / 1000;
+    uint32_t bin = 0;
+    while (bin < nof_bins - 1 && us >= (1U << bin)) {
+      bin++;
+    }
+    bins[bin]++;
+  }
+
+  uint64_t max_count = *std::max_element(bins, bins + nof_bins);
+  for (uint32_t i = 0; i < nof_bins; i++) {
+    if (bins[i] == 0) {
+      continue;
+    }
+    uint32_t len = (uint32_t)((bins[i] * bar_width + max_count - 1) / max_count);
+    printf("  <%6dus %8" PRIu64 " %s\n", 1U << i, bins[i], std::string(len, '#').c_str());
+  }
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    usage(argv[0]);
+    return -1;
+  }
+  uint32_t budget_us = (argc > 2) ? (uint32_t)strtol(argv[2], nullptr, 10) : 1000;
+  uint32_t nof_worst = (argc > 3) ? (uint32_t)strtol(argv[3], nullptr, 10) : 10;
+
+  FILE* f = fopen(argv[1], "rb");
+  if (f == nullptr) {
+    perror("fopen");
+    return -1;
+  }
+
+  tti_trace_file_header header = {};
+  if (fread(&header, sizeof(header), 1, f) != 1 ||
+      memcmp(header.magic, tti_trace_file_magic, sizeof(header.magic)) != 0 ||
+      header.version != tti_trace_file_version || header.nof_stages > tti_trace_max_stages) {
+    fprintf(stderr, "%s is not a valid TTI trace file\n", argv[1]);
+    fclose(f);
+    return -1;
+  }
+
+  std::vector<tti_trace_record> records;
+  tti_trace_record              record;
+  while (fread(&record, sizeof(record), 1, f) == 1) {
+    records.push_back(record);
+  }
+  fclose(f);
+
+  if (records.empty()) {
+    printf("No records\n");
+    return 0;
+  }
+
+  auto total_ns = [&header](const tti_trace_record& r) {
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < header.nof_stages; i++) {
+      total += r.stage_ns[i];
+    }
+    return total;
+  };
+
+  uint32_t nof_workers = 0;
+  for (const tti_trace_record& r : records) {
+    nof_workers = std::max(nof_workers, r.worker_id + 1);
+  }
+  printf("%zd TTIs from %d workers\n\n", records.size(), nof_workers);
+
+  // Latency histogram of every stage and of the whole TTI
+  std::vector<uint32_t> values(records.size());
+  for (uint32_t s = 0; s < header.nof_stages; s++) {
+    for (size_t i = 0; i < records.size(); i++) {
+      values[i] = records[i].stage_ns[s];
+    }
+    std::string name(header.stage_names[s], strnlen(header.stage_names[s], tti_trace_stage_name_len));
+    print_stage(name, values);
+  }
+  for (size_t i = 0; i < records.size(); i++) {
+    values[i] = total_ns(records[i]);
+  }
+  print_stage("total", values);
+
+  // TTIs above the budget, the slowest first
+  std::vector<tti_trace_record> late;
+  for (const tti_trace_record& r : records) {
+    if (total_ns(r) > budget_us * 1000) {
+      late.push_back(r);
+    }
+  }
+  printf("\n%zd TTIs above %dus\n", late.size(), budget_us);
+
+  std::sort(late.begin(), late.end(), [&total_ns](const tti_trace_record& a, const tti_trace_record& b) {
+    return total_ns(a) > total_ns(b);
+  });
+  for (size_t i = 0; i < std::min((size_t)nof_worst, late.size()); i++) {
+    printf("  tti=%d worker=%d total=%.1fus:", late[i].tti, late[i].worker_id, total_ns(late[i]) / 1000.0);
+    for (uint32_t s = 0; s < header.nof_stages; s++) {
+      std::string name(header.stage_names[s], strnlen(header.stage_names[s], tti_trace_stage_name_len));
+      printf(" %s=%.1f", name.c_str(), late[i].stage_ns[s] / 1000.0);
+    }
+    printf("\n");
+  }
+
+  return 0;
+}
@@ -19,6 +19,8 @@
  *
  */
 
+#include <complex.h>
+
 #include "srsran/phy/cfr/cfr.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/vector.h"
@@ -30,6 +32,7 @@
 #define CFR_LPF_WITH_ZEROS
 
 static inline float cfr_symb_peak(float* in_abs, int len);
+static bool         cfr_limit_evm(srsran_cfr_t* q, const cf_t* ref, cf_t* out);
 
 void srsran_cfr_process(srsran_cfr_t* q, cf_t* in, cf_t* out)
 {
@@ -50,12 +53,12 @@ void srsran_cfr_process(srsran_cfr_t* q, cf_t* in, cf_t* out)
 
   // Calculate absolute input values
   srsran_vec_abs_cf(in, q->abs_buffer_in, symbol_sz);
+  const float symb_peak = cfr_symb_peak(q->abs_buffer_in, q->cfg.symbol_sz);
 
   // In auto modes, the beta threshold is calculated based on the measured PAPR
   if (q->cfg.cfr_mode == SRSRAN_CFR_THR_MANUAL) {
     beta = q->cfg.manual_thr;
   } else {
-    const float symb_peak     = cfr_symb_peak(q->abs_buffer_in, q->cfg.symbol_sz);
     const float pwr_symb_peak = symb_peak * symb_peak;
     const float pwr_symb_avg  = srsran_vec_avg_power_ff(q->abs_buffer_in, q->cfg.symbol_sz);
     float       symb_papr     = 0.0f;
@@ -76,8 +79,8 @@ void srsran_cfr_process(srsran_cfr_t* q, cf_t* in, cf_t* out)
     beta                 = (papr_reduction > 1) ? symb_peak / sqrtf(papr_reduction) : 0;
   }
 
-  // Clipping algorithm
-  if (isnormal(beta)) {
+  // Clipping algorithm, the filtering is skipped if no sample exceeds the threshold
+  if (isnormal(beta) && symb_peak > beta) {
 #ifdef CFR_PEAK_EXTRACTION
     srsran_vec_cf_zero(q->peak_buffer, symbol_sz);
     cf_t clip_thr = 0;
@@ -104,18 +107,42 @@ void srsran_cfr_process(srsran_cfr_t* q, cf_t* in, cf_t* out)
     srsran_vec_sub_ccc(in, q->peak_buffer, out, symbol_sz);
 #else /* CFR_PEAK_EXTRACTION */
 
-    // Generate a clipping envelope and clip the signal
-    srsran_vec_gen_clip_env(q->abs_buffer_in, beta, alpha, q->abs_buffer_in, symbol_sz);
-    srsran_vec_prod_cfc(in, q->abs_buffer_in, out, symbol_sz);
+    // The input is kept for limiting the EVM, as the output may overwrite it
+    const bool limit_evm = isnormal(q->cfg.max_evm);
+    if (limit_evm) {
+      srsran_vec_cf_copy(q->peak_buffer, in, symbol_sz);
+    }
+
+    const uint32_t nof_iterations = SRSRAN_MAX(1, q->cfg.nof_iterations);
+    const cf_t*    src            = in;
+    for (uint32_t iter = 0; iter < nof_iterations; iter++) {
+      // The filtering regrows some peaks, clip them again unless they are below the threshold
+      if (iter > 0) {
+        srsran_vec_abs_cf(out, q->abs_buffer_in, symbol_sz);
+        if (cfr_symb_peak(q->abs_buffer_in, symbol_sz) <= beta) {
+          break;
+        }
+      }
+
+      // Generate a clipping envelope and clip the signal
+      srsran_vec_gen_clip_env(q->abs_buffer_in, beta, alpha, q->abs_buffer_in, symbol_sz);
+      srsran_vec_prod_cfc(src, q->abs_buffer_in, out, symbol_sz);
+      src = out;
 
-    // FFT filter
-    srsran_dft_run_c(&q->fft_plan, out, out);
+      // FFT filter
+      srsran_dft_run_c(&q->fft_plan, out, out);
 #ifdef CFR_LPF_WITH_ZEROS
-    srsran_vec_cf_zero(out + q->lpf_bw / 2 + q->cfg.dc_sc, symbol_sz - q->cfg.symbol_bw - q->cfg.dc_sc);
+      srsran_vec_cf_zero(out + q->lpf_bw / 2 + q->cfg.dc_sc, symbol_sz - q->cfg.symbol_bw - q->cfg.dc_sc);
 #else  /* CFR_LPF_WITH_ZEROS */
-    srsran_vec_prod_cfc(out, q->lpf_spectrum, out, symbol_sz);
+      srsran_vec_prod_cfc(out, q->lpf_spectrum, out, symbol_sz);
 #endif /* CFR_LPF_WITH_ZEROS */
-    srsran_dft_run_c(&q->ifft_plan, out, out);
+      srsran_dft_run_c(&q->ifft_plan, out, out);
+
+      // Stop iterating once the EVM budget is used up
+      if (limit_evm && cfr_limit_evm(q, q->peak_buffer, out)) {
+        break;
+      }
+    }
 #endif /* CFR_PEAK_EXTRACTION */
 
   } else {
@@ -125,7 +152,7 @@ void srsran_cfr_process(srsran_cfr_t* q, cf_t* in, cf_t* out)
     }
   }
   if (q->cfg.cfr_mode != SRSRAN_CFR_THR_MANUAL && q->cfg.measure_out_papr) {
-    srsran_vec_abs_cf(in, q->abs_buffer_out, symbol_sz);
+    srsran_vec_abs_cf(out, q->abs_buffer_out, symbol_sz);
 
     const float symb_peak     = cfr_symb_peak(q->abs_buffer_out, q->cfg.symbol_sz);
     const float pwr_symb_peak = symb_peak * symb_peak;
@@ -166,6 +193,10 @@ int srsran_cfr_init(srsran_cfr_t* q, srsran_cfr_cfg_t* cfg)
     ERROR("Error, invalid CFR mode");
     goto clean_exit;
   }
+  if (cfg->max_evm < 0 || cfg->max_evm > 1) {
+    ERROR("Error, invalid EVM limit");
+    goto clean_exit;
+  }
   if (cfg->cfr_mode == SRSRAN_CFR_THR_MANUAL && cfg->manual_thr <= 0) {
     ERROR("Error, invalid configuration for manual threshold");
     goto clean_exit;
@@ -329,6 +360,31 @@ static inline float cfr_symb_peak(float* in_abs, int len)
   return in_abs[max_index];
 }
 
+// Scales down the distortion of the output with respect to the reference if it exceeds the EVM limit. Returns true if
+// the output has been limited.
+static bool cfr_limit_evm(srsran_cfr_t* q, const cf_t* ref, cf_t* out)
+{
+  const uint32_t symbol_sz = q->cfg.symbol_sz;
+
+  // Error power from the powers and the correlation, it avoids computing the error signal if it is within the limit
+  const float pwr_ref = srsran_vec_avg_power_cf(ref, symbol_sz);
+  const float pwr_out = srsran_vec_avg_power_cf(out, symbol_sz);
+  const float corr    = crealf(srsran_vec_dot_prod_conj_ccc(out, ref, symbol_sz)) / (float)symbol_sz;
+  const float pwr_err = pwr_out + pwr_ref - 2.0f * corr;
+
+  const float max_pwr_err = q->cfg.max_evm * q->cfg.max_evm * pwr_ref;
+  if (!isnormal(pwr_err) || pwr_err <= max_pwr_err) {
+    return false;
+  }
+
+  // out = ref + (out - ref) * gain
+  srsran_vec_sub_ccc(out, ref, out, symbol_sz);
+  srsran_vec_sc_prod_cfc(out, sqrtf(max_pwr_err / pwr_err), out, symbol_sz);
+  srsran_vec_sum_ccc(out, ref, out, symbol_sz);
+
+  return true;
+}
+
 bool srsran_cfr_params_valid(srsran_cfr_cfg_t* cfr_conf)
 {
   if (cfr_conf == NULL) {
@@ -340,6 +396,9 @@ bool srsran_cfr_params_valid(srsran_cfr_cfg_t* cfr_conf)
   if (cfr_conf->alpha < 0 || cfr_conf->alpha > 1) {
     return false;
   }
+  if (cfr_conf->max_evm < 0 || cfr_conf->max_evm > 1) {
+    return false;
+  }
   if (cfr_conf->cfr_mode == SRSRAN_CFR_THR_MANUAL && cfr_conf->manual_thr <= 0) {
     return false;
   }
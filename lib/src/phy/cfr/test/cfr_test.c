@@ -44,6 +44,8 @@ static bool              dc_empty        = true;
 static float             thr_manual      = 1.5f;
 static float             max_papr_db     = 8.0f;
 static float             ema_alpha       = (float)1 / (float)SRSRAN_CP_NORM_NSYMB;
+static uint32_t          nof_iterations  = 1;
+static float             max_evm         = 0.0f;
 
 static uint32_t force_symbol_sz = 0;
 static double   elapsed_us(struct timeval* ts_start, struct timeval* ts_end)
@@ -71,12 +73,14 @@ static void usage(char* prog)
   printf("\t-t CFR manual threshold: [Default %.2f]\n", thr_manual);
   printf("\t-p CFR Max PAPR in dB (auto modes): [Default %.2f]\n", max_papr_db);
   printf("\t-E Power avg EMA alpha (EMA mode): [Default %.2f]\n", ema_alpha);
+  printf("\t-I Number of clipping and filtering iterations: [Default %d]\n", nof_iterations);
+  printf("\t-V Maximum EVM per symbol (0 to 1), 0 for no limit: [Default %.2f]\n", max_evm);
 }
 
 static int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "NnerfmatdpE")) != -1) {
+  while ((opt = getopt(argc, argv, "NnerfmatdpEIV")) != -1) {
     switch (opt) {
       case 'n':
         nof_prb = (int)strtol(argv[optind], NULL, 10);
@@ -111,6 +115,12 @@ static int parse_args(int argc, char** argv)
       case 'E':
         ema_alpha = strtof(argv[optind], NULL);
         break;
+      case 'I':
+        nof_iterations = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'V':
+        max_evm = strtof(argv[optind], NULL);
+        break;
       default:
         usage(argv[0]);
         return SRSRAN_ERROR;
@@ -133,6 +143,7 @@ int main(int argc, char** argv)
   float           mse_dB      = 0.0f;
   float           nmse_dB     = 0.0f;
   float           evm         = 0.0f;
+  float           worst_evm   = 0.0f;
   int             max_prb     = 0.0f;
   float           acpr_in_dB  = 0.0f;
   float           acpr_out_dB = 0.0f;
@@ -192,6 +203,8 @@ int main(int argc, char** argv)
     cfr_tx_cfg.manual_thr       = thr_manual;
     cfr_tx_cfg.ema_alpha        = ema_alpha;
     cfr_tx_cfg.dc_sc            = dc_empty;
+    cfr_tx_cfg.nof_iterations   = nof_iterations;
+    cfr_tx_cfg.max_evm          = max_evm;
 
     if (!srsran_cfr_params_valid(&cfr_tx_cfg)) {
       ERROR("Invalid CFR configuration");
@@ -240,7 +253,10 @@ int main(int argc, char** argv)
       }
     }
     gettimeofday(&end, NULL);
-    printf("%.1fMsps \t", (float)(total_nof_re * nof_repetitions) / elapsed_us(&start, &end));
+    double t_us = elapsed_us(&start, &end);
+    printf("%.1fMsps %.2fus/symb \t",
+           (float)(total_nof_re * nof_repetitions) / t_us,
+           t_us / (double)(total_nof_symb * nof_repetitions));
 
     // Compute metrics
     srsran_vec_sub_ccc(input, output, error, total_nof_re);
@@ -254,6 +270,14 @@ int main(int argc, char** argv)
 
     float snr_dB = srsran_convert_power_to_dB(power_in / power_err);
 
+    // The EVM limit applies to every OFDM symbol
+    worst_evm = 0.0f;
+    for (uint32_t i = 0; i < total_nof_symb; i++) {
+      float pwr_symb_in  = srsran_vec_avg_power_cf(input + i * symbol_sz, symbol_sz);
+      float pwr_symb_err = srsran_vec_avg_power_cf(error + i * symbol_sz, symbol_sz);
+      worst_evm          = SRSRAN_MAX(worst_evm, sqrtf(pwr_symb_err / pwr_symb_in));
+    }
+
     float papr_in  = srsran_convert_power_to_dB(srsran_vec_papr_c(input, total_nof_re));
     float papr_out = srsran_convert_power_to_dB(srsran_vec_papr_c(output, total_nof_re));
 
@@ -268,7 +292,12 @@ int main(int argc, char** argv)
     acpr_out_dB = srsran_vec_acc_ff(acpr_buff, total_nof_symb) / (float)total_nof_symb;
     acpr_out_dB = srsran_convert_power_to_dB(acpr_out_dB);
 
-    printf("MSE=%.3fdB  NMSE=%.3fdB  EVM=%.3f%%  SNR=%.3fdB", mse_dB, nmse_dB, evm, snr_dB);
+    printf("MSE=%.3fdB  NMSE=%.3fdB  EVM=%.3f%%  Max-EVM=%.3f%%  SNR=%.3fdB",
+           mse_dB,
+           nmse_dB,
+           evm,
+           100 * worst_evm,
+           snr_dB);
     printf("  In-PAPR=%.3fdB  Out-PAPR=%.3fdB", papr_in, papr_out);
     printf("  In-ACPR=%.3fdB  Out-ACPR=%.3fdB\n", acpr_in_dB, acpr_out_dB);
 
@@ -288,6 +317,10 @@ int main(int argc, char** argv)
       printf("ACPR too large \n");
       goto clean_exit;
     }
+    if (isnormal(max_evm) && worst_evm > max_evm * 1.01f) {
+      printf("EVM too large \n");
+      goto clean_exit;
+    }
   }
   ret = SRSRAN_SUCCESS;
 
@@ -32,33 +32,32 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
   uint32_t srate_max   = (uint32_t)srsran_symbol_sz(SRSRAN_MAX_PRB) * 15000;
   uint32_t buffer_size = (uint32_t)SRSRAN_SF_LEN_PRB(SRSRAN_MAX_PRB) * 5; // be safe, 5 Subframes
 
-  if (_nof_channels > SRSRAN_MAX_CHANNELS) {
-    fprintf(stderr,
-            "Error creating channel object: maximum number of channels exceeded (%d > %d)\n",
-            _nof_channels,
-            SRSRAN_MAX_CHANNELS);
-    return;
-  }
-
   // Copy args
   args = channel_args;
 
-  // Allocate internal buffers
-  buffer_in  = srsran_vec_cf_malloc(buffer_size);
-  buffer_out = srsran_vec_cf_malloc(buffer_size);
-  if (!buffer_out || !buffer_in) {
-    ret = SRSRAN_ERROR;
-  }
-
   nof_channels = _nof_channels;
-  for (uint32_t i = 0; i < nof_channels; i++) {
+  fading.resize(nof_channels, nullptr);
+  delay.resize(nof_channels, nullptr);
+  awgn.resize(nof_channels, nullptr);
+  hst.resize(nof_channels, nullptr);
+  buffer_in.resize(nof_channels, nullptr);
+  buffer_out.resize(nof_channels, nullptr);
+
+  // Every channel has its own state, so they can be processed in parallel
+  for (uint32_t i = 0; i < nof_channels && ret == SRSRAN_SUCCESS; i++) {
+    // Allocate internal buffers
+    buffer_in[i]  = srsran_vec_cf_malloc(buffer_size);
+    buffer_out[i] = srsran_vec_cf_malloc(buffer_size);
+    if (!buffer_out[i] || !buffer_in[i]) {
+      ret = SRSRAN_ERROR;
+    }
+
     // Create fading channel
     if (channel_args.fading_enable && !channel_args.fading_model.empty() && channel_args.fading_model != "none" &&
         ret == SRSRAN_SUCCESS) {
       fading[i] = (srsran_channel_fading_t*)calloc(sizeof(srsran_channel_fading_t), 1);
-      ret       = srsran_channel_fading_init(fading[i], srate_max, channel_args.fading_model.c_str(), 0x1234 * i);
-    } else {
-      fading[i] = nullptr;
+      ret       = srsran_channel_fading_init(
+          fading[i], srate_max, channel_args.fading_model.c_str(), 0x1234 * i + channel_args.seed);
     }
 
     // Create delay
@@ -70,22 +69,20 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
                                       channel_args.delay_period_s,
                                       channel_args.delay_init_time_s,
                                       srate_max);
-    } else {
-      delay[i] = nullptr;
     }
-  }
 
-  // Create AWGN channnel
-  if (channel_args.awgn_enable && ret == SRSRAN_SUCCESS) {
-    awgn = (srsran_channel_awgn_t*)calloc(sizeof(srsran_channel_awgn_t), 1);
-    ret  = srsran_channel_awgn_init(awgn, 1234);
-    srsran_channel_awgn_set_n0(awgn, args.awgn_signal_power_dBfs - args.awgn_snr_dB);
-  }
+    // Create AWGN channnel
+    if (channel_args.awgn_enable && ret == SRSRAN_SUCCESS) {
+      awgn[i] = (srsran_channel_awgn_t*)calloc(sizeof(srsran_channel_awgn_t), 1);
+      ret     = srsran_channel_awgn_init(awgn[i], 1234 + i + channel_args.seed);
+      srsran_channel_awgn_set_n0(awgn[i], args.awgn_signal_power_dBfs - args.awgn_snr_dB);
+    }
 
-  // Create high speed train
-  if (channel_args.hst_enable && ret == SRSRAN_SUCCESS) {
-    hst = (srsran_channel_hst_t*)calloc(sizeof(srsran_channel_hst_t), 1);
-    srsran_channel_hst_init(hst, channel_args.hst_fd_hz, channel_args.hst_period_s, channel_args.hst_init_time_s);
+    // Create high speed train
+    if (channel_args.hst_enable && ret == SRSRAN_SUCCESS) {
+      hst[i] = (srsran_channel_hst_t*)calloc(sizeof(srsran_channel_hst_t), 1);
+      srsran_channel_hst_init(hst[i], channel_args.hst_fd_hz, channel_args.hst_period_s, channel_args.hst_init_time_s);
+    }
   }
 
   // Create Radio Link Failure simulator
@@ -94,6 +91,15 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
     srsran_channel_rlf_init(rlf, channel_args.rlf_t_on_ms, channel_args.rlf_t_off_ms);
   }
 
+  // Launch workers, the fading segments of a channel are split among them too
+  nof_threads = SRSRAN_MAX(1, channel_args.nof_threads);
+  if (ret == SRSRAN_SUCCESS) {
+    ret = fading_alloc();
+  }
+  for (uint32_t i = 1; i < nof_threads && ret == SRSRAN_SUCCESS; i++) {
+    workers.emplace_back(&channel::worker_loop, this, i);
+  }
+
   if (ret != SRSRAN_SUCCESS) {
     fprintf(stderr, "Error: Creating channel\n\n");
   }
@@ -101,22 +107,13 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
 
 channel::~channel()
 {
-  if (buffer_in) {
-    free(buffer_in);
+  {
+    std::unique_lock<std::mutex> lock(worker_mutex);
+    job_quit = true;
   }
-
-  if (buffer_out) {
-    free(buffer_out);
-  }
-
-  if (awgn) {
-    srsran_channel_awgn_free(awgn);
-    free(awgn);
-  }
-
-  if (hst) {
-    srsran_channel_hst_free(hst);
-    free(hst);
+  worker_cvar.notify_all();
+  for (std::thread& worker : workers) {
+    worker.join();
   }
 
   if (rlf) {
@@ -124,7 +121,17 @@ channel::~channel()
     free(rlf);
   }
 
+  fading_free();
+
   for (uint32_t i = 0; i < nof_channels; i++) {
+    if (buffer_in[i]) {
+      free(buffer_in[i]);
+    }
+
+    if (buffer_out[i]) {
+      free(buffer_out[i]);
+    }
+
     if (fading[i]) {
       srsran_channel_fading_free(fading[i]);
       free(fading[i]);
@@ -134,6 +141,16 @@ channel::~channel()
       srsran_channel_delay_free(delay[i]);
       free(delay[i]);
     }
+
+    if (awgn[i]) {
+      srsran_channel_awgn_free(awgn[i]);
+      free(awgn[i]);
+    }
+
+    if (hst[i]) {
+      srsran_channel_hst_free(hst[i]);
+      free(hst[i]);
+    }
   }
 }
 
@@ -147,66 +164,226 @@ static inline cf_t local_cexpf(float phase)
 }
 }
 
-void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
-                  cf_t*                     out[SRSRAN_MAX_CHANNELS],
-                  uint32_t                  len,
-                  const srsran_timestamp_t& t)
+// Allocates the fading responses of a job and the scratch of every thread, they depend on the sampling rate
+int channel::fading_alloc()
 {
-  // Early return if pointers are not enabled
-  if (in == nullptr || out == nullptr) {
-    return;
+  if (fading.empty() || fading[0] == nullptr) {
+    return SRSRAN_SUCCESS;
   }
 
-  // For each channel
-  for (uint32_t i = 0; i < nof_channels; i++) {
-    // Skip iteration if any buffer is null
-    if (in[i] == nullptr || out[i] == nullptr) {
-      continue;
+  uint32_t buffer_size = (uint32_t)SRSRAN_SF_LEN_PRB(SRSRAN_MAX_PRB) * 5;
+  uint32_t N           = fading[0]->N;
+  fading_response.resize(nof_channels, nullptr);
+  for (cf_t*& response : fading_response) {
+    response = srsran_vec_cf_malloc(srsran_channel_fading_nof_segments(fading[0], buffer_size) * N);
+    if (response == nullptr) {
+      return SRSRAN_ERROR;
     }
+  }
 
-    // If sampling rate is not set, copy input and skip rest of channel
-    if (current_srate == 0) {
-      if (in[i] != out[i]) {
-        srsran_vec_cf_copy(out[i], in[i], len);
-      }
-      continue;
+  fading_scratch.resize(nof_threads);
+  for (srsran_channel_fading_scratch_t& scratch : fading_scratch) {
+    if (srsran_channel_fading_scratch_init(&scratch, fading[0]) != SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
     }
+  }
 
-    // Copy input buffer
-    srsran_vec_cf_copy(buffer_in, in[i], len);
+  return SRSRAN_SUCCESS;
+}
 
-    if (hst) {
-      srsran_channel_hst_execute(hst, buffer_in, buffer_out, len, &t);
-      srsran_vec_sc_prod_ccc(buffer_out, local_cexpf(hst_init_phase), buffer_in, len);
+void channel::fading_free()
+{
+  for (cf_t* response : fading_response) {
+    if (response) {
+      free(response);
     }
+  }
+  fading_response.clear();
 
-    if (awgn) {
-      srsran_channel_awgn_run_c(awgn, buffer_in, buffer_out, len);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+  for (srsran_channel_fading_scratch_t& scratch : fading_scratch) {
+    srsran_channel_fading_scratch_free(&scratch);
+  }
+  fading_scratch.clear();
+}
+
+// Stages before fading, they carry state from sample to sample so every channel runs them in a single thread
+void channel::run_head(uint32_t thread_idx, uint32_t i)
+{
+  cf_t* in  = job_in[i];
+  cf_t* out = job_out[i];
+
+  // Skip iteration if any buffer is null
+  if (in == nullptr || out == nullptr) {
+    return;
+  }
+
+  // If sampling rate is not set, copy input and skip rest of channel
+  if (current_srate == 0) {
+    if (in != out) {
+      srsran_vec_cf_copy(out, in, job_len);
     }
+    return;
+  }
 
-    if (fading[i]) {
-      srsran_channel_fading_execute(fading[i], buffer_in, buffer_out, len, t.full_secs + t.frac_secs);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+  const srsran_timestamp_t& t          = *job_t;
+  cf_t*                     buffer_in  = this->buffer_in[i];
+  cf_t*                     buffer_out = this->buffer_out[i];
+  uint32_t                  len        = job_len;
+
+  // Copy input buffer
+  srsran_vec_cf_copy(buffer_in, in, len);
+
+  if (hst[i]) {
+    srsran_channel_hst_execute(hst[i], buffer_in, buffer_out, len, &t);
+    srsran_vec_sc_prod_ccc(buffer_out, local_cexpf(hst_init_phase), buffer_in, len);
+  }
+
+  if (awgn[i]) {
+    srsran_channel_awgn_run_c(awgn[i], buffer_in, buffer_out, len);
+    srsran_vec_cf_copy(buffer_in, buffer_out, len);
+  }
+}
+
+// Fading segments do not depend on each other, the segments of all channels are split among the threads
+void channel::run_fading(uint32_t thread_idx, uint32_t task_idx)
+{
+  uint32_t i   = task_idx / fading_nof_segments;
+  uint32_t idx = task_idx % fading_nof_segments;
+
+  if (job_in[i] == nullptr || job_out[i] == nullptr) {
+    return;
+  }
+
+  const srsran_timestamp_t& t = *job_t;
+  srsran_channel_fading_filter(fading[i],
+                               &fading_scratch[thread_idx],
+                               buffer_in[i],
+                               job_len,
+                               idx,
+                               t.full_secs + t.frac_secs,
+                               &fading_response[i][idx * fading[i]->N]);
+}
+
+// Overlaps the fading segments and runs the stages after fading
+void channel::run_tail(uint32_t thread_idx, uint32_t i)
+{
+  cf_t* in  = job_in[i];
+  cf_t* out = job_out[i];
+
+  // Skip iteration if any buffer is null or the input was copied already
+  if (in == nullptr || out == nullptr || current_srate == 0) {
+    return;
+  }
+
+  const srsran_timestamp_t& t          = *job_t;
+  cf_t*                     buffer_in  = this->buffer_in[i];
+  cf_t*                     buffer_out = this->buffer_out[i];
+  uint32_t                  len        = job_len;
+
+  if (fading[i]) {
+    srsran_channel_fading_overlap_add(fading[i], fading_response[i], buffer_in, len, t.full_secs + t.frac_secs);
+  }
+
+  if (delay[i]) {
+    srsran_channel_delay_execute(delay[i], buffer_in, buffer_out, len, &t);
+    srsran_vec_cf_copy(buffer_in, buffer_out, len);
+  }
+
+  if (rlf) {
+    srsran_channel_rlf_execute(rlf, buffer_in, buffer_out, len, &t);
+    srsran_vec_cf_copy(buffer_in, buffer_out, len);
+  }
+
+  // Copy output buffer
+  srsran_vec_cf_copy(out, buffer_in, len);
+}
+
+void channel::worker_loop(uint32_t worker_idx)
+{
+  uint64_t count = 0;
+
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(worker_mutex);
+      worker_cvar.wait(lock, [this, count]() { return job_quit || job_count != count; });
+      if (job_quit) {
+        return;
+      }
+      count = job_count;
     }
 
-    if (delay[i]) {
-      srsran_channel_delay_execute(delay[i], buffer_in, buffer_out, len, &t);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+    for (uint32_t i = worker_idx; i < job_nof_tasks; i += nof_threads) {
+      (this->*job_task)(worker_idx, i);
     }
 
-    if (rlf) {
-      srsran_channel_rlf_execute(rlf, buffer_in, buffer_out, len, &t);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+    {
+      std::unique_lock<std::mutex> lock(worker_mutex);
+      job_pending--;
+      if (job_pending == 0) {
+        done_cvar.notify_one();
+      }
+    }
+  }
+}
+
+void channel::run_tasks(task_t task, uint32_t nof_tasks)
+{
+  // Not worth waking up the workers for a single task
+  if (workers.empty() || nof_tasks == 1) {
+    for (uint32_t i = 0; i < nof_tasks; i++) {
+      (this->*task)(0, i);
     }
+    return;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(worker_mutex);
+    job_task      = task;
+    job_nof_tasks = nof_tasks;
+    job_pending   = (uint32_t)workers.size();
+    job_count++;
+  }
+  worker_cvar.notify_all();
+
+  // The caller processes its share while the workers do theirs
+  for (uint32_t i = 0; i < nof_tasks; i += nof_threads) {
+    (this->*task)(0, i);
+  }
+
+  std::unique_lock<std::mutex> lock(worker_mutex);
+  done_cvar.wait(lock, [this]() { return job_pending == 0; });
+}
 
-    // Copy output buffer
-    srsran_vec_cf_copy(out[i], buffer_in, len);
+void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
+                  cf_t*                     out[SRSRAN_MAX_CHANNELS],
+                  uint32_t                  len,
+                  const srsran_timestamp_t& t)
+{
+  // Early return if pointers are not enabled
+  if (in == nullptr || out == nullptr) {
+    return;
   }
 
-  if (hst) {
+  if (nof_channels > SRSRAN_MAX_CHANNELS) {
+    logger.error("Channel: %d channels can not be run on %d ports", nof_channels, SRSRAN_MAX_CHANNELS);
+    return;
+  }
+
+  job_in  = in;
+  job_out = out;
+  job_len = len;
+  job_t   = &t;
+
+  run_tasks(&channel::run_head, nof_channels);
+  if (current_srate != 0 && !fading.empty() && fading[0] != nullptr) {
+    fading_nof_segments = srsran_channel_fading_nof_segments(fading[0], len);
+    run_tasks(&channel::run_fading, nof_channels * fading_nof_segments);
+  }
+  run_tasks(&channel::run_tail, nof_channels);
+
+  if (!hst.empty() && hst[0]) {
     // Increment phase to keep it coherent between frames
-    hst_init_phase += (2 * M_PI * len * hst->fs_hz / hst->srate_hz);
+    hst_init_phase += (2 * M_PI * len * hst[0]->fs_hz / hst[0]->srate_hz);
 
     // Positive Remainder
     while (hst_init_phase > 2 * M_PI) {
@@ -219,14 +396,22 @@ void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
     }
   }
 
-  // Logging
+  log_state(t);
+}
+
+void channel::log_state(const srsran_timestamp_t& t)
+{
+  if (!logger.debug.enabled()) {
+    return;
+  }
+
   std::stringstream str;
   str << "Channel: t=" << t.full_secs + t.frac_secs << "s; ";
-  if (delay[0]) {
+  if (!delay.empty() && delay[0]) {
     str << "delay=" << delay[0]->delay_us << "us; ";
   }
-  if (hst) {
-    str << "hst=" << hst->fs_hz << "Hz; ";
+  if (!hst.empty() && hst[0]) {
+    str << "hst=" << hst[0]->fs_hz << "Hz; ";
   }
   logger.debug("%s", str.str().c_str());
 }
@@ -238,16 +423,22 @@ void channel::set_srate(uint32_t srate)
       if (fading[i]) {
         srsran_channel_fading_free(fading[i]);
 
-        srsran_channel_fading_init(fading[i], srate, args.fading_model.c_str(), 0x1234 * i);
+        srsran_channel_fading_init(fading[i], srate, args.fading_model.c_str(), 0x1234 * i + args.seed);
       }
 
       if (delay[i]) {
         srsran_channel_delay_update_srate(delay[i], srate);
       }
+
+      if (hst[i]) {
+        srsran_channel_hst_update_srate(hst[i], srate);
+      }
     }
 
-    if (hst) {
-      srsran_channel_hst_update_srate(hst, srate);
+    // The fading segments depend on the sampling rate
+    fading_free();
+    if (fading_alloc() != SRSRAN_SUCCESS) {
+      logger.error("Channel: error allocating fading buffers");
     }
 
     // Update sampling rate
@@ -257,7 +448,9 @@ void channel::set_srate(uint32_t srate)
 
 void channel::set_signal_power_dBfs(float power_dBfs)
 {
-  if (awgn != nullptr) {
-    srsran_channel_awgn_set_n0(awgn, power_dBfs - args.awgn_snr_dB);
+  for (srsran_channel_awgn_t* q : awgn) {
+    if (q != nullptr) {
+      srsran_channel_awgn_set_n0(q, power_dBfs - args.awgn_snr_dB);
+    }
   }
 }
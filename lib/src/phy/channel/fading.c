@@ -21,6 +21,7 @@
 
 #include "srsran/phy/channel/fading.h"
 #include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 #include <math.h>
 #include <stdio.h>
@@ -90,6 +91,9 @@ static inline __m128 _sine(const float* table, __m128 arg)
   __m128  argmod   = _mm_sub_ps(arg, _mm_mul_ps(turns, _mm_set1_ps(2.0f * (float)M_PI)));
   __m128  indexps  = _mm_mul_ps(argmod, _mm_set1_ps(1024.0f / (2.0f * (float)M_PI)));
   __m128i indexi32 = _mm_abs_epi32(_mm_cvtps_epi32(indexps));
+
+  // Rounding may reach the end of the table, wrap it around
+  indexi32 = _mm_and_si128(indexi32, _mm_set1_epi32(1023));
   _mm_store_si128((__m128i*)idx, indexi32);
 
   for (int i = 0; i < 4; i++) {
@@ -160,55 +164,91 @@ static inline void generate_tap(float delay_ns, float power_db, float srate, cf_
   cf_t  a0        = amplitude / N;
 
   srsran_vec_gen_sine(a0, -O, buf, N);
+
+  // Shift FFT, so the taps can be added without reordering them
+  for (uint32_t i = 0; i < N / 2; i++) {
+    cf_t temp      = buf[i];
+    buf[i]         = buf[i + N / 2];
+    buf[i + N / 2] = temp;
+  }
 }
 
-static inline void generate_taps(srsran_channel_fading_t* q, float time)
+static inline void generate_taps(srsran_channel_fading_t* q, float time, cf_t* h_freq)
 {
-  // Generate taps
-  for (int i = 0; i < nof_taps[q->model]; i++) {
-    // Compute phase for the doppler dispersion
-    cf_t a = get_doppler_dispersion(q, time, q->doppler, q->coeff_alpha[i], q->coeff_a[i], q->coeff_b[i]);
+  uint32_t M                                = nof_taps[q->model];
+  cf_t     a[SRSRAN_CHANNEL_FADING_MAXTAPS] = {};
 
-    if (i) {
-      // Copy tap frequency response
-      srsran_vec_sc_prod_ccc(q->h_tap[i], a, q->temp, q->N);
+  // Compute phase for the doppler dispersion
+  for (uint32_t i = 0; i < M; i++) {
+    a[i] = get_doppler_dispersion(q, time, q->doppler, q->coeff_alpha[i], q->coeff_a[i], q->coeff_b[i]);
+  }
 
-      // Add to frequency response, shifts FFT at same time
-      srsran_vec_sum_ccc(q->h_freq, &q->temp[q->N / 2], q->h_freq, q->N / 2);
-      srsran_vec_sum_ccc(&q->h_freq[q->N / 2], q->temp, &q->h_freq[q->N / 2], q->N / 2);
-    } else {
-      // Copy tap frequency response
-      srsran_vec_sc_prod_ccc(&q->h_tap[i][q->N / 2], a, q->h_freq, q->N / 2);
-      srsran_vec_sc_prod_ccc(&q->h_tap[i][0], a, &q->h_freq[q->N / 2], q->N / 2);
+  // Add all the tap frequency responses in a single pass, each output sample is written once
+  uint32_t k = 0;
+#if SRSRAN_SIMD_CF_SIZE
+  simd_cf_t _a[SRSRAN_CHANNEL_FADING_MAXTAPS];
+  for (uint32_t i = 0; i < M; i++) {
+    _a[i] = srsran_simd_cf_set1(a[i]);
+  }
+
+  for (; k + SRSRAN_SIMD_CF_SIZE < q->N + 1; k += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t acc = srsran_simd_cf_prod(srsran_simd_cfi_load(&q->h_tap[0][k]), _a[0]);
+    for (uint32_t i = 1; i < M; i++) {
+      acc = srsran_simd_cf_add(acc, srsran_simd_cf_prod(srsran_simd_cfi_load(&q->h_tap[i][k]), _a[i]));
     }
+    srsran_simd_cfi_store(&h_freq[k], acc);
   }
-  // at this stage, q->h_freq should contain the frequency response
+#endif /* SRSRAN_SIMD_CF_SIZE */
+
+  for (; k < q->N; k++) {
+    cf_t acc = 0;
+    for (uint32_t i = 0; i < M; i++) {
+      acc += q->h_tap[i][k] * a[i];
+    }
+    h_freq[k] = acc;
+  }
+  // at this stage, h_freq should contain the frequency response
 }
 
-static inline void filter_segment(srsran_channel_fading_t* q, const cf_t* input, cf_t* output, uint32_t nsamples)
+// Computes the N samples response of a segment, the first nsamples are output and the rest overlap the next segments
+static inline void filter_segment(srsran_channel_fading_t* q,
+                                  srsran_dft_plan_t*       fft,
+                                  srsran_dft_plan_t*       ifft,
+                                  cf_t*                    h_freq,
+                                  cf_t*                    y_freq,
+                                  const cf_t*              input,
+                                  uint32_t                 nsamples,
+                                  float                    time,
+                                  cf_t*                    response)
 {
+  // Generate taps
+  generate_taps(q, time, h_freq);
+
   // Fill Input vector
-  srsran_vec_cf_copy(q->temp, input, nsamples);
-  srsran_vec_cf_zero(&q->temp[nsamples], q->N - nsamples);
+  srsran_vec_cf_copy(response, input, nsamples);
+  srsran_vec_cf_zero(&response[nsamples], q->N - nsamples);
 
   // Do FFT
-  srsran_dft_run_c_zerocopy(&q->fft, q->temp, q->y_freq);
+  srsran_dft_run_c_zerocopy(fft, response, y_freq);
 
   // Apply channel
-  srsran_vec_prod_ccc(q->y_freq, q->h_freq, q->y_freq, q->N);
+  srsran_vec_prod_ccc(y_freq, h_freq, y_freq, q->N);
 
   // Do iFFT
-  srsran_dft_run_c_zerocopy(&q->ifft, q->y_freq, q->temp);
+  srsran_dft_run_c_zerocopy(ifft, y_freq, response);
+}
 
+static inline void overlap_add(srsran_channel_fading_t* q, cf_t* response, cf_t* output, uint32_t nsamples)
+{
   // Add state
-  srsran_vec_sum_ccc(q->temp, q->state, q->temp, q->state_len);
+  srsran_vec_sum_ccc(response, q->state, response, q->state_len);
 
   // Copy the first nsamples into the output
-  srsran_vec_cf_copy(output, q->temp, nsamples);
+  srsran_vec_cf_copy(output, response, nsamples);
 
   // Copy the rest of the samples into the state
   q->state_len = q->N - nsamples;
-  srsran_vec_cf_copy(q->state, &q->temp[nsamples], q->state_len);
+  srsran_vec_cf_copy(q->state, &response[nsamples], q->state_len);
 }
 
 int srsran_channel_fading_init(srsran_channel_fading_t* q, double srate, const char* model, uint32_t seed)
@@ -345,14 +385,12 @@ double srsran_channel_fading_execute(srsran_channel_fading_t* q,
 
   if (q) {
     while (counter < nsamples) {
-      // Generate taps
-      generate_taps(q, (float)init_time);
-
       // Do not process more than N/2 samples
       uint32_t n = SRSRAN_MIN(q->N / 2, nsamples - counter);
 
       // Execute
-      filter_segment(q, &in[counter], &out[counter], n);
+      filter_segment(q, &q->fft, &q->ifft, q->h_freq, q->y_freq, &in[counter], n, (float)init_time, q->temp);
+      overlap_add(q, q->temp, &out[counter], n);
 
       // Increment time
       init_time += n / q->srate;
@@ -365,3 +403,98 @@ double srsran_channel_fading_execute(srsran_channel_fading_t* q,
   // Return time
   return init_time;
 }
+
+int srsran_channel_fading_scratch_init(srsran_channel_fading_scratch_t* s, const srsran_channel_fading_t* q)
+{
+  if (s == NULL || q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(s, srsran_channel_fading_scratch_t, 1);
+
+  if (srsran_dft_plan_c(&s->fft, q->N, SRSRAN_DFT_FORWARD) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error: planning fft\n");
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_dft_plan_c(&s->ifft, q->N, SRSRAN_DFT_BACKWARD) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error: planning ifft\n");
+    return SRSRAN_ERROR;
+  }
+
+  s->h_freq = srsran_vec_cf_malloc(q->N);
+  s->y_freq = srsran_vec_cf_malloc(q->N);
+  if (!s->h_freq || !s->y_freq) {
+    fprintf(stderr, "Error: allocating scratch\n");
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_channel_fading_scratch_free(srsran_channel_fading_scratch_t* s)
+{
+  if (s) {
+    srsran_dft_plan_free(&s->fft);
+    srsran_dft_plan_free(&s->ifft);
+
+    if (s->h_freq) {
+      free(s->h_freq);
+    }
+
+    if (s->y_freq) {
+      free(s->y_freq);
+    }
+  }
+}
+
+uint32_t srsran_channel_fading_nof_segments(const srsran_channel_fading_t* q, uint32_t nsamples)
+{
+  return (q && q->N > 1) ? SRSRAN_CEIL(nsamples, q->N / 2) : 0;
+}
+
+void srsran_channel_fading_filter(srsran_channel_fading_t*         q,
+                                  srsran_channel_fading_scratch_t* s,
+                                  const cf_t*                      in,
+                                  uint32_t                         nsamples,
+                                  uint32_t                         idx,
+                                  double                           init_time,
+                                  cf_t*                            response)
+{
+  if (q == NULL || s == NULL || in == NULL || response == NULL) {
+    return;
+  }
+
+  // Accumulate the time the same way srsran_channel_fading_execute() does
+  uint32_t counter = 0;
+  for (uint32_t i = 0; i < idx; i++) {
+    uint32_t n = SRSRAN_MIN(q->N / 2, nsamples - counter);
+    init_time += n / q->srate;
+    counter += n;
+  }
+
+  if (counter < nsamples) {
+    uint32_t n = SRSRAN_MIN(q->N / 2, nsamples - counter);
+    filter_segment(q, &s->fft, &s->ifft, s->h_freq, s->y_freq, &in[counter], n, (float)init_time, response);
+  }
+}
+
+double srsran_channel_fading_overlap_add(srsran_channel_fading_t* q,
+                                         cf_t*                    responses,
+                                         cf_t*                    out,
+                                         uint32_t                 nsamples,
+                                         double                   init_time)
+{
+  uint32_t counter = 0;
+
+  if (q) {
+    for (cf_t* response = responses; counter < nsamples; response += q->N) {
+      uint32_t n = SRSRAN_MIN(q->N / 2, nsamples - counter);
+      overlap_add(q, response, &out[counter], n);
+      init_time += n / q->srate;
+      counter += n;
+    }
+  }
+
+  return init_time;
+}
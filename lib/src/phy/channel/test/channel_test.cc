@@ -0,0 +1,196 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/phy/channel/channel.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include <chrono>
+#include <getopt.h>
+#include <vector>
+
+static uint32_t    nof_ports   = 2;
+static uint32_t    nof_threads = 4;
+static uint32_t    nof_sf      = 10;
+static uint32_t    srate_hz    = 23040000;
+static std::string model       = "eva70";
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [pmtns]\n", prog);
+  printf("\t-p Number of eNB ports [Default %d]\n", nof_ports);
+  printf("\t-m Fading model [Default %s]\n", model.c_str());
+  printf("\t-t Number of threads [Default %d]\n", nof_threads);
+  printf("\t-n Number of subframes [Default %d]\n", nof_sf);
+  printf("\t-s Sampling rate in Hz [Default %d]\n", srate_hz);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "pmtns")) != -1) {
+    switch (opt) {
+      case 'p':
+        nof_ports = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'm':
+        model = argv[optind];
+        break;
+      case 't':
+        nof_threads = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        nof_sf = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        srate_hz = (uint32_t)strtof(argv[optind], NULL);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+class channel_tester
+{
+public:
+  channel_tester(const srsran::channel::args_t& args, uint32_t nof_channels, uint32_t sf_len) :
+    logger(srslog::fetch_basic_logger("CHAN", false)), chan(args, nof_channels, logger)
+  {
+    logger.set_level(srslog::basic_levels::error);
+    chan.set_srate(srate_hz);
+    for (uint32_t i = 0; i < SRSRAN_MAX_CHANNELS; i++) {
+      out[i] = srsran_vec_cf_malloc(sf_len);
+    }
+  }
+
+  ~channel_tester()
+  {
+    for (uint32_t i = 0; i < SRSRAN_MAX_CHANNELS; i++) {
+      free(out[i]);
+    }
+  }
+
+  srslog::basic_logger& logger;
+  srsran::channel       chan;
+  cf_t*                 out[SRSRAN_MAX_CHANNELS] = {};
+};
+
+// Runs the same channel serially and with several threads, both must produce the same samples
+static int test_run(const srsran::channel::args_t& args, cf_t** in, uint32_t sf_len)
+{
+  srsran::channel::args_t serial_args = args;
+  serial_args.nof_threads             = 1;
+  channel_tester serial(serial_args, nof_ports, sf_len);
+  channel_tester parallel(args, nof_ports, sf_len);
+
+  std::chrono::nanoseconds serial_time(0), parallel_time(0);
+  for (uint32_t sf = 0; sf < nof_sf; sf++) {
+    srsran_timestamp_t ts = {};
+    srsran_timestamp_init_uint64(&ts, (uint64_t)sf * sf_len, srate_hz);
+
+    auto t0 = std::chrono::steady_clock::now();
+    serial.chan.run(in, serial.out, sf_len, ts);
+    auto t1 = std::chrono::steady_clock::now();
+    parallel.chan.run(in, parallel.out, sf_len, ts);
+    auto t2 = std::chrono::steady_clock::now();
+    serial_time += t1 - t0;
+    parallel_time += t2 - t1;
+
+    for (uint32_t p = 0; p < nof_ports; p++) {
+      TESTASSERT(memcmp(serial.out[p], parallel.out[p], sizeof(cf_t) * sf_len) == 0);
+    }
+  }
+
+  printf("run: %d ports, %.1f us per subframe serial, %.1f us with %d threads\n",
+         nof_ports,
+         serial_time.count() / 1e3 / nof_sf,
+         parallel_time.count() / 1e3 / nof_sf,
+         args.nof_threads);
+
+  return SRSRAN_SUCCESS;
+}
+
+// The fading segments are filtered in parallel, the result must be the same as filtering them one after the other
+static int test_fading(cf_t** in, uint32_t sf_len)
+{
+  srsran::channel::args_t args = {};
+  args.enable                  = true;
+  args.nof_threads             = nof_threads;
+  args.fading_enable           = true;
+  args.fading_model            = model;
+  channel_tester tester(args, 1, sf_len);
+
+  srsran_channel_fading_t fading = {};
+  TESTASSERT(srsran_channel_fading_init(&fading, srate_hz, model.c_str(), 0) == SRSRAN_SUCCESS);
+  std::vector<cf_t> expected(sf_len);
+
+  for (uint32_t sf = 0; sf < nof_sf; sf++) {
+    srsran_timestamp_t ts = {};
+    srsran_timestamp_init_uint64(&ts, (uint64_t)sf * sf_len, srate_hz);
+
+    tester.chan.run(in, tester.out, sf_len, ts);
+    srsran_channel_fading_execute(&fading, in[0], expected.data(), sf_len, ts.full_secs + ts.frac_secs);
+    TESTASSERT(memcmp(expected.data(), tester.out[0], sizeof(cf_t) * sf_len) == 0);
+  }
+
+  srsran_channel_fading_free(&fading);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+  srslog::init();
+
+  uint32_t sf_len = srate_hz / 1000;
+  TESTASSERT(nof_ports > 0 && nof_ports <= SRSRAN_MAX_PORTS);
+
+  // Random input per port
+  srsran_random_t    random = srsran_random_init(0);
+  std::vector<cf_t*> in(nof_ports);
+  for (cf_t*& ptr : in) {
+    ptr = srsran_vec_cf_malloc(sf_len);
+    srsran_random_uniform_complex_dist_vector(random, ptr, sf_len, -1.0f, +1.0f);
+  }
+
+  srsran::channel::args_t args = {};
+  args.enable                  = true;
+  args.nof_threads             = nof_threads;
+  args.awgn_enable             = true;
+  args.awgn_snr_dB             = 20.0f;
+  args.fading_enable           = true;
+  args.fading_model            = model;
+  args.delay_enable            = true;
+  args.hst_enable              = true;
+
+  TESTASSERT(test_run(args, in.data(), sf_len) == SRSRAN_SUCCESS);
+  TESTASSERT(test_fading(in.data(), sf_len) == SRSRAN_SUCCESS);
+
+  for (cf_t* ptr : in) {
+    free(ptr);
+  }
+  srsran_random_free(random);
+
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
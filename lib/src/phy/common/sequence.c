@@ -687,43 +687,46 @@ void srsran_sequence_apply_bit(const uint8_t* in, uint8_t* out, uint32_t length,
   srsran_sequence_state_apply_bit(&sequence_state, in, out, length);
 }
 
+/**
+ * Bit reversal look-up table for converting LSB first sequence bytes into MSB first packed bytes
+ */
+static const uint8_t sequence_reverse_lut[256] = {
+    0b00000000, 0b10000000, 0b01000000, 0b11000000, 0b00100000, 0b10100000, 0b01100000, 0b11100000, 0b00010000,
+    0b10010000, 0b01010000, 0b11010000, 0b00110000, 0b10110000, 0b01110000, 0b11110000, 0b00001000, 0b10001000,
+    0b01001000, 0b11001000, 0b00101000, 0b10101000, 0b01101000, 0b11101000, 0b00011000, 0b10011000, 0b01011000,
+    0b11011000, 0b00111000, 0b10111000, 0b01111000, 0b11111000, 0b00000100, 0b10000100, 0b01000100, 0b11000100,
+    0b00100100, 0b10100100, 0b01100100, 0b11100100, 0b00010100, 0b10010100, 0b01010100, 0b11010100, 0b00110100,
+    0b10110100, 0b01110100, 0b11110100, 0b00001100, 0b10001100, 0b01001100, 0b11001100, 0b00101100, 0b10101100,
+    0b01101100, 0b11101100, 0b00011100, 0b10011100, 0b01011100, 0b11011100, 0b00111100, 0b10111100, 0b01111100,
+    0b11111100, 0b00000010, 0b10000010, 0b01000010, 0b11000010, 0b00100010, 0b10100010, 0b01100010, 0b11100010,
+    0b00010010, 0b10010010, 0b01010010, 0b11010010, 0b00110010, 0b10110010, 0b01110010, 0b11110010, 0b00001010,
+    0b10001010, 0b01001010, 0b11001010, 0b00101010, 0b10101010, 0b01101010, 0b11101010, 0b00011010, 0b10011010,
+    0b01011010, 0b11011010, 0b00111010, 0b10111010, 0b01111010, 0b11111010, 0b00000110, 0b10000110, 0b01000110,
+    0b11000110, 0b00100110, 0b10100110, 0b01100110, 0b11100110, 0b00010110, 0b10010110, 0b01010110, 0b11010110,
+    0b00110110, 0b10110110, 0b01110110, 0b11110110, 0b00001110, 0b10001110, 0b01001110, 0b11001110, 0b00101110,
+    0b10101110, 0b01101110, 0b11101110, 0b00011110, 0b10011110, 0b01011110, 0b11011110, 0b00111110, 0b10111110,
+    0b01111110, 0b11111110, 0b00000001, 0b10000001, 0b01000001, 0b11000001, 0b00100001, 0b10100001, 0b01100001,
+    0b11100001, 0b00010001, 0b10010001, 0b01010001, 0b11010001, 0b00110001, 0b10110001, 0b01110001, 0b11110001,
+    0b00001001, 0b10001001, 0b01001001, 0b11001001, 0b00101001, 0b10101001, 0b01101001, 0b11101001, 0b00011001,
+    0b10011001, 0b01011001, 0b11011001, 0b00111001, 0b10111001, 0b01111001, 0b11111001, 0b00000101, 0b10000101,
+    0b01000101, 0b11000101, 0b00100101, 0b10100101, 0b01100101, 0b11100101, 0b00010101, 0b10010101, 0b01010101,
+    0b11010101, 0b00110101, 0b10110101, 0b01110101, 0b11110101, 0b00001101, 0b10001101, 0b01001101, 0b11001101,
+    0b00101101, 0b10101101, 0b01101101, 0b11101101, 0b00011101, 0b10011101, 0b01011101, 0b11011101, 0b00111101,
+    0b10111101, 0b01111101, 0b11111101, 0b00000011, 0b10000011, 0b01000011, 0b11000011, 0b00100011, 0b10100011,
+    0b01100011, 0b11100011, 0b00010011, 0b10010011, 0b01010011, 0b11010011, 0b00110011, 0b10110011, 0b01110011,
+    0b11110011, 0b00001011, 0b10001011, 0b01001011, 0b11001011, 0b00101011, 0b10101011, 0b01101011, 0b11101011,
+    0b00011011, 0b10011011, 0b01011011, 0b11011011, 0b00111011, 0b10111011, 0b01111011, 0b11111011, 0b00000111,
+    0b10000111, 0b01000111, 0b11000111, 0b00100111, 0b10100111, 0b01100111, 0b11100111, 0b00010111, 0b10010111,
+    0b01010111, 0b11010111, 0b00110111, 0b10110111, 0b01110111, 0b11110111, 0b00001111, 0b10001111, 0b01001111,
+    0b11001111, 0b00101111, 0b10101111, 0b01101111, 0b11101111, 0b00011111, 0b10011111, 0b01011111, 0b11011111,
+    0b00111111, 0b10111111, 0b01111111, 0b11111111,
+};
+
 void srsran_sequence_apply_packed(const uint8_t* in, uint8_t* out, uint32_t length, uint32_t seed)
 {
   uint32_t x1 = sequence_x1_init;           // X1 initial state is fix
   uint32_t x2 = sequence_get_x2_init(seed); // loads x2 initial state
 
-  const uint8_t reverse_lut[256] = {
-      0b00000000, 0b10000000, 0b01000000, 0b11000000, 0b00100000, 0b10100000, 0b01100000, 0b11100000, 0b00010000,
-      0b10010000, 0b01010000, 0b11010000, 0b00110000, 0b10110000, 0b01110000, 0b11110000, 0b00001000, 0b10001000,
-      0b01001000, 0b11001000, 0b00101000, 0b10101000, 0b01101000, 0b11101000, 0b00011000, 0b10011000, 0b01011000,
-      0b11011000, 0b00111000, 0b10111000, 0b01111000, 0b11111000, 0b00000100, 0b10000100, 0b01000100, 0b11000100,
-      0b00100100, 0b10100100, 0b01100100, 0b11100100, 0b00010100, 0b10010100, 0b01010100, 0b11010100, 0b00110100,
-      0b10110100, 0b01110100, 0b11110100, 0b00001100, 0b10001100, 0b01001100, 0b11001100, 0b00101100, 0b10101100,
-      0b01101100, 0b11101100, 0b00011100, 0b10011100, 0b01011100, 0b11011100, 0b00111100, 0b10111100, 0b01111100,
-      0b11111100, 0b00000010, 0b10000010, 0b01000010, 0b11000010, 0b00100010, 0b10100010, 0b01100010, 0b11100010,
-      0b00010010, 0b10010010, 0b01010010, 0b11010010, 0b00110010, 0b10110010, 0b01110010, 0b11110010, 0b00001010,
-      0b10001010, 0b01001010, 0b11001010, 0b00101010, 0b10101010, 0b01101010, 0b11101010, 0b00011010, 0b10011010,
-      0b01011010, 0b11011010, 0b00111010, 0b10111010, 0b01111010, 0b11111010, 0b00000110, 0b10000110, 0b01000110,
-      0b11000110, 0b00100110, 0b10100110, 0b01100110, 0b11100110, 0b00010110, 0b10010110, 0b01010110, 0b11010110,
-      0b00110110, 0b10110110, 0b01110110, 0b11110110, 0b00001110, 0b10001110, 0b01001110, 0b11001110, 0b00101110,
-      0b10101110, 0b01101110, 0b11101110, 0b00011110, 0b10011110, 0b01011110, 0b11011110, 0b00111110, 0b10111110,
-      0b01111110, 0b11111110, 0b00000001, 0b10000001, 0b01000001, 0b11000001, 0b00100001, 0b10100001, 0b01100001,
-      0b11100001, 0b00010001, 0b10010001, 0b01010001, 0b11010001, 0b00110001, 0b10110001, 0b01110001, 0b11110001,
-      0b00001001, 0b10001001, 0b01001001, 0b11001001, 0b00101001, 0b10101001, 0b01101001, 0b11101001, 0b00011001,
-      0b10011001, 0b01011001, 0b11011001, 0b00111001, 0b10111001, 0b01111001, 0b11111001, 0b00000101, 0b10000101,
-      0b01000101, 0b11000101, 0b00100101, 0b10100101, 0b01100101, 0b11100101, 0b00010101, 0b10010101, 0b01010101,
-      0b11010101, 0b00110101, 0b10110101, 0b01110101, 0b11110101, 0b00001101, 0b10001101, 0b01001101, 0b11001101,
-      0b00101101, 0b10101101, 0b01101101, 0b11101101, 0b00011101, 0b10011101, 0b01011101, 0b11011101, 0b00111101,
-      0b10111101, 0b01111101, 0b11111101, 0b00000011, 0b10000011, 0b01000011, 0b11000011, 0b00100011, 0b10100011,
-      0b01100011, 0b11100011, 0b00010011, 0b10010011, 0b01010011, 0b11010011, 0b00110011, 0b10110011, 0b01110011,
-      0b11110011, 0b00001011, 0b10001011, 0b01001011, 0b11001011, 0b00101011, 0b10101011, 0b01101011, 0b11101011,
-      0b00011011, 0b10011011, 0b01011011, 0b11011011, 0b00111011, 0b10111011, 0b01111011, 0b11111011, 0b00000111,
-      0b10000111, 0b01000111, 0b11000111, 0b00100111, 0b10100111, 0b01100111, 0b11100111, 0b00010111, 0b10010111,
-      0b01010111, 0b11010111, 0b00110111, 0b10110111, 0b01110111, 0b11110111, 0b00001111, 0b10001111, 0b01001111,
-      0b11001111, 0b00101111, 0b10101111, 0b01101111, 0b11101111, 0b00011111, 0b10011111, 0b01011111, 0b11011111,
-      0b00111111, 0b10111111, 0b01111111, 0b11111111,
-  };
-
   uint32_t i = 0;
 #if SEQUENCE_PAR_BITS % 8 != 0
   uint64_t buffer = 0;
@@ -744,7 +747,7 @@ void srsran_sequence_apply_packed(const uint8_t* in, uint8_t* out, uint32_t leng
     }
 
     // Apply XOR
-    out[i] = in[i] ^ reverse_lut[buffer & 255UL];
+    out[i] = in[i] ^ sequence_reverse_lut[buffer & 255UL];
     buffer = buffer >> 8UL;
     count -= 8;
   }
@@ -765,14 +768,14 @@ void srsran_sequence_apply_packed(const uint8_t* in, uint8_t* out, uint32_t leng
       count += SEQUENCE_PAR_BITS;
     }
 
-    out[i] = in[i] ^ reverse_lut[buffer & ((1U << rem8) - 1U) & 255U];
+    out[i] = in[i] ^ sequence_reverse_lut[buffer & ((1U << rem8) - 1U) & 255U];
   }
 #else  // SEQUENCE_PAR_BITS % 8 == 0
   while (i < (length / 8 - (SEQUENCE_PAR_BITS - 1) / 8)) {
     uint32_t c = (uint32_t)(x1 ^ x2);
 
     for (uint32_t j = 0; j < SEQUENCE_PAR_BITS / 8; j++) {
-      out[i] = in[i] ^ reverse_lut[c & 255U];
+      out[i] = in[i] ^ sequence_reverse_lut[c & 255U];
       c      = c >> 8U;
       i++;
     }
@@ -785,7 +788,7 @@ void srsran_sequence_apply_packed(const uint8_t* in, uint8_t* out, uint32_t leng
   // Process spare bytes
   uint32_t c = (uint32_t)(x1 ^ x2);
   while (i < length / 8) {
-    out[i] = in[i] ^ reverse_lut[c & 255U];
+    out[i] = in[i] ^ sequence_reverse_lut[c & 255U];
     c      = c >> 8U;
     i++;
   }
@@ -793,7 +796,306 @@ void srsran_sequence_apply_packed(const uint8_t* in, uint8_t* out, uint32_t leng
   // Process spare bits
   uint32_t rem8 = length % 8;
   if (rem8 != 0) {
-    out[i] = in[i] ^ reverse_lut[c & ((1U << rem8) - 1U) & 255U];
+    out[i] = in[i] ^ sequence_reverse_lut[c & ((1U << rem8) - 1U) & 255U];
   }
 #endif // SEQUENCE_PAR_BITS % 8 == 0
 }
+
+/*
+ * Pseudo-random sequence cache
+ * ----------------------------
+ *
+ * The sequences are generated SEQUENCE_PAR_BITS at a time and stored packed in 32 bit words (LSB first). Applying a
+ * cached sequence does not depend on the generator step size, so the sign and XOR operations are performed on 16, 32 or
+ * 64 bits at a time depending on the available instruction set.
+ */
+
+/**
+ * Number of words needed for storing a sequence of LEN bits, including the overshoot of the last parallel step
+ */
+#define SEQUENCE_CACHE_NOF_WORDS(LEN) (SRSRAN_CEIL((LEN) + SEQUENCE_PAR_BITS, 32) + 1)
+
+static inline uint64_t sequence_cache_get_u64(const uint32_t* words, uint32_t i)
+{
+  return (uint64_t)words[i / 32] | ((uint64_t)words[i / 32 + 1] << 32U);
+}
+
+static void sequence_cache_extend(srsran_sequence_cache_entry_t* e, uint32_t length)
+{
+  while (e->len < length) {
+    uint64_t c = (uint64_t)((e->x1 ^ e->x2) & SEQUENCE_MASK) << (e->len % 32);
+
+    // The current word is partially filled and the next word is empty
+    e->words[e->len / 32] |= (uint32_t)c;
+    e->words[e->len / 32 + 1] = (uint32_t)(c >> 32U);
+
+    // Step sequences
+    e->x1 = sequence_gen_LTE_pr_memless_step_par_x1(e->x1);
+    e->x2 = sequence_gen_LTE_pr_memless_step_par_x2(e->x2);
+
+    e->len += SEQUENCE_PAR_BITS;
+  }
+}
+
+static const uint32_t* sequence_cache_get(srsran_sequence_cache_t* q, uint32_t seed, uint32_t length)
+{
+  if (q == NULL || q->nof_entries == 0 || length > q->max_len) {
+    return NULL;
+  }
+
+  q->tick++;
+
+  // Look for the sequence and, at the same time, for the least recently used entry
+  srsran_sequence_cache_entry_t* lru = &q->entry[0];
+  for (uint32_t i = 0; i < q->nof_entries; i++) {
+    srsran_sequence_cache_entry_t* e = &q->entry[i];
+    if (e->last_used != 0 && e->seed == seed) {
+      e->last_used = q->tick;
+      sequence_cache_extend(e, length);
+      q->nof_hits++;
+      return e->words;
+    }
+    if (e->last_used < lru->last_used) {
+      lru = e;
+    }
+  }
+
+  // Evict the least recently used sequence, empty entries get their buffer on first use
+  if (lru->words == NULL) {
+    lru->words = srsran_vec_u32_malloc(SEQUENCE_CACHE_NOF_WORDS(q->max_len));
+    if (lru->words == NULL) {
+      ERROR("Error allocating sequence cache entry");
+      return NULL;
+    }
+  }
+  srsran_sequence_state_t state = {};
+  srsran_sequence_state_init(&state, seed);
+  lru->seed      = seed;
+  lru->len       = 0;
+  lru->last_used = q->tick;
+  lru->x1        = state.x1;
+  lru->x2        = state.x2;
+  lru->words[0]  = 0;
+  sequence_cache_extend(lru, length);
+  q->nof_misses++;
+
+  return lru->words;
+}
+
+int srsran_sequence_cache_init(srsran_sequence_cache_t* q, uint32_t nof_entries, uint32_t max_len)
+{
+  if (q == NULL || nof_entries == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_sequence_cache_t, 1);
+
+  q->entry = calloc(nof_entries, sizeof(srsran_sequence_cache_entry_t));
+  if (q->entry == NULL) {
+    ERROR("Error allocating sequence cache");
+    return SRSRAN_ERROR;
+  }
+
+  q->nof_entries = nof_entries;
+  q->max_len     = max_len;
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_sequence_cache_free(srsran_sequence_cache_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->entry != NULL) {
+    for (uint32_t i = 0; i < q->nof_entries; i++) {
+      if (q->entry[i].words != NULL) {
+        free(q->entry[i].words);
+      }
+    }
+    free(q->entry);
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_sequence_cache_t, 1);
+}
+
+void srsran_sequence_cache_reset(srsran_sequence_cache_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < q->nof_entries; i++) {
+    q->entry[i].last_used = 0;
+  }
+  q->tick = 0;
+}
+
+void srsran_sequence_cache_apply_s(srsran_sequence_cache_t* q,
+                                   const int16_t*           in,
+                                   int16_t*                 out,
+                                   uint32_t                 length,
+                                   uint32_t                 seed)
+{
+  const uint32_t* c = sequence_cache_get(q, seed, length);
+  if (c == NULL) {
+    srsran_sequence_apply_s(in, out, length, seed);
+    return;
+  }
+
+  uint32_t i = 0;
+
+#ifdef LV_HAVE_AVX512
+  for (; i + 32 <= length; i += 32) {
+    __mmask32 mask = (__mmask32)c[i / 32];
+    __m512i   v    = _mm512_loadu_si512((__m512i*)(in + i));
+    v              = _mm512_mask_sub_epi16(v, mask, _mm512_setzero_si512(), v);
+    _mm512_storeu_si512((__m512i*)(out + i), v);
+  }
+#endif // LV_HAVE_AVX512
+
+#ifdef LV_HAVE_AVX2
+  const __m256i bits256 = _mm256_setr_epi16(
+      0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x100, 0x200, 0x400, 0x800, 0x1000, 0x2000, 0x4000, -0x8000);
+  for (; i + 16 <= length; i += 16) {
+    // Broadcast the 16 bits of interest and get the negation mask
+    __m256i mask = _mm256_set1_epi16((int16_t)(c[i / 32] >> (i % 32)));
+    mask         = _mm256_cmpeq_epi16(_mm256_and_si256(mask, bits256), bits256);
+
+    // Negate: (v ^ mask) - mask
+    __m256i v = _mm256_loadu_si256((__m256i*)(in + i));
+    v         = _mm256_sub_epi16(_mm256_xor_si256(v, mask), mask);
+    _mm256_storeu_si256((__m256i*)(out + i), v);
+  }
+#endif // LV_HAVE_AVX2
+
+#ifdef LV_HAVE_SSE
+  const __m128i bits128 = _mm_setr_epi16(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80);
+  for (; i + 8 <= length; i += 8) {
+    __m128i mask = _mm_set1_epi16((int16_t)((c[i / 32] >> (i % 32)) & 0xff));
+    mask         = _mm_cmpeq_epi16(_mm_and_si128(mask, bits128), bits128);
+
+    __m128i v = _mm_loadu_si128((__m128i*)(in + i));
+    v         = _mm_sub_epi16(_mm_xor_si128(v, mask), mask);
+    _mm_storeu_si128((__m128i*)(out + i), v);
+  }
+#endif // LV_HAVE_SSE
+
+  for (; i < length; i++) {
+    out[i] = ((c[i / 32] >> (i % 32)) & 1U) ? -in[i] : in[i];
+  }
+}
+
+#ifdef LV_HAVE_AVX2
+/**
+ * Expands 32 sequence bits into a 32 byte mask, 0xff where the bit is set
+ */
+static inline __m256i sequence_cache_mask_avx2(uint32_t c)
+{
+  const __m256i bits    = _mm256_set1_epi64x(0x8040201008040201);
+  const __m256i shuffle = _mm256_setr_epi8(
+      0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+
+  // Each 128 bit lane holds the 4 bytes, byte n is copied into the 8 bytes of bit n
+  __m256i mask = _mm256_shuffle_epi8(_mm256_set1_epi32((int32_t)c), shuffle);
+  return _mm256_cmpeq_epi8(_mm256_and_si256(mask, bits), bits);
+}
+#endif // LV_HAVE_AVX2
+
+void srsran_sequence_cache_apply_c(srsran_sequence_cache_t* q,
+                                   const int8_t*            in,
+                                   int8_t*                  out,
+                                   uint32_t                 length,
+                                   uint32_t                 seed)
+{
+  const uint32_t* c = sequence_cache_get(q, seed, length);
+  if (c == NULL) {
+    srsran_sequence_apply_c(in, out, length, seed);
+    return;
+  }
+
+  uint32_t i = 0;
+
+#ifdef LV_HAVE_AVX512
+  for (; i + 64 <= length; i += 64) {
+    __mmask64 mask = (__mmask64)sequence_cache_get_u64(c, i);
+    __m512i   v    = _mm512_loadu_si512((__m512i*)(in + i));
+    v              = _mm512_mask_sub_epi8(v, mask, _mm512_setzero_si512(), v);
+    _mm512_storeu_si512((__m512i*)(out + i), v);
+  }
+#endif // LV_HAVE_AVX512
+
+#ifdef LV_HAVE_AVX2
+  for (; i + 32 <= length; i += 32) {
+    __m256i mask = sequence_cache_mask_avx2(c[i / 32]);
+    __m256i v    = _mm256_loadu_si256((__m256i*)(in + i));
+    v            = _mm256_sub_epi8(_mm256_xor_si256(v, mask), mask);
+    _mm256_storeu_si256((__m256i*)(out + i), v);
+  }
+#endif // LV_HAVE_AVX2
+
+  for (; i < length; i++) {
+    out[i] = ((c[i / 32] >> (i % 32)) & 1U) ? -in[i] : in[i];
+  }
+}
+
+void srsran_sequence_cache_apply_bit(srsran_sequence_cache_t* q,
+                                     const uint8_t*           in,
+                                     uint8_t*                 out,
+                                     uint32_t                 length,
+                                     uint32_t                 seed)
+{
+  const uint32_t* c = sequence_cache_get(q, seed, length);
+  if (c == NULL) {
+    srsran_sequence_apply_bit(in, out, length, seed);
+    return;
+  }
+
+  uint32_t i = 0;
+
+#ifdef LV_HAVE_AVX512
+  for (; i + 64 <= length; i += 64) {
+    __mmask64 mask = (__mmask64)sequence_cache_get_u64(c, i);
+    __m512i   v    = _mm512_loadu_si512((__m512i*)(in + i));
+    v              = _mm512_xor_si512(v, _mm512_maskz_mov_epi8(mask, _mm512_set1_epi8(1)));
+    _mm512_storeu_si512((__m512i*)(out + i), v);
+  }
+#endif // LV_HAVE_AVX512
+
+#ifdef LV_HAVE_AVX2
+  for (; i + 32 <= length; i += 32) {
+    __m256i mask = _mm256_and_si256(sequence_cache_mask_avx2(c[i / 32]), _mm256_set1_epi8(1));
+    __m256i v    = _mm256_loadu_si256((__m256i*)(in + i));
+    _mm256_storeu_si256((__m256i*)(out + i), _mm256_xor_si256(v, mask));
+  }
+#endif // LV_HAVE_AVX2
+
+  for (; i < length; i++) {
+    out[i] = in[i] ^ (uint8_t)((c[i / 32] >> (i % 32)) & 1U);
+  }
+}
+
+void srsran_sequence_cache_apply_packed(srsran_sequence_cache_t* q,
+                                        const uint8_t*           in,
+                                        uint8_t*                 out,
+                                        uint32_t                 length,
+                                        uint32_t                 seed)
+{
+  const uint32_t* c = sequence_cache_get(q, seed, length);
+  if (c == NULL) {
+    srsran_sequence_apply_packed(in, out, length, seed);
+    return;
+  }
+
+  uint32_t i = 0;
+  for (; i < length / 8; i++) {
+    out[i] = in[i] ^ sequence_reverse_lut[(c[i / 4] >> (8U * (i % 4))) & 255U];
+  }
+
+  // Process spare bits
+  uint32_t rem8 = length % 8;
+  if (rem8 != 0) {
+    out[i] = in[i] ^ sequence_reverse_lut[(c[i / 4] >> (8U * (i % 4))) & ((1U << rem8) - 1U) & 255U];
+  }
+}
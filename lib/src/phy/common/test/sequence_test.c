@@ -23,6 +23,7 @@
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/random.h"
+#include "srsran/support/srsran_test.h"
 
 #define Nc 1600
 #define MAX_SEQ_LEN (256 * 1024)
@@ -43,6 +44,8 @@ static int8_t  ones_char[Nc + MAX_SEQ_LEN + 31];
 static uint8_t ones_packed[(MAX_SEQ_LEN * 7) / 8];
 static uint8_t ones_unpacked[MAX_SEQ_LEN];
 
+static srsran_sequence_cache_t cache = {};
+
 static int test_sequence(srsran_sequence_t* sequence, uint32_t seed, uint32_t length, uint32_t repetitions)
 {
   int            ret                      = SRSRAN_SUCCESS;
@@ -178,6 +181,31 @@ static int test_sequence(srsran_sequence_t* sequence, uint32_t seed, uint32_t le
     ret = SRSRAN_ERROR;
   }
 
+  // Test cached sequences, the first call generates the sequence and the following ones reuse it
+  srsran_sequence_cache_apply_s(&cache, ones_short, sequence->c_short, length, seed);
+  if (memcmp(c_short, sequence->c_short, length * sizeof(int16_t)) != 0) {
+    ERROR("Unmatched cached c_short");
+    ret = SRSRAN_ERROR;
+  }
+
+  srsran_sequence_cache_apply_c(&cache, ones_char, sequence->c_char, length, seed);
+  if (memcmp(c_char, sequence->c_char, length * sizeof(int8_t)) != 0) {
+    ERROR("Unmatched cached c_char");
+    ret = SRSRAN_ERROR;
+  }
+
+  srsran_sequence_cache_apply_bit(&cache, ones_unpacked, c_unpacked, length, seed);
+  if (memcmp(c, c_unpacked, length) != 0) {
+    ERROR("Unmatched cached c_unpacked");
+    ret = SRSRAN_ERROR;
+  }
+
+  srsran_sequence_cache_apply_packed(&cache, ones_packed, c_packed, length, seed);
+  if (memcmp(c_packed_gold, c_packed, (length + 7) / 8) != 0) {
+    ERROR("Unmatched cached c_packed");
+    ret = SRSRAN_ERROR;
+  }
+
   printf("%08x; %8d; %8.1f; %8.1f; %8.1f; %8.1f; %8.1f; %8.1f; %8c\n",
          seed,
          length,
@@ -189,6 +217,54 @@ static int test_sequence(srsran_sequence_t* sequence, uint32_t seed, uint32_t le
          (double)(length * repetitions) / (double)interval_xor_packed_us,
          ret == SRSRAN_SUCCESS ? 'y' : 'n');
 
+  return ret;
+}
+
+static int test_sequence_cache(srsran_random_t random_gen)
+{
+  const uint32_t nof_entries = 4;
+  const uint32_t max_len     = 10000;
+  uint32_t       seeds[5];
+  int8_t         gold[max_len + 1];
+  int8_t         out[max_len + 1];
+
+  srsran_sequence_cache_t q = {};
+  TESTASSERT(srsran_sequence_cache_init(&q, nof_entries, max_len) == SRSRAN_SUCCESS);
+
+  for (uint32_t i = 0; i < 5; i++) {
+    seeds[i] = (uint32_t)srsran_random_uniform_int_dist(random_gen, 1, INT32_MAX);
+  }
+
+  // Fill the cache with short sequences
+  for (uint32_t i = 0; i < nof_entries; i++) {
+    srsran_sequence_cache_apply_c(&q, ones_char, out, 100, seeds[i]);
+  }
+  TESTASSERT(q.nof_misses == nof_entries && q.nof_hits == 0);
+
+  // A longer request extends the cached sequence
+  srsran_sequence_apply_c(ones_char, gold, max_len, seeds[0]);
+  srsran_sequence_cache_apply_c(&q, ones_char, out, max_len, seeds[0]);
+  TESTASSERT(q.nof_hits == 1);
+  TESTASSERT(memcmp(gold, out, max_len) == 0);
+
+  // A new seed evicts the least recently used, seeds[1]
+  srsran_sequence_cache_apply_c(&q, ones_char, out, 777, seeds[4]);
+  srsran_sequence_apply_c(ones_char, gold, 777, seeds[4]);
+  TESTASSERT(memcmp(gold, out, 777) == 0);
+  TESTASSERT(q.nof_misses == nof_entries + 1);
+  srsran_sequence_cache_apply_c(&q, ones_char, out, 100, seeds[0]);
+  TESTASSERT(q.nof_misses == nof_entries + 1);
+  srsran_sequence_cache_apply_c(&q, ones_char, out, 100, seeds[1]);
+  TESTASSERT(q.nof_misses == nof_entries + 2);
+
+  // Lengths beyond the maximum bypass the cache
+  srsran_sequence_apply_c(ones_char, gold, max_len + 1, seeds[0]);
+  srsran_sequence_cache_apply_c(&q, ones_char, out, max_len + 1, seeds[0]);
+  TESTASSERT(memcmp(gold, out, max_len + 1) == 0);
+  TESTASSERT(q.nof_misses == nof_entries + 2 && q.nof_hits == 2);
+
+  srsran_sequence_cache_free(&q);
+
   return SRSRAN_SUCCESS;
 }
 
@@ -218,6 +294,12 @@ int main(int argc, char** argv)
     return SRSRAN_ERROR;
   }
 
+  // Initialise sequence cache
+  if (srsran_sequence_cache_init(&cache, 1, max_length) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error initializing sequence cache\n");
+    return SRSRAN_ERROR;
+  }
+
   printf("%8s; %8s; %8s; %8s; %8s; %8s; %8s; %8s; %8s;\n",
          "seed",
          "length",
@@ -229,13 +311,23 @@ int main(int argc, char** argv)
          "XOR Pack",
          "Passed");
 
+  int ret = SRSRAN_SUCCESS;
   for (uint32_t length = min_length; length <= max_length; length = (length * 5) / 4) {
-    test_sequence(&sequence, (uint32_t)srsran_random_uniform_int_dist(random_gen, 1, INT32_MAX), length, repetitions);
+    if (test_sequence(
+            &sequence, (uint32_t)srsran_random_uniform_int_dist(random_gen, 1, INT32_MAX), length, repetitions) !=
+        SRSRAN_SUCCESS) {
+      ret = SRSRAN_ERROR;
+    }
+  }
+
+  if (test_sequence_cache(random_gen) != SRSRAN_SUCCESS) {
+    ret = SRSRAN_ERROR;
   }
 
   // Free sequence object
   srsran_sequence_free(&sequence);
+  srsran_sequence_cache_free(&cache);
   srsran_random_free(random_gen);
 
-  return SRSRAN_SUCCESS;
+  return ret;
 }
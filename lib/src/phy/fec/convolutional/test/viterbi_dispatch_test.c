@@ -0,0 +1,216 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/phy/utils/cpu.h"
+#include "srsran/srsran.h"
+#include <getopt.h>
+#include <stdlib.h>
+
+static uint32_t nof_frames   = 200;
+static uint32_t frame_length = 40; // PBCH with CRC
+static float    ebno_db      = 4.5f;
+static bool     tail_biting  = true;
+static uint32_t seed         = 1234;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [nlets]\n", prog);
+  printf("\t-n nof_frames [Default %d]\n", nof_frames);
+  printf("\t-l frame_length [Default %d]\n", frame_length);
+  printf("\t-e ebno in dB [Default %.1f]\n", ebno_db);
+  printf("\t-t toggle tail biting [Default %s]\n", tail_biting ? "yes" : "no");
+  printf("\t-s seed [Default %d]\n", seed);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nlets")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_frames = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'l':
+        frame_length = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'e':
+        ebno_db = strtof(argv[optind], NULL);
+        break;
+      case 't':
+        tail_biting = !tail_biting;
+        break;
+      case 's':
+        seed = (uint32_t)strtoul(argv[optind], NULL, 0);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/*
+ * Checks the decoder selected by srsran_viterbi_init() for this build and CPU against the portable decoder. Every
+ * entry point must succeed and decode noiseless codewords exactly. On noisy codewords, the
+ * quantization differs between decoders, so up to 1% more frames than the portable decoder may be wrong.
+ */
+int main(int argc, char** argv)
+{
+  int                ret      = SRSRAN_ERROR;
+  srsran_viterbi_t   dec      = {};
+  srsran_viterbi_t   dec_port = {};
+  srsran_convcoder_t cod      = {};
+  uint8_t*           data_tx  = NULL;
+  uint8_t*           data_rx  = NULL;
+  uint8_t*           symbols  = NULL;
+  float*             llr      = NULL;
+  int16_t*           llr_s    = NULL;
+  uint8_t*           llr_c    = NULL;
+  uint32_t           fer_f = 0, fer_s = 0, fer_c = 0, fer_port = 0;
+
+  parse_args(argc, argv);
+  srsran_random_t random_gen = srsran_random_init(seed);
+
+  cod.poly[0]     = 0x6D;
+  cod.poly[1]     = 0x4F;
+  cod.poly[2]     = 0x57;
+  cod.K           = 7;
+  cod.R           = 3;
+  cod.tail_biting = tail_biting;
+
+  uint32_t coded_length = cod.R * (frame_length + ((cod.tail_biting) ? 0 : cod.K - 1));
+  float    var          = srsran_convert_dB_to_power(-(ebno_db + srsran_convert_power_to_dB(1.0f / 3.0f)));
+
+  if (srsran_viterbi_init(&dec, SRSRAN_VITERBI_37, cod.poly, frame_length, cod.tail_biting) ||
+      srsran_viterbi_init_port(&dec_port, SRSRAN_VITERBI_37, cod.poly, frame_length, cod.tail_biting)) {
+    ERROR("Error initiating Viterbi decoder");
+    goto clean_exit;
+  }
+
+#ifdef SRSRAN_AVX512_KERNELS
+  // The AVX512 decoder, the only one with a multi-codeword decoder, is selected if and only if the CPU supports it
+  if ((dec.ptr_multi != NULL) != srsran_cpu_has_avx512()) {
+    ERROR("The AVX512 decoder selection does not match the CPU (%s)", srsran_cpu_isa_string(srsran_cpu_get_isa()));
+    goto clean_exit;
+  }
+#endif
+
+  data_tx = srsran_vec_u8_malloc(frame_length);
+  data_rx = srsran_vec_u8_malloc(frame_length);
+  symbols = srsran_vec_u8_malloc(coded_length);
+  llr     = srsran_vec_f_malloc(coded_length);
+  llr_s   = srsran_vec_i16_malloc(coded_length);
+  llr_c   = srsran_vec_u8_malloc(coded_length);
+  if (!data_tx || !data_rx || !symbols || !llr || !llr_s || !llr_c) {
+    goto clean_exit;
+  }
+
+  // The first frame is noiseless
+  for (uint32_t n = 0; n < nof_frames; n++) {
+    for (uint32_t j = 0; j < frame_length; j++) {
+      data_tx[j] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 1);
+    }
+    srsran_convcoder_encode(&cod, data_tx, symbols, frame_length);
+    for (uint32_t j = 0; j < coded_length; j++) {
+      llr[j] = symbols[j] ? M_SQRT2 : -M_SQRT2;
+    }
+    if (n > 0) {
+      srsran_ch_awgn_f(llr, llr, var, coded_length);
+    }
+    srsran_vec_convert_fi(llr, 1000, llr_s, coded_length);
+    srsran_vec_quant_fuc(llr, llr_c, 32, 127.5, 255, coded_length);
+
+    if (srsran_viterbi_decode_uc(&dec_port, llr_c, data_rx, frame_length) < SRSRAN_SUCCESS) {
+      ERROR("Error decoding with the portable decoder");
+      goto clean_exit;
+    }
+    uint32_t e_port = srsran_bit_diff(data_tx, data_rx, frame_length);
+
+    if (srsran_viterbi_decode_f(&dec, llr, data_rx, frame_length) < SRSRAN_SUCCESS) {
+      ERROR("Error decoding float symbols");
+      goto clean_exit;
+    }
+    uint32_t e_f = srsran_bit_diff(data_tx, data_rx, frame_length);
+
+    if (srsran_viterbi_decode_s(&dec, llr_s, data_rx, frame_length) < SRSRAN_SUCCESS) {
+      ERROR("Error decoding int16 symbols");
+      goto clean_exit;
+    }
+    uint32_t e_s = srsran_bit_diff(data_tx, data_rx, frame_length);
+
+    if (srsran_viterbi_decode_uc(&dec, llr_c, data_rx, frame_length) < SRSRAN_SUCCESS) {
+      ERROR("Error decoding uint8 symbols");
+      goto clean_exit;
+    }
+    uint32_t e_c = srsran_bit_diff(data_tx, data_rx, frame_length);
+
+    if (n == 0 && (e_port || e_f || e_s || e_c)) {
+      ERROR("Noiseless codeword decoded with errors (port=%d, float=%d, int16=%d, uint8=%d)", e_port, e_f, e_s, e_c);
+      goto clean_exit;
+    }
+    fer_port += (e_port > 0);
+    fer_f += (e_f > 0);
+    fer_s += (e_s > 0);
+    fer_c += (e_c > 0);
+  }
+
+  printf("Decoded %d frames of %d bits at Eb/No %.1f dB: wrong frames port=%d, float=%d, int16=%d, uint8=%d\n",
+         nof_frames,
+         frame_length,
+         ebno_db,
+         fer_port,
+         fer_f,
+         fer_s,
+         fer_c);
+
+  uint32_t max_fer = fer_port + nof_frames / 100 + 1;
+  if (fer_f > max_fer || fer_s > max_fer || fer_c > max_fer) {
+    ERROR("The selected decoder is less accurate than the portable decoder");
+    goto clean_exit;
+  }
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_viterbi_free(&dec);
+  srsran_viterbi_free(&dec_port);
+  srsran_random_free(random_gen);
+  if (data_tx) {
+    free(data_tx);
+  }
+  if (data_rx) {
+    free(data_rx);
+  }
+  if (symbols) {
+    free(symbols);
+  }
+  if (llr) {
+    free(llr);
+  }
+  if (llr_s) {
+    free(llr_s);
+  }
+  if (llr_c) {
+    free(llr_c);
+  }
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Failed");
+  return ret;
+}
@@ -0,0 +1,222 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/srsran.h"
+#include <getopt.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+static uint32_t nof_cw       = SRSRAN_VITERBI_MAX_MULTI;
+static uint32_t frame_length = 43; // DCI format 1A for 20 MHz with CRC
+static uint32_t repetitions  = 100;
+static float    ebno_db      = 3.0f;
+static bool     tail_biting  = true;
+static uint32_t seed         = 1234;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [nlRets]\n", prog);
+  printf("\t-n number of codewords decoded together [Default %d]\n", nof_cw);
+  printf("\t-l frame_length [Default %d]\n", frame_length);
+  printf("\t-R number of repetitions of the benchmark [Default %d]\n", repetitions);
+  printf("\t-e ebno in dB [Default %.1f]\n", ebno_db);
+  printf("\t-t toggle tail biting [Default %s]\n", tail_biting ? "yes" : "no");
+  printf("\t-s seed [Default %d]\n", seed);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nlRets")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_cw = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'l':
+        frame_length = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'R':
+        repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'e':
+        ebno_db = strtof(argv[optind], NULL);
+        break;
+      case 't':
+        tail_biting = !tail_biting;
+        break;
+      case 's':
+        seed = (uint32_t)strtoul(argv[optind], NULL, 0);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  int                ret                                     = SRSRAN_ERROR;
+  srsran_viterbi_t   dec                                     = {};
+  srsran_convcoder_t cod                                     = {};
+  float*             llr[SRSRAN_VITERBI_MAX_MULTI]           = {};
+  uint8_t*           data_tx[SRSRAN_VITERBI_MAX_MULTI]       = {};
+  uint8_t*           data_rx[SRSRAN_VITERBI_MAX_MULTI]       = {};
+  uint8_t*           data_rx_multi[SRSRAN_VITERBI_MAX_MULTI] = {};
+  uint8_t*           symbols                                 = NULL;
+  struct timeval     t[3];
+
+  parse_args(argc, argv);
+  if (nof_cw == 0 || nof_cw > SRSRAN_VITERBI_MAX_MULTI) {
+    ERROR("Invalid number of codewords %d", nof_cw);
+    return SRSRAN_ERROR;
+  }
+  srand(seed);
+  srsran_random_t random_gen = srsran_random_init(seed);
+
+  cod.poly[0]     = 0x6D;
+  cod.poly[1]     = 0x4F;
+  cod.poly[2]     = 0x57;
+  cod.K           = 7;
+  cod.R           = 3;
+  cod.tail_biting = tail_biting;
+
+  uint32_t coded_length = cod.R * (frame_length + ((cod.tail_biting) ? 0 : cod.K - 1));
+  float    var          = srsran_convert_dB_to_power(-(ebno_db + srsran_convert_power_to_dB(1.0f / 3.0f)));
+
+  if (srsran_viterbi_init(&dec, SRSRAN_VITERBI_37, cod.poly, frame_length, cod.tail_biting)) {
+    ERROR("Error initiating Viterbi decoder");
+    goto clean_exit;
+  }
+
+  symbols = srsran_vec_u8_malloc(coded_length);
+  if (!symbols) {
+    goto clean_exit;
+  }
+  for (uint32_t i = 0; i < nof_cw; i++) {
+    llr[i]           = srsran_vec_f_malloc(coded_length);
+    data_tx[i]       = srsran_vec_u8_malloc(frame_length);
+    data_rx[i]       = srsran_vec_u8_malloc(frame_length);
+    data_rx_multi[i] = srsran_vec_u8_malloc(frame_length);
+    if (!llr[i] || !data_tx[i] || !data_rx[i] || !data_rx_multi[i]) {
+      goto clean_exit;
+    }
+  }
+
+  // Generate, encode and add noise to every codeword
+  for (uint32_t i = 0; i < nof_cw; i++) {
+    for (uint32_t j = 0; j < frame_length; j++) {
+      data_tx[i][j] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 1);
+    }
+    srsran_convcoder_encode(&cod, data_tx[i], symbols, frame_length);
+    for (uint32_t j = 0; j < coded_length; j++) {
+      llr[i][j] = symbols[j] ? M_SQRT2 : -M_SQRT2;
+    }
+    srsran_ch_awgn_f(llr[i], llr[i], var, coded_length);
+  }
+
+  // Decode the codewords one by one
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < repetitions; r++) {
+    for (uint32_t i = 0; i < nof_cw; i++) {
+      if (srsran_viterbi_decode_f(&dec, llr[i], data_rx[i], frame_length) < SRSRAN_SUCCESS) {
+        ERROR("Error decoding");
+        goto clean_exit;
+      }
+    }
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  double single_us = (t[0].tv_sec * 1e6 + t[0].tv_usec) / repetitions;
+
+  // Decode all the codewords together
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < repetitions; r++) {
+    if (srsran_viterbi_decode_f_multi(&dec, llr, data_rx_multi, nof_cw, frame_length) < SRSRAN_SUCCESS) {
+      ERROR("Error decoding");
+      goto clean_exit;
+    }
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  double multi_us = (t[0].tv_sec * 1e6 + t[0].tv_usec) / repetitions;
+
+  // The codewords decoded together must match the codewords decoded one by one
+  uint32_t errors = 0;
+  for (uint32_t i = 0; i < nof_cw; i++) {
+    if (memcmp(data_rx[i], data_rx_multi[i], frame_length) != 0) {
+      ERROR("Codeword %d decoded together does not match the codeword decoded alone", i);
+      goto clean_exit;
+    }
+    errors += srsran_bit_diff(data_tx[i], data_rx[i], frame_length);
+  }
+
+#ifdef LV_HAVE_AVX2
+  // The AVX512 decoder must match the AVX2 16-bit decoder
+  srsran_viterbi_t dec_avx2 = {};
+  if (srsran_viterbi_init_avx2_16bit(&dec_avx2, SRSRAN_VITERBI_37, cod.poly, frame_length, cod.tail_biting)) {
+    ERROR("Error initiating Viterbi decoder");
+    goto clean_exit;
+  }
+  for (uint32_t i = 0; i < nof_cw; i++) {
+    srsran_viterbi_decode_f(&dec_avx2, llr[i], data_rx[i], frame_length);
+    if (memcmp(data_rx[i], data_rx_multi[i], frame_length) != 0) {
+      ERROR("Codeword %d does not match the AVX2 decoder", i);
+      srsran_viterbi_free(&dec_avx2);
+      goto clean_exit;
+    }
+  }
+  srsran_viterbi_free(&dec_avx2);
+#endif
+
+  printf("Decoded %d codewords of %d bits (BER %.2e): one by one %.1f us, together %.1f us\n",
+         nof_cw,
+         frame_length,
+         (double)errors / (double)(nof_cw * frame_length),
+         single_us,
+         multi_us);
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_viterbi_free(&dec);
+  srsran_random_free(random_gen);
+  if (symbols) {
+    free(symbols);
+  }
+  for (uint32_t i = 0; i < SRSRAN_VITERBI_MAX_MULTI; i++) {
+    if (llr[i]) {
+      free(llr[i]);
+    }
+    if (data_tx[i]) {
+      free(data_tx[i]);
+    }
+    if (data_rx[i]) {
+      free(data_rx[i]);
+    }
+    if (data_rx_multi[i]) {
+      free(data_rx_multi[i]);
+    }
+  }
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Failed");
+  return ret;
+}
@@ -28,6 +28,7 @@
 
 #include "parity.h"
 #include "srsran/phy/fec/convolutional/viterbi.h"
+#include "srsran/phy/utils/cpu.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/vector.h"
 #include "viterbi37.h"
@@ -36,6 +37,9 @@
 
 #define TB_ITER 5
 
+/* Minimum number of codewords for which the multi-codeword decoder is faster than decoding them one by one */
+#define VITERBI_MULTI_MIN_CW 12
+
 #define DEFAULT_GAIN 100
 
 #define DEFAULT_GAIN_16 500
@@ -125,6 +129,26 @@ void free37_sse(void* o)
 
 #endif
 
+#if defined(LV_HAVE_AVX2) || defined(SRSRAN_AVX512_KERNELS)
+/* 8-bit entry point of the 16-bit decoders, the symbols are expanded to 16 bit keeping the same zero (127.5) */
+static int decode37_uc_16bit(void* o, uint8_t* symbols, uint8_t* data, uint32_t frame_length)
+{
+  srsran_viterbi_t* q = o;
+
+  if (frame_length > q->framebits) {
+    ERROR("Initialized decoder for max frame length %d bits", q->framebits);
+    return -1;
+  }
+
+  uint32_t len = q->tail_biting ? 3 * frame_length : 3 * (frame_length + q->K - 1);
+  for (uint32_t i = 0; i < len; i++) {
+    q->symbols_us[i] = (uint16_t)symbols[i] * 257;
+  }
+
+  return q->decode_s(q, q->symbols_us, data, frame_length);
+}
+#endif
+
 #ifdef LV_HAVE_AVX2
 int decode37_avx2_16bit(void* o, uint16_t* symbols, uint8_t* data, uint32_t frame_length)
 {
@@ -217,6 +241,92 @@ void free37_avx2(void* o)
 
 #endif
 
+#ifdef SRSRAN_AVX512_KERNELS
+int decode37_avx512(void* o, uint16_t* symbols, uint8_t* data, uint32_t frame_length)
+{
+  srsran_viterbi_t* q = o;
+
+  uint32_t best_state;
+
+  if (frame_length > q->framebits) {
+    ERROR("Initialized decoder for max frame length %d bits", q->framebits);
+    return -1;
+  }
+
+  /* Initialize Viterbi decoder */
+  init_viterbi37_avx512(q->ptr, q->tail_biting ? -1 : 0);
+
+  /* Decode block */
+  if (q->tail_biting) {
+    for (int i = 0; i < TB_ITER; i++) {
+      memcpy(&q->tmp_s[i * 3 * frame_length], symbols, 3 * frame_length * sizeof(uint16_t));
+    }
+    update_viterbi37_blk_avx512(q->ptr, q->tmp_s, TB_ITER * frame_length, &best_state);
+    chainback_viterbi37_avx512(q->ptr, q->tmp, TB_ITER * frame_length, best_state);
+    memcpy(data, &q->tmp[((int)(TB_ITER / 2)) * frame_length], frame_length * sizeof(uint8_t));
+  } else {
+    update_viterbi37_blk_avx512(q->ptr, symbols, frame_length + q->K - 1, NULL);
+    chainback_viterbi37_avx512(q->ptr, data, frame_length, 0);
+  }
+
+  return q->framebits;
+}
+
+/* Decodes up to VITERBI37_AVX512_NOF_LANES codewords, each one in a lane of the multi-codeword decoder */
+static int
+decode37_avx512_multi(srsran_viterbi_t* q, uint16_t** symbols, uint8_t** data, uint32_t nof_cw, uint32_t frame_length)
+{
+  uint32_t best_state[VITERBI37_AVX512_NOF_LANES];
+  uint32_t nof_syms = q->tail_biting ? 3 * frame_length : 3 * (frame_length + q->K - 1);
+
+  /* Initialize Viterbi decoder */
+  init_viterbi37_avx512_multi(q->ptr_multi, q->tail_biting ? -1 : 0);
+  for (uint32_t i = 0; i < nof_cw; i++) {
+    load_viterbi37_avx512_multi(q->ptr_multi, i, symbols[i], nof_syms);
+  }
+
+  /* Decode block, the symbols are repeated TB_ITER times for tail biting */
+  if (q->tail_biting) {
+    update_viterbi37_blk_avx512_multi(q->ptr_multi, frame_length, TB_ITER * frame_length, best_state);
+    chainback_viterbi37_avx512_multi(q->ptr_multi,
+                                     data,
+                                     nof_cw,
+                                     ((int)(TB_ITER / 2)) * frame_length,
+                                     frame_length,
+                                     TB_ITER * frame_length,
+                                     best_state);
+  } else {
+    update_viterbi37_blk_avx512_multi(q->ptr_multi, frame_length + q->K - 1, frame_length + q->K - 1, NULL);
+    chainback_viterbi37_avx512_multi(q->ptr_multi, data, nof_cw, 0, frame_length, frame_length, NULL);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void free37_avx512(void* o)
+{
+  srsran_viterbi_t* q = o;
+
+  if (q->symbols_uc) {
+    free(q->symbols_uc);
+  }
+  if (q->symbols_us) {
+    free(q->symbols_us);
+  }
+  if (q->tmp) {
+    free(q->tmp);
+  }
+  if (q->tmp_s) {
+    free(q->tmp_s);
+  }
+  if (q->symbols_multi) {
+    free(q->symbols_multi);
+  }
+  delete_viterbi37_avx512(q->ptr);
+  delete_viterbi37_avx512_multi(q->ptr_multi);
+}
+#endif
+
 #ifdef HAVE_NEON
 int decode37_neon(void* o, uint8_t* symbols, uint8_t* data, uint32_t frame_length)
 {
@@ -439,6 +549,7 @@ int init37_avx2_16bit(srsran_viterbi_t* q, int poly[3], uint32_t framebits, bool
   q->gain_quant_s = 4;
   q->gain_quant   = DEFAULT_GAIN_16;
   q->tail_biting  = tail_biting;
+  q->decode       = decode37_uc_16bit;
   q->decode_s     = decode37_avx2_16bit;
   q->free         = free37_avx2_16bit;
   q->decode_f     = NULL;
@@ -471,6 +582,59 @@ int init37_avx2_16bit(srsran_viterbi_t* q, int poly[3], uint32_t framebits, bool
 
 #endif
 
+#ifdef SRSRAN_AVX512_KERNELS
+int init37_avx512(srsran_viterbi_t* q, int poly[3], uint32_t framebits, bool tail_biting)
+{
+  q->K            = 7;
+  q->R            = 3;
+  q->framebits    = framebits;
+  q->gain_quant_s = 4;
+  q->gain_quant   = DEFAULT_GAIN_16;
+  q->tail_biting  = tail_biting;
+  q->decode       = decode37_uc_16bit;
+  q->decode_s     = decode37_avx512;
+  q->free         = free37_avx512;
+  q->decode_f     = NULL;
+  q->symbols_uc   = srsran_vec_u8_malloc(3 * (q->framebits + q->K - 1));
+  q->symbols_us   = srsran_vec_u16_malloc(3 * (q->framebits + q->K - 1));
+  if (!q->symbols_uc || !q->symbols_us) {
+    perror("malloc");
+    srsran_viterbi_free(q);
+    return -1;
+  }
+  if (q->tail_biting) {
+    q->tmp   = srsran_vec_u8_malloc(TB_ITER * 3 * (q->framebits + q->K - 1));
+    q->tmp_s = srsran_vec_u16_malloc(TB_ITER * 3 * (q->framebits + q->K - 1));
+    if (!q->tmp || !q->tmp_s) {
+      perror("malloc");
+      srsran_viterbi_free(q);
+      return -1;
+    }
+  } else {
+    q->tmp = NULL;
+  }
+
+  if ((q->ptr = create_viterbi37_avx512(poly, TB_ITER * framebits)) == NULL) {
+    ERROR("create_viterbi37 failed");
+    srsran_viterbi_free(q);
+    return -1;
+  }
+  q->symbols_multi = srsran_vec_u16_malloc(SRSRAN_VITERBI_MAX_MULTI * 3 * (q->framebits + q->K - 1));
+  if (!q->symbols_multi) {
+    perror("malloc");
+    srsran_viterbi_free(q);
+    return -1;
+  }
+  if ((q->ptr_multi = create_viterbi37_avx512_multi(poly, TB_ITER * framebits, 3 * (framebits + q->K - 1))) == NULL) {
+    ERROR("create_viterbi37 failed");
+    srsran_viterbi_free(q);
+    return -1;
+  }
+
+  return 0;
+}
+#endif
+
 void srsran_viterbi_set_gain_quant(srsran_viterbi_t* q, float gain_quant)
 {
   q->gain_quant = gain_quant;
@@ -492,7 +656,12 @@ int srsran_viterbi_init(srsran_viterbi_t*     q,
     case SRSRAN_VITERBI_37:
 #ifdef LV_HAVE_SSE
 
-#ifdef LV_HAVE_AVX2
+#ifdef SRSRAN_AVX512_KERNELS
+      if (srsran_cpu_has_avx512()) {
+        return init37_avx512(q, poly, max_frame_length, tail_bitting);
+      }
+#endif
+#if defined(LV_HAVE_AVX2)
 #ifdef VITERBI_16
       return init37_avx2_16bit(q, poly, max_frame_length, tail_bitting);
 #else
@@ -514,6 +683,32 @@ int srsran_viterbi_init(srsran_viterbi_t*     q,
   }
 }
 
+#ifdef SRSRAN_AVX512_KERNELS
+int srsran_viterbi_init_avx512(srsran_viterbi_t*     q,
+                               srsran_viterbi_type_t type,
+                               int                   poly[3],
+                               uint32_t              max_frame_length,
+                               bool                  tail_bitting)
+{
+  bzero(q, sizeof(srsran_viterbi_t));
+  if (!srsran_cpu_has_avx512()) {
+    ERROR("The CPU does not support the AVX512 decoder");
+    return -1;
+  }
+  return init37_avx512(q, poly, max_frame_length, tail_bitting);
+}
+#endif
+
+int srsran_viterbi_init_port(srsran_viterbi_t*     q,
+                             srsran_viterbi_type_t type,
+                             int                   poly[3],
+                             uint32_t              max_frame_length,
+                             bool                  tail_bitting)
+{
+  bzero(q, sizeof(srsran_viterbi_t));
+  return init37(q, poly, max_frame_length, tail_bitting);
+}
+
 #ifdef LV_HAVE_SSE
 int srsran_viterbi_init_sse(srsran_viterbi_t*     q,
                             srsran_viterbi_type_t type,
@@ -534,6 +729,16 @@ int srsran_viterbi_init_avx2(srsran_viterbi_t*     q,
 {
   return init37_avx2(q, poly, max_frame_length, tail_bitting);
 }
+
+int srsran_viterbi_init_avx2_16bit(srsran_viterbi_t*     q,
+                                   srsran_viterbi_type_t type,
+                                   int                   poly[3],
+                                   uint32_t              max_frame_length,
+                                   bool                  tail_bitting)
+{
+  bzero(q, sizeof(srsran_viterbi_t));
+  return init37_avx2_16bit(q, poly, max_frame_length, tail_bitting);
+}
 #endif
 
 void srsran_viterbi_free(srsran_viterbi_t* q)
@@ -544,6 +749,17 @@ void srsran_viterbi_free(srsran_viterbi_t* q)
   bzero(q, sizeof(srsran_viterbi_t));
 }
 
+/* Maximum absolute value of the symbols, used for scaling them before quantization */
+static float viterbi_max_abs(const float* symbols, uint32_t len)
+{
+  float    max   = 1e-9;
+  uint32_t max_i = srsran_vec_max_abs_fi(symbols, len);
+  if (max_i < len && isnormal(symbols[max_i])) {
+    max = fabsf(symbols[max_i]);
+  }
+  return max;
+}
+
 /* symbols are real-valued */
 int srsran_viterbi_decode_f(srsran_viterbi_t* q, float* symbols, uint8_t* data, uint32_t frame_length)
 {
@@ -558,23 +774,59 @@ int srsran_viterbi_decode_f(srsran_viterbi_t* q, float* symbols, uint8_t* data,
     len = 3 * (frame_length + q->K - 1);
   }
   if (!q->decode_f) {
-    float    max   = 1e-9;
-    uint32_t max_i = srsran_vec_max_abs_fi(symbols, len);
-    if (max_i < len && isnormal(symbols[max_i])) {
-      max = fabsf(symbols[max_i]);
+    // The symbols are quantized for the native width of the decoder, only the 16-bit decoders have decode_s
+    float max = viterbi_max_abs(symbols, len);
+    if (q->decode_s) {
+      srsran_vec_quant_fus(symbols, q->symbols_us, q->gain_quant / max, 32767.5, 65535, len);
+      return srsran_viterbi_decode_us(q, q->symbols_us, data, frame_length);
     }
-#ifdef VITERBI_16
-    srsran_vec_quant_fus(symbols, q->symbols_us, q->gain_quant / max, 32767.5, 65535, len);
-    return srsran_viterbi_decode_us(q, q->symbols_us, data, frame_length);
-#else
     srsran_vec_quant_fuc(symbols, q->symbols_uc, q->gain_quant / max, 127.5, 255, len);
     return srsran_viterbi_decode_uc(q, q->symbols_uc, data, frame_length);
-#endif
   } else {
     return q->decode_f(q, symbols, data, frame_length);
   }
 }
 
+/* symbols are real-valued, several codewords of the same length are decoded together if the decoder supports it */
+int srsran_viterbi_decode_f_multi(srsran_viterbi_t* q,
+                                  float*            symbols[SRSRAN_VITERBI_MAX_MULTI],
+                                  uint8_t*          data[SRSRAN_VITERBI_MAX_MULTI],
+                                  uint32_t          nof_cw,
+                                  uint32_t          frame_length)
+{
+  if (q == NULL || symbols == NULL || data == NULL || nof_cw > SRSRAN_VITERBI_MAX_MULTI) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  if (frame_length > q->framebits) {
+    ERROR("Initialized decoder for max frame length %d bits", q->framebits);
+    return SRSRAN_ERROR;
+  }
+
+#ifdef SRSRAN_AVX512_KERNELS
+  // The multi-codeword decoder processes all the lanes regardless of nof_cw, it only pays off for enough codewords
+  if (q->ptr_multi != NULL && nof_cw >= VITERBI_MULTI_MIN_CW) {
+    uint32_t  len = q->tail_biting ? 3 * frame_length : 3 * (frame_length + q->K - 1);
+    uint16_t* symbols_us[SRSRAN_VITERBI_MAX_MULTI];
+
+    // Quantize every codeword with its own scaling, as it is done for a single codeword
+    for (uint32_t i = 0; i < nof_cw; i++) {
+      float max     = viterbi_max_abs(symbols[i], len);
+      symbols_us[i] = &q->symbols_multi[i * len];
+      srsran_vec_quant_fus(symbols[i], symbols_us[i], q->gain_quant / max, 32767.5, 65535, len);
+    }
+    return decode37_avx512_multi(q, symbols_us, data, nof_cw, frame_length);
+  }
+#endif
+
+  // Otherwise, decode the codewords one by one
+  for (uint32_t i = 0; i < nof_cw; i++) {
+    if (srsran_viterbi_decode_f(q, symbols[i], data[i], frame_length) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
 /* symbols are int16 */
 int srsran_viterbi_decode_s(srsran_viterbi_t* q, int16_t* symbols, uint8_t* data, uint32_t frame_length)
 {
@@ -595,15 +847,15 @@ int srsran_viterbi_decode_s(srsran_viterbi_t* q, int16_t* symbols, uint8_t* data
       max = abs(symbols[i]);
     }
   }
-#ifdef VITERBI_16
-  srsran_vec_quant_sus(symbols, q->symbols_us, 1, (float)INT16_MAX, UINT16_MAX, len);
-  return srsran_viterbi_decode_us(q, q->symbols_us, data, frame_length);
-#else
+  if (q->decode_s) {
+    srsran_vec_quant_sus(symbols, q->symbols_us, 1, (float)INT16_MAX, UINT16_MAX, len);
+    return srsran_viterbi_decode_us(q, q->symbols_us, data, frame_length);
+  }
   srsran_vec_quant_suc(symbols, q->symbols_uc, (float)q->gain_quant / max, 127, 255, len);
   return srsran_viterbi_decode_uc(q, q->symbols_uc, data, frame_length);
-#endif
 }
 
+/* Only the 16-bit decoders take 16-bit symbols, the 8-bit decoders refuse them */
 int srsran_viterbi_decode_us(srsran_viterbi_t* q, uint16_t* symbols, uint8_t* data, uint32_t frame_length)
 {
   int ret = SRSRAN_ERROR;
@@ -615,12 +867,15 @@ int srsran_viterbi_decode_us(srsran_viterbi_t* q, uint16_t* symbols, uint8_t* da
   return ret;
 }
 
+/* Every decoder takes 8-bit symbols */
 int srsran_viterbi_decode_uc(srsran_viterbi_t* q, uint8_t* symbols, uint8_t* data, uint32_t frame_length)
 {
   int ret = SRSRAN_ERROR;
 
   if (q && q->decode) {
     ret = q->decode(q, symbols, data, frame_length);
+  } else if (q) {
+    ERROR("The Viterbi decoder does not support 8-bit symbols");
   }
 
   return ret;
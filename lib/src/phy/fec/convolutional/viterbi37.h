@@ -82,4 +82,35 @@ void delete_viterbi37_avx2_16bit(void* p);
 
 int update_viterbi37_blk_avx2_16bit(void* p, uint16_t* syms, uint32_t nbits, uint32_t* best_state);
 
+void* create_viterbi37_avx512(int polys[3], uint32_t len);
+
+int init_viterbi37_avx512(void* p, int starting_state);
+
+int chainback_viterbi37_avx512(void* p, uint8_t* data, uint32_t nbits, uint32_t endstate);
+
+void delete_viterbi37_avx512(void* p);
+
+void update_viterbi37_blk_avx512(void* p, uint16_t* syms, int nbits, uint32_t* best_state);
+
+/* Number of codewords decoded in parallel by the multi-codeword AVX512 decoder */
+#define VITERBI37_AVX512_NOF_LANES 32
+
+void* create_viterbi37_avx512_multi(int polys[3], uint32_t len, uint32_t max_syms);
+
+int init_viterbi37_avx512_multi(void* p, int starting_state);
+
+void load_viterbi37_avx512_multi(void* p, uint32_t lane, const uint16_t* syms, uint32_t nof_syms);
+
+void update_viterbi37_blk_avx512_multi(void* p, uint32_t period, uint32_t nbits, uint32_t* best_state);
+
+int chainback_viterbi37_avx512_multi(void*           p,
+                                     uint8_t**       data,
+                                     uint32_t        nof_lanes,
+                                     uint32_t        first_bit,
+                                     uint32_t        nof_bits,
+                                     uint32_t        nbits,
+                                     const uint32_t* endstate);
+
+void delete_viterbi37_avx512_multi(void* p);
+
 #endif /* SRSRAN_VITERBI37_H_ */
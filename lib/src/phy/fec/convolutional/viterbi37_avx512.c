@@ -0,0 +1,502 @@
+/* Adapted Phil Karn's r=1/3 k=9 viterbi decoder to r=1/3 k=7
+ *
+ * K=15 r=1/6 Viterbi decoder for x86 SSE2
+ * Copyright Mar 2004, Phil Karn, KA9Q
+ * May be used under the terms of the GNU Lesser General Public License (LGPL)
+ */
+
+#include "parity.h"
+#include "viterbi37.h"
+#include <limits.h>
+#include <memory.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#ifdef LV_HAVE_AVX512
+
+#include <immintrin.h>
+
+/*
+ * 16-bit decoder, the 64 path metrics of a single codeword are held in two AVX512 registers
+ */
+
+typedef union {
+  unsigned short c[64];
+  __m512i        v[2];
+} metric_t;
+
+typedef union {
+  uint64_t      w;
+  unsigned char c[8];
+} decision_t;
+
+static union branchtab37 {
+  unsigned short c[32];
+  __m512i        v;
+} Branchtab37_avx512[3];
+
+/* State info for instance of Viterbi decoder */
+struct v37 {
+  metric_t    metrics1;                  /* path metric buffer 1 */
+  metric_t    metrics2;                  /* path metric buffer 2 */
+  decision_t* dp;                        /* Pointer to current decision */
+  metric_t *  old_metrics, *new_metrics; /* Pointers to path metrics, swapped on every bit */
+  decision_t* decisions;                 /* Beginning of decisions for block */
+  uint32_t    len;
+};
+
+static void set_viterbi37_polynomial_avx512(int polys[3])
+{
+  int state;
+  for (state = 0; state < 32; state++) {
+    Branchtab37_avx512[0].c[state] = (polys[0] < 0) ^ parity((2 * state) & polys[0]) ? 65535 : 0;
+    Branchtab37_avx512[1].c[state] = (polys[1] < 0) ^ parity((2 * state) & polys[1]) ? 65535 : 0;
+    Branchtab37_avx512[2].c[state] = (polys[2] < 0) ^ parity((2 * state) & polys[2]) ? 65535 : 0;
+  }
+}
+
+static void clear_v37_avx512(struct v37* vp)
+{
+  bzero(vp->decisions, sizeof(decision_t) * vp->len);
+  vp->dp = NULL;
+  bzero(&vp->metrics1, sizeof(metric_t));
+  bzero(&vp->metrics2, sizeof(metric_t));
+  vp->old_metrics = NULL;
+  vp->new_metrics = NULL;
+}
+
+/* Initialize Viterbi decoder for start of new frame */
+int init_viterbi37_avx512(void* p, int starting_state)
+{
+  struct v37* vp = p;
+  uint32_t    i;
+
+  for (i = 0; i < 64; i++)
+    vp->metrics1.c[i] = 63;
+
+  clear_v37_avx512(vp);
+  vp->old_metrics = &vp->metrics1;
+  vp->new_metrics = &vp->metrics2;
+  vp->dp          = vp->decisions;
+  if (starting_state != -1) {
+    vp->old_metrics->c[starting_state & 63] = 0; /* Bias known start state */
+  }
+  return 0;
+}
+
+/* Create a new instance of a Viterbi decoder */
+void* create_viterbi37_avx512(int polys[3], uint32_t len)
+{
+  void*       p;
+  struct v37* vp;
+
+  set_viterbi37_polynomial_avx512(polys);
+
+  if (posix_memalign(&p, sizeof(__m512i), sizeof(struct v37)))
+    return NULL;
+
+  vp = (struct v37*)p;
+  if (posix_memalign(&p, sizeof(__m512i), (len + 6) * sizeof(decision_t))) {
+    free(vp);
+    return NULL;
+  }
+  vp->decisions = (decision_t*)p;
+  vp->len       = len + 6;
+  return vp;
+}
+
+/* Viterbi chainback */
+int chainback_viterbi37_avx512(void*    p,
+                               uint8_t* data,  /* Decoded output data */
+                               uint32_t nbits, /* Number of data bits */
+                               uint32_t endstate)
+{ /* Terminal encoder state */
+  struct v37* vp = p;
+
+  if (p == NULL)
+    return -1;
+
+  decision_t* d = (decision_t*)vp->decisions;
+
+  /* Make room beyond the end of the encoder register so we can
+   * accumulate a full byte of decoded data
+   */
+  endstate %= 64;
+  endstate <<= 2;
+
+  d += 6; /* Look past tail */
+  while (nbits--) {
+    int k;
+
+    k           = (d[nbits].w >> (endstate >> 2)) & 1;
+    endstate    = (endstate >> 1) | (k << 7);
+    data[nbits] = k;
+  }
+  return 0;
+}
+
+/* Delete instance of a Viterbi decoder */
+void delete_viterbi37_avx512(void* p)
+{
+  struct v37* vp = p;
+
+  if (vp != NULL) {
+    free(vp->decisions);
+    free(vp);
+  }
+}
+
+/* Spreads the 32 bits of x over the even bits of the result */
+static inline uint64_t spread_bits(uint32_t x)
+{
+  uint64_t v = x;
+  v          = (v | (v << 16)) & 0x0000FFFF0000FFFFULL;
+  v          = (v | (v << 8)) & 0x00FF00FF00FF00FFULL;
+  v          = (v | (v << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  v          = (v | (v << 2)) & 0x3333333333333333ULL;
+  v          = (v | (v << 1)) & 0x5555555555555555ULL;
+  return v;
+}
+
+/* Interleaving indexes for storing the survivors of the states 2i and 2i+1 contiguously */
+static const unsigned short interleave_lo[32] = {0,  32, 1,  33, 2,  34, 3,  35, 4,  36, 5,  37, 6,  38, 7,  39,
+                                                 8,  40, 9,  41, 10, 42, 11, 43, 12, 44, 13, 45, 14, 46, 15, 47};
+static const unsigned short interleave_hi[32] = {16, 48, 17, 49, 18, 50, 19, 51, 20, 52, 21, 53, 22, 54, 23, 55,
+                                                 24, 56, 25, 57, 26, 58, 27, 59, 28, 60, 29, 61, 30, 62, 31, 63};
+
+void update_viterbi37_blk_avx512(void* p, unsigned short* syms, int nbits, uint32_t* best_state)
+{
+  struct v37* vp = p;
+  decision_t* d;
+
+  if (p == NULL)
+    return;
+
+  d = (decision_t*)vp->dp;
+
+  const __m512i idx_lo = _mm512_loadu_si512(interleave_lo);
+  const __m512i idx_hi = _mm512_loadu_si512(interleave_hi);
+  const __m512i zero   = _mm512_setzero_si512();
+  const __m512i max    = _mm512_set1_epi16(8191);
+
+  while (nbits--) {
+    __m512i   sym0v, sym1v, sym2v, metric, m_metric, m0, m1, m2, m3, survivor0, survivor1;
+    __mmask32 decision0, decision1;
+    void*     tmp;
+
+    /* Splat the 0th symbol across sym0v, the 1st symbol across sym1v, etc */
+    sym0v = _mm512_set1_epi16(syms[0]);
+    sym1v = _mm512_set1_epi16(syms[1]);
+    sym2v = _mm512_set1_epi16(syms[2]);
+    syms += 3;
+
+    /* Form branch metrics */
+    m0     = _mm512_avg_epu16(_mm512_xor_si512(Branchtab37_avx512[0].v, sym0v),
+                          _mm512_xor_si512(Branchtab37_avx512[1].v, sym1v));
+    metric = _mm512_avg_epu16(_mm512_xor_si512(Branchtab37_avx512[2].v, sym2v), m0);
+
+    metric   = _mm512_srli_epi16(metric, 3);
+    m_metric = _mm512_sub_epi16(max, metric);
+
+    /* Add branch metrics to path metrics */
+    m0 = _mm512_add_epi16(vp->old_metrics->v[0], metric);
+    m3 = _mm512_add_epi16(vp->old_metrics->v[1], metric);
+    m1 = _mm512_add_epi16(vp->old_metrics->v[1], m_metric);
+    m2 = _mm512_add_epi16(vp->old_metrics->v[0], m_metric);
+
+    /* Compare and select, using modulo arithmetic */
+    decision0 = _mm512_cmpgt_epi16_mask(_mm512_sub_epi16(m0, m1), zero);
+    decision1 = _mm512_cmpgt_epi16_mask(_mm512_sub_epi16(m2, m3), zero);
+    survivor0 = _mm512_mask_blend_epi16(decision0, m0, m1);
+    survivor1 = _mm512_mask_blend_epi16(decision1, m2, m3);
+
+    /* Interleave the decisions, so the bit n corresponds to the state n */
+    d->w = spread_bits(decision0) | (spread_bits(decision1) << 1);
+
+    /* Store surviving metrics */
+    vp->new_metrics->v[0] = _mm512_permutex2var_epi16(survivor0, idx_lo, survivor1);
+    vp->new_metrics->v[1] = _mm512_permutex2var_epi16(survivor0, idx_hi, survivor1);
+
+    // See if we need to normalize
+    if (vp->new_metrics->c[0] > 12288) {
+      __m512i min512 = _mm512_min_epu16(vp->new_metrics->v[0], vp->new_metrics->v[1]);
+      __m256i min256 = _mm256_min_epu16(_mm512_castsi512_si256(min512), _mm512_extracti64x4_epi64(min512, 1));
+      __m128i min128 = _mm_min_epu16(_mm256_castsi256_si128(min256), _mm256_extracti128_si256(min256, 1));
+
+      __m512i adjustv = _mm512_set1_epi16(_mm_extract_epi16(_mm_minpos_epu16(min128), 0));
+
+      /* We cannot use a saturated subtract, because we often have to adjust by more than SHRT_MAX
+       * This is okay since it can't overflow anyway
+       */
+      vp->new_metrics->v[0] = _mm512_sub_epi16(vp->new_metrics->v[0], adjustv);
+      vp->new_metrics->v[1] = _mm512_sub_epi16(vp->new_metrics->v[1], adjustv);
+    }
+
+    d++;
+    /* Swap pointers to old and new metrics */
+    tmp             = vp->old_metrics;
+    vp->old_metrics = vp->new_metrics;
+    vp->new_metrics = tmp;
+  }
+
+  if (best_state) {
+    uint32_t i, bst = 0;
+
+    uint16_t minmetric = UINT16_MAX;
+    for (i = 0; i < 64; i++) {
+      if (vp->old_metrics->c[i] <= minmetric) {
+        bst       = i;
+        minmetric = vp->old_metrics->c[i];
+      }
+    }
+    *best_state = bst;
+  }
+
+  vp->dp = d;
+}
+
+/*
+ * Multi-codeword 16-bit decoder, every lane of the AVX512 registers decodes a different codeword. Each one of the 64
+ * path metrics is held in a register, so no shuffling is required for the butterflies.
+ */
+
+struct v37_multi {
+  __m512i         metrics1[64];    /* path metric buffer 1 */
+  __m512i         metrics2[64];    /* path metric buffer 2 */
+  uint32_t*       decisions;       /* 64 decision masks per bit, the bit n of the mask s is the lane n of the state s */
+  unsigned short* syms;            /* Interleaved symbols, the symbol i of the lane n is at i * nof_lanes + n */
+  uint32_t*       bits;            /* Decoded bits, the bit n of the word i is the bit i of the lane n */
+  uint32_t        len;             /* Number of decision bits */
+  uint32_t        max_syms;        /* Maximum number of symbols per codeword */
+  uint8_t         branch_code[32]; /* Generator outputs of each butterfly */
+};
+
+/* Create a new instance of a multi-codeword Viterbi decoder */
+void* create_viterbi37_avx512_multi(int polys[3], uint32_t len, uint32_t max_syms)
+{
+  void*             p;
+  struct v37_multi* vp;
+
+  if (posix_memalign(&p, sizeof(__m512i), sizeof(struct v37_multi)))
+    return NULL;
+
+  vp = (struct v37_multi*)p;
+  if (posix_memalign(&p, sizeof(__m512i), (len + 6) * 64 * sizeof(uint32_t))) {
+    free(vp);
+    return NULL;
+  }
+  vp->decisions = (uint32_t*)p;
+  if (posix_memalign(&p, sizeof(__m512i), max_syms * VITERBI37_AVX512_NOF_LANES * sizeof(unsigned short))) {
+    free(vp->decisions);
+    free(vp);
+    return NULL;
+  }
+  vp->syms = (unsigned short*)p;
+  if (posix_memalign(&p, sizeof(__m512i), (len + 6) * sizeof(uint32_t))) {
+    free(vp->syms);
+    free(vp->decisions);
+    free(vp);
+    return NULL;
+  }
+  vp->bits     = (uint32_t*)p;
+  vp->len      = len + 6;
+  vp->max_syms = max_syms;
+
+  for (int state = 0; state < 32; state++) {
+    vp->branch_code[state] = (uint8_t)((((polys[0] < 0) ^ parity((2 * state) & polys[0])) << 0) |
+                                       (((polys[1] < 0) ^ parity((2 * state) & polys[1])) << 1) |
+                                       (((polys[2] < 0) ^ parity((2 * state) & polys[2])) << 2));
+  }
+
+  return vp;
+}
+
+/* Initialize the multi-codeword Viterbi decoder for a new set of frames */
+int init_viterbi37_avx512_multi(void* p, int starting_state)
+{
+  struct v37_multi* vp = p;
+
+  if (p == NULL)
+    return -1;
+
+  /* The single codeword decoders clear the path metrics after biasing the start state, so every state starts with the
+   * same metric. Do the same to produce identical decisions.
+   */
+  (void)starting_state;
+  for (uint32_t i = 0; i < 64; i++) {
+    vp->metrics1[i] = _mm512_setzero_si512();
+  }
+  bzero(vp->decisions, vp->len * 64 * sizeof(uint32_t));
+  bzero(vp->syms, vp->max_syms * VITERBI37_AVX512_NOF_LANES * sizeof(unsigned short));
+
+  return 0;
+}
+
+/* Loads the symbols of the codeword decoded in the given lane */
+void load_viterbi37_avx512_multi(void* p, uint32_t lane, const unsigned short* syms, uint32_t nof_syms)
+{
+  struct v37_multi* vp = p;
+
+  if (p == NULL || lane >= VITERBI37_AVX512_NOF_LANES || nof_syms > vp->max_syms)
+    return;
+
+  for (uint32_t i = 0; i < nof_syms; i++) {
+    vp->syms[i * VITERBI37_AVX512_NOF_LANES + lane] = syms[i];
+  }
+}
+
+void update_viterbi37_blk_avx512_multi(void* p, uint32_t period, uint32_t nbits, uint32_t* best_state)
+{
+  struct v37_multi* vp = p;
+
+  if (p == NULL || period == 0 || nbits + 6 > vp->len)
+    return;
+
+  const __m512i zero    = _mm512_setzero_si512();
+  const __m512i ones    = _mm512_set1_epi16(-1);
+  const __m512i max     = _mm512_set1_epi16(8191);
+  const __m512i norm_th = _mm512_set1_epi16(12288);
+
+  __m512i* old_metrics = vp->metrics1;
+  __m512i* new_metrics = vp->metrics2;
+
+  for (uint32_t s = 0; s < nbits; s++) {
+    /* The symbols are read cyclically every period bits, which repeats the codeword for tail biting */
+    const unsigned short* syms = &vp->syms[(s % period) * 3 * VITERBI37_AVX512_NOF_LANES];
+    uint32_t*             d    = &vp->decisions[s * 64];
+
+    __m512i sym0v = _mm512_load_si512(&syms[0]);
+    __m512i sym1v = _mm512_load_si512(&syms[VITERBI37_AVX512_NOF_LANES]);
+    __m512i sym2v = _mm512_load_si512(&syms[2 * VITERBI37_AVX512_NOF_LANES]);
+
+    /* Form branch metrics for every combination of the generator outputs */
+    __m512i metric[8], m_metric[8];
+    for (uint32_t c = 0; c < 8; c++) {
+      __m512i m0  = _mm512_avg_epu16((c & 1) ? _mm512_xor_si512(ones, sym0v) : sym0v,
+                                     (c & 2) ? _mm512_xor_si512(ones, sym1v) : sym1v);
+      metric[c]   = _mm512_avg_epu16((c & 4) ? _mm512_xor_si512(ones, sym2v) : sym2v, m0);
+      metric[c]   = _mm512_srli_epi16(metric[c], 3);
+      m_metric[c] = _mm512_sub_epi16(max, metric[c]);
+    }
+
+    for (uint32_t i = 0; i < 32; i++) {
+      uint32_t c = vp->branch_code[i];
+
+      /* Add branch metrics to path metrics */
+      __m512i m0 = _mm512_add_epi16(old_metrics[i], metric[c]);
+      __m512i m3 = _mm512_add_epi16(old_metrics[32 + i], metric[c]);
+      __m512i m1 = _mm512_add_epi16(old_metrics[32 + i], m_metric[c]);
+      __m512i m2 = _mm512_add_epi16(old_metrics[i], m_metric[c]);
+
+      /* Compare and select, using modulo arithmetic */
+      __mmask32 decision0 = _mm512_cmpgt_epi16_mask(_mm512_sub_epi16(m0, m1), zero);
+      __mmask32 decision1 = _mm512_cmpgt_epi16_mask(_mm512_sub_epi16(m2, m3), zero);
+
+      new_metrics[2 * i]     = _mm512_mask_blend_epi16(decision0, m0, m1);
+      new_metrics[2 * i + 1] = _mm512_mask_blend_epi16(decision1, m2, m3);
+      d[2 * i]               = decision0;
+      d[2 * i + 1]           = decision1;
+    }
+
+    /* Normalize only the lanes that need it, as if each codeword was decoded on its own */
+    __mmask32 norm = _mm512_cmpgt_epu16_mask(new_metrics[0], norm_th);
+    if (norm) {
+      __m512i adjustv = new_metrics[0];
+      for (uint32_t i = 1; i < 64; i++) {
+        adjustv = _mm512_min_epu16(adjustv, new_metrics[i]);
+      }
+      for (uint32_t i = 0; i < 64; i++) {
+        new_metrics[i] = _mm512_mask_sub_epi16(new_metrics[i], norm, new_metrics[i], adjustv);
+      }
+    }
+
+    /* Swap pointers to old and new metrics */
+    __m512i* tmp = old_metrics;
+    old_metrics  = new_metrics;
+    new_metrics  = tmp;
+  }
+
+  if (best_state) {
+    /* Find the last state with the minimum metric of each lane */
+    __m512i minv = _mm512_set1_epi16(-1);
+    __m512i bstv = _mm512_setzero_si512();
+    for (uint32_t i = 0; i < 64; i++) {
+      __mmask32 le = _mm512_cmple_epu16_mask(old_metrics[i], minv);
+      minv         = _mm512_mask_mov_epi16(minv, le, old_metrics[i]);
+      bstv         = _mm512_mask_mov_epi16(bstv, le, _mm512_set1_epi16((short)i));
+    }
+
+    unsigned short bst[VITERBI37_AVX512_NOF_LANES];
+    _mm512_storeu_si512(bst, bstv);
+    for (uint32_t i = 0; i < VITERBI37_AVX512_NOF_LANES; i++) {
+      best_state[i] = bst[i];
+    }
+  }
+}
+
+/* Viterbi chainback of all the lanes at once. The bits [first_bit, first_bit + nof_bits) of the lane n are written in
+ * data[n], for the lanes [0, nof_lanes). A NULL endstate means all the lanes end in the state 0.
+ */
+int chainback_viterbi37_avx512_multi(void*           p,
+                                     uint8_t**       data,
+                                     uint32_t        nof_lanes,
+                                     uint32_t        first_bit,
+                                     uint32_t        nof_bits,
+                                     uint32_t        nbits,
+                                     const uint32_t* endstate)
+{
+  struct v37_multi* vp = p;
+
+  if (p == NULL || nof_lanes > VITERBI37_AVX512_NOF_LANES || first_bit + nof_bits > nbits || nbits + 6 > vp->len)
+    return -1;
+
+  const uint32_t* d = &vp->decisions[6 * 64]; /* Look past tail */
+
+  /* The state register of every lane, with room for two more bits as in the single codeword chainback */
+  __m512i state[2] = {_mm512_setzero_si512(), _mm512_setzero_si512()};
+  if (endstate != NULL) {
+    state[0] = _mm512_slli_epi32(_mm512_and_si512(_mm512_loadu_si512(&endstate[0]), _mm512_set1_epi32(63)), 2);
+    state[1] = _mm512_slli_epi32(_mm512_and_si512(_mm512_loadu_si512(&endstate[16]), _mm512_set1_epi32(63)), 2);
+  }
+  const __m512i lane[2] = {_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+                           _mm512_setr_epi32(16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31)};
+  const __m512i one     = _mm512_set1_epi32(1);
+
+  while (nbits--) {
+    uint32_t bits = 0;
+    for (uint32_t i = 0; i < 2; i++) {
+      /* Gather the decisions of the current state of each lane and select the bit of the lane */
+      __m512i dec = _mm512_i32gather_epi32(_mm512_srli_epi32(state[i], 2), &d[nbits * 64], sizeof(uint32_t));
+      __m512i k   = _mm512_and_si512(_mm512_srlv_epi32(dec, lane[i]), one);
+
+      state[i] = _mm512_or_si512(_mm512_srli_epi32(state[i], 1), _mm512_slli_epi32(k, 7));
+      bits |= (uint32_t)_mm512_test_epi32_mask(k, k) << (16 * i);
+    }
+    vp->bits[nbits] = bits;
+  }
+
+  for (uint32_t n = 0; n < nof_lanes; n++) {
+    for (uint32_t i = 0; i < nof_bits; i++) {
+      data[n][i] = (vp->bits[first_bit + i] >> n) & 1;
+    }
+  }
+  return 0;
+}
+
+/* Delete instance of a multi-codeword Viterbi decoder */
+void delete_viterbi37_avx512_multi(void* p)
+{
+  struct v37_multi* vp = p;
+
+  if (vp != NULL) {
+    free(vp->decisions);
+    free(vp->syms);
+    free(vp->bits);
+    free(vp);
+  }
+}
+
+#endif // LV_HAVE_AVX512
@@ -47,6 +47,114 @@ static void gen_crc_table(srsran_crc_t* h)
   }
 }
 
+/*
+ * Carry-less multiplication CRC
+ * -----------------------------
+ *
+ * The message is split in 128 bit blocks where the register MSB holds the first bit. A block A = A_hi x^64 + A_lo
+ * followed by D more bits is congruent, modulo the generator polynomial P, to A_hi (x^(D+64) mod P) + A_lo (x^D mod P),
+ * which fits in 96 bits. Folding every block into the next one leaves a 128 bit remainder with the same checksum as the
+ * whole message, the remainder is finished with the look-up table.
+ */
+#if defined(LV_HAVE_SSE) && defined(LV_HAVE_PCLMUL)
+#define CRC_HAVE_CLMUL 1
+#endif
+
+/**
+ * Minimum number of bytes for using carry-less multiplication, the look-up table is faster for shorter messages
+ */
+#define CRC_CLMUL_MIN_BYTES 32
+
+static uint64_t crc_xpow_mod(const srsran_crc_t* h, uint32_t n)
+{
+  uint64_t r = 1;
+  for (uint32_t i = 0; i < n; i++) {
+    r <<= 1U;
+    if (r & ((uint64_t)1 << (uint32_t)h->order)) {
+      r = (r ^ (uint64_t)h->polynom) & h->crcmask;
+    }
+  }
+  return r;
+}
+
+#ifdef CRC_HAVE_CLMUL
+static inline __m128i crc_clmul_bswap(__m128i v)
+{
+  return _mm_shuffle_epi8(v, _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+// Multiplies the low half by k[0] = x^D mod P and the high half by k[1] = x^(D+64) mod P
+static inline __m128i crc_clmul_fold(__m128i acc, __m128i k)
+{
+  return _mm_xor_si128(_mm_clmulepi64_si128(acc, k, 0x00), _mm_clmulepi64_si128(acc, k, 0x11));
+}
+
+// Packs 128 unpacked bits, one per byte, into a block
+static inline __m128i crc_clmul_load_unpacked(const uint8_t* bits)
+{
+  const __m128i reverse = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+  uint16_t      packed[8];
+
+  for (uint32_t i = 0; i < 8; i++) {
+    __m128i mask = _mm_cmpgt_epi8(_mm_loadu_si128((__m128i*)(bits + 16 * i)), _mm_setzero_si128());
+    packed[i]    = (uint16_t)_mm_movemask_epi8(_mm_shuffle_epi8(mask, reverse));
+  }
+
+  return crc_clmul_bswap(_mm_loadu_si128((__m128i*)packed));
+}
+
+static inline __m128i crc_clmul_load(const uint8_t* data, uint32_t block, bool unpacked)
+{
+  if (unpacked) {
+    return crc_clmul_load_unpacked(data + 128 * block);
+  }
+  return crc_clmul_bswap(_mm_loadu_si128((__m128i*)(data + 16 * block)));
+}
+
+/**
+ * Feeds nof_blocks 128 bit blocks into the CRC register
+ */
+static inline void crc_clmul_run(srsran_crc_t* h, const uint8_t* data, uint32_t nof_blocks, bool unpacked)
+{
+  const __m128i k128 = _mm_set_epi64x((long long)h->fold_128[1], (long long)h->fold_128[0]);
+  const __m128i k512 = _mm_set_epi64x((long long)h->fold_512[1], (long long)h->fold_512[0]);
+
+  // Starting from the register value R is the same as starting from zero with R added to the first bits
+  uint64_t reg  = (h->crcinit & h->crcmask) << (64U - (uint32_t)h->order);
+  __m128i  acc0 = _mm_xor_si128(crc_clmul_load(data, 0, unpacked), _mm_set_epi64x((long long)reg, 0));
+
+  uint32_t i = 1;
+  if (nof_blocks >= 8) {
+    // Four independent accumulators hide the multiplication latency
+    __m128i acc1 = crc_clmul_load(data, 1, unpacked);
+    __m128i acc2 = crc_clmul_load(data, 2, unpacked);
+    __m128i acc3 = crc_clmul_load(data, 3, unpacked);
+    for (i = 4; i + 4 <= nof_blocks; i += 4) {
+      acc0 = _mm_xor_si128(crc_clmul_fold(acc0, k512), crc_clmul_load(data, i, unpacked));
+      acc1 = _mm_xor_si128(crc_clmul_fold(acc1, k512), crc_clmul_load(data, i + 1, unpacked));
+      acc2 = _mm_xor_si128(crc_clmul_fold(acc2, k512), crc_clmul_load(data, i + 2, unpacked));
+      acc3 = _mm_xor_si128(crc_clmul_fold(acc3, k512), crc_clmul_load(data, i + 3, unpacked));
+    }
+
+    acc0 = _mm_xor_si128(crc_clmul_fold(acc0, k128), acc1);
+    acc0 = _mm_xor_si128(crc_clmul_fold(acc0, k128), acc2);
+    acc0 = _mm_xor_si128(crc_clmul_fold(acc0, k128), acc3);
+  }
+
+  for (; i < nof_blocks; i++) {
+    acc0 = _mm_xor_si128(crc_clmul_fold(acc0, k128), crc_clmul_load(data, i, unpacked));
+  }
+
+  // Finish the remainder with the table
+  uint8_t remainder[16];
+  _mm_storeu_si128((__m128i*)remainder, crc_clmul_bswap(acc0));
+  h->crcinit = 0;
+  for (uint32_t j = 0; j < 16; j++) {
+    srsran_crc_checksum_put_byte(h, remainder[j]);
+  }
+}
+#endif // CRC_HAVE_CLMUL
+
 uint64_t reversecrcbit(uint32_t crc, int nbits, srsran_crc_t* h)
 {
   uint64_t m, rmask = 0x1;
@@ -89,6 +197,12 @@ int srsran_crc_init(srsran_crc_t* h, uint32_t crc_poly, int crc_order)
   // generate lookup table
   gen_crc_table(h);
 
+  // Folding constants for the carry-less multiplication
+  h->fold_128[0] = crc_xpow_mod(h, 128);
+  h->fold_128[1] = crc_xpow_mod(h, 128 + 64);
+  h->fold_512[0] = crc_xpow_mod(h, 512);
+  h->fold_512[1] = crc_xpow_mod(h, 512 + 64);
+
   return 0;
 }
 
@@ -107,8 +221,17 @@ uint32_t srsran_crc_checksum(srsran_crc_t* h, uint8_t* data, int len)
     a = 1;
   }
 
+  i = 0;
+#ifdef CRC_HAVE_CLMUL
+  if (len8 >= CRC_CLMUL_MIN_BYTES && h->order <= 32) {
+    int nof_blocks = len8 / 16;
+    crc_clmul_run(h, data, (uint32_t)nof_blocks, true);
+    i = nof_blocks * 16;
+  }
+#endif // CRC_HAVE_CLMUL
+
   // Calculate CRC
-  for (i = 0; i < len8 + a; i++) {
+  for (; i < len8 + a; i++) {
     pter = (uint8_t*)(data + 8 * i);
     uint8_t byte;
     if (i == len8) {
@@ -143,18 +266,32 @@ uint32_t srsran_crc_checksum(srsran_crc_t* h, uint8_t* data, int len)
   return crc;
 }
 
+void srsran_crc_checksum_put_bytes(srsran_crc_t* h, const uint8_t* data, uint32_t nof_bytes)
+{
+  uint32_t i = 0;
+
+#ifdef CRC_HAVE_CLMUL
+  if (nof_bytes >= CRC_CLMUL_MIN_BYTES && h->order <= 32) {
+    uint32_t nof_blocks = nof_bytes / 16;
+    crc_clmul_run(h, data, nof_blocks, false);
+    i = nof_blocks * 16;
+  }
+#endif // CRC_HAVE_CLMUL
+
+  for (; i < nof_bytes; i++) {
+    srsran_crc_checksum_put_byte(h, data[i]);
+  }
+}
+
 // len is multiple of 8
 uint32_t srsran_crc_checksum_byte(srsran_crc_t* h, const uint8_t* data, int len)
 {
-  int      i;
   uint32_t crc = 0;
 
   srsran_crc_set_init(h, 0);
 
   // Calculate CRC
-  for (i = 0; i < len / 8; i++) {
-    srsran_crc_checksum_put_byte(h, data[i]);
-  }
+  srsran_crc_checksum_put_bytes(h, data, (uint32_t)(len / 8));
   crc = (uint32_t)srsran_crc_checksum_get(h);
 
   return crc;
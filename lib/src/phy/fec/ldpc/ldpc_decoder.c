@@ -36,6 +36,7 @@
 #include "ldpc_dec_all.h"
 #include "srsran/phy/fec/ldpc/base_graph.h"
 #include "srsran/phy/fec/ldpc/ldpc_decoder.h"
+#include "srsran/phy/utils/cpu.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/vector.h"
 
@@ -432,7 +433,7 @@ static int init_c_avx2long_flood(srsran_ldpc_decoder_t* q)
 
 // AVX512 Declarations
 
-#ifdef LV_HAVE_AVX512
+#ifdef SRSRAN_AVX512_KERNELS
 
 /*! Carries out the actual destruction of the memory allocated to the decoder, 8-bit-LLR case (AVX512 implementation).
  */
@@ -535,7 +536,7 @@ static int init_c_avx512long_flood(srsran_ldpc_decoder_t* q)
   return 0;
 }
 
-#endif // LV_HAVE_AVX512
+#endif // SRSRAN_AVX512_KERNELS
 
 int srsran_ldpc_decoder_init(srsran_ldpc_decoder_t* q, const srsran_ldpc_decoder_args_t* args)
 {
@@ -629,16 +630,24 @@ int srsran_ldpc_decoder_init(srsran_ldpc_decoder_t* q, const srsran_ldpc_decoder
         return init_c_avx2long_flood(q);
       }
 #endif // LV_HAVE_AVX2
-#ifdef LV_HAVE_AVX512
+#ifdef SRSRAN_AVX512_KERNELS
     case SRSRAN_LDPC_DECODER_C_AVX512:
+    case SRSRAN_LDPC_DECODER_C_AVX512_FLOOD:
+      if (!srsran_cpu_has_avx512()) {
+        ERROR("The CPU does not support the AVX512 decoder");
+        free(q->var_indices);
+        free(q->pcm);
+        return -1;
+      }
+      if (type == SRSRAN_LDPC_DECODER_C_AVX512_FLOOD) {
+        return init_c_avx512long_flood(q);
+      }
       if (ls <= SRSRAN_AVX512_B_SIZE) {
         return init_c_avx512(q);
       } else {
         return init_c_avx512long(q);
       }
-    case SRSRAN_LDPC_DECODER_C_AVX512_FLOOD:
-      return init_c_avx512long_flood(q);
-#endif // LV_HAVE_AVX2
+#endif // SRSRAN_AVX512_KERNELS
 
     default:
       ERROR("Unknown decoder.");
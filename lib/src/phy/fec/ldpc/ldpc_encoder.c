@@ -36,6 +36,7 @@
 #include "ldpc_enc_all.h"
 #include "srsran/phy/fec/ldpc/base_graph.h"
 #include "srsran/phy/fec/ldpc/ldpc_encoder.h"
+#include "srsran/phy/utils/cpu.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/vector.h"
 
@@ -320,7 +321,7 @@ static int init_avx2long(srsran_ldpc_encoder_t* q)
 
 #endif
 
-#ifdef LV_HAVE_AVX512
+#ifdef SRSRAN_AVX512_KERNELS
 
 /*! Carries out the actual destruction of the memory allocated to the encoder. */
 static void free_enc_avx512(void* o)
@@ -555,14 +556,19 @@ int srsran_ldpc_encoder_init(srsran_ldpc_encoder_t*     q,
         return init_avx2long(q);
       }
 #endif // LV_HAVE_AVX2
-#ifdef LV_HAVE_AVX512
+#ifdef SRSRAN_AVX512_KERNELS
     case SRSRAN_LDPC_ENCODER_AVX512:
+      if (!srsran_cpu_has_avx512()) {
+        ERROR("The CPU does not support the AVX512 encoder");
+        free(q->pcm);
+        return -1;
+      }
       if (ls <= SRSRAN_AVX512_B_SIZE) {
         return init_avx512(q);
       } else {
         return init_avx512long(q);
       }
-#endif // LV_HAVE_AVX512
+#endif // SRSRAN_AVX512_KERNELS
     default:
       return -1;
   }
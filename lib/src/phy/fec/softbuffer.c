@@ -24,15 +24,218 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <strings.h>
+#include <sys/mman.h>
 
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/phy/fec/softbuffer.h"
 #include "srsran/phy/fec/turbo/turbodecoder_gen.h"
 #include "srsran/phy/phch/ra.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 
 #define MAX_PDSCH_RE(cp) (2 * SRSRAN_CP_NSYMB(cp) * 12)
 
+#define SOFTBUFFER_POOL_CHUNK_SIZE (2UL * 1024UL * 1024UL)
+#define SOFTBUFFER_POOL_ALIGN(X) (((X) + SRSRAN_SIMD_BIT_ALIGN - 1) & ~((size_t)SRSRAN_SIMD_BIT_ALIGN - 1))
+
+uint32_t srsran_softbuffer_llr_nof_bytes(srsran_softbuffer_llr_t llr_format, uint32_t nof_llr)
+{
+  switch (llr_format) {
+    case SRSRAN_SOFTBUFFER_LLR_8BIT:
+      return nof_llr;
+    case SRSRAN_SOFTBUFFER_LLR_4BIT:
+      return (nof_llr + 1) / 2;
+    case SRSRAN_SOFTBUFFER_LLR_16BIT:
+    default:
+      return nof_llr * (uint32_t)sizeof(int16_t);
+  }
+}
+
+int srsran_softbuffer_llr_from_nof_bits(uint32_t nof_bits, srsran_softbuffer_llr_t* llr_format)
+{
+  if (llr_format == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  switch (nof_bits) {
+    case 16:
+      *llr_format = SRSRAN_SOFTBUFFER_LLR_16BIT;
+      break;
+    case 8:
+      *llr_format = SRSRAN_SOFTBUFFER_LLR_8BIT;
+      break;
+    case 4:
+      *llr_format = SRSRAN_SOFTBUFFER_LLR_4BIT;
+      break;
+    default:
+      ERROR("Invalid soft-buffer LLR width %d, valid values are 16, 8 and 4", nof_bits);
+      return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+// Code block slot layout: soft bits followed by the decoded data, each one aligned for SIMD
+static size_t softbuffer_pool_data_offset(const srsran_softbuffer_pool_t* q)
+{
+  return SOFTBUFFER_POOL_ALIGN(srsran_softbuffer_llr_nof_bytes(q->llr_format, q->max_cb_size));
+}
+
+int srsran_softbuffer_pool_init(srsran_softbuffer_pool_t* q,
+                                uint32_t                  max_cb_size,
+                                srsran_softbuffer_llr_t   llr_format,
+                                uint64_t                  max_bytes)
+{
+  if (q == NULL || max_cb_size == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_softbuffer_pool_t, 1);
+
+  q->max_cb_size = max_cb_size;
+  q->llr_format  = llr_format;
+  q->slot_size   = (uint32_t)(softbuffer_pool_data_offset(q) + SOFTBUFFER_POOL_ALIGN(max_cb_size / 8));
+  if (q->slot_size > SOFTBUFFER_POOL_CHUNK_SIZE) {
+    ERROR("Code block size %d does not fit in a softbuffer pool chunk", max_cb_size);
+    return SRSRAN_ERROR;
+  }
+  q->max_chunks = (uint32_t)SRSRAN_MAX((max_bytes + SOFTBUFFER_POOL_CHUNK_SIZE - 1) / SOFTBUFFER_POOL_CHUNK_SIZE, 1);
+
+  uint32_t slots_per_chunk = SOFTBUFFER_POOL_CHUNK_SIZE / q->slot_size;
+  q->chunks                = SRSRAN_MEM_ALLOC(uint8_t*, q->max_chunks);
+  q->chunk_huge            = SRSRAN_MEM_ALLOC(bool, q->max_chunks);
+  q->free_slots            = SRSRAN_MEM_ALLOC(void*, q->max_chunks * slots_per_chunk);
+  if (q->chunks == NULL || q->chunk_huge == NULL || q->free_slots == NULL) {
+    perror("malloc");
+    srsran_softbuffer_pool_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  pthread_mutex_init(&q->mutex, NULL);
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_softbuffer_pool_free(srsran_softbuffer_pool_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+  if (q->chunks) {
+    for (uint32_t i = 0; i < q->nof_chunks; i++) {
+      munmap(q->chunks[i], SOFTBUFFER_POOL_CHUNK_SIZE);
+    }
+    free(q->chunks);
+    pthread_mutex_destroy(&q->mutex);
+  }
+  if (q->chunk_huge) {
+    free(q->chunk_huge);
+  }
+  if (q->free_slots) {
+    free(q->free_slots);
+  }
+  SRSRAN_MEM_ZERO(q, srsran_softbuffer_pool_t, 1);
+}
+
+// Requests a new chunk from the system and adds its slots to the free list. It must be called with the mutex locked.
+static bool softbuffer_pool_grow(srsran_softbuffer_pool_t* q)
+{
+  if (q->nof_chunks >= q->max_chunks) {
+    return false;
+  }
+
+  // Prefer explicit huge pages, a single TLB entry covers the whole chunk. Otherwise, ask for transparent huge pages.
+  bool  huge  = true;
+  void* chunk = MAP_FAILED;
+#ifdef MAP_HUGETLB
+  chunk = mmap(NULL, SOFTBUFFER_POOL_CHUNK_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif /* MAP_HUGETLB */
+  if (chunk == MAP_FAILED) {
+    huge  = false;
+    chunk = mmap(NULL, SOFTBUFFER_POOL_CHUNK_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (chunk == MAP_FAILED) {
+      return false;
+    }
+#ifdef MADV_HUGEPAGE
+    madvise(chunk, SOFTBUFFER_POOL_CHUNK_SIZE, MADV_HUGEPAGE);
+#endif /* MADV_HUGEPAGE */
+  }
+
+  q->chunks[q->nof_chunks]     = chunk;
+  q->chunk_huge[q->nof_chunks] = huge;
+  q->nof_chunks++;
+
+  // Push the slots in reverse order, so they are handed out in address order
+  uint32_t slots_per_chunk = SOFTBUFFER_POOL_CHUNK_SIZE / q->slot_size;
+  for (uint32_t i = 0; i < slots_per_chunk; i++) {
+    q->free_slots[q->nof_free++] = (uint8_t*)chunk + (size_t)(slots_per_chunk - 1 - i) * q->slot_size;
+  }
+  q->nof_slots += slots_per_chunk;
+  return true;
+}
+
+// Attaches a zeroed slot to the first nof_cb code blocks of a softbuffer that do not have one
+static int softbuffer_pool_get(srsran_softbuffer_pool_t* q, srsran_softbuffer_rx_t* sb, uint32_t nof_cb)
+{
+  size_t   data_offset = softbuffer_pool_data_offset(q);
+  uint32_t llr_bytes   = srsran_softbuffer_llr_nof_bytes(q->llr_format, q->max_cb_size);
+
+  for (uint32_t i = 0; i < nof_cb; i++) {
+    if (sb->buffer_f[i] != NULL) {
+      continue;
+    }
+
+    pthread_mutex_lock(&q->mutex);
+    if (q->nof_free == 0 && !softbuffer_pool_grow(q)) {
+      q->nof_failures++;
+      pthread_mutex_unlock(&q->mutex);
+      return SRSRAN_ERROR;
+    }
+    uint8_t* slot = q->free_slots[--q->nof_free];
+    q->max_used   = SRSRAN_MAX(q->max_used, q->nof_slots - q->nof_free);
+    pthread_mutex_unlock(&q->mutex);
+
+    // Zero outside of the lock, the slot belongs to the softbuffer now
+    sb->buffer_f[i] = (int16_t*)slot;
+    sb->data[i]     = slot + data_offset;
+    sb->cb_crc[i]   = false;
+    srsran_vec_u8_zero((uint8_t*)sb->buffer_f[i], llr_bytes);
+    srsran_vec_u8_zero(sb->data[i], q->max_cb_size / 8);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+// Returns the slots of the code blocks from first_cb onwards to the pool
+static void softbuffer_pool_put(srsran_softbuffer_pool_t* q, srsran_softbuffer_rx_t* sb, uint32_t first_cb)
+{
+  pthread_mutex_lock(&q->mutex);
+  for (uint32_t i = first_cb; i < sb->max_cb; i++) {
+    if (sb->buffer_f[i] != NULL) {
+      q->free_slots[q->nof_free++] = sb->buffer_f[i];
+      sb->buffer_f[i]              = NULL;
+      sb->data[i]                  = NULL;
+    }
+  }
+  pthread_mutex_unlock(&q->mutex);
+}
+
+void srsran_softbuffer_pool_get_metrics(srsran_softbuffer_pool_t* q, srsran_softbuffer_pool_metrics_t* m)
+{
+  if (q == NULL || m == NULL) {
+    return;
+  }
+  pthread_mutex_lock(&q->mutex);
+  m->nof_cb_used  = q->nof_slots - q->nof_free;
+  m->max_cb_used  = q->max_used;
+  m->nof_chunks   = q->nof_chunks;
+  m->nof_bytes    = (uint64_t)q->nof_chunks * SOFTBUFFER_POOL_CHUNK_SIZE;
+  m->nof_failures = q->nof_failures;
+  m->nof_huge     = 0;
+  for (uint32_t i = 0; i < q->nof_chunks; i++) {
+    m->nof_huge += q->chunk_huge[i] ? 1 : 0;
+  }
+  pthread_mutex_unlock(&q->mutex);
+}
+
 int srsran_softbuffer_rx_init(srsran_softbuffer_rx_t* q, uint32_t nof_prb)
 {
   int ret = srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, nof_prb);
@@ -47,6 +250,14 @@ int srsran_softbuffer_rx_init(srsran_softbuffer_rx_t* q, uint32_t nof_prb)
 }
 
 int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, uint32_t max_cb_size)
+{
+  return srsran_softbuffer_rx_init_guru_llr(q, max_cb, max_cb_size, SRSRAN_SOFTBUFFER_LLR_16BIT);
+}
+
+int srsran_softbuffer_rx_init_guru_llr(srsran_softbuffer_rx_t* q,
+                                       uint32_t                max_cb,
+                                       uint32_t                max_cb_size,
+                                       srsran_softbuffer_llr_t llr_format)
 {
   int ret = SRSRAN_ERROR;
 
@@ -61,6 +272,7 @@ int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, u
   // Set internal attributes
   q->max_cb      = max_cb;
   q->max_cb_size = max_cb_size;
+  q->llr_format  = llr_format;
 
   q->buffer_f = SRSRAN_MEM_ALLOC(int16_t*, q->max_cb);
   if (!q->buffer_f) {
@@ -83,7 +295,7 @@ int srsran_softbuffer_rx_init_guru(srsran_softbuffer_rx_t* q, uint32_t max_cb, u
   }
 
   for (uint32_t i = 0; i < q->max_cb; i++) {
-    q->buffer_f[i] = srsran_vec_i16_malloc(q->max_cb_size);
+    q->buffer_f[i] = (int16_t*)srsran_vec_u8_malloc(srsran_softbuffer_llr_nof_bytes(q->llr_format, q->max_cb_size));
     if (!q->buffer_f[i]) {
       perror("malloc");
       goto clean_exit;
@@ -112,6 +324,9 @@ clean_exit:
 void srsran_softbuffer_rx_free(srsran_softbuffer_rx_t* q)
 {
   if (q) {
+    // Code blocks taken from a pool go back to it
+    srsran_softbuffer_rx_release(q);
+
     if (q->buffer_f) {
       for (uint32_t i = 0; i < q->max_cb; i++) {
         if (q->buffer_f[i]) {
@@ -136,6 +351,58 @@ void srsran_softbuffer_rx_free(srsran_softbuffer_rx_t* q)
   }
 }
 
+int srsran_softbuffer_rx_init_pool(srsran_softbuffer_rx_t* q, uint32_t max_cb, srsran_softbuffer_pool_t* pool)
+{
+  if (q == NULL || pool == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_softbuffer_rx_t, 1);
+
+  q->max_cb      = max_cb;
+  q->max_cb_size = pool->max_cb_size;
+  q->llr_format  = pool->llr_format;
+
+  // No code block is attached until a transmission needs it
+  q->buffer_f = SRSRAN_MEM_ALLOC(int16_t*, q->max_cb);
+  q->data     = SRSRAN_MEM_ALLOC(uint8_t*, q->max_cb);
+  q->cb_crc   = SRSRAN_MEM_ALLOC(bool, q->max_cb);
+  if (!q->buffer_f || !q->data || !q->cb_crc) {
+    perror("malloc");
+    srsran_softbuffer_rx_free(q);
+    return SRSRAN_ERROR;
+  }
+  SRSRAN_MEM_ZERO(q->buffer_f, int16_t*, q->max_cb);
+  SRSRAN_MEM_ZERO(q->data, uint8_t*, q->max_cb);
+  SRSRAN_MEM_ZERO(q->cb_crc, bool, q->max_cb);
+
+  // Set the pool after the arrays, so a failed initialisation does not return anything to it
+  q->pool = pool;
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_softbuffer_rx_reserve(srsran_softbuffer_rx_t* q, uint32_t nof_cb)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  if (q->pool == NULL) {
+    return SRSRAN_SUCCESS;
+  }
+  return softbuffer_pool_get(q->pool, q, SRSRAN_MIN(nof_cb, q->max_cb));
+}
+
+void srsran_softbuffer_rx_release(srsran_softbuffer_rx_t* q)
+{
+  if (q == NULL || q->pool == NULL || q->buffer_f == NULL) {
+    return;
+  }
+  softbuffer_pool_put(q->pool, q, 0);
+  SRSRAN_MEM_ZERO(q->cb_crc, bool, q->max_cb);
+  q->tb_crc = false;
+}
+
 void srsran_softbuffer_rx_reset_tbs(srsran_softbuffer_rx_t* q, uint32_t tbs)
 {
   uint32_t nof_cb = (tbs + 24) / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1;
@@ -144,6 +411,10 @@ void srsran_softbuffer_rx_reset_tbs(srsran_softbuffer_rx_t* q, uint32_t tbs)
 
 void srsran_softbuffer_rx_reset(srsran_softbuffer_rx_t* q)
 {
+  if (q->pool) {
+    srsran_softbuffer_rx_release(q);
+    return;
+  }
   srsran_softbuffer_rx_reset_cb(q, q->max_cb);
 }
 
@@ -153,9 +424,14 @@ void srsran_softbuffer_rx_reset_cb(srsran_softbuffer_rx_t* q, uint32_t nof_cb)
     if (nof_cb > q->max_cb) {
       nof_cb = q->max_cb;
     }
+    // The code blocks the new transmission does not need go back to the pool
+    if (q->pool) {
+      softbuffer_pool_put(q->pool, q, nof_cb);
+    }
+    uint32_t llr_bytes = srsran_softbuffer_llr_nof_bytes(q->llr_format, q->max_cb_size);
     for (uint32_t i = 0; i < nof_cb; i++) {
       if (q->buffer_f[i]) {
-        srsran_vec_i16_zero(q->buffer_f[i], q->max_cb_size);
+        srsran_vec_u8_zero((uint8_t*)q->buffer_f[i], llr_bytes);
       }
       if (q->data[i]) {
         srsran_vec_u8_zero(q->data[i], q->max_cb_size / 8);
@@ -177,6 +453,78 @@ void srsran_softbuffer_rx_reset_cb_crc(srsran_softbuffer_rx_t* q, uint32_t nof_c
   SRSRAN_MEM_ZERO(q->cb_crc, bool, SRSRAN_MIN(q->max_cb, nof_cb));
 }
 
+// Rounds a soft bit to the nearest 4-bit step, symmetrically around zero, and saturates it
+static inline uint8_t softbuffer_llr_to_4bit(int8_t llr)
+{
+  int32_t mag = (abs(llr) + SRSRAN_SOFTBUFFER_LLR_4BIT_STEP / 2) / SRSRAN_SOFTBUFFER_LLR_4BIT_STEP;
+  mag         = SRSRAN_MIN(mag, 7);
+  return (uint8_t)((llr < 0 ? -mag : mag) & 0xf);
+}
+
+static inline int8_t softbuffer_llr_from_4bit(uint8_t nibble)
+{
+  return (int8_t)(((int8_t)(uint8_t)(nibble << 4U) >> 4) * SRSRAN_SOFTBUFFER_LLR_4BIT_STEP);
+}
+
+static bool softbuffer_rx_cb_valid(const srsran_softbuffer_rx_t* q, uint32_t cb_idx, uint32_t nof_llr)
+{
+  if (q == NULL || q->buffer_f == NULL || cb_idx >= q->max_cb || q->buffer_f[cb_idx] == NULL ||
+      nof_llr > q->max_cb_size) {
+    return false;
+  }
+  if (q->llr_format == SRSRAN_SOFTBUFFER_LLR_16BIT) {
+    ERROR("Soft-buffer code blocks are not stored in 8-bit or 4-bit");
+    return false;
+  }
+  return true;
+}
+
+int srsran_softbuffer_rx_cb_unpack(const srsran_softbuffer_rx_t* q, uint32_t cb_idx, int8_t* llr, uint32_t nof_llr)
+{
+  if (llr == NULL || !softbuffer_rx_cb_valid(q, cb_idx, nof_llr)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  const uint8_t* ptr = (const uint8_t*)q->buffer_f[cb_idx];
+  if (q->llr_format == SRSRAN_SOFTBUFFER_LLR_8BIT) {
+    srsran_vec_i8_copy(llr, (const int8_t*)ptr, nof_llr);
+    return SRSRAN_SUCCESS;
+  }
+
+  // Branch free, so the compiler vectorises it. Low nibble first.
+  uint32_t i = 0;
+  for (; i < nof_llr / 2; i++) {
+    llr[2 * i]     = softbuffer_llr_from_4bit(ptr[i] & 0xfU);
+    llr[2 * i + 1] = softbuffer_llr_from_4bit(ptr[i] >> 4U);
+  }
+  if (nof_llr % 2) {
+    llr[2 * i] = softbuffer_llr_from_4bit(ptr[i] & 0xfU);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_softbuffer_rx_cb_pack(srsran_softbuffer_rx_t* q, uint32_t cb_idx, const int8_t* llr, uint32_t nof_llr)
+{
+  if (llr == NULL || !softbuffer_rx_cb_valid(q, cb_idx, nof_llr)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint8_t* ptr = (uint8_t*)q->buffer_f[cb_idx];
+  if (q->llr_format == SRSRAN_SOFTBUFFER_LLR_8BIT) {
+    srsran_vec_i8_copy((int8_t*)ptr, llr, nof_llr);
+    return SRSRAN_SUCCESS;
+  }
+
+  uint32_t i = 0;
+  for (; i < nof_llr / 2; i++) {
+    ptr[i] = softbuffer_llr_to_4bit(llr[2 * i]) | (uint8_t)(softbuffer_llr_to_4bit(llr[2 * i + 1]) << 4U);
+  }
+  if (nof_llr % 2) {
+    ptr[i] = (ptr[i] & 0xf0U) | softbuffer_llr_to_4bit(llr[2 * i]);
+  }
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_softbuffer_tx_init(srsran_softbuffer_tx_t* q, uint32_t nof_prb)
 {
   int ret = srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, nof_prb);
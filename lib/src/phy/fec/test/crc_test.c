@@ -71,6 +71,62 @@ void parse_args(int argc, char** argv)
   }
 }
 
+// Bit-serial reference of the CRC register
+static uint32_t crc_reference(const srsran_crc_t* h, const uint8_t* bits, int len)
+{
+  uint64_t crc = 0;
+  for (int i = 0; i < len; i++) {
+    bool feedback = ((crc >> (h->order - 1)) & 1U) ^ (bits[i] & 1U);
+    crc           = (crc << 1U) & h->crcmask;
+    if (feedback) {
+      crc = (crc ^ (uint64_t)h->polynom) & h->crcmask;
+    }
+  }
+  return (uint32_t)crc;
+}
+
+// Checks the unpacked, packed and multiple buffer checksums against the reference for all the lengths up to max_len
+static int test_crc_consistency(srsran_crc_t* h, const uint8_t* bits, int max_len)
+{
+  uint8_t* packed = srsran_vec_u8_malloc(max_len / 8 + 1);
+  if (!packed) {
+    return SRSRAN_ERROR;
+  }
+  srsran_bit_pack_vector((uint8_t*)bits, packed, max_len);
+
+  for (int len = 1; len <= max_len; len++) {
+    uint32_t gold = crc_reference(h, bits, len);
+
+    if (srsran_crc_checksum(h, (uint8_t*)bits, len) != gold) {
+      ERROR("Unpacked CRC mismatch for %d bits", len);
+      free(packed);
+      return SRSRAN_ERROR;
+    }
+
+    if (len % 8 == 0) {
+      if (srsran_crc_checksum_byte(h, packed, len) != gold) {
+        ERROR("Packed CRC mismatch for %d bits", len);
+        free(packed);
+        return SRSRAN_ERROR;
+      }
+
+      // Split the message in two buffers
+      uint32_t split = (uint32_t)(len / 8) / 3;
+      srsran_crc_set_init(h, 0);
+      srsran_crc_checksum_put_bytes(h, packed, split);
+      srsran_crc_checksum_put_bytes(h, packed + split, (uint32_t)(len / 8) - split);
+      if ((uint32_t)srsran_crc_checksum_get(h) != gold) {
+        ERROR("Split packed CRC mismatch for %d bits", len);
+        free(packed);
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  free(packed);
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   int          i;
@@ -111,6 +167,12 @@ int main(int argc, char** argv)
 
   INFO("checksum=%x", crc_word);
 
+  // check all the implementations agree
+  if (test_crc_consistency(&crc_p, data, num_bits)) {
+    free(data);
+    exit(-1);
+  }
+
   free(data);
 
   // check if generated word is as expected
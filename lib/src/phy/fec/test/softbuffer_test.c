@@ -0,0 +1,245 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/phy/fec/cbsegm.h"
+#include "srsran/phy/fec/softbuffer.h"
+#include "srsran/phy/fec/turbo/rm_turbo.h"
+#include "srsran/phy/fec/turbo/turbodecoder_gen.h"
+#include "srsran/phy/utils/vector.h"
+#include <stdlib.h>
+
+#define MAX_CB 13
+#define POOL_BYTES (4UL * 1024UL * 1024UL)
+
+static bool is_zero(const srsran_softbuffer_rx_t* sb, uint32_t cb_idx)
+{
+  for (uint32_t i = 0; i < sb->max_cb_size; i++) {
+    if (sb->buffer_f[cb_idx][i] != 0) {
+      return false;
+    }
+  }
+  for (uint32_t i = 0; i < sb->max_cb_size / 8; i++) {
+    if (sb->data[cb_idx][i] != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static int test_lazy_allocation(srsran_softbuffer_pool_t* pool)
+{
+  srsran_softbuffer_rx_t           sb      = {};
+  srsran_softbuffer_pool_metrics_t metrics = {};
+
+  TESTASSERT(srsran_softbuffer_rx_init_pool(&sb, MAX_CB, pool) == SRSRAN_SUCCESS);
+  srsran_softbuffer_pool_get_metrics(pool, &metrics);
+  TESTASSERT(metrics.nof_cb_used == 0);
+  TESTASSERT(metrics.nof_chunks == 0);
+
+  // New transmission of 5 code blocks, they are zeroed and do not overlap
+  srsran_softbuffer_rx_reset_tbs(&sb, 5 * (SRSRAN_TCOD_MAX_LEN_CB - 24) - 25);
+  TESTASSERT(srsran_softbuffer_rx_reserve(&sb, 5) == SRSRAN_SUCCESS);
+  srsran_softbuffer_pool_get_metrics(pool, &metrics);
+  TESTASSERT(metrics.nof_cb_used == 5);
+  TESTASSERT(metrics.nof_chunks == 1);
+  for (uint32_t i = 0; i < 5; i++) {
+    TESTASSERT(is_zero(&sb, i));
+    TESTASSERT((uint8_t*)sb.data[i] >= (uint8_t*)&sb.buffer_f[i][sb.max_cb_size]);
+    srsran_vec_i16_zero(sb.buffer_f[i], sb.max_cb_size);
+    sb.buffer_f[i][0] = (int16_t)(i + 1);
+    sb.data[i][0]     = (uint8_t)(i + 1);
+  }
+  TESTASSERT(sb.buffer_f[5] == NULL);
+
+  // A retransmission keeps the soft bits
+  int16_t* cb0 = sb.buffer_f[0];
+  TESTASSERT(srsran_softbuffer_rx_reserve(&sb, 5) == SRSRAN_SUCCESS);
+  TESTASSERT(sb.buffer_f[0] == cb0);
+  TESTASSERT(sb.buffer_f[4][0] == 5);
+
+  // A smaller new transmission returns the code blocks it does not use and zeroes the rest
+  srsran_softbuffer_rx_reset_tbs(&sb, 2 * (SRSRAN_TCOD_MAX_LEN_CB - 24) - 25);
+  srsran_softbuffer_pool_get_metrics(pool, &metrics);
+  TESTASSERT(metrics.nof_cb_used == 2);
+  TESTASSERT(sb.buffer_f[2] == NULL);
+  TESTASSERT(is_zero(&sb, 0) && is_zero(&sb, 1));
+
+  // Idle soft-buffers do not hold any memory, the returned code blocks are zeroed when reused
+  srsran_softbuffer_rx_release(&sb);
+  srsran_softbuffer_pool_get_metrics(pool, &metrics);
+  TESTASSERT(metrics.nof_cb_used == 0);
+  TESTASSERT(metrics.max_cb_used == 5);
+  TESTASSERT(srsran_softbuffer_rx_reserve(&sb, MAX_CB) == SRSRAN_SUCCESS);
+  for (uint32_t i = 0; i < MAX_CB; i++) {
+    TESTASSERT(is_zero(&sb, i));
+  }
+
+  srsran_softbuffer_rx_free(&sb);
+  srsran_softbuffer_pool_get_metrics(pool, &metrics);
+  TESTASSERT(metrics.nof_cb_used == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+static int test_exhaustion(srsran_softbuffer_pool_t* pool)
+{
+  srsran_softbuffer_rx_t           sb[16]  = {};
+  srsran_softbuffer_pool_metrics_t metrics = {};
+
+  // The pool holds fewer code blocks than the soft-buffers need
+  uint32_t nof_ok = 0;
+  for (uint32_t i = 0; i < 16; i++) {
+    TESTASSERT(srsran_softbuffer_rx_init_pool(&sb[i], MAX_CB, pool) == SRSRAN_SUCCESS);
+    if (srsran_softbuffer_rx_reserve(&sb[i], MAX_CB) == SRSRAN_SUCCESS) {
+      nof_ok++;
+    }
+  }
+  srsran_softbuffer_pool_get_metrics(pool, &metrics);
+  TESTASSERT(nof_ok > 0 && nof_ok < 16);
+  TESTASSERT(metrics.nof_failures > 0);
+  TESTASSERT(metrics.nof_bytes == POOL_BYTES);
+  TESTASSERT(metrics.nof_huge <= metrics.nof_chunks);
+
+  // Releasing one soft-buffer makes room for another one
+  srsran_softbuffer_rx_release(&sb[0]);
+  TESTASSERT(srsran_softbuffer_rx_reserve(&sb[15], MAX_CB) == SRSRAN_SUCCESS);
+
+  for (uint32_t i = 0; i < 16; i++) {
+    srsran_softbuffer_rx_free(&sb[i]);
+  }
+  srsran_softbuffer_pool_get_metrics(pool, &metrics);
+  TESTASSERT(metrics.nof_cb_used == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+static int test_llr_format(srsran_softbuffer_llr_t llr_format)
+{
+  const uint32_t           nof_llr = 1001; // Odd, so the last 4-bit soft bit shares its byte with nothing
+  srsran_softbuffer_rx_t   sb      = {};
+  srsran_softbuffer_pool_t pool    = {};
+  int8_t                   llr_tx[1001];
+  int8_t                   llr_rx[1001];
+
+  for (uint32_t i = 0; i < nof_llr; i++) {
+    llr_tx[i] = (int8_t)((int32_t)(i % 255) - 127);
+  }
+
+  // Owned code blocks are zeroed with the size of the format and keep the soft bits within the quantization error
+  TESTASSERT(srsran_softbuffer_rx_init_guru_llr(&sb, 2, SOFTBUFFER_SIZE, llr_format) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_softbuffer_rx_cb_unpack(&sb, 1, llr_rx, nof_llr) == SRSRAN_SUCCESS);
+  for (uint32_t i = 0; i < nof_llr; i++) {
+    TESTASSERT(llr_rx[i] == 0);
+  }
+  TESTASSERT(srsran_softbuffer_rx_cb_pack(&sb, 1, llr_tx, nof_llr) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_softbuffer_rx_cb_unpack(&sb, 1, llr_rx, nof_llr) == SRSRAN_SUCCESS);
+  for (uint32_t i = 0; i < nof_llr; i++) {
+    if (llr_format == SRSRAN_SOFTBUFFER_LLR_8BIT) {
+      TESTASSERT(llr_rx[i] == llr_tx[i]);
+    } else {
+      // Rounded to the nearest step, saturated and symmetric around zero
+      int32_t max = 7 * SRSRAN_SOFTBUFFER_LLR_4BIT_STEP;
+      int32_t ref = SRSRAN_MAX(SRSRAN_MIN(llr_tx[i], max), -max);
+      TESTASSERT(abs(llr_rx[i] - ref) <= SRSRAN_SOFTBUFFER_LLR_4BIT_STEP / 2);
+      TESTASSERT(llr_rx[i] % SRSRAN_SOFTBUFFER_LLR_4BIT_STEP == 0);
+      TESTASSERT((llr_tx[i] < 0 && llr_rx[i] <= 0) || (llr_tx[i] >= 0 && llr_rx[i] >= 0));
+    }
+  }
+  srsran_softbuffer_rx_reset(&sb);
+  TESTASSERT(srsran_softbuffer_rx_cb_unpack(&sb, 1, llr_rx, nof_llr) == SRSRAN_SUCCESS);
+  for (uint32_t i = 0; i < nof_llr; i++) {
+    TESTASSERT(llr_rx[i] == 0);
+  }
+  srsran_softbuffer_rx_free(&sb);
+
+  // Pool backed soft-buffers inherit the format, the slots shrink with it
+  TESTASSERT(srsran_softbuffer_pool_init(&pool, SOFTBUFFER_SIZE, llr_format, POOL_BYTES) == SRSRAN_SUCCESS);
+  TESTASSERT(pool.slot_size < SOFTBUFFER_SIZE * sizeof(int16_t));
+  TESTASSERT(pool.slot_size >= srsran_softbuffer_llr_nof_bytes(llr_format, SOFTBUFFER_SIZE) + SOFTBUFFER_SIZE / 8);
+  TESTASSERT(srsran_softbuffer_rx_init_pool(&sb, MAX_CB, &pool) == SRSRAN_SUCCESS);
+  TESTASSERT(sb.llr_format == llr_format);
+  TESTASSERT(srsran_softbuffer_rx_reserve(&sb, MAX_CB) == SRSRAN_SUCCESS);
+  for (uint32_t i = 0; i < MAX_CB; i++) {
+    TESTASSERT(srsran_softbuffer_rx_cb_pack(&sb, i, llr_tx, nof_llr) == SRSRAN_SUCCESS);
+    TESTASSERT((uint8_t*)sb.data[i] >= (uint8_t*)sb.buffer_f[i] + srsran_softbuffer_llr_nof_bytes(llr_format, nof_llr));
+  }
+  srsran_softbuffer_rx_free(&sb);
+  srsran_softbuffer_pool_free(&pool);
+
+  // 16-bit soft-buffers are not packed
+  TESTASSERT(srsran_softbuffer_rx_init_guru(&sb, 1, SOFTBUFFER_SIZE) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_softbuffer_rx_cb_pack(&sb, 0, llr_tx, nof_llr) < SRSRAN_SUCCESS);
+  srsran_softbuffer_rx_free(&sb);
+
+  return SRSRAN_SUCCESS;
+}
+
+static int test_combining_8bit()
+{
+  uint32_t cb_idx  = srsran_cbsegm_cbindex(1024);
+  uint32_t out_len = 3 * 1024 + 12;
+  int8_t*  input   = srsran_vec_i8_malloc(out_len);
+  int8_t*  output  = srsran_vec_i8_malloc(SOFTBUFFER_SIZE);
+  TESTASSERT(input != NULL && output != NULL);
+
+  // Combining the same strong soft bits several times saturates instead of wrapping around
+  for (uint32_t i = 0; i < out_len; i++) {
+    input[i] = (i % 2) ? 100 : -100;
+  }
+  srsran_vec_i8_zero(output, SOFTBUFFER_SIZE);
+  for (uint32_t n = 0; n < 3; n++) {
+    TESTASSERT(srsran_rm_turbo_rx_lut_8bit(input, output, out_len, cb_idx, 0) == SRSRAN_SUCCESS);
+  }
+  uint32_t nof_pos = 0;
+  uint32_t nof_neg = 0;
+  for (uint32_t i = 0; i < SOFTBUFFER_SIZE; i++) {
+    TESTASSERT(output[i] == 0 || output[i] == INT8_MAX || output[i] == -INT8_MAX);
+    nof_pos += output[i] > 0 ? 1 : 0;
+    nof_neg += output[i] < 0 ? 1 : 0;
+  }
+  TESTASSERT(nof_pos == out_len / 2 && nof_neg == out_len / 2);
+
+  free(input);
+  free(output);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srsran_softbuffer_pool_t pool = {};
+
+  TESTASSERT(srsran_softbuffer_pool_init(&pool, SOFTBUFFER_SIZE, SRSRAN_SOFTBUFFER_LLR_16BIT, POOL_BYTES) ==
+             SRSRAN_SUCCESS);
+  TESTASSERT(test_lazy_allocation(&pool) == SRSRAN_SUCCESS);
+  TESTASSERT(test_exhaustion(&pool) == SRSRAN_SUCCESS);
+  srsran_softbuffer_pool_free(&pool);
+
+  TESTASSERT(test_llr_format(SRSRAN_SOFTBUFFER_LLR_8BIT) == SRSRAN_SUCCESS);
+  TESTASSERT(test_llr_format(SRSRAN_SOFTBUFFER_LLR_4BIT) == SRSRAN_SUCCESS);
+
+  srsran_rm_turbo_gentables();
+  TESTASSERT(test_combining_8bit() == SRSRAN_SUCCESS);
+  srsran_rm_turbo_free_tables();
+
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
@@ -444,6 +444,13 @@ int srsran_rm_turbo_rx_lut_(int16_t* input,
   }
 }
 
+// 8-bit soft combining saturates, repetitions and retransmissions must not wrap around
+static inline int8_t rm_turbo_sat_add_8bit(int8_t a, int8_t b)
+{
+  int16_t s = (int16_t)a + (int16_t)b;
+  return (int8_t)SRSRAN_MAX(SRSRAN_MIN(s, INT8_MAX), -INT8_MAX);
+}
+
 int srsran_rm_turbo_rx_lut_8bit(int8_t* input, int8_t* output, uint32_t in_len, uint32_t cb_idx, uint32_t rv_idx)
 {
   if (rv_idx < 4 && cb_idx < SRSRAN_NOF_TC_CB_SIZES) {
@@ -472,7 +479,7 @@ int srsran_rm_turbo_rx_lut_8bit(int8_t* input, int8_t* output, uint32_t in_len,
     uint32_t  out_len = 3 * srsran_cbsegm_cbsize(cb_idx) + 12;
 
     for (int i = 0; i < in_len; i++) {
-      output[deinter[i % out_len]] += input[i];
+      output[deinter[i % out_len]] = rm_turbo_sat_add_8bit(output[deinter[i % out_len]], input[i]);
     }
     return 0;
 #endif
@@ -576,12 +583,12 @@ int srsran_rm_turbo_rx_lut_sse(int16_t*  input,
 #define SAVE_OUTPUT_SSE_8(j)                                                                                           \
   x = (int8_t)_mm_extract_epi8(xVal, j);                                                                               \
   l = (uint16_t)_mm_extract_epi16(lutVal1, j);                                                                         \
-  output[l] += x;
+  output[l] = rm_turbo_sat_add_8bit(output[l], x);
 
 #define SAVE_OUTPUT_SSE_8_2(j)                                                                                         \
   x = (int8_t)_mm_extract_epi8(xVal, j + 8);                                                                           \
   l = (uint16_t)_mm_extract_epi16(lutVal2, j);                                                                         \
-  output[l] += x;
+  output[l] = rm_turbo_sat_add_8bit(output[l], x);
 
 int srsran_rm_turbo_rx_lut_sse_8bit(int8_t*   input,
                                     int8_t*   output,
@@ -629,7 +636,7 @@ int srsran_rm_turbo_rx_lut_sse_8bit(int8_t*   input,
         SAVE_OUTPUT_SSE_8_2(7);
       }
       for (int i = 16 * (in_len / 16); i < in_len; i++) {
-        output[deinter[i % out_len]] += input[i];
+        output[deinter[i % out_len]] = rm_turbo_sat_add_8bit(output[deinter[i % out_len]], input[i]);
       }
     } else {
       int intCnt   = 16;
@@ -667,12 +674,12 @@ int srsran_rm_turbo_rx_lut_sse_8bit(int8_t*   input,
           /* Copy last elements */
           if ((out_len % 16) == 12) {
             for (int j = (nwrapps + 1) * out_len - 12; j < (nwrapps + 1) * out_len; j++) {
-              output[deinter[j % out_len]] += input[j];
+              output[deinter[j % out_len]] = rm_turbo_sat_add_8bit(output[deinter[j % out_len]], input[j]);
               inputCnt++;
             }
           } else {
             for (int j = (nwrapps + 1) * out_len - 4; j < (nwrapps + 1) * out_len; j++) {
-              output[deinter[j % out_len]] += input[j];
+              output[deinter[j % out_len]] = rm_turbo_sat_add_8bit(output[deinter[j % out_len]], input[j]);
               inputCnt++;
             }
           }
@@ -684,7 +691,7 @@ int srsran_rm_turbo_rx_lut_sse_8bit(int8_t*   input,
         }
       }
       for (int i = inputCnt; i < in_len; i++) {
-        output[deinter[i % out_len]] += input[i];
+        output[deinter[i % out_len]] = rm_turbo_sat_add_8bit(output[deinter[i % out_len]], input[i]);
       }
     }
 
@@ -813,12 +820,12 @@ int srsran_rm_turbo_rx_lut_avx(int16_t*  input,
 #define SAVE_OUTPUT8(j)                                                                                                \
   x = (int8_t)_mm256_extract_epi8(xVal, j);                                                                            \
   l = (uint16_t)_mm256_extract_epi16(lutVal1, j);                                                                      \
-  output[l] += x;
+  output[l] = rm_turbo_sat_add_8bit(output[l], x);
 
 #define SAVE_OUTPUT8_2(j)                                                                                              \
   x = (int8_t)_mm256_extract_epi8(xVal, j + 8);                                                                        \
   l = (uint16_t)_mm256_extract_epi16(lutVal2, j);                                                                      \
-  output[l] += x;
+  output[l] = rm_turbo_sat_add_8bit(output[l], x);
 
 int srsran_rm_turbo_rx_lut_avx_8bit(int8_t*   input,
                                     int8_t*   output,
@@ -884,7 +891,7 @@ int srsran_rm_turbo_rx_lut_avx_8bit(int8_t*   input,
         SAVE_OUTPUT8_2(15);
       }
       for (int i = 32 * (in_len / 32); i < in_len; i++) {
-        output[deinter[i % out_len]] += input[i];
+        output[deinter[i % out_len]] = rm_turbo_sat_add_8bit(output[deinter[i % out_len]], input[i]);
       }
     } else {
       printf("wraps not implemented!\n");
@@ -942,7 +949,7 @@ int srsran_rm_turbo_rx_lut_avx_8bit(int8_t*   input,
           printf("warning rate matching wrapping remainder %d\n", out_len % 32);
           /* Copy last elements */
           for (int j = (nwrapps + 1) * out_len - (out_len % 32); j < (nwrapps + 1) * out_len; j++) {
-            output[deinter[j % out_len]] += input[j];
+            output[deinter[j % out_len]] = rm_turbo_sat_add_8bit(output[deinter[j % out_len]], input[j]);
             inputCnt++;
           }
           /* And wrap pointers */
@@ -953,7 +960,7 @@ int srsran_rm_turbo_rx_lut_avx_8bit(int8_t*   input,
         }
       }
       for (int i = inputCnt; i < in_len; i++) {
-        output[deinter[i % out_len]] += input[i];
+        output[deinter[i % out_len]] = rm_turbo_sat_add_8bit(output[deinter[i % out_len]], input[i]);
       }
 #endif
     }
@@ -89,6 +89,13 @@ static int pdcch_init(srsran_pdcch_t* q, uint32_t max_prb, uint32_t nof_rx_anten
 
     srsran_vec_f_zero(q->llr, q->max_bits);
 
+    q->cce_llr_abs = srsran_vec_f_malloc(q->max_bits / 72);
+    if (!q->cce_llr_abs) {
+      goto clean;
+    }
+
+    srsran_vec_f_zero(q->cce_llr_abs, q->max_bits / 72);
+
     q->d = srsran_vec_cf_malloc(q->max_bits / 2);
     if (!q->d) {
       goto clean;
@@ -140,6 +147,9 @@ void srsran_pdcch_free(srsran_pdcch_t* q)
   if (q->llr) {
     free(q->llr);
   }
+  if (q->cce_llr_abs) {
+    free(q->cce_llr_abs);
+  }
   if (q->d) {
     free(q->d);
   }
@@ -369,6 +379,50 @@ int srsran_pdcch_dci_decode(srsran_pdcch_t* q, float* e, uint8_t* data, uint32_t
   }
 }
 
+float srsran_pdcch_candidate_energy(const srsran_pdcch_t* q, const srsran_dci_location_t* location)
+{
+  if (q == NULL || location == NULL || location->L >= PDCCH_NOF_FORMATS ||
+      location->ncce + PDCCH_FORMAT_NOF_CCE(location->L) > q->max_bits / 72) {
+    return 0.0f;
+  }
+
+  float sum = 0.0f;
+  for (uint32_t i = 0; i < PDCCH_FORMAT_NOF_CCE(location->L); i++) {
+    sum += q->cce_llr_abs[location->ncce + i];
+  }
+
+  return sum / PDCCH_FORMAT_NOF_BITS(location->L);
+}
+
+/* Decodes a candidate, the decoded message is reused if the same location was already decoded in the current subframe
+ * with the same payload size. For example, DCI formats 0 and 1A in the same location are decoded only once.
+ */
+static int pdcch_decode_candidate(srsran_pdcch_t* q, srsran_dci_msg_t* msg, uint32_t e_bits, uint32_t nof_bits)
+{
+  for (uint32_t i = 0; i < q->nof_decoded; i++) {
+    srsran_pdcch_decoded_t* d = &q->decoded[i];
+    if (d->location.ncce == msg->location.ncce && d->location.L == msg->location.L && d->nof_bits == nof_bits) {
+      memcpy(msg->payload, d->payload, nof_bits);
+      msg->rnti = d->crc_rem;
+      return SRSRAN_SUCCESS;
+    }
+  }
+
+  int ret = srsran_pdcch_dci_decode(q, &q->llr[msg->location.ncce * 72], msg->payload, e_bits, nof_bits, &msg->rnti);
+
+  // Save the decoded message if there is space left
+  if (ret == SRSRAN_SUCCESS && q->nof_decoded < SRSRAN_PDCCH_MAX_DECODED_CACHE) {
+    srsran_pdcch_decoded_t* d = &q->decoded[q->nof_decoded];
+    d->location               = msg->location;
+    d->nof_bits               = nof_bits;
+    d->crc_rem                = msg->rnti;
+    memcpy(d->payload, msg->payload, nof_bits);
+    q->nof_decoded++;
+  }
+
+  return ret;
+}
+
 /** Tries to decode a DCI message from the LLRs stored in the srsran_pdcch_t structure by the function
  * srsran_pdcch_extract_llr(). This function can be called multiple times.
  * The location to search for is obtained from msg.
@@ -388,14 +442,10 @@ int srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dc
       uint32_t e_bits   = PDCCH_FORMAT_NOF_BITS(msg->location.L);
 
       // Compute absolute mean of the LLRs
-      double mean = 0;
-      for (int i = 0; i < e_bits; i++) {
-        mean += fabsf(q->llr[msg->location.ncce * 72 + i]);
-      }
-      mean /= e_bits;
+      float mean = srsran_pdcch_candidate_energy(q, &msg->location);
 
-      if (mean > 0.3f) {
-        ret = srsran_pdcch_dci_decode(q, &q->llr[msg->location.ncce * 72], msg->payload, e_bits, nof_bits, &msg->rnti);
+      if (mean > SRSRAN_PDCCH_MIN_LLR_MEAN) {
+        ret = pdcch_decode_candidate(q, msg, e_bits, nof_bits);
         if (ret == SRSRAN_SUCCESS) {
           msg->nof_bits = nof_bits;
           // Check format differentiation
@@ -506,6 +556,19 @@ int srsran_pdcch_extract_llr(srsran_pdcch_t*        q,
     /* descramble */
     srsran_scrambling_f_offset(&q->seq[sf->tti % 10], q->llr, 0, e_bits);
 
+    /* absolute LLR sum of each CCE, used for computing the energy of every candidate */
+    srsran_vec_f_zero(q->cce_llr_abs, q->max_bits / 72);
+    for (uint32_t cce = 0; cce < NOF_CCE(sf->cfi); cce++) {
+      float sum = 0.0f;
+      for (uint32_t j = 0; j < 72; j++) {
+        sum += fabsf(q->llr[cce * 72 + j]);
+      }
+      q->cce_llr_abs[cce] = sum;
+    }
+
+    /* previously decoded candidates are no longer valid */
+    q->nof_decoded = 0;
+
     ret = SRSRAN_SUCCESS;
   }
   return ret;
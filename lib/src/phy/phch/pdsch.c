@@ -40,6 +40,9 @@
 
 #define MAX_PDSCH_RE(cp) (2 * SRSRAN_CP_NSYMB(cp) * 12)
 
+/* Default number of RNTIs with cached scrambling sequences, each RNTI uses one for every subframe in the radio frame */
+#define PDSCH_SEQ_CACHE_NOF_RNTI 2
+
 /* 3GPP 36.213 Table 5.2-1: The cell-specific ratio rho_B / rho_A for 1, 2, or 4 cell specific antenna ports */
 const static float pdsch_cfg_cell_specific_ratio_table[2][4] = {
     /* One antenna port         */ {1.0f / 1.0f, 4.0f / 5.0f, 3.0f / 5.0f, 2.0f / 5.0f},
@@ -292,6 +295,13 @@ static int pdsch_init(srsran_pdsch_t* q, uint32_t max_prb, bool is_ue, uint32_t
         goto clean;
       }
 
+      if (srsran_sequence_cache_init(&q->seq_cache[i],
+                                     PDSCH_SEQ_CACHE_NOF_RNTI * SRSRAN_NOF_SF_X_FRAME,
+                                     q->max_re * srsran_mod_bits_x_symbol(SRSRAN_MOD_256QAM)) < SRSRAN_SUCCESS) {
+        ERROR("Initiating PDSCH scrambling sequence cache");
+        goto clean;
+      }
+
       // If it is the UE, allocate EVM buffer, for only minimum PRB
       if (is_ue) {
         q->evm_buffer[i] = srsran_evm_buffer_alloc(srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, 6));
@@ -429,6 +439,8 @@ void srsran_pdsch_free(srsran_pdsch_t* q)
     if (q->evm_buffer[i]) {
       srsran_evm_free(q->evm_buffer[i]);
     }
+
+    srsran_sequence_cache_free(&q->seq_cache[i]);
   }
 
   /* Free sch objects */
@@ -457,6 +469,24 @@ void srsran_pdsch_free(srsran_pdsch_t* q)
   bzero(q, sizeof(srsran_pdsch_t));
 }
 
+int srsran_pdsch_set_seq_cache_nof_rnti(srsran_pdsch_t* q, uint32_t nof_rnti)
+{
+  if (q == NULL || nof_rnti == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  for (int i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
+    uint32_t max_len = q->seq_cache[i].max_len;
+    srsran_sequence_cache_free(&q->seq_cache[i]);
+    if (srsran_sequence_cache_init(&q->seq_cache[i], nof_rnti * SRSRAN_NOF_SF_X_FRAME, max_len) < SRSRAN_SUCCESS) {
+      ERROR("Error resizing PDSCH scrambling sequence cache");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_pdsch_set_cell(srsran_pdsch_t* q, srsran_cell_t cell)
 {
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
@@ -715,21 +745,19 @@ static int srsran_pdsch_codeword_decode(srsran_pdsch_t*     q,
 
     /* Bit scrambling */
     if (q->llr_is_8bit) {
-      srsran_sequence_pdsch_apply_c(q->e[codeword_idx],
-                                    q->e[codeword_idx],
-                                    cfg->rnti,
-                                    codeword_idx,
-                                    2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
-                                    q->cell.id,
-                                    cfg->grant.tb[tb_idx].nof_bits);
+      srsran_sequence_cache_apply_c(
+          &q->seq_cache[codeword_idx],
+          q->e[codeword_idx],
+          q->e[codeword_idx],
+          cfg->grant.tb[tb_idx].nof_bits,
+          srsran_sequence_pdsch_seed(cfg->rnti, codeword_idx, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id));
     } else {
-      srsran_sequence_pdsch_apply_s(q->e[codeword_idx],
-                                    q->e[codeword_idx],
-                                    cfg->rnti,
-                                    codeword_idx,
-                                    2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
-                                    q->cell.id,
-                                    cfg->grant.tb[tb_idx].nof_bits);
+      srsran_sequence_cache_apply_s(
+          &q->seq_cache[codeword_idx],
+          q->e[codeword_idx],
+          q->e[codeword_idx],
+          cfg->grant.tb[tb_idx].nof_bits,
+          srsran_sequence_pdsch_seed(cfg->rnti, codeword_idx, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id));
     }
 
     if (cfg->csi_enable) {
@@ -995,13 +1023,12 @@ static int srsran_pdsch_codeword_encode(srsran_pdsch_t*         q,
     }
 
     /* Bit scrambling */
-    srsran_sequence_pdsch_apply_pack((uint8_t*)q->e[codeword_idx],
-                                     (uint8_t*)q->e[codeword_idx],
-                                     cfg->rnti,
-                                     codeword_idx,
-                                     2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
-                                     q->cell.id,
-                                     cfg->grant.tb[tb_idx].nof_bits);
+    srsran_sequence_cache_apply_packed(
+        &q->seq_cache[codeword_idx],
+        (uint8_t*)q->e[codeword_idx],
+        (uint8_t*)q->e[codeword_idx],
+        cfg->grant.tb[tb_idx].nof_bits,
+        srsran_sequence_pdsch_seed(cfg->rnti, codeword_idx, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id));
 
     /* Bit mapping */
     srsran_mod_modulate_bytes(
@@ -26,6 +26,12 @@
 #include "srsran/phy/mimo/precoding.h"
 #include "srsran/phy/modem/demod_soft.h"
 
+/**
+ * Number of cached scrambling sequences per code word. The NR scrambling sequence does not depend on the slot, so each
+ * entry serves one RNTI and scrambling identity
+ */
+#define PDSCH_NR_SEQ_CACHE_NOF_ENTRIES 8
+
 static int pdsch_nr_alloc(srsran_pdsch_nr_t* q, uint32_t max_mimo_layers, uint32_t max_prb)
 {
   // Reallocate symbols if necessary
@@ -150,6 +156,14 @@ int srsran_pdsch_nr_set_carrier(srsran_pdsch_nr_t* q, const srsran_carrier_nr_t*
           return SRSRAN_ERROR;
         }
       }
+
+      if (q->seq_cache[i].nof_entries == 0) {
+        if (srsran_sequence_cache_init(
+                &q->seq_cache[i], PDSCH_NR_SEQ_CACHE_NOF_ENTRIES, SRSRAN_SLOT_MAX_NOF_BITS_NR) < SRSRAN_SUCCESS) {
+          ERROR("Initialising scrambling sequence cache");
+          return SRSRAN_ERROR;
+        }
+      }
     }
   }
 
@@ -179,6 +193,8 @@ void srsran_pdsch_nr_free(srsran_pdsch_nr_t* q)
     if (q->d[cw]) {
       free(q->d[cw]);
     }
+
+    srsran_sequence_cache_free(&q->seq_cache[cw]);
   }
 
   srsran_sch_nr_free(&q->sch);
@@ -337,7 +353,8 @@ static inline int pdsch_nr_encode_codeword(srsran_pdsch_nr_t*         q,
 
   // 7.3.1.1 Scrambling
   uint32_t cinit = pdsch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx);
-  srsran_sequence_apply_bit(q->b[tb->cw_idx], q->b[tb->cw_idx], tb->nof_bits, cinit);
+  srsran_sequence_cache_apply_bit(
+      &q->seq_cache[tb->cw_idx], q->b[tb->cw_idx], q->b[tb->cw_idx], tb->nof_bits, cinit);
 
   // 7.3.1.2 Modulation
   srsran_mod_modulate(&q->modem_tables[tb->mod], q->b[tb->cw_idx], q->d[tb->cw_idx], tb->nof_bits);
@@ -467,7 +484,8 @@ static inline int pdsch_nr_decode_codeword(srsran_pdsch_nr_t*         q,
   srsran_vec_neg_bb(llr, llr, tb->nof_bits);
 
   // Descrambling
-  srsran_sequence_apply_c(llr, llr, tb->nof_bits, pdsch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx));
+  uint32_t cinit = pdsch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx);
+  srsran_sequence_cache_apply_c(&q->seq_cache[tb->cw_idx], llr, llr, tb->nof_bits, cinit);
 
   if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
     DEBUG("b=");
@@ -447,6 +447,65 @@ static cf_t* get_precoded_dft(srsran_prach_t* p, uint32_t idx)
   return p->dft_seqs[idx];
 }
 
+/// Allocates the batched detection buffers and plans the IFFT of all the root sequences in a single transform.
+static int prach_batch_setup(srsran_prach_t* p)
+{
+  uint32_t nof_roots = p->num_ra_preambles;
+
+  // Skip if the current plan already matches
+  if (p->batch_nof_roots == nof_roots && p->batch_N_zc == p->N_zc) {
+    return SRSRAN_SUCCESS;
+  }
+
+  if (p->batch_nof_roots > 0) {
+    srsran_dft_plan_free(&p->batch_ifft);
+  }
+  if (p->batch_corr_spec) {
+    free(p->batch_corr_spec);
+  }
+  if (p->batch_corr_time) {
+    free(p->batch_corr_time);
+  }
+  if (p->batch_corr) {
+    free(p->batch_corr);
+  }
+  p->batch_nof_roots = 0;
+  p->batch_N_zc      = 0;
+
+  p->batch_corr_spec = srsran_vec_cf_malloc(nof_roots * p->N_zc);
+  p->batch_corr_time = srsran_vec_cf_malloc(nof_roots * p->N_zc);
+  p->batch_corr      = srsran_vec_f_malloc(nof_roots * p->N_zc);
+  if (p->batch_corr_spec == NULL || p->batch_corr_time == NULL || p->batch_corr == NULL) {
+    ERROR("Error allocating memory");
+    return SRSRAN_ERROR;
+  }
+
+  // Same scaling than the ZC IFFT, no normalization
+  if (srsran_dft_plan_guru_c(&p->batch_ifft,
+                             (int)p->N_zc,
+                             SRSRAN_DFT_BACKWARD,
+                             p->batch_corr_spec,
+                             p->batch_corr_time,
+                             1,
+                             1,
+                             (int)nof_roots,
+                             (int)p->N_zc,
+                             (int)p->N_zc)) {
+    ERROR("Error creating DFT plan");
+    return SRSRAN_ERROR;
+  }
+
+  // Generate the DFT of every root sequence beforehand
+  for (uint32_t i = 0; i < nof_roots; i++) {
+    get_precoded_dft(p, p->root_seqs_idx[i]);
+  }
+
+  p->batch_nof_roots = nof_roots;
+  p->batch_N_zc      = p->N_zc;
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_prach_gen_seqs(srsran_prach_t* p)
 {
   uint32_t u           = 0;
@@ -646,6 +705,7 @@ int srsran_prach_set_cell_(srsran_prach_t*      p,
       p->successive_cancellation = false;
     }
     p->freq_domain_offset_calc = cfg->enable_freq_domain_offset_calc;
+    p->batch_detection         = cfg->enable_batch_detection;
     if (tdd_config) {
       p->tdd_config = *tdd_config;
     }
@@ -696,6 +756,11 @@ int srsran_prach_set_cell_(srsran_prach_t*      p,
       p->num_ra_preambles = p->N_roots;
     }
 
+    if (p->batch_detection && prach_batch_setup(p) < SRSRAN_SUCCESS) {
+      ERROR("Error setting up batched PRACH detection");
+      return SRSRAN_ERROR;
+    }
+
     // Create our FFT objects and buffers
     p->N_ifft_ul = N_ifft_ul;
     if (4 == preamble_format) {
@@ -866,6 +931,39 @@ void srsran_prach_calculate_correction_array(srsran_prach_t* p, cf_t* corr_freq)
   }
 }
 
+// Number of cyclic shift windows in the correlation of each root sequence
+static uint32_t prach_nof_windows(const srsran_prach_t* p)
+{
+  uint32_t winsize = (p->N_cs != 0) ? p->N_cs : p->N_zc;
+  return p->N_zc / winsize;
+}
+
+// Finds the correlation peak within every cyclic shift window and returns the largest of them
+static float prach_find_peaks(srsran_prach_t* p, const float* corr, uint32_t n_wins)
+{
+  uint32_t winsize  = (p->N_cs != 0) ? p->N_cs : p->N_zc;
+  float    max_peak = 0;
+  for (int j = 0; j < n_wins; j++) {
+    uint32_t start = (p->N_zc - (j * p->N_cs)) % p->N_zc;
+    uint32_t end   = start + winsize;
+    if (end > p->deadzone) {
+      end -= p->deadzone;
+    }
+    start += p->deadzone;
+    p->peak_values[j] = 0;
+    for (int k = start; k < end; k++) {
+      if (corr[k] > p->peak_values[j]) {
+        p->peak_values[j]  = corr[k];
+        p->peak_offsets[j] = k - start;
+        if (p->peak_values[j] > max_peak) {
+          max_peak = p->peak_values[j];
+        }
+      }
+    }
+  }
+  return max_peak;
+}
+
 // This function carries out the main processing on the incomming PRACH signal
 int srsran_prach_process(srsran_prach_t* p,
                          cf_t*           signal,
@@ -879,7 +977,6 @@ int srsran_prach_process(srsran_prach_t* p,
 {
   float max_to_cancel = 0;
   cancellation_idx    = -1;
-  int max_idx         = 0;
   srsran_vec_cf_zero(p->cross, p->N_zc);
   srsran_vec_cf_zero(p->corr_freq, p->N_zc);
   for (int i = 0; i < p->num_ra_preambles; i++) {
@@ -897,34 +994,8 @@ int srsran_prach_process(srsran_prach_t* p,
 
     float corr_ave = srsran_vec_acc_ff(p->corr, p->N_zc) / p->N_zc;
 
-    uint32_t winsize = 0;
-    if (p->N_cs != 0) {
-      winsize = p->N_cs;
-    } else {
-      winsize = p->N_zc;
-    }
-    uint32_t n_wins = p->N_zc / winsize;
-
-    float max_peak = 0;
-    for (int j = 0; j < n_wins; j++) {
-      uint32_t start = (p->N_zc - (j * p->N_cs)) % p->N_zc;
-      uint32_t end   = start + winsize;
-      if (end > p->deadzone) {
-        end -= p->deadzone;
-      }
-      start += p->deadzone;
-      p->peak_values[j] = 0;
-      for (int k = start; k < end; k++) {
-        if (p->corr[k] > p->peak_values[j]) {
-          p->peak_values[j]  = p->corr[k];
-          p->peak_offsets[j] = k - start;
-          if (p->peak_values[j] > max_peak) {
-            max_peak = p->peak_values[j];
-            max_idx  = k;
-          }
-        }
-      }
-    }
+    uint32_t n_wins   = prach_nof_windows(p);
+    float    max_peak = prach_find_peaks(p, p->corr, n_wins);
     if (max_peak > (p->detect_factor * corr_ave)) {
       for (int j = 0; j < n_wins; j++) {
         if (p->peak_values[j] > p->detect_factor * corr_ave) {
@@ -966,6 +1037,57 @@ int srsran_prach_process(srsran_prach_t* p,
   return 0;
 }
 
+// Correlates all the root sequences with the received bins and transforms them back to time domain with a single
+// batched IFFT. It reports the same detections than srsran_prach_process() without successive cancellation.
+static void prach_detect_batch(srsran_prach_t* p,
+                               uint32_t*       indices,
+                               float*          t_offsets,
+                               float*          peak_to_avg,
+                               uint32_t*       n_indices)
+{
+  uint32_t nof_roots = p->batch_nof_roots;
+  uint32_t N_zc      = p->N_zc;
+
+  for (uint32_t i = 0; i < nof_roots; i++) {
+    cf_t* root_spec = get_precoded_dft(p, p->root_seqs_idx[i]);
+    srsran_vec_prod_conj_ccc(p->prach_bins, root_spec, &p->batch_corr_spec[i * N_zc], N_zc);
+  }
+
+  srsran_dft_run_guru_c(&p->batch_ifft);
+  srsran_vec_abs_square_cf(p->batch_corr_time, p->batch_corr, nof_roots * N_zc);
+
+  srsran_vec_cf_zero(p->cross, N_zc);
+  uint32_t n_wins = prach_nof_windows(p);
+  for (uint32_t i = 0; i < nof_roots; i++) {
+    const float* corr     = &p->batch_corr[i * N_zc];
+    float        corr_ave = srsran_vec_acc_ff(corr, N_zc) / N_zc;
+    float        max_peak = prach_find_peaks(p, corr, n_wins);
+    if (max_peak <= (p->detect_factor * corr_ave)) {
+      continue;
+    }
+
+    // The cross-correlation is only needed for the detected root sequences
+    if (t_offsets && p->freq_domain_offset_calc) {
+      const cf_t* corr_spec = &p->batch_corr_spec[i * N_zc];
+      srsran_vec_prod_conj_ccc(corr_spec, &corr_spec[1], p->cross, N_zc - 1);
+    }
+
+    for (uint32_t j = 0; j < n_wins; j++) {
+      if (p->peak_values[j] > p->detect_factor * corr_ave) {
+        indices[*n_indices] = (i * n_wins) + j;
+        if (peak_to_avg) {
+          peak_to_avg[*n_indices] = p->peak_values[j] / corr_ave;
+        }
+        if (t_offsets) {
+          t_offsets[*n_indices] = (p->freq_domain_offset_calc) ? (srsran_prach_calculate_time_offset_secs(p, p->cross))
+                                                               : (srsran_prach_get_offset_secs(p, j));
+        }
+        (*n_indices)++;
+      }
+    }
+  }
+}
+
 int srsran_prach_detect_offset(srsran_prach_t* p,
                                uint32_t        freq_offset,
                                cf_t*           signal,
@@ -996,6 +1118,13 @@ int srsran_prach_detect_offset(srsran_prach_t* p,
     uint32_t begin   = PHI + (K * k_0) + (p->is_nr ? 0 : (K / 2));
 
     memcpy(p->prach_bins, &p->signal_fft[begin], p->N_zc * sizeof(cf_t));
+
+    // Successive cancellation needs to correlate one root sequence at a time
+    if (p->batch_detection && !p->successive_cancellation) {
+      prach_detect_batch(p, indices, t_offsets, peak_to_avg, n_indices);
+      return SRSRAN_SUCCESS;
+    }
+
     int loops = (p->successive_cancellation) ? SUCCESSIVE_CANCELLATION_ITS : 1;
     // if successive cancellation is enabled, we perform the entire search process p->num_ra_preambles times, removing
     // the highest power PRACH preamble each time.
@@ -1033,6 +1162,19 @@ int srsran_prach_free(srsran_prach_t* p)
     free(p->td_signals[i]);
   }
 
+  if (p->batch_nof_roots > 0) {
+    srsran_dft_plan_free(&p->batch_ifft);
+  }
+  if (p->batch_corr_spec) {
+    free(p->batch_corr_spec);
+  }
+  if (p->batch_corr_time) {
+    free(p->batch_corr_time);
+  }
+  if (p->batch_corr) {
+    free(p->batch_corr);
+  }
+
   bzero(p, sizeof(srsran_prach_t));
 
   return 0;
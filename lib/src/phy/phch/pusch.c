@@ -41,6 +41,9 @@
 
 #define MAX_PUSCH_RE(cp) (2 * SRSRAN_CP_NSYMB(cp) * 12)
 
+/* Default number of RNTIs with cached scrambling sequences, each RNTI uses one for every subframe in the radio frame */
+#define PUSCH_SEQ_CACHE_NOF_RNTI 2
+
 #define ACK_SNR_TH -1.0
 
 /* Allocate/deallocate PUSCH RBs to the resource grid
@@ -148,6 +151,13 @@ static int pusch_init(srsran_pusch_t* q, uint32_t max_prb, bool is_ue)
       goto clean;
     }
 
+    if (srsran_sequence_cache_init(&q->seq_cache,
+                                   PUSCH_SEQ_CACHE_NOF_RNTI * SRSRAN_NOF_SF_X_FRAME,
+                                   q->max_re * srsran_mod_bits_x_symbol(SRSRAN_MOD_64QAM)) < SRSRAN_SUCCESS) {
+      ERROR("Error initiating PUSCH scrambling sequence cache");
+      goto clean;
+    }
+
     // Allocate eNb specific buffers
     if (!q->is_ue) {
       q->ce = srsran_vec_cf_malloc(q->max_re);
@@ -208,6 +218,7 @@ void srsran_pusch_free(srsran_pusch_t* q)
     srsran_evm_free(q->evm_buffer);
   }
   srsran_dft_precoding_free(&q->dft_precoding);
+  srsran_sequence_cache_free(&q->seq_cache);
 
   for (i = 0; i < SRSRAN_MOD_NITEMS; i++) {
     srsran_modem_table_free(&q->mod[i]);
@@ -217,6 +228,22 @@ void srsran_pusch_free(srsran_pusch_t* q)
   bzero(q, sizeof(srsran_pusch_t));
 }
 
+int srsran_pusch_set_seq_cache_nof_rnti(srsran_pusch_t* q, uint32_t nof_rnti)
+{
+  if (q == NULL || nof_rnti == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t max_len = q->seq_cache.max_len;
+  srsran_sequence_cache_free(&q->seq_cache);
+  if (srsran_sequence_cache_init(&q->seq_cache, nof_rnti * SRSRAN_NOF_SF_X_FRAME, max_len) < SRSRAN_SUCCESS) {
+    ERROR("Error resizing PUSCH scrambling sequence cache");
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_pusch_set_cell(srsran_pusch_t* q, srsran_cell_t cell)
 {
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
@@ -305,12 +332,8 @@ int srsran_pusch_encode(srsran_pusch_t*      q,
     uint32_t nof_ri_ack_bits = (uint32_t)ret;
 
     // Run scrambling
-    srsran_sequence_pusch_apply_pack((uint8_t*)q->q,
-                                     (uint8_t*)q->q,
-                                     cfg->rnti,
-                                     2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
-                                     q->cell.id,
-                                     cfg->grant.tb.nof_bits);
+    uint32_t seed = srsran_sequence_pusch_seed(cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id);
+    srsran_sequence_cache_apply_packed(&q->seq_cache, (uint8_t*)q->q, (uint8_t*)q->q, cfg->grant.tb.nof_bits, seed);
 
     // Correct UCI placeholder/repetition bits
     uint8_t* d = q->q;
@@ -433,18 +456,17 @@ int srsran_pusch_decode(srsran_pusch_t*        q,
     }
 
     // Descrambling
+    uint32_t seed = srsran_sequence_pusch_seed(cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id);
     if (q->llr_is_8bit) {
-      srsran_sequence_pusch_apply_c(
-          q->q, q->q, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+      srsran_sequence_cache_apply_c(&q->seq_cache, q->q, q->q, cfg->grant.tb.nof_bits, seed);
     } else {
-      srsran_sequence_pusch_apply_s(
-          q->q, q->q, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+      srsran_sequence_cache_apply_s(&q->seq_cache, q->q, q->q, cfg->grant.tb.nof_bits, seed);
     }
 
-    // Generate packed sequence for UCI decoder
+    // Generate unpacked sequence for UCI decoder, the cache hit avoids generating it twice
     uint8_t* c = (uint8_t*)q->z; // Reuse Z
-    srsran_sequence_pusch_gen_unpack(
-        c, cfg->rnti, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id, cfg->grant.tb.nof_bits);
+    srsran_vec_u8_zero(c, cfg->grant.tb.nof_bits);
+    srsran_sequence_cache_apply_bit(&q->seq_cache, c, c, cfg->grant.tb.nof_bits, seed);
 
     // Set max number of iterations
     srsran_sch_set_max_noi(&q->ul_sch, cfg->max_nof_iterations);
@@ -27,6 +27,12 @@
 #include "srsran/phy/phch/ra_nr.h"
 #include "srsran/phy/phch/uci_cfg.h"
 
+/**
+ * Number of cached scrambling sequences per code word. The NR scrambling sequence does not depend on the slot, so each
+ * entry serves one RNTI and scrambling identity
+ */
+#define PUSCH_NR_SEQ_CACHE_NOF_ENTRIES 8
+
 static int pusch_nr_alloc(srsran_pusch_nr_t* q, uint32_t max_mimo_layers, uint32_t max_prb)
 {
   // Reallocate symbols if necessary
@@ -172,6 +178,14 @@ int srsran_pusch_nr_set_carrier(srsran_pusch_nr_t* q, const srsran_carrier_nr_t*
           return SRSRAN_ERROR;
         }
       }
+
+      if (q->seq_cache[i].nof_entries == 0) {
+        if (srsran_sequence_cache_init(
+                &q->seq_cache[i], PUSCH_NR_SEQ_CACHE_NOF_ENTRIES, SRSRAN_SLOT_MAX_NOF_BITS_NR) < SRSRAN_SUCCESS) {
+          ERROR("Initialising scrambling sequence cache");
+          return SRSRAN_ERROR;
+        }
+      }
     }
   }
 
@@ -227,6 +241,8 @@ void srsran_pusch_nr_free(srsran_pusch_nr_t* q)
     if (q->d[cw]) {
       free(q->d[cw]);
     }
+
+    srsran_sequence_cache_free(&q->seq_cache[cw]);
   }
 
   srsran_sch_nr_free(&q->sch);
@@ -678,7 +694,7 @@ static inline int pusch_nr_encode_codeword(srsran_pusch_nr_t*           q,
 
   // 7.3.1.1 Scrambling
   uint32_t cinit = pusch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx);
-  srsran_sequence_apply_bit(b, q->b[tb->cw_idx], nof_bits, cinit);
+  srsran_sequence_cache_apply_bit(&q->seq_cache[tb->cw_idx], b, q->b[tb->cw_idx], nof_bits, cinit);
 
   // Special Scrambling condition
   if (cfg->uci.ack.count <= 2) {
@@ -852,7 +868,8 @@ static inline int pusch_nr_decode_codeword(srsran_pusch_nr_t*         q,
   }
 
   // Descrambling
-  srsran_sequence_apply_c(llr, llr, nof_bits, pusch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx));
+  uint32_t cinit = pusch_nr_cinit(&q->carrier, cfg, rnti, tb->cw_idx);
+  srsran_sequence_cache_apply_c(&q->seq_cache[tb->cw_idx], llr, llr, nof_bits, cinit);
 
   if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
     DEBUG("b=");
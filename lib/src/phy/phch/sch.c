@@ -137,6 +137,10 @@ uint32_t srsran_sch_find_Ioffset_cqi(float beta)
 
 #define SCH_MAX_G_BITS (SRSRAN_MAX_PRB * 12 * 12 * 12)
 
+// Span of the rate dematched soft bits of a code block, including the sub-block alignment of the turbo decoder input
+#define SCH_CB_LLR_LEN(K) (3 * ((K) + 32) + 12)
+#define SCH_MAX_CB_LLR SCH_CB_LLR_LEN(SRSRAN_TCOD_MAX_LEN_CB)
+
 int srsran_sch_init(srsran_sch_t* q)
 {
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
@@ -181,6 +185,10 @@ int srsran_sch_init(srsran_sch_t* q)
       goto clean;
     }
     bzero(q->temp_g_bits, SRSRAN_MAX_PRB * 12 * 12 * 12);
+    q->temp_cb_llr = srsran_vec_i8_malloc(SCH_MAX_CB_LLR);
+    if (!q->temp_cb_llr) {
+      goto clean;
+    }
     q->ul_interleaver = srsran_vec_u32_malloc(SCH_MAX_G_BITS);
     if (!q->ul_interleaver) {
       goto clean;
@@ -211,6 +219,9 @@ void srsran_sch_free(srsran_sch_t* q)
   if (q->temp_g_bits) {
     free(q->temp_g_bits);
   }
+  if (q->temp_cb_llr) {
+    free(q->temp_cb_llr);
+  }
   if (q->ul_interleaver) {
     free(q->ul_interleaver);
   }
@@ -406,11 +417,25 @@ bool decode_tb_cb(srsran_sch_t*           q,
         rp   = (cb_segm->C - gamma) * n_e + (cb_idx - (cb_segm->C - gamma)) * n_e2;
       }
 
+      // 4-bit soft-buffers are expanded, combined and stored again, the decoder works on the 8-bit copy
+      int8_t*  w_b   = (int8_t*)softbuffer->buffer_f[cb_idx];
+      uint32_t w_len = SRSRAN_MIN(SCH_CB_LLR_LEN(cb_len), softbuffer->max_cb_size);
+      if (softbuffer->llr_format == SRSRAN_SOFTBUFFER_LLR_4BIT) {
+        w_b = q->temp_cb_llr;
+        if (srsran_softbuffer_rx_cb_unpack(softbuffer, cb_idx, w_b, w_len) < SRSRAN_SUCCESS) {
+          ERROR("Error expanding soft-buffer");
+          return SRSRAN_ERROR;
+        }
+      }
+
       if (q->llr_is_8bit) {
-        if (srsran_rm_turbo_rx_lut_8bit(&e_bits_b[rp], (int8_t*)softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
+        if (srsran_rm_turbo_rx_lut_8bit(&e_bits_b[rp], w_b, n_e2, cb_len_idx, rv)) {
           ERROR("Error in rate matching");
           return SRSRAN_ERROR;
         }
+        if (softbuffer->llr_format == SRSRAN_SOFTBUFFER_LLR_4BIT) {
+          srsran_softbuffer_rx_cb_pack(softbuffer, cb_idx, w_b, w_len);
+        }
       } else {
         if (srsran_rm_turbo_rx_lut(&e_bits_s[rp], softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
           ERROR("Error in rate matching");
@@ -425,7 +450,7 @@ bool decode_tb_cb(srsran_sch_t*           q,
       uint32_t cb_noi     = 0;
       do {
         if (q->llr_is_8bit) {
-          srsran_tdec_iteration_8bit(&q->decoder, (int8_t*)softbuffer->buffer_f[cb_idx], &data[cb_idx * rlen / 8]);
+          srsran_tdec_iteration_8bit(&q->decoder, w_b, &data[cb_idx * rlen / 8]);
         } else {
           srsran_tdec_iteration(&q->decoder, softbuffer->buffer_f[cb_idx], &data[cb_idx * rlen / 8]);
         }
@@ -544,6 +569,18 @@ static int decode_tb(srsran_sch_t*           q,
     return SRSRAN_ERROR_INVALID_INPUTS;
   }
 
+  // Soft bits stored in less than 16 bit can only be combined by the 8-bit decoder
+  if (softbuffer->llr_format != SRSRAN_SOFTBUFFER_LLR_16BIT && !q->llr_is_8bit) {
+    ERROR("Soft-buffers with 8-bit or 4-bit soft bits require the 8-bit turbo decoder");
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Attach the code blocks of pool backed softbuffers
+  if (srsran_softbuffer_rx_reserve(softbuffer, cb_segm->C) < SRSRAN_SUCCESS) {
+    ERROR("Error reserving %d code blocks in the softbuffer pool", cb_segm->C);
+    return SRSRAN_ERROR;
+  }
+
   // Process Codeblocks
   bool cb_crc_ok = decode_tb_cb(q, softbuffer, cb_segm, Qm, rv, nof_e_bits, e_bits, data);
 
@@ -26,6 +26,7 @@
 #include "srsran/phy/fec/ldpc/ldpc_rm.h"
 #include "srsran/phy/phch/ra_nr.h"
 #include "srsran/phy/utils/bit.h"
+#include "srsran/phy/utils/cpu.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/vector.h"
 
@@ -225,17 +226,16 @@ int srsran_sch_nr_init_tx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
 
   srsran_ldpc_encoder_type_t encoder_type = SRSRAN_LDPC_ENCODER_C;
 
-#ifdef LV_HAVE_AVX512
   if (!args->disable_simd) {
-    encoder_type = SRSRAN_LDPC_ENCODER_AVX512;
-  }
-#else // LV_HAVE_AVX512
 #ifdef LV_HAVE_AVX2
-  if (!args->disable_simd) {
     encoder_type = SRSRAN_LDPC_ENCODER_AVX2;
-  }
 #endif // LV_HAVE_AVX2
-#endif // LV_HAVE_AVX612
+#ifdef SRSRAN_AVX512_KERNELS
+    if (srsran_cpu_has_avx512()) {
+      encoder_type = SRSRAN_LDPC_ENCODER_AVX512;
+    }
+#endif // SRSRAN_AVX512_KERNELS
+  }
 
   // Iterate over all possible lifting sizes
   for (uint16_t ls = 0; ls <= MAX_LIFTSIZE; ls++) {
@@ -290,17 +290,16 @@ int srsran_sch_nr_init_rx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
   srsran_ldpc_decoder_type_t decoder_type =
       args->decoder_use_flooded ? SRSRAN_LDPC_DECODER_C_FLOOD : SRSRAN_LDPC_DECODER_C;
 
-#ifdef LV_HAVE_AVX512
   if (!args->disable_simd) {
-    decoder_type = args->decoder_use_flooded ? SRSRAN_LDPC_DECODER_C_AVX512_FLOOD : SRSRAN_LDPC_DECODER_C_AVX512;
-  }
-#else // LV_HAVE_AVX512
 #ifdef LV_HAVE_AVX2
-  if (!args->disable_simd) {
     decoder_type = args->decoder_use_flooded ? SRSRAN_LDPC_DECODER_C_AVX2_FLOOD : SRSRAN_LDPC_DECODER_C_AVX2;
-  }
 #endif // LV_HAVE_AVX2
-#endif // LV_HAVE_AVX512
+#ifdef SRSRAN_AVX512_KERNELS
+    if (srsran_cpu_has_avx512()) {
+      decoder_type = args->decoder_use_flooded ? SRSRAN_LDPC_DECODER_C_AVX512_FLOOD : SRSRAN_LDPC_DECODER_C_AVX512;
+    }
+#endif // SRSRAN_AVX512_KERNELS
+  }
 
   // If the scaling factor is not provided use a default value that allows decoding all possible combinations of nPRB
   // and MCS indexes for all possible MCS tables
@@ -356,6 +355,11 @@ int srsran_sch_nr_init_rx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
     return SRSRAN_ERROR;
   }
 
+  q->temp_llr = srsran_vec_i8_malloc(SRSRAN_LDPC_MAX_LEN_ENCODED_CB);
+  if (!q->temp_llr) {
+    return SRSRAN_ERROR;
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -380,6 +384,9 @@ void srsran_sch_nr_free(srsran_sch_nr_t* q)
   if (q->temp_cb) {
     free(q->temp_cb);
   }
+  if (q->temp_llr) {
+    free(q->temp_llr);
+  }
 
   for (uint16_t ls = 0; ls <= MAX_LIFTSIZE; ls++) {
     if (q->encoder_bg1[ls]) {
@@ -603,6 +610,12 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
     return SRSRAN_ERROR;
   }
 
+  // Attach the code blocks of pool backed softbuffers
+  if (srsran_softbuffer_rx_reserve(tb->softbuffer.rx, cfg.C) < SRSRAN_SUCCESS) {
+    ERROR("Error reserving %d code blocks in the softbuffer pool", cfg.C);
+    return SRSRAN_ERROR;
+  }
+
   // Counter of code blocks that have matched CRC
   uint32_t cb_ok = 0;
   res->crc       = false;
@@ -647,6 +660,16 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
                 tb->rv,
                 cfg.Qm,
                 cfg.Nref);
+    // 4-bit soft-buffers are expanded, combined and stored again, the decoder works on the 8-bit copy
+    uint32_t rm_len = decoder->liftN - 2 * cfg.Z;
+    if (tb->softbuffer.rx->llr_format == SRSRAN_SOFTBUFFER_LLR_4BIT) {
+      if (srsran_softbuffer_rx_cb_unpack(tb->softbuffer.rx, r, q->temp_llr, rm_len) < SRSRAN_SUCCESS) {
+        ERROR("Error expanding soft-buffer");
+        return SRSRAN_ERROR;
+      }
+      rm_buffer = q->temp_llr;
+    }
+
     int n_llr =
         srsran_ldpc_rm_rx_c(&q->rx_rm, input_ptr, rm_buffer, E, cfg.F, cfg.bg, cfg.Z, tb->rv, tb->mod, cfg.Nref);
     if (n_llr < SRSRAN_SUCCESS) {
@@ -654,6 +677,10 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
       return SRSRAN_ERROR;
     }
 
+    if (tb->softbuffer.rx->llr_format == SRSRAN_SOFTBUFFER_LLR_4BIT) {
+      srsran_softbuffer_rx_cb_pack(tb->softbuffer.rx, r, rm_buffer, rm_len);
+    }
+
     // Select CB or TB early stop CRC
     srsran_crc_t* crc = (cfg.L_tb == 16) ? &q->crc_tb_16 : &q->crc_tb_24;
     if (cfg.L_cb) {
@@ -709,6 +736,9 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
   uint32_t checksum2  = 0;
   uint8_t* output_ptr = res->payload;
 
+  // The TB CRC is computed while the CBs are appended, their data is still in cache
+  srsran_crc_set_init(crc_tb, 0);
+
   for (uint32_t r = 0; r < cfg.C; r++) {
     uint32_t cb_len = cfg.Kp - cfg.L_cb;
 
@@ -719,6 +749,9 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
 
     // Append CB
     srsran_vec_u8_copy(output_ptr, tb->softbuffer.rx->data[r], cb_len / 8);
+    if (cfg.C > 1) {
+      srsran_crc_checksum_put_bytes(crc_tb, output_ptr, cb_len / 8);
+    }
     output_ptr += cb_len / 8;
 
     // Compute TB CRC for last block
@@ -736,7 +769,7 @@ static int sch_nr_decode(srsran_sch_nr_t*        q,
     res->crc = true;
   } else {
     // More than one
-    uint32_t checksum1 = srsran_crc_checksum_byte(crc_tb, res->payload, tb->tbs);
+    uint32_t checksum1 = (uint32_t)srsran_crc_checksum_get(crc_tb);
     res->crc           = (checksum1 == checksum2);
     SCH_INFO_RX("TB: TBS=%d; CRC={%06x, %06x}", tb->tbs, checksum1, checksum2);
   }
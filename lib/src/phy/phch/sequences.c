@@ -59,14 +59,14 @@ int srsran_sequence_pdcch(srsran_sequence_t* seq, uint32_t nslot, uint32_t cell_
 /**
  * 36.211 6.3.1
  */
-static inline uint32_t sequence_pdsch_seed(uint16_t rnti, int q, uint32_t nslot, uint32_t cell_id)
+uint32_t srsran_sequence_pdsch_seed(uint16_t rnti, int q, uint32_t nslot, uint32_t cell_id)
 {
   return (rnti << 14) + (q << 13) + ((nslot / 2) << 9) + cell_id;
 }
 
 int srsran_sequence_pdsch(srsran_sequence_t* seq, uint16_t rnti, int q, uint32_t nslot, uint32_t cell_id, uint32_t len)
 {
-  return srsran_sequence_LTE_pr(seq, len, sequence_pdsch_seed(rnti, q, nslot, cell_id));
+  return srsran_sequence_LTE_pr(seq, len, srsran_sequence_pdsch_seed(rnti, q, nslot, cell_id));
 }
 
 void srsran_sequence_pdsch_apply_pack(const uint8_t* in,
@@ -77,7 +77,7 @@ void srsran_sequence_pdsch_apply_pack(const uint8_t* in,
                                       uint32_t       cell_id,
                                       uint32_t       len)
 {
-  srsran_sequence_apply_packed(in, out, len, sequence_pdsch_seed(rnti, q, nslot, cell_id));
+  srsran_sequence_apply_packed(in, out, len, srsran_sequence_pdsch_seed(rnti, q, nslot, cell_id));
 }
 
 void srsran_sequence_pdsch_apply_f(const float* in,
@@ -88,7 +88,7 @@ void srsran_sequence_pdsch_apply_f(const float* in,
                                    uint32_t     cell_id,
                                    uint32_t     len)
 {
-  srsran_sequence_apply_f(in, out, len, sequence_pdsch_seed(rnti, q, nslot, cell_id));
+  srsran_sequence_apply_f(in, out, len, srsran_sequence_pdsch_seed(rnti, q, nslot, cell_id));
 }
 
 void srsran_sequence_pdsch_apply_s(const int16_t* in,
@@ -99,7 +99,7 @@ void srsran_sequence_pdsch_apply_s(const int16_t* in,
                                    uint32_t       cell_id,
                                    uint32_t       len)
 {
-  srsran_sequence_apply_s(in, out, len, sequence_pdsch_seed(rnti, q, nslot, cell_id));
+  srsran_sequence_apply_s(in, out, len, srsran_sequence_pdsch_seed(rnti, q, nslot, cell_id));
 }
 
 void srsran_sequence_pdsch_apply_c(const int8_t* in,
@@ -110,20 +110,20 @@ void srsran_sequence_pdsch_apply_c(const int8_t* in,
                                    uint32_t      cell_id,
                                    uint32_t      len)
 {
-  srsran_sequence_apply_c(in, out, len, sequence_pdsch_seed(rnti, q, nslot, cell_id));
+  srsran_sequence_apply_c(in, out, len, srsran_sequence_pdsch_seed(rnti, q, nslot, cell_id));
 }
 
 /**
  * 36.211 5.3.1
  */
-static inline uint32_t sequence_pusch_seed(uint16_t rnti, uint32_t nslot, uint32_t cell_id)
+uint32_t srsran_sequence_pusch_seed(uint16_t rnti, uint32_t nslot, uint32_t cell_id)
 {
   return (rnti << 14) + ((nslot / 2) << 9) + cell_id;
 }
 
 int srsran_sequence_pusch(srsran_sequence_t* seq, uint16_t rnti, uint32_t nslot, uint32_t cell_id, uint32_t len)
 {
-  return srsran_sequence_LTE_pr(seq, len, sequence_pusch_seed(rnti, nslot, cell_id));
+  return srsran_sequence_LTE_pr(seq, len, srsran_sequence_pusch_seed(rnti, nslot, cell_id));
 }
 
 void srsran_sequence_pusch_apply_pack(const uint8_t* in,
@@ -133,7 +133,7 @@ void srsran_sequence_pusch_apply_pack(const uint8_t* in,
                                       uint32_t       cell_id,
                                       uint32_t       len)
 {
-  srsran_sequence_apply_packed(in, out, len, sequence_pusch_seed(rnti, nslot, cell_id));
+  srsran_sequence_apply_packed(in, out, len, srsran_sequence_pusch_seed(rnti, nslot, cell_id));
 }
 
 void srsran_sequence_pusch_apply_s(const int16_t* in,
@@ -143,14 +143,14 @@ void srsran_sequence_pusch_apply_s(const int16_t* in,
                                    uint32_t       cell_id,
                                    uint32_t       len)
 {
-  srsran_sequence_apply_s(in, out, len, sequence_pusch_seed(rnti, nslot, cell_id));
+  srsran_sequence_apply_s(in, out, len, srsran_sequence_pusch_seed(rnti, nslot, cell_id));
 }
 
 void srsran_sequence_pusch_gen_unpack(uint8_t* out, uint16_t rnti, uint32_t nslot, uint32_t cell_id, uint32_t len)
 {
   srsran_vec_u8_zero(out, len);
 
-  srsran_sequence_apply_bit(out, out, len, sequence_pusch_seed(rnti, nslot, cell_id));
+  srsran_sequence_apply_bit(out, out, len, srsran_sequence_pusch_seed(rnti, nslot, cell_id));
 }
 
 void srsran_sequence_pusch_apply_c(const int8_t* in,
@@ -160,7 +160,7 @@ void srsran_sequence_pusch_apply_c(const int8_t* in,
                                    uint32_t      cell_id,
                                    uint32_t      len)
 {
-  srsran_sequence_apply_c(in, out, len, sequence_pusch_seed(rnti, nslot, cell_id));
+  srsran_sequence_apply_c(in, out, len, srsran_sequence_pusch_seed(rnti, nslot, cell_id));
 }
 
 /**
@@ -55,6 +55,7 @@ static char*       input_file                   = NULL;
 static int         M                            = 1;
 static bool        enable_256qam                = false;
 static bool        use_8_bit                    = false;
+static uint32_t    llr_bits                     = 16;
 
 void usage(char* prog)
 {
@@ -64,6 +65,7 @@ void usage(char* prog)
   printf("\t-M MCS2 [Default %d]\n", mcs[1]);
   printf("\t-c cell id [Default %d]\n", cell.id);
   printf("\t-b Use 8-bit LLR [Default 16-bit]\n");
+  printf("\t-L Soft-buffer LLR width in bits (16, 8 or 4), 8 and 4 require -b [Default %d]\n", llr_bits);
   printf("\t-s subframe [Default %d]\n", subframe);
   printf("\t-r rv_idx [Default %d]\n", rv_idx[0]);
   printf("\t-t rv_idx2 [Default %d]\n", rv_idx[1]);
@@ -83,7 +85,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "fmMcsbrtRFpnqawvXxj")) != -1) {
+  while ((opt = getopt(argc, argv, "fmMcsbrtRFpnqawvXxjL")) != -1) {
     switch (opt) {
       case 'f':
         input_file = argv[optind];
@@ -94,6 +96,9 @@ void parse_args(int argc, char** argv)
       case 'b':
         use_8_bit = true;
         break;
+      case 'L':
+        llr_bits = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'M':
         mcs[1] = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
@@ -349,7 +354,14 @@ int main(int argc, char** argv)
       goto quit;
     }
 
-    if (srsran_softbuffer_rx_init(softbuffers_rx[i], cell.nof_prb)) {
+    srsran_softbuffer_llr_t llr_format = SRSRAN_SOFTBUFFER_LLR_16BIT;
+    if (srsran_softbuffer_llr_from_nof_bits(llr_bits, &llr_format) < SRSRAN_SUCCESS) {
+      goto quit;
+    }
+
+    uint32_t max_tbs = (uint32_t)srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, cell.nof_prb);
+    uint32_t max_cb  = max_tbs / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1;
+    if (srsran_softbuffer_rx_init_guru_llr(softbuffers_rx[i], max_cb, SOFTBUFFER_SIZE, llr_format)) {
       ERROR("Error initiating RX soft buffer");
       goto quit;
     }
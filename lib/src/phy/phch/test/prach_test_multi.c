@@ -45,6 +45,7 @@ uint32_t n_seqs           = 64;
 uint32_t num_ra_preambles = 0; // use default
 
 bool freq_domain_offset_calc       = false;
+bool batch_detection               = false;
 bool test_successive_cancellation  = false;
 bool test_offset_calculation       = false;
 bool stagger_prach_power_and_phase = false;
@@ -63,12 +64,13 @@ void usage(char* prog)
   printf("\t-s test_successive_cancellation  [Default false]\n");
   printf("\t-O test_offset_calculation  [Default false]\n");
   printf("\t-F freq_domain_offset_calc [Default false]\n");
+  printf("\t-B batch_detection [Default false]\n");
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "NfrznioSsOF")) != -1) {
+  while ((opt = getopt(argc, argv, "NfrznioSsOFB")) != -1) {
     switch (opt) {
       case 'N':
         nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -103,6 +105,9 @@ void parse_args(int argc, char** argv)
       case 'F':
         freq_domain_offset_calc = true;
         break;
+      case 'B':
+        batch_detection = true;
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -178,6 +183,7 @@ int main(int argc, char** argv)
   prach_cfg.num_ra_preambles               = num_ra_preambles;
   prach_cfg.enable_successive_cancellation = test_successive_cancellation;
   prach_cfg.enable_freq_domain_offset_calc = freq_domain_offset_calc;
+  prach_cfg.enable_batch_detection         = batch_detection;
 
   int srate   = srsran_sampling_freq_hz(nof_prb);
   int divisor = srate / PRACH_SRATE;
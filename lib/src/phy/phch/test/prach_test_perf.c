@@ -0,0 +1,344 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * \file prach_test_perf.c
+ * \brief Throughput test for the LTE PRACH detector.
+ *
+ * This program generates several PRACH occasions, each of them carrying a number of simultaneous preambles with
+ * random sequence indices and delays, and measures how many occasions per second are processed by the root by root
+ * detector and by the batched detector. The batched detector can process the occasions from several threads, each of
+ * them with its own PRACH object. Both detectors must report exactly the same preambles.
+ *
+ * The simulation setup can be controlled by means of the following arguments.
+ *   - <tt>-N num</tt>: sets the number of processed occasions to \c num.
+ *   - <tt>-n num</tt>: sets the total number of UL PRBs to \c num.
+ *   - <tt>-f num</tt>: sets the PRACH configuration index to \c num.
+ *   - <tt>-z num</tt>: sets the zero correlation zone configuration to \c num.
+ *   - <tt>-u num</tt>: sets the number of simultaneous preambles in each occasion to \c num.
+ *   - <tt>-t num</tt>: sets the number of threads running the batched detector to \c num.
+ *   - <tt>-s val</tt>: sets the SNR to \c val dB.
+ *   - <tt>-v </tt>: activates verbose output.
+ *
+ * Example:
+ * \code{.cpp}
+ * prach_test_perf -n 100 -u 16 -t 2
+ * \endcode
+ */
+
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/phy/utils/random.h"
+#include "srsran/srsran.h"
+
+#define MAX_LEN 70176
+#define MAX_THREADS 16
+#define NOF_BUFFERS 8
+#define MAX_DETECTIONS 64
+
+static uint32_t nof_prb        = 25;
+static uint32_t config_idx     = 0;
+static uint32_t zero_corr_zone = 1;
+static uint32_t nof_preambles  = 8;
+static uint32_t nof_threads    = 1;
+static int      nof_occasions  = 100;
+static float    snr_dB         = 10.0F;
+static bool     is_verbose     = false;
+
+// Received occasions, shared by all the detectors
+static uint32_t detect_len           = 0;
+static cf_t*    buffers[NOF_BUFFERS] = {};
+
+typedef struct {
+  srsran_prach_cfg_t cfg;
+  uint32_t           thread_idx;
+  int                ret;
+} worker_args_t;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s\n", prog);
+  printf("\t-N Number of occasions [Default %d]\n", nof_occasions);
+  printf("\t-n Uplink number of PRB [Default %d]\n", nof_prb);
+  printf("\t-f PRACH configuration index [Default %d]\n", config_idx);
+  printf("\t-z Zero correlation zone config [Default %d]\n", zero_corr_zone);
+  printf("\t-u Number of simultaneous preambles [Default %d]\n", nof_preambles);
+  printf("\t-t Number of batched detector threads [Default %d]\n", nof_threads);
+  printf("\t-s SNR in dB [Default %.2f]\n", snr_dB);
+  printf("\t-v Activate verbose output [Default %s]\n", is_verbose ? "true" : "false");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt = 0;
+  while ((opt = getopt(argc, argv, "N:n:f:z:u:t:s:v")) != -1) {
+    switch (opt) {
+      case 'N':
+        nof_occasions = (int)strtol(optarg, NULL, 10);
+        break;
+      case 'n':
+        nof_prb = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'f':
+        config_idx = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'z':
+        zero_corr_zone = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'u':
+        nof_preambles = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 't':
+        nof_threads = SRSRAN_MIN((uint32_t)strtol(optarg, NULL, 10), MAX_THREADS);
+        break;
+      case 's':
+        snr_dB = strtof(optarg, NULL);
+        break;
+      case 'v':
+        is_verbose = true;
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static double elapsed_us(struct timeval t[3])
+{
+  get_time_interval(t);
+  return t[0].tv_sec * 1e6 + t[0].tv_usec;
+}
+
+// Fills every buffer with the sum of several preambles with random sequence index and delay plus noise
+static int generate_occasions(srsran_prach_t* prach, srsran_random_t random_gen)
+{
+  cf_t*    preamble  = srsran_vec_cf_malloc(MAX_LEN);
+  uint32_t max_delay = SRSRAN_MAX(prach->N_cs, 1) / 2;
+  float    noise_var = srsran_convert_dB_to_power(-snr_dB);
+
+  if (preamble == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t b = 0; b < NOF_BUFFERS; b++) {
+    srsran_vec_cf_zero(buffers[b], MAX_LEN);
+    for (uint32_t u = 0; u < nof_preambles; u++) {
+      uint32_t seq_index = (uint32_t)srsran_random_uniform_int_dist(random_gen, 0, 63);
+      uint32_t delay     = (uint32_t)srsran_random_uniform_int_dist(random_gen, 0, (int)max_delay);
+      if (srsran_prach_gen(prach, seq_index, 0, preamble) < SRSRAN_SUCCESS) {
+        free(preamble);
+        return SRSRAN_ERROR;
+      }
+      srsran_vec_sum_ccc(&buffers[b][delay], preamble, &buffers[b][delay], prach->N_cp + prach->N_seq);
+    }
+    srsran_ch_awgn_c(buffers[b], buffers[b], noise_var, MAX_LEN);
+  }
+
+  free(preamble);
+  return SRSRAN_SUCCESS;
+}
+
+// Both detectors must report the same preambles, offsets and peak to average ratios
+static int compare_detectors(srsran_prach_t* serial, srsran_prach_t* batch)
+{
+  uint32_t indices[2][MAX_DETECTIONS];
+  float    offsets[2][MAX_DETECTIONS];
+  float    p2avg[2][MAX_DETECTIONS];
+  uint32_t n_indices[2] = {};
+
+  for (uint32_t b = 0; b < NOF_BUFFERS; b++) {
+    cf_t* signal = &buffers[b][serial->N_cp];
+    srsran_prach_detect_offset(serial, 0, signal, detect_len, indices[0], offsets[0], p2avg[0], &n_indices[0]);
+    srsran_prach_detect_offset(batch, 0, signal, detect_len, indices[1], offsets[1], p2avg[1], &n_indices[1]);
+
+    if (is_verbose) {
+      printf("Occasion %d: detected %d/%d preambles\n", b, n_indices[0], n_indices[1]);
+    }
+    if (n_indices[0] != n_indices[1]) {
+      ERROR("Occasion %d: detected %d preambles root by root and %d batched", b, n_indices[0], n_indices[1]);
+      return SRSRAN_ERROR;
+    }
+    for (uint32_t i = 0; i < n_indices[0]; i++) {
+      if (indices[0][i] != indices[1][i] || fabsf(offsets[0][i] - offsets[1][i]) > 1e-9f ||
+          fabsf(p2avg[0][i] - p2avg[1][i]) > 1e-3f * p2avg[0][i]) {
+        ERROR("Occasion %d: detection %d does not match (preamble %d/%d; offset %.2f/%.2f us; p2avg %.2f/%.2f)",
+              b,
+              i,
+              indices[0][i],
+              indices[1][i],
+              offsets[0][i] * 1e6,
+              offsets[1][i] * 1e6,
+              p2avg[0][i],
+              p2avg[1][i]);
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+// Processes the occasions assigned to one thread with its own batched detector
+static void* batch_worker(void* arg)
+{
+  worker_args_t* args = (worker_args_t*)arg;
+  srsran_prach_t prach;
+  uint32_t       indices[MAX_DETECTIONS];
+  float          offsets[MAX_DETECTIONS];
+  uint32_t       n_indices = 0;
+
+  args->ret = SRSRAN_ERROR;
+  if (srsran_prach_init(&prach, srsran_symbol_sz(nof_prb)) || srsran_prach_set_cfg(&prach, &args->cfg, nof_prb)) {
+    ERROR("Error initiating PRACH object");
+    return NULL;
+  }
+
+  for (int i = (int)args->thread_idx; i < nof_occasions; i += (int)nof_threads) {
+    cf_t* signal = &buffers[i % NOF_BUFFERS][prach.N_cp];
+    srsran_prach_detect_offset(&prach, 0, signal, detect_len, indices, offsets, NULL, &n_indices);
+  }
+
+  srsran_prach_free(&prach);
+  args->ret = SRSRAN_SUCCESS;
+  return NULL;
+}
+
+int main(int argc, char** argv)
+{
+  int                ret = SRSRAN_ERROR;
+  srsran_prach_t     serial;
+  srsran_prach_t     batch;
+  srsran_prach_cfg_t prach_cfg;
+  srsran_random_t    random_gen = srsran_random_init(0x1234);
+  pthread_t          threads[MAX_THREADS];
+  worker_args_t      worker_args[MAX_THREADS];
+  struct timeval     t[3];
+  uint32_t           indices[MAX_DETECTIONS];
+  float              offsets[MAX_DETECTIONS];
+  uint32_t           n_indices = 0;
+
+  parse_args(argc, argv);
+  nof_threads = SRSRAN_MAX(nof_threads, 1);
+
+  ZERO_OBJECT(serial);
+  ZERO_OBJECT(batch);
+  ZERO_OBJECT(prach_cfg);
+  prach_cfg.config_idx     = config_idx;
+  prach_cfg.root_seq_idx   = 0;
+  prach_cfg.zero_corr_zone = zero_corr_zone;
+
+  for (uint32_t b = 0; b < NOF_BUFFERS; b++) {
+    buffers[b] = srsran_vec_cf_malloc(MAX_LEN);
+    if (buffers[b] == NULL) {
+      ERROR("Error allocating memory");
+      goto clean_exit;
+    }
+  }
+
+  if (srsran_prach_init(&serial, srsran_symbol_sz(nof_prb)) || srsran_prach_set_cfg(&serial, &prach_cfg, nof_prb)) {
+    ERROR("Error initiating PRACH object");
+    goto clean_exit;
+  }
+  prach_cfg.enable_batch_detection = true;
+  if (srsran_prach_init(&batch, srsran_symbol_sz(nof_prb)) || srsran_prach_set_cfg(&batch, &prach_cfg, nof_prb)) {
+    ERROR("Error initiating PRACH object");
+    goto clean_exit;
+  }
+
+  detect_len = serial.N_seq;
+  if (serial.f == 2 || serial.f == 3) {
+    detect_len /= 2;
+  }
+
+  if (generate_occasions(&serial, random_gen) < SRSRAN_SUCCESS) {
+    ERROR("Error generating PRACH occasions");
+    goto clean_exit;
+  }
+
+  if (compare_detectors(&serial, &batch) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  // Root by root detector
+  gettimeofday(&t[1], NULL);
+  for (int i = 0; i < nof_occasions; i++) {
+    cf_t* signal = &buffers[i % NOF_BUFFERS][serial.N_cp];
+    srsran_prach_detect_offset(&serial, 0, signal, detect_len, indices, offsets, NULL, &n_indices);
+  }
+  gettimeofday(&t[2], NULL);
+  double serial_us = elapsed_us(t);
+
+  // Batched detector, the occasions are split across threads
+  gettimeofday(&t[1], NULL);
+  for (uint32_t i = 0; i < nof_threads; i++) {
+    worker_args[i].cfg        = prach_cfg;
+    worker_args[i].thread_idx = i;
+    worker_args[i].ret        = SRSRAN_ERROR;
+    if (pthread_create(&threads[i], NULL, batch_worker, &worker_args[i])) {
+      ERROR("Error creating thread");
+      goto clean_exit;
+    }
+  }
+  for (uint32_t i = 0; i < nof_threads; i++) {
+    pthread_join(threads[i], NULL);
+    if (worker_args[i].ret < SRSRAN_SUCCESS) {
+      goto clean_exit;
+    }
+  }
+  gettimeofday(&t[2], NULL);
+  double batch_us = elapsed_us(t);
+
+  printf("PRACH throughput: format %d, %d PRB, N_cs=%d, %d roots, %d preambles per occasion, SNR=%.1f dB\n",
+         serial.f,
+         nof_prb,
+         serial.N_cs,
+         serial.num_ra_preambles,
+         nof_preambles,
+         snr_dB);
+  printf("  Root by root: %.1f us per occasion, %.1f occasions/s\n",
+         serial_us / nof_occasions,
+         nof_occasions * 1e6 / serial_us);
+  printf("  Batched (%d threads): %.1f us per occasion, %.1f occasions/s\n",
+         nof_threads,
+         batch_us / nof_occasions,
+         nof_occasions * 1e6 / batch_us);
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_prach_free(&serial);
+  srsran_prach_free(&batch);
+  for (uint32_t b = 0; b < NOF_BUFFERS; b++) {
+    if (buffers[b]) {
+      free(buffers[b]);
+    }
+  }
+  srsran_random_free(random_gen);
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Failed");
+  return ret;
+}
@@ -33,6 +33,7 @@ static uint32_t            n_prb     = 0;  // Set to 0 for steering
 static uint32_t            mcs       = 30; // Set to 30 for steering
 static uint32_t            rv        = 4;  // Set to 30 for steering
 static srsran_sch_cfg_nr_t pdsch_cfg = {};
+static uint32_t            llr_bits  = 16; // Soft-buffer LLR width
 
 static void usage(char* prog)
 {
@@ -44,13 +45,14 @@ static void usage(char* prog)
   printf("\t-T Provide MCS table (64qam, 256qam, 64qamLowSE) [Default %s]\n",
          srsran_mcs_table_to_str(pdsch_cfg.sch_cfg.mcs_table));
   printf("\t-L Provide number of layers [Default %d]\n", carrier.max_mimo_layers);
+  printf("\t-b Soft-buffer LLR width in bits (16, 8 or 4) [Default %d]\n", llr_bits);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "PpmTLvr")) != -1) {
+  while ((opt = getopt(argc, argv, "PpmTLvrb")) != -1) {
     switch (opt) {
       case 'P':
         carrier.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -70,6 +72,9 @@ int parse_args(int argc, char** argv)
       case 'L':
         carrier.max_mimo_layers = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
+      case 'b':
+        llr_bits = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -139,8 +144,13 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
-  if (srsran_softbuffer_rx_init_guru(&softbuffer_rx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB) <
-      SRSRAN_SUCCESS) {
+  srsran_softbuffer_llr_t llr_format = SRSRAN_SOFTBUFFER_LLR_16BIT;
+  if (srsran_softbuffer_llr_from_nof_bits(llr_bits, &llr_format) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  if (srsran_softbuffer_rx_init_guru_llr(
+          &softbuffer_rx, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB, llr_format) < SRSRAN_SUCCESS) {
     ERROR("Error init soft-buffer");
     goto clean_exit;
   }
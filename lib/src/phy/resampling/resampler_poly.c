@@ -0,0 +1,295 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <srsran/phy/utils/debug.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "srsran/phy/resampling/resampler.h"
+#include "srsran/phy/utils/simd.h"
+#include "srsran/phy/utils/vector.h"
+
+/**
+ * Kaiser window shape parameter, it gives about 50 dB of stop-band attenuation
+ */
+#define RESAMPLER_POLY_KAISER_BETA 5.0
+
+/**
+ * Number of floats of every filter phase, the real and imaginary parts are multiplied by the same tap
+ */
+#define RESAMPLER_POLY_PHASE_LEN (2 * SRSRAN_RESAMPLER_POLY_NOF_TAPS)
+
+#if SRSRAN_SIMD_F_SIZE && (RESAMPLER_POLY_PHASE_LEN % (2 * SRSRAN_SIMD_F_SIZE))
+#error "The number of polyphase filter taps must be a multiple of the SIMD size"
+#endif
+
+static uint32_t resampler_poly_gcd(uint32_t a, uint32_t b)
+{
+  while (b != 0) {
+    uint32_t t = a % b;
+    a          = b;
+    b          = t;
+  }
+  return a;
+}
+
+// Zeroth order modified Bessel function of the first kind, used by the Kaiser window
+static double resampler_poly_bessel_i0(double x)
+{
+  double sum  = 1.0;
+  double term = 1.0;
+  for (uint32_t k = 1; k < 32; k++) {
+    term *= (x / (2.0 * k)) * (x / (2.0 * k));
+    sum += term;
+  }
+  return sum;
+}
+
+/*
+ * Designs a Kaiser windowed sinc prototype filter at the interpolated rate, its cut-off is the Nyquist frequency of the
+ * lowest of the input and output rates. The taps are rearranged in phases, so that the output sample with phase p is
+ * the dot product between the phase p and the last SRSRAN_RESAMPLER_POLY_NOF_TAPS input samples in time order.
+ */
+static void resampler_poly_design(srsran_resampler_poly_t* q)
+{
+  uint32_t L  = q->interp;
+  uint32_t N  = L * SRSRAN_RESAMPLER_POLY_NOF_TAPS;
+  double   fc = 0.5 / (double)SRSRAN_MAX(q->interp, q->decim);
+
+  double  sum = 0.0;
+  double* h   = calloc(N, sizeof(double));
+  if (h == NULL) {
+    return;
+  }
+
+  for (uint32_t j = 0; j < N; j++) {
+    double t    = (double)j - (double)(N - 1) / 2.0;
+    double x    = 2.0 * fc * t;
+    double sinc = (x == 0.0) ? 1.0 : sin(M_PI * x) / (M_PI * x);
+    double r    = 2.0 * (double)j / (double)(N - 1) - 1.0;
+    double w    = resampler_poly_bessel_i0(RESAMPLER_POLY_KAISER_BETA * sqrt(1.0 - r * r)) /
+               resampler_poly_bessel_i0(RESAMPLER_POLY_KAISER_BETA);
+    h[j] = 2.0 * fc * sinc * w;
+    sum += h[j];
+  }
+
+  // Every phase has unitary gain on average
+  double scale = (double)L / sum;
+
+  for (uint32_t p = 0; p < L; p++) {
+    float* phase = &q->filter[p * RESAMPLER_POLY_PHASE_LEN];
+    for (uint32_t k = 0; k < SRSRAN_RESAMPLER_POLY_NOF_TAPS; k++) {
+      float tap = (float)(h[p + k * L] * scale);
+
+      // The k-th tap is applied to the k-th newest input sample
+      uint32_t idx       = SRSRAN_RESAMPLER_POLY_NOF_TAPS - 1 - k;
+      phase[2 * idx]     = tap;
+      phase[2 * idx + 1] = tap;
+    }
+  }
+
+  free(h);
+}
+
+int srsran_resampler_poly_init(srsran_resampler_poly_t* q, uint32_t interp, uint32_t decim)
+{
+  if (q == NULL || interp == 0 || decim == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t gcd = resampler_poly_gcd(interp, decim);
+  interp /= gcd;
+  decim /= gcd;
+
+  if (interp > SRSRAN_RESAMPLER_POLY_MAX_FACTOR || decim > SRSRAN_RESAMPLER_POLY_MAX_FACTOR) {
+    ERROR("Resampling ratio %d/%d exceeds the maximum factor %d", interp, decim, SRSRAN_RESAMPLER_POLY_MAX_FACTOR);
+    return SRSRAN_ERROR_OUT_OF_BOUNDS;
+  }
+
+  if (q->filter != NULL && q->interp == interp && q->decim == decim) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // Make sure resampler is freed
+  srsran_resampler_poly_free(q);
+
+  q->interp = interp;
+  q->decim  = decim;
+  q->filter = srsran_vec_f_malloc(interp * RESAMPLER_POLY_PHASE_LEN);
+  if (q->filter == NULL) {
+    ERROR("Error allocating filter");
+    return SRSRAN_ERROR;
+  }
+
+  resampler_poly_design(q);
+
+  srsran_resampler_poly_reset_state(q);
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_resampler_poly_reset_state(srsran_resampler_poly_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  q->phase  = 0;
+  q->offset = 0;
+  srsran_vec_cf_zero(q->state, 2 * SRSRAN_RESAMPLER_POLY_NOF_TAPS);
+}
+
+float srsran_resampler_poly_get_delay(const srsran_resampler_poly_t* q)
+{
+  if (q == NULL || q->decim == 0) {
+    return 0.0f;
+  }
+
+  return (float)(q->interp * SRSRAN_RESAMPLER_POLY_NOF_TAPS - 1) / (float)(2 * q->decim);
+}
+
+uint32_t srsran_resampler_poly_nof_input(const srsran_resampler_poly_t* q, uint32_t nof_output)
+{
+  if (q == NULL || q->interp == 0 || nof_output == 0) {
+    return 0;
+  }
+
+  // Index of the newest input sample used by the last output sample, plus one
+  return q->offset + (uint32_t)(((uint64_t)q->phase + (uint64_t)(nof_output - 1) * q->decim) / q->interp) + 1;
+}
+
+uint32_t srsran_resampler_poly_nof_output(const srsran_resampler_poly_t* q, uint32_t nof_input)
+{
+  if (q == NULL || q->decim == 0 || nof_input <= q->offset) {
+    return 0;
+  }
+
+  uint64_t n = (uint64_t)(nof_input - q->offset) * q->interp - q->phase;
+  return (uint32_t)((n + q->decim - 1) / q->decim);
+}
+
+// Dot product between the interleaved complex samples and the duplicated real taps of a filter phase
+static inline cf_t resampler_poly_dot(const cf_t* x, const float* h)
+{
+  const float* xp = (const float*)x;
+  float        re = 0.0f;
+  float        im = 0.0f;
+
+#if SRSRAN_SIMD_F_SIZE
+  // Two accumulators break the dependency between consecutive additions
+  simd_f_t acc0 = srsran_simd_f_zero();
+  simd_f_t acc1 = srsran_simd_f_zero();
+  for (uint32_t i = 0; i < RESAMPLER_POLY_PHASE_LEN; i += 2 * SRSRAN_SIMD_F_SIZE) {
+    simd_f_t x0 = srsran_simd_f_loadu(&xp[i]);
+    simd_f_t x1 = srsran_simd_f_loadu(&xp[i + SRSRAN_SIMD_F_SIZE]);
+    acc0        = srsran_simd_f_add(acc0, srsran_simd_f_mul(x0, srsran_simd_f_load(&h[i])));
+    acc1        = srsran_simd_f_add(acc1, srsran_simd_f_mul(x1, srsran_simd_f_load(&h[i + SRSRAN_SIMD_F_SIZE])));
+  }
+
+  // Even lanes accumulate the real part and odd lanes the imaginary part
+  float sum[SRSRAN_SIMD_F_SIZE] __attribute__((aligned(SRSRAN_SIMD_BIT_ALIGN / 8)));
+  srsran_simd_f_store(sum, srsran_simd_f_add(acc0, acc1));
+  for (uint32_t i = 0; i < SRSRAN_SIMD_F_SIZE; i += 2) {
+    re += sum[i];
+    im += sum[i + 1];
+  }
+#else  /* SRSRAN_SIMD_F_SIZE */
+  for (uint32_t i = 0; i < RESAMPLER_POLY_PHASE_LEN; i += 2) {
+    re += xp[i] * h[i];
+    im += xp[i + 1] * h[i + 1];
+  }
+#endif /* SRSRAN_SIMD_F_SIZE */
+
+  return re + I * im;
+}
+
+uint32_t srsran_resampler_poly_run(srsran_resampler_poly_t* q, const cf_t* input, cf_t* output, uint32_t nof_input)
+{
+  if (q == NULL || q->filter == NULL) {
+    return 0;
+  }
+
+  // Feed zeros in blocks if there is no input
+  if (input == NULL) {
+    cf_t     zeros[SRSRAN_RESAMPLER_POLY_NOF_TAPS] = {};
+    uint32_t count                                 = 0;
+    for (uint32_t i = 0; i < nof_input; i += SRSRAN_RESAMPLER_POLY_NOF_TAPS) {
+      uint32_t n = SRSRAN_MIN(SRSRAN_RESAMPLER_POLY_NOF_TAPS, nof_input - i);
+      count += srsran_resampler_poly_run(q, zeros, (output != NULL) ? &output[count] : NULL, n);
+    }
+    return count;
+  }
+
+  const uint32_t nof_taps  = SRSRAN_RESAMPLER_POLY_NOF_TAPS;
+  const uint32_t step      = q->decim / q->interp;
+  const uint32_t step_frac = q->decim % q->interp;
+  uint32_t       phase     = q->phase;
+  uint32_t       offset    = q->offset;
+  uint32_t       count     = 0;
+
+  // Append the first input samples to the last ones, the output samples which use both are computed from the state
+  uint32_t nof_staged = SRSRAN_MIN(nof_input, nof_taps - 1);
+  srsran_vec_cf_copy(&q->state[nof_taps - 1], input, nof_staged);
+
+  while (offset < nof_input) {
+    const cf_t* x = (offset < nof_taps - 1) ? &q->state[offset] : &input[offset - (nof_taps - 1)];
+
+    if (output != NULL) {
+      output[count] = resampler_poly_dot(x, &q->filter[phase * RESAMPLER_POLY_PHASE_LEN]);
+    }
+    count++;
+
+    // Advance decim / interp input samples
+    offset += step;
+    phase += step_frac;
+    if (phase >= q->interp) {
+      phase -= q->interp;
+      offset++;
+    }
+  }
+
+  // Keep the last input samples for the next call
+  if (nof_input >= nof_taps - 1) {
+    srsran_vec_cf_copy(q->state, &input[nof_input - (nof_taps - 1)], nof_taps - 1);
+  } else {
+    memmove(q->state, &q->state[nof_input], (nof_taps - 1) * sizeof(cf_t));
+  }
+
+  q->phase  = phase;
+  q->offset = offset - nof_input;
+
+  return count;
+}
+
+void srsran_resampler_poly_free(srsran_resampler_poly_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->filter) {
+    free(q->filter);
+  }
+
+  memset(q, 0, sizeof(srsran_resampler_poly_t));
+}
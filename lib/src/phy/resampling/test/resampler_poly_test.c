@@ -0,0 +1,186 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/resampling/resampler.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <getopt.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+static uint32_t buffer_size = 23040;
+static uint32_t interp      = 4;
+static uint32_t decim       = 3;
+static uint32_t repetitions = 10;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [sidr]\n", prog);
+  printf("\t-s Input buffer size [Default %d]\n", buffer_size);
+  printf("\t-i Interpolation factor or output sampling rate [Default %d]\n", interp);
+  printf("\t-d Decimation factor or input sampling rate [Default %d]\n", decim);
+  printf("\t-r Number of repetitions for the throughput measurement [Default %d]\n", repetitions);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+
+  while ((opt = getopt(argc, argv, "sidrv")) != -1) {
+    switch (opt) {
+      case 's':
+        buffer_size = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'i':
+        interp = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'd':
+        decim = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  struct timeval          t[3] = {};
+  srsran_resampler_poly_t q    = {};
+  int                     ret  = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  if (srsran_resampler_poly_init(&q, interp, decim) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising resampler");
+    return SRSRAN_ERROR;
+  }
+  uint32_t L = q.interp;
+  uint32_t M = q.decim;
+
+  uint32_t max_output = srsran_resampler_poly_nof_output(&q, buffer_size);
+  cf_t*    input      = srsran_vec_cf_malloc(buffer_size);
+  cf_t*    output     = srsran_vec_cf_malloc(max_output);
+  cf_t*    output2    = srsran_vec_cf_malloc(max_output);
+  if (input == NULL || output == NULL || output2 == NULL) {
+    ERROR("Error allocating buffers");
+    goto clean_exit;
+  }
+
+  // Tone within the pass-band of both rates, in cycles per input sample
+  double freq = 0.2 * SRSRAN_MIN(1.0, (double)L / (double)M);
+  for (uint32_t i = 0; i < buffer_size; i++) {
+    input[i] = cexpf(I * (float)(2.0 * M_PI * freq * i));
+  }
+
+  // Process the whole buffer at once
+  uint32_t nof_output = srsran_resampler_poly_run(&q, input, output, buffer_size);
+  if (nof_output != max_output) {
+    ERROR("Wrong number of output samples (%d != %d)", nof_output, max_output);
+    goto clean_exit;
+  }
+
+  // Compare with the ideal resampled tone after the filter transient
+  double   delay     = (double)srsran_resampler_poly_get_delay(&q);
+  uint32_t transient = (uint32_t)ceil(2.0 * delay) + 1;
+  if (transient >= nof_output) {
+    ERROR("Buffer size is too short");
+    goto clean_exit;
+  }
+  double err = 0.0;
+  for (uint32_t n = transient; n < nof_output; n++) {
+    double phase = 2.0 * M_PI * freq * ((double)n - delay) * (double)M / (double)L;
+    err += pow(cabs(output[n] - cexp(I * phase)), 2.0);
+  }
+  err = sqrt(err / (nof_output - transient));
+
+  // Process the same buffer in blocks of different sizes, the result shall be identical
+  srsran_resampler_poly_reset_state(&q);
+  uint32_t count = 0;
+  for (uint32_t i = 0, block = 1; i < buffer_size; i += block, block = (block * 7 + 3) % 251) {
+    block = SRSRAN_MIN(block, buffer_size - i);
+
+    uint32_t expected = srsran_resampler_poly_nof_output(&q, block);
+    uint32_t n        = srsran_resampler_poly_run(&q, &input[i], &output2[count], block);
+    if (n != expected) {
+      ERROR("Wrong number of output samples for a block of %d (%d != %d)", block, n, expected);
+      goto clean_exit;
+    }
+    count += n;
+  }
+  if (count != nof_output || memcmp(output, output2, sizeof(cf_t) * nof_output) != 0) {
+    ERROR("The output depends on the block size");
+    goto clean_exit;
+  }
+
+  // The number of input samples for a given number of output samples is exact when decimating
+  for (uint32_t n = 1; n < 100; n++) {
+    uint32_t nof_input = srsran_resampler_poly_nof_input(&q, n);
+    uint32_t produced  = srsran_resampler_poly_nof_output(&q, nof_input);
+    if (produced < n || (L <= M && produced != n) || srsran_resampler_poly_nof_output(&q, nof_input - 1) >= n) {
+      ERROR("Wrong number of input samples for %d output samples (%d)", n, nof_input);
+      goto clean_exit;
+    }
+  }
+
+  // Measure throughput
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < repetitions; r++) {
+    srsran_resampler_poly_reset_state(&q);
+    srsran_resampler_poly_run(&q, input, output2, buffer_size);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  uint64_t duration_us = (uint64_t)(t[0].tv_sec * 1000000UL + t[0].tv_usec);
+
+  printf("Ratio %d/%d; Done %.1f Msps (input) %.1f Msps (output); RMS error: %.6f\n",
+         L,
+         M,
+         (double)buffer_size * repetitions / (double)duration_us,
+         (double)nof_output * repetitions / (double)duration_us,
+         err);
+
+  ret = (err < 0.01) ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+
+clean_exit:
+  srsran_resampler_poly_free(&q);
+  if (input) {
+    free(input);
+  }
+  if (output) {
+    free(output);
+  }
+  if (output2) {
+    free(output2);
+  }
+
+  return ret;
+}
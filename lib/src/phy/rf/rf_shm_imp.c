@@ -0,0 +1,662 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp.h"
+#include "rf_helper.h"
+#include "rf_plugin.h"
+#include "rf_shm_imp_port.h"
+#include <inttypes.h>
+#include <math.h>
+#include <pthread.h>
+#include <srsran/phy/common/phy_common.h>
+#include <srsran/phy/common/timestamp.h>
+#include <srsran/phy/utils/vector.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define SHM_MAX_BUFFER_SIZE (307200) // 10 subframes at 30.72 MHz, in samples
+#define SHM_BASERATE_DEFAULT_HZ (23040000)
+#define SHM_RING_DEFAULT_MS (20)
+#define SHM_NOF_SLOTS_DEFAULT (16)
+#define SHM_TIMEOUT_MS (2000)
+#define SHM_MAX_GAIN_DB (30.0f)
+#define SHM_MIN_GAIN_DB (0.0f)
+
+typedef struct {
+  // Common attributes
+  srsran_rf_info_t info;
+  uint32_t         nof_channels;
+
+  // RF State
+  uint32_t srate; // radio rate configured by upper layers
+  uint32_t base_srate;
+  uint32_t decim_factor; // decimation factor between base_srate used on transport on radio's rate
+  double   rx_gain;
+  double   tx_gain;
+  char     id[RF_PARAM_LEN];
+
+  // Shared memory ports
+  rf_shm_port_t tx_port[SRSRAN_MAX_CHANNELS];
+  rf_shm_port_t rx_port[SRSRAN_MAX_CHANNELS];
+
+  // Base rate sample buffers
+  cf_t* buffer_rx[SRSRAN_MAX_CHANNELS];
+  cf_t* buffer_tx[SRSRAN_MAX_CHANNELS];
+
+  // Rx timestamp, the timeline is joined on the first reception
+  bool     rx_started;
+  uint64_t next_rx_ts;
+
+  pthread_mutex_t config_mutex;
+  pthread_mutex_t tx_mutex;
+} rf_shm_handler_t;
+
+static void update_rates(rf_shm_handler_t* handler, double srate);
+
+/*
+ * Static Atributes
+ */
+const char shm_devname[4] = "shm";
+
+/*
+ * Public methods
+ */
+
+void rf_shm_suppress_stdout(void* h)
+{
+  // do nothing
+}
+
+void rf_shm_register_error_handler(void* h, srsran_rf_error_handler_t new_handler, void* arg)
+{
+  // do nothing
+}
+
+const char* rf_shm_devname(void* h)
+{
+  return shm_devname;
+}
+
+int rf_shm_start_rx_stream(void* h, bool now)
+{
+  return SRSRAN_SUCCESS;
+}
+
+int rf_shm_stop_rx_stream(void* h)
+{
+  return SRSRAN_SUCCESS;
+}
+
+void rf_shm_flush_buffer(void* h)
+{
+  // do nothing
+}
+
+bool rf_shm_has_rssi(void* h)
+{
+  return false;
+}
+
+float rf_shm_get_rssi(void* h)
+{
+  return 0.0;
+}
+
+int rf_shm_open(char* args, void** h)
+{
+  return rf_shm_open_multi(args, h, 1);
+}
+
+int rf_shm_open_multi(char* args, void** h, uint32_t nof_channels)
+{
+  int ret = SRSRAN_ERROR;
+  if (h && nof_channels < SRSRAN_MAX_CHANNELS) {
+    *h = NULL;
+
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)malloc(sizeof(rf_shm_handler_t));
+    if (!handler) {
+      perror("malloc");
+      return SRSRAN_ERROR;
+    }
+    bzero(handler, sizeof(rf_shm_handler_t));
+    *h                        = handler;
+    handler->base_srate       = SHM_BASERATE_DEFAULT_HZ; // Sample rate for 100 PRB cell
+    handler->info.max_rx_gain = SHM_MAX_GAIN_DB;
+    handler->info.min_rx_gain = SHM_MIN_GAIN_DB;
+    handler->info.max_tx_gain = SHM_MAX_GAIN_DB;
+    handler->info.min_tx_gain = SHM_MIN_GAIN_DB;
+    handler->nof_channels     = nof_channels;
+    strcpy(handler->id, "shm\0");
+
+    if (pthread_mutex_init(&handler->config_mutex, NULL)) {
+      perror("Mutex init");
+    }
+    if (pthread_mutex_init(&handler->tx_mutex, NULL)) {
+      perror("Mutex init");
+    }
+
+    rf_shm_port_opts_t opts = {};
+    opts.nof_slots          = SHM_NOF_SLOTS_DEFAULT;
+    opts.trx_timeout_ms     = SHM_TIMEOUT_MS;
+
+    // parse args
+    if (args && strlen(args)) {
+      // base_srate
+      parse_uint32(args, "base_srate", -1, &handler->base_srate);
+
+      // id
+      parse_string(args, "id", -1, handler->id);
+
+      // nof_slots, maximum number of transmitters of a port
+      parse_uint32(args, "nof_slots", -1, &opts.nof_slots);
+
+      // trx_timeout_ms
+      parse_uint32(args, "trx_timeout_ms", -1, &opts.trx_timeout_ms);
+    } else {
+      fprintf(stderr,
+              "[shm] Error: No device 'args' option has been set. Please make sure to set this option to be able to "
+              "use the shared memory no-RF module\n");
+      goto clean_exit;
+    }
+
+    // ring_size, samples at the base rate kept by every transmitter
+    opts.base_srate  = handler->base_srate;
+    opts.nof_samples = (handler->base_srate / 1000) * SHM_RING_DEFAULT_MS;
+    parse_uint32(args, "ring_size", -1, &opts.nof_samples);
+
+    update_rates(handler, 1.92e6);
+
+    for (uint32_t i = 0; i < handler->nof_channels; i++) {
+      // tx_port
+      char tx_port[RF_PARAM_LEN] = {};
+      if (parse_string(args, "tx_port", i, tx_port) == SRSRAN_SUCCESS) {
+        opts.transmitter = true;
+        if (rf_shm_port_open(&handler->tx_port[i], tx_port, &opts) != SRSRAN_SUCCESS) {
+          fprintf(stderr, "[shm] Error: opening transmitter\n");
+          goto clean_exit;
+        }
+      } else {
+        fprintf(stdout, "[shm] %s Tx port not specified. Disabling transmitter.\n", handler->id);
+      }
+
+      // rx_port
+      char rx_port[RF_PARAM_LEN] = {};
+      if (parse_string(args, "rx_port", i, rx_port) == SRSRAN_SUCCESS) {
+        opts.transmitter = false;
+        if (rf_shm_port_open(&handler->rx_port[i], rx_port, &opts) != SRSRAN_SUCCESS) {
+          fprintf(stderr, "[shm] Error: opening receiver\n");
+          goto clean_exit;
+        }
+      } else {
+        fprintf(stdout, "[shm] %s Rx port not specified. Disabling receiver.\n", handler->id);
+      }
+
+      if (!rf_shm_port_is_open(&handler->tx_port[i]) && !rf_shm_port_is_open(&handler->rx_port[i])) {
+        fprintf(stderr, "[shm] Error: Neither Tx port nor Rx port specified.\n");
+        goto clean_exit;
+      }
+    }
+
+    // Create decimation and interpolation buffers
+    for (uint32_t i = 0; i < handler->nof_channels; i++) {
+      handler->buffer_rx[i] = srsran_vec_cf_malloc(SHM_MAX_BUFFER_SIZE);
+      if (!handler->buffer_rx[i]) {
+        fprintf(stderr, "Error: allocating rx buffer\n");
+        goto clean_exit;
+      }
+
+      handler->buffer_tx[i] = srsran_vec_cf_malloc(SHM_MAX_BUFFER_SIZE);
+      if (!handler->buffer_tx[i]) {
+        fprintf(stderr, "Error: allocating tx buffer\n");
+        goto clean_exit;
+      }
+    }
+
+    ret = SRSRAN_SUCCESS;
+
+  clean_exit:
+    if (ret) {
+      rf_shm_close(handler);
+      *h = NULL;
+    }
+  }
+  return ret;
+}
+
+int rf_shm_close(void* h)
+{
+  rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+  if (handler == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // The segments are not unlinked, other processes may still use them
+  for (uint32_t i = 0; i < handler->nof_channels; i++) {
+    rf_shm_port_close(&handler->tx_port[i]);
+    rf_shm_port_close(&handler->rx_port[i]);
+
+    if (handler->buffer_rx[i]) {
+      free(handler->buffer_rx[i]);
+    }
+    if (handler->buffer_tx[i]) {
+      free(handler->buffer_tx[i]);
+    }
+  }
+
+  pthread_mutex_destroy(&handler->config_mutex);
+  pthread_mutex_destroy(&handler->tx_mutex);
+
+  free(handler);
+
+  return SRSRAN_SUCCESS;
+}
+
+void update_rates(rf_shm_handler_t* handler, double srate)
+{
+  pthread_mutex_lock(&handler->config_mutex);
+  // Decimation must be full integer
+  if (((uint64_t)handler->base_srate % (uint64_t)srate) == 0) {
+    handler->srate        = (uint32_t)srate;
+    handler->decim_factor = handler->base_srate / handler->srate;
+  } else {
+    fprintf(stderr,
+            "Error: couldn't update sample rate. %.2f is not divisible by %.2f\n",
+            srate / 1e6,
+            handler->base_srate / 1e6);
+  }
+  printf("Current sample rate is %.2f MHz with a base rate of %.2f MHz (x%d decimation)\n",
+         handler->srate / 1e6,
+         handler->base_srate / 1e6,
+         handler->decim_factor);
+  pthread_mutex_unlock(&handler->config_mutex);
+}
+
+double rf_shm_set_rx_srate(void* h, double srate)
+{
+  double ret = 0.0;
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    update_rates(handler, srate);
+    ret = handler->srate;
+  }
+  return ret;
+}
+
+double rf_shm_set_tx_srate(void* h, double srate)
+{
+  double ret = 0.0;
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    update_rates(handler, srate);
+    ret = handler->srate;
+  }
+  return ret;
+}
+
+int rf_shm_set_rx_gain(void* h, double gain)
+{
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    pthread_mutex_lock(&handler->config_mutex);
+    handler->rx_gain = gain;
+    pthread_mutex_unlock(&handler->config_mutex);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int rf_shm_set_rx_gain_ch(void* h, uint32_t ch, double gain)
+{
+  return rf_shm_set_rx_gain(h, gain);
+}
+
+int rf_shm_set_tx_gain(void* h, double gain)
+{
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    pthread_mutex_lock(&handler->config_mutex);
+    handler->tx_gain = gain;
+    pthread_mutex_unlock(&handler->config_mutex);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int rf_shm_set_tx_gain_ch(void* h, uint32_t ch, double gain)
+{
+  return rf_shm_set_tx_gain(h, gain);
+}
+
+double rf_shm_get_rx_gain(void* h)
+{
+  double ret = 0.0;
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    pthread_mutex_lock(&handler->config_mutex);
+    ret = handler->rx_gain;
+    pthread_mutex_unlock(&handler->config_mutex);
+  }
+  return ret;
+}
+
+double rf_shm_get_tx_gain(void* h)
+{
+  double ret = NAN;
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    pthread_mutex_lock(&handler->config_mutex);
+    ret = handler->tx_gain;
+    pthread_mutex_unlock(&handler->config_mutex);
+  }
+  return ret;
+}
+
+srsran_rf_info_t* rf_shm_get_info(void* h)
+{
+  srsran_rf_info_t* info = NULL;
+  if (h) {
+    rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+    info                      = &handler->info;
+  }
+  return info;
+}
+
+double rf_shm_set_rx_freq(void* h, uint32_t ch, double freq)
+{
+  // The ports select the carrier, the frequency is ignored
+  return freq;
+}
+
+double rf_shm_set_tx_freq(void* h, uint32_t ch, double freq)
+{
+  // The ports select the carrier, the frequency is ignored
+  return freq;
+}
+
+void rf_shm_get_time(void* h, time_t* secs, double* frac_secs)
+{
+  if (h) {
+    if (secs) {
+      *secs = 0;
+    }
+
+    if (frac_secs) {
+      *frac_secs = 0;
+    }
+  }
+}
+
+int rf_shm_recv_with_time(void* h, void* data, uint32_t nsamples, bool blocking, time_t* secs, double* frac_secs)
+{
+  return rf_shm_recv_with_time_multi(h, &data, nsamples, blocking, secs, frac_secs);
+}
+
+int rf_shm_recv_with_time_multi(void* h, void** data, uint32_t nsamples, bool blocking, time_t* secs, double* frac_secs)
+{
+  int ret = SRSRAN_ERROR;
+
+  if (h == NULL || data == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+
+  pthread_mutex_lock(&handler->config_mutex);
+  uint32_t decim_factor = handler->decim_factor;
+  float    scale        = srsran_convert_dB_to_amplitude(handler->rx_gain);
+  pthread_mutex_unlock(&handler->config_mutex);
+
+  uint32_t nsamples_baserate = nsamples * decim_factor;
+  if (nsamples_baserate > SHM_MAX_BUFFER_SIZE) {
+    fprintf(stderr,
+            "[shm] Error: Trying to receive %d samples but buffer is only %d samples.\n",
+            nsamples_baserate,
+            SHM_MAX_BUFFER_SIZE);
+    return SRSRAN_ERROR;
+  }
+
+  // Join the timeline of the transmitters already running, or start a new one
+  if (!handler->rx_started) {
+    uint64_t ts = 0;
+    for (uint32_t i = 0; i < handler->nof_channels; i++) {
+      ts = SRSRAN_MAX(ts, rf_shm_port_get_ts(&handler->rx_port[i]));
+    }
+    handler->next_rx_ts = ts;
+    handler->rx_started = true;
+
+    pthread_mutex_lock(&handler->tx_mutex);
+    for (uint32_t i = 0; i < handler->nof_channels; i++) {
+      rf_shm_port_start(&handler->tx_port[i], ts);
+    }
+    pthread_mutex_unlock(&handler->tx_mutex);
+  }
+
+  // set timestamp for this reception
+  if (secs != NULL && frac_secs != NULL) {
+    srsran_timestamp_t ts = {};
+    srsran_timestamp_init_uint64(&ts, handler->next_rx_ts, handler->base_srate);
+    *secs      = ts.full_secs;
+    *frac_secs = ts.frac_secs;
+  }
+
+  // Publish zeros up to the end of this reception, the receivers of our transmissions do not wait for a subframe
+  // that is not going to be transmitted
+  pthread_mutex_lock(&handler->tx_mutex);
+  for (uint32_t i = 0; i < handler->nof_channels; i++) {
+    rf_shm_port_align(&handler->tx_port[i], handler->next_rx_ts + nsamples_baserate);
+  }
+  pthread_mutex_unlock(&handler->tx_mutex);
+
+  // Add the transmitters of every port
+  int nof_transmitters = 0;
+  for (uint32_t i = 0; i < handler->nof_channels; i++) {
+    cf_t* ptr = (decim_factor != 1 || data[i] == NULL) ? handler->buffer_rx[i] : (cf_t*)data[i];
+
+    if (!rf_shm_port_is_open(&handler->rx_port[i])) {
+      srsran_vec_cf_zero(ptr, nsamples_baserate);
+      continue;
+    }
+
+    int n = rf_shm_port_read(&handler->rx_port[i], handler->next_rx_ts, ptr, nsamples_baserate);
+    if (n < SRSRAN_SUCCESS) {
+      fprintf(stderr, "[shm] Error: receiving data.\n");
+      goto clean_exit;
+    }
+    nof_transmitters += n;
+  }
+
+  // Nobody is transmitting, keep the pace of a real radio
+  if (nof_transmitters == 0) {
+    usleep((1000000UL * nsamples_baserate) / handler->base_srate);
+  }
+
+  // decimate if needed
+  for (uint32_t c = 0; c < handler->nof_channels; c++) {
+    if (data[c] == NULL) {
+      continue;
+    }
+
+    cf_t* dst = (cf_t*)data[c];
+    if (decim_factor != 1) {
+      cf_t* ptr = handler->buffer_rx[c];
+      for (uint32_t i = 0, n = 0; i < nsamples; i++) {
+        // Averaging decimation
+        cf_t avg = 0.0f;
+        for (uint32_t j = 0; j < decim_factor; j++, n++) {
+          avg += ptr[n];
+        }
+        dst[i] = avg; // divide by decim_factor later via scale
+      }
+    }
+
+    // Set gain, it also incorporates decim_factor
+    srsran_vec_sc_prod_cfc(dst, scale / (float)decim_factor, dst, nsamples);
+  }
+
+  // update rx time
+  handler->next_rx_ts += nsamples_baserate;
+
+  ret = (int)nsamples;
+
+clean_exit:
+  return ret;
+}
+
+int rf_shm_send_timed(void*  h,
+                      void*  data,
+                      int    nsamples,
+                      time_t secs,
+                      double frac_secs,
+                      bool   has_time_spec,
+                      bool   blocking,
+                      bool   is_start_of_burst,
+                      bool   is_end_of_burst)
+{
+  void* _data[4] = {data, NULL, NULL, NULL};
+
+  return rf_shm_send_timed_multi(
+      h, _data, nsamples, secs, frac_secs, has_time_spec, blocking, is_start_of_burst, is_end_of_burst);
+}
+
+int rf_shm_send_timed_multi(void*  h,
+                            void*  data[4],
+                            int    nsamples,
+                            time_t secs,
+                            double frac_secs,
+                            bool   has_time_spec,
+                            bool   blocking,
+                            bool   is_start_of_burst,
+                            bool   is_end_of_burst)
+{
+  int ret = SRSRAN_ERROR;
+
+  if (h == NULL || data == NULL || nsamples <= 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  rf_shm_handler_t* handler = (rf_shm_handler_t*)h;
+
+  pthread_mutex_lock(&handler->config_mutex);
+  uint32_t decim_factor = handler->decim_factor;
+  float    tx_gain      = srsran_convert_dB_to_amplitude(handler->tx_gain);
+  pthread_mutex_unlock(&handler->config_mutex);
+
+  // If the Tx gain is NAN, INF or 0.0, use 1.0
+  if (!isnormal(tx_gain)) {
+    tx_gain = 1.0f;
+  }
+
+  uint32_t nsamples_baseband = (uint32_t)nsamples * decim_factor;
+  if (nsamples_baseband > SHM_MAX_BUFFER_SIZE) {
+    fprintf(stderr,
+            "Error: trying to transmit too many samples (%d > %d).\n",
+            nsamples_baseband,
+            SHM_MAX_BUFFER_SIZE);
+    return SRSRAN_ERROR;
+  }
+
+  pthread_mutex_lock(&handler->tx_mutex);
+  for (uint32_t i = 0; i < handler->nof_channels; i++) {
+    rf_shm_port_t* port = &handler->tx_port[i];
+    if (!rf_shm_port_is_open(port)) {
+      continue;
+    }
+
+    // Transmissions without time follow the previous one
+    uint64_t tx_ts = rf_shm_port_get_write_ts(port);
+    if (has_time_spec) {
+      srsran_timestamp_t ts = {};
+      srsran_timestamp_init(&ts, secs, frac_secs);
+      tx_ts = srsran_timestamp_uint64(&ts, handler->base_srate);
+    } else if (tx_ts == RF_SHM_TS_NONE) {
+      tx_ts = handler->next_rx_ts;
+    }
+
+    // Interpolate and set gain, NULL buffers transmit zeros
+    cf_t* buf = NULL;
+    if (data[i] != NULL) {
+      buf       = handler->buffer_tx[i];
+      cf_t* src = (cf_t*)data[i];
+      for (uint32_t k = 0, n = 0; k < (uint32_t)nsamples; k++) {
+        // perform zero order hold
+        for (uint32_t j = 0; j < decim_factor; j++, n++) {
+          buf[n] = src[k];
+        }
+      }
+      srsran_vec_sc_prod_cfc(buf, tx_gain, buf, nsamples_baseband);
+    }
+
+    if (rf_shm_port_write(port, tx_ts, buf, nsamples_baseband) < SRSRAN_SUCCESS) {
+      fprintf(stderr,
+              "[shm] Error: tx time is %.3f ms in the past (%" PRIu64 " < %" PRIu64 ")\n",
+              1000.0 * (double)(rf_shm_port_get_write_ts(port) - tx_ts) / handler->base_srate,
+              tx_ts,
+              rf_shm_port_get_write_ts(port));
+      goto clean_exit;
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  pthread_mutex_unlock(&handler->tx_mutex);
+  return ret;
+}
+
+rf_dev_t srsran_rf_dev_shm = {"shm",
+                              rf_shm_devname,
+                              rf_shm_start_rx_stream,
+                              rf_shm_stop_rx_stream,
+                              rf_shm_flush_buffer,
+                              rf_shm_has_rssi,
+                              rf_shm_get_rssi,
+                              rf_shm_suppress_stdout,
+                              rf_shm_register_error_handler,
+                              rf_shm_open,
+                              .srsran_rf_open_multi = rf_shm_open_multi,
+                              rf_shm_close,
+                              rf_shm_set_rx_srate,
+                              rf_shm_set_rx_gain,
+                              rf_shm_set_rx_gain_ch,
+                              rf_shm_set_tx_gain,
+                              rf_shm_set_tx_gain_ch,
+                              rf_shm_get_rx_gain,
+                              rf_shm_get_tx_gain,
+                              rf_shm_get_info,
+                              rf_shm_set_rx_freq,
+                              rf_shm_set_tx_srate,
+                              rf_shm_set_tx_freq,
+                              rf_shm_get_time,
+                              NULL,
+                              rf_shm_recv_with_time,
+                              rf_shm_recv_with_time_multi,
+                              rf_shm_send_timed,
+                              .srsran_rf_send_timed_multi = rf_shm_send_timed_multi};
+
+#ifdef ENABLE_RF_PLUGINS
+int register_plugin(rf_dev_t** rf_api)
+{
+  if (rf_api == NULL) {
+    return SRSRAN_ERROR;
+  }
+  *rf_api = &srsran_rf_dev_shm;
+  return SRSRAN_SUCCESS;
+}
+#endif /* ENABLE_RF_PLUGINS */
@@ -0,0 +1,484 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp_port.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <srsran/phy/utils/vector.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+// Time the creator of a segment has to initialise it before other processes give up
+#define RF_SHM_OPEN_TIMEOUT_MS (1000)
+
+// Returned when mapping a segment that its last user is unlinking
+#define RF_SHM_UNLINKED (1)
+
+// Longest sleep of a receiver, it bounds the time needed to notice that a transmitter process died
+#define RF_SHM_MAX_SLEEP_MS (100)
+
+static long rf_shm_futex(uint32_t* uaddr, int op, uint32_t val, const struct timespec* timeout)
+{
+  return syscall(SYS_futex, uaddr, op, val, timeout, NULL, 0);
+}
+
+static size_t rf_shm_segment_size(uint32_t nof_slots, uint32_t nof_samples)
+{
+  return sizeof(rf_shm_hdr_t) + nof_slots * sizeof(rf_shm_slot_t) + (size_t)nof_slots * nof_samples * sizeof(cf_t);
+}
+
+static void rf_shm_port_wake(rf_shm_slot_t* slot)
+{
+  __atomic_add_fetch(&slot->seq, 1, __ATOMIC_SEQ_CST);
+  if (__atomic_load_n(&slot->nof_waiters, __ATOMIC_SEQ_CST) > 0) {
+    rf_shm_futex(&slot->seq, FUTEX_WAKE, INT_MAX, NULL);
+  }
+}
+
+// Tells whether the process holding a slot no longer exists
+static bool rf_shm_owner_is_dead(int32_t owner)
+{
+  return owner > 0 && kill(owner, 0) == -1 && errno == ESRCH;
+}
+
+/*
+ * Claims a free slot or the slot of a transmitter process that no longer exists. The owner is the pid, so a single CAS
+ * both takes the slot and records who holds it.
+ */
+static int rf_shm_port_claim(rf_shm_port_t* q)
+{
+  int32_t pid = (int32_t)getpid();
+
+  for (uint32_t i = 0; i < q->hdr->nof_slots; i++) {
+    rf_shm_slot_t* slot  = &q->slots[i];
+    int32_t        owner = __atomic_load_n(&slot->owner, __ATOMIC_ACQUIRE);
+
+    if (owner == 0 || (owner != pid && rf_shm_owner_is_dead(owner))) {
+      if (__atomic_compare_exchange_n(&slot->owner, &owner, pid, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        __atomic_store_n(&slot->start_ts, RF_SHM_TS_NONE, __ATOMIC_RELEASE);
+        __atomic_store_n(&slot->write_ts, 0, __ATOMIC_RELEASE);
+        q->slot = (int32_t)i;
+        return SRSRAN_SUCCESS;
+      }
+    }
+  }
+
+  fprintf(stderr, "[shm] Error: all the %d slots of %s are in use\n", q->hdr->nof_slots, q->name);
+  return SRSRAN_ERROR;
+}
+
+// Counts the port in the users of the segment, unless the last user already left and unlinked it
+static bool rf_shm_port_attach(rf_shm_port_t* q)
+{
+  uint32_t nof_users = __atomic_load_n(&q->hdr->nof_users, __ATOMIC_ACQUIRE);
+  while (nof_users > 0) {
+    if (__atomic_compare_exchange_n(
+            &q->hdr->nof_users, &nof_users, nof_users + 1, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+      q->attached = true;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Maps the segment, returns RF_SHM_UNLINKED if it was being removed by its last user
+static int rf_shm_port_map(rf_shm_port_t* q, const char* name, const rf_shm_port_opts_t* opts)
+{
+  int ret = SRSRAN_ERROR;
+  int fd  = -1;
+
+  bzero(q, sizeof(rf_shm_port_t));
+  q->slot           = -1;
+  q->trx_timeout_ms = opts->trx_timeout_ms;
+
+  // POSIX shared memory names start with a slash
+  snprintf(q->name, sizeof(q->name), "%s%s", (name[0] == '/') ? "" : "/", name);
+
+  bool creator = true;
+  fd           = shm_open(q->name, O_RDWR | O_CREAT | O_EXCL, 0660);
+  if (fd < 0 && errno == EEXIST) {
+    creator = false;
+    fd      = shm_open(q->name, O_RDWR, 0660);
+    if (fd < 0 && errno == ENOENT) {
+      ret = RF_SHM_UNLINKED;
+      goto clean_exit;
+    }
+  }
+  if (fd < 0) {
+    fprintf(stderr, "[shm] Error: opening %s: %s\n", q->name, strerror(errno));
+    goto clean_exit;
+  }
+
+  if (creator) {
+    if (opts->nof_slots == 0 || opts->nof_slots > RF_SHM_MAX_SLOTS || opts->nof_samples == 0) {
+      fprintf(stderr, "[shm] Error: invalid %d slots of %d samples\n", opts->nof_slots, opts->nof_samples);
+      shm_unlink(q->name);
+      goto clean_exit;
+    }
+    q->size = rf_shm_segment_size(opts->nof_slots, opts->nof_samples);
+    if (ftruncate(fd, (off_t)q->size) < 0) {
+      fprintf(stderr, "[shm] Error: allocating %zu B for %s: %s\n", q->size, q->name, strerror(errno));
+      shm_unlink(q->name);
+      goto clean_exit;
+    }
+  } else {
+    // Wait for the creator to size the segment
+    struct stat st    = {};
+    uint32_t    count = 0;
+    while (fstat(fd, &st) == 0 && (size_t)st.st_size < sizeof(rf_shm_hdr_t) && count++ < RF_SHM_OPEN_TIMEOUT_MS) {
+      usleep(1000);
+    }
+    q->size = (size_t)st.st_size;
+  }
+
+  q->base = mmap(NULL, q->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (q->base == MAP_FAILED) {
+    fprintf(stderr, "[shm] Error: mapping %s: %s\n", q->name, strerror(errno));
+    q->base = NULL;
+    goto clean_exit;
+  }
+  q->hdr = (rf_shm_hdr_t*)q->base;
+
+  if (creator) {
+    // The segment is zeroed by ftruncate, all the slots are free
+    q->hdr->version     = RF_SHM_VERSION;
+    q->hdr->nof_slots   = opts->nof_slots;
+    q->hdr->nof_samples = opts->nof_samples;
+    q->hdr->base_srate  = opts->base_srate;
+    q->hdr->nof_users   = 1;
+    q->attached         = true;
+    __atomic_store_n(&q->hdr->magic, RF_SHM_MAGIC, __ATOMIC_RELEASE);
+  } else {
+    uint32_t count = 0;
+    while (__atomic_load_n(&q->hdr->magic, __ATOMIC_ACQUIRE) != RF_SHM_MAGIC && count++ < RF_SHM_OPEN_TIMEOUT_MS) {
+      usleep(1000);
+    }
+    if (q->hdr->magic != RF_SHM_MAGIC || q->hdr->version != RF_SHM_VERSION ||
+        q->size < rf_shm_segment_size(q->hdr->nof_slots, q->hdr->nof_samples)) {
+      fprintf(stderr, "[shm] Error: %s is not a valid segment, remove it from /dev/shm\n", q->name);
+      goto clean_exit;
+    }
+    if (q->hdr->base_srate != opts->base_srate) {
+      fprintf(stderr,
+              "[shm] Error: %s runs at %.2f MHz and the device at %.2f MHz\n",
+              q->name,
+              q->hdr->base_srate / 1e6,
+              opts->base_srate / 1e6);
+      goto clean_exit;
+    }
+    if (!rf_shm_port_attach(q)) {
+      ret = RF_SHM_UNLINKED;
+      goto clean_exit;
+    }
+  }
+
+  q->slots   = (rf_shm_slot_t*)((uint8_t*)q->base + sizeof(rf_shm_hdr_t));
+  q->samples = (cf_t*)&q->slots[q->hdr->nof_slots];
+
+  if (opts->transmitter && rf_shm_port_claim(q) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  if (fd >= 0) {
+    close(fd);
+  }
+  if (ret != SRSRAN_SUCCESS) {
+    rf_shm_port_close(q);
+  }
+  return ret;
+}
+
+int rf_shm_port_open(rf_shm_port_t* q, const char* name, const rf_shm_port_opts_t* opts)
+{
+  if (q == NULL || name == NULL || opts == NULL || strlen(name) == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // A segment whose last user is leaving is unlinked soon, then the next attempt creates a new one
+  int      ret   = RF_SHM_UNLINKED;
+  uint32_t count = 0;
+  while (ret == RF_SHM_UNLINKED && count++ < RF_SHM_OPEN_TIMEOUT_MS) {
+    ret = rf_shm_port_map(q, name, opts);
+    if (ret == RF_SHM_UNLINKED) {
+      usleep(1000);
+    }
+  }
+
+  if (ret == RF_SHM_UNLINKED) {
+    fprintf(stderr, "[shm] Error: %s is being removed and was not unlinked in time\n", q->name);
+    ret = SRSRAN_ERROR;
+  }
+  return ret;
+}
+
+void rf_shm_port_close(rf_shm_port_t* q)
+{
+  if (q == NULL || q->base == NULL) {
+    return;
+  }
+
+  // Release the slot and wake up the receivers waiting for it. A receiver may have released it already if this process
+  // was taken for dead, then it may belong to another transmitter
+  if (q->slot >= 0) {
+    rf_shm_slot_t* slot  = &q->slots[q->slot];
+    int32_t        owner = (int32_t)getpid();
+    if (__atomic_compare_exchange_n(&slot->owner, &owner, 0, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+      rf_shm_port_wake(slot);
+    }
+    q->slot = -1;
+  }
+
+  // The last user removes the segment, nobody can attach it afterwards
+  if (q->attached && __atomic_sub_fetch(&q->hdr->nof_users, 1, __ATOMIC_ACQ_REL) == 0) {
+    shm_unlink(q->name);
+  }
+  q->attached = false;
+
+  munmap(q->base, q->size);
+  q->base = NULL;
+}
+
+bool rf_shm_port_is_open(rf_shm_port_t* q)
+{
+  return q != NULL && q->base != NULL;
+}
+
+void rf_shm_port_start(rf_shm_port_t* q, uint64_t ts)
+{
+  if (q == NULL || q->slot < 0) {
+    return;
+  }
+
+  rf_shm_slot_t* slot = &q->slots[q->slot];
+  if (__atomic_load_n(&slot->start_ts, __ATOMIC_ACQUIRE) == RF_SHM_TS_NONE) {
+    __atomic_store_n(&slot->write_ts, ts, __ATOMIC_RELEASE);
+    __atomic_store_n(&slot->start_ts, ts, __ATOMIC_RELEASE);
+  }
+}
+
+uint64_t rf_shm_port_get_write_ts(rf_shm_port_t* q)
+{
+  if (q == NULL || q->slot < 0) {
+    return RF_SHM_TS_NONE;
+  }
+
+  rf_shm_slot_t* slot = &q->slots[q->slot];
+  if (__atomic_load_n(&slot->start_ts, __ATOMIC_ACQUIRE) == RF_SHM_TS_NONE) {
+    return RF_SHM_TS_NONE;
+  }
+  return __atomic_load_n(&slot->write_ts, __ATOMIC_ACQUIRE);
+}
+
+// Copies samples in the ring of the transmitter slot, zeros if buffer is NULL
+static void rf_shm_port_copy(rf_shm_port_t* q, uint64_t ts, const cf_t* buffer, uint32_t nsamples)
+{
+  uint32_t N    = q->hdr->nof_samples;
+  cf_t*    ring = &q->samples[(size_t)q->slot * N];
+
+  while (nsamples > 0) {
+    uint32_t pos = (uint32_t)(ts % N);
+    uint32_t len = SRSRAN_MIN(nsamples, N - pos);
+    if (buffer) {
+      srsran_vec_cf_copy(&ring[pos], buffer, len);
+      buffer += len;
+    } else {
+      srsran_vec_cf_zero(&ring[pos], len);
+    }
+    ts += len;
+    nsamples -= len;
+  }
+}
+
+// Publishes the samples up to ts, in pieces no longer than the ring so the receivers can keep up
+static void rf_shm_port_publish(rf_shm_port_t* q, uint64_t ts, const cf_t* buffer, uint32_t nsamples)
+{
+  rf_shm_slot_t* slot = &q->slots[q->slot];
+  uint32_t       N    = q->hdr->nof_samples;
+
+  while (nsamples > 0) {
+    uint32_t len = SRSRAN_MIN(nsamples, N);
+    rf_shm_port_copy(q, ts, buffer, len);
+    ts += len;
+    nsamples -= len;
+    if (buffer) {
+      buffer += len;
+    }
+
+    __atomic_store_n(&slot->write_ts, ts, __ATOMIC_RELEASE);
+    rf_shm_port_wake(slot);
+  }
+}
+
+int rf_shm_port_write(rf_shm_port_t* q, uint64_t ts, const cf_t* buffer, uint32_t nsamples)
+{
+  if (q == NULL || q->slot < 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  rf_shm_port_start(q, ts);
+
+  uint64_t write_ts = rf_shm_port_get_write_ts(q);
+  if (ts < write_ts) {
+    return SRSRAN_ERROR;
+  }
+
+  // Fill the gap with zeros
+  while (write_ts < ts) {
+    uint32_t len = (uint32_t)SRSRAN_MIN(ts - write_ts, (uint64_t)q->hdr->nof_samples);
+    rf_shm_port_publish(q, write_ts, NULL, len);
+    write_ts += len;
+  }
+
+  rf_shm_port_publish(q, ts, buffer, nsamples);
+
+  return (int)nsamples;
+}
+
+void rf_shm_port_align(rf_shm_port_t* q, uint64_t ts)
+{
+  uint64_t write_ts = rf_shm_port_get_write_ts(q);
+  if (write_ts != RF_SHM_TS_NONE && write_ts < ts) {
+    rf_shm_port_write(q, ts, NULL, 0);
+  }
+}
+
+uint64_t rf_shm_port_get_ts(rf_shm_port_t* q)
+{
+  uint64_t ts = 0;
+
+  for (uint32_t i = 0; q != NULL && q->base != NULL && i < q->hdr->nof_slots; i++) {
+    rf_shm_slot_t* slot = &q->slots[i];
+    if (__atomic_load_n(&slot->owner, __ATOMIC_ACQUIRE) &&
+        __atomic_load_n(&slot->start_ts, __ATOMIC_ACQUIRE) != RF_SHM_TS_NONE) {
+      ts = SRSRAN_MAX(ts, __atomic_load_n(&slot->write_ts, __ATOMIC_ACQUIRE));
+    }
+  }
+
+  return ts;
+}
+
+static void rf_shm_timespec_add_ms(struct timespec* t, uint32_t ms)
+{
+  t->tv_sec += ms / 1000;
+  t->tv_nsec += (ms % 1000) * 1000000L;
+  if (t->tv_nsec >= 1000000000L) {
+    t->tv_sec++;
+    t->tv_nsec -= 1000000000L;
+  }
+}
+
+static int64_t rf_shm_timespec_diff_ns(const struct timespec* a, const struct timespec* b)
+{
+  return (int64_t)(a->tv_sec - b->tv_sec) * 1000000000L + (a->tv_nsec - b->tv_nsec);
+}
+
+// Waits until the slot transmitter reaches ts. Returns false if it was released or did not make it in time.
+static bool rf_shm_port_wait(rf_shm_port_t* q, rf_shm_slot_t* slot, uint64_t ts)
+{
+  struct timespec deadline = {};
+  clock_gettime(CLOCK_MONOTONIC, &deadline);
+  rf_shm_timespec_add_ms(&deadline, q->trx_timeout_ms);
+
+  while (__atomic_load_n(&slot->write_ts, __ATOMIC_ACQUIRE) < ts) {
+    if (!__atomic_load_n(&slot->owner, __ATOMIC_ACQUIRE)) {
+      return false;
+    }
+
+    struct timespec now = {};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t remaining_ns = rf_shm_timespec_diff_ns(&deadline, &now);
+    if (remaining_ns <= 0) {
+      // Release the slot if the transmitter process died, otherwise it is just late
+      int32_t owner = __atomic_load_n(&slot->owner, __ATOMIC_ACQUIRE);
+      if (rf_shm_owner_is_dead(owner)) {
+        fprintf(stderr, "[shm] Transmitter process %d of %s no longer exists, releasing its slot\n", owner, q->name);
+        __atomic_compare_exchange_n(&slot->owner, &owner, 0, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+      } else {
+        fprintf(stderr, "[shm] Error: timeout waiting for a transmitter of %s after %dms\n", q->name, q->trx_timeout_ms);
+      }
+      return false;
+    }
+
+    // Register as waiter before checking again, so a write in between always wakes this receiver up
+    __atomic_add_fetch(&slot->nof_waiters, 1, __ATOMIC_SEQ_CST);
+    uint32_t seq = __atomic_load_n(&slot->seq, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&slot->write_ts, __ATOMIC_SEQ_CST) < ts && __atomic_load_n(&slot->owner, __ATOMIC_SEQ_CST)) {
+      int64_t         sleep_ns = SRSRAN_MIN(remaining_ns, (int64_t)RF_SHM_MAX_SLEEP_MS * 1000000L);
+      struct timespec timeout  = {sleep_ns / 1000000000L, sleep_ns % 1000000000L};
+      rf_shm_futex(&slot->seq, FUTEX_WAIT, seq, &timeout);
+    }
+    __atomic_sub_fetch(&slot->nof_waiters, 1, __ATOMIC_SEQ_CST);
+  }
+
+  return true;
+}
+
+int rf_shm_port_read(rf_shm_port_t* q, uint64_t ts, cf_t* buffer, uint32_t nsamples)
+{
+  if (q == NULL || q->base == NULL || buffer == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t N     = q->hdr->nof_samples;
+  uint64_t end   = ts + nsamples;
+  int      count = 0;
+
+  srsran_vec_cf_zero(buffer, nsamples);
+
+  for (uint32_t i = 0; i < q->hdr->nof_slots; i++) {
+    rf_shm_slot_t* slot = &q->slots[i];
+
+    // Skip free slots and transmitters starting after this read
+    uint64_t start_ts = __atomic_load_n(&slot->start_ts, __ATOMIC_ACQUIRE);
+    if (!__atomic_load_n(&slot->owner, __ATOMIC_ACQUIRE) || start_ts == RF_SHM_TS_NONE || start_ts >= end) {
+      continue;
+    }
+
+    rf_shm_port_wait(q, slot, end);
+
+    // Add what is available, the samples overwritten by a transmitter running too far ahead are lost
+    uint64_t write_ts = __atomic_load_n(&slot->write_ts, __ATOMIC_ACQUIRE);
+    uint64_t first    = SRSRAN_MAX(SRSRAN_MAX(ts, start_ts), (write_ts > N) ? write_ts - N : 0);
+    uint64_t last     = SRSRAN_MIN(end, write_ts);
+    cf_t*    ring     = &q->samples[(size_t)i * N];
+    for (uint64_t t = first; t < last;) {
+      uint32_t pos = (uint32_t)(t % N);
+      uint32_t len = (uint32_t)SRSRAN_MIN(last - t, (uint64_t)(N - pos));
+      srsran_vec_sum_ccc(&buffer[t - ts], &ring[pos], &buffer[t - ts], len);
+      t += len;
+    }
+
+    count++;
+  }
+
+  return count;
+}
@@ -0,0 +1,127 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_RF_SHM_IMP_PORT_H
+#define SRSRAN_RF_SHM_IMP_PORT_H
+
+#include "srsran/config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * A port is a shared memory segment holding one sample ring per writer slot. Rings are indexed by absolute timestamp
+ * in samples at the base rate, so every process attached to a port shares the same timeline. A transmitter owns one
+ * slot and publishes samples in it, a receiver adds the samples of all the active slots. Hence, one eNB transmit port
+ * can be read by many UEs and the transmissions of many UEs are combined in the eNB receive port.
+ *
+ * Segment layout: rf_shm_hdr_t, nof_slots rf_shm_slot_t, nof_slots rings of nof_samples cf_t.
+ *
+ * The last port to close unlinks the segment. The segments of processes that did not close their ports stay in
+ * /dev/shm and are reused, the slots of the transmitters that no longer exist are claimed again.
+ */
+
+#define RF_SHM_MAGIC (0x7372736dU) // "srsm"
+#define RF_SHM_VERSION (2)
+#define RF_SHM_MAX_SLOTS (64)
+#define RF_SHM_TS_NONE (UINT64_MAX)
+#define RF_SHM_CACHE_LINE (64)
+
+typedef struct {
+  uint32_t magic; // Written last by the creator, the segment can not be used until it is set
+  uint32_t version;
+  uint32_t nof_slots;
+  uint32_t nof_samples; // Ring length per slot
+  uint32_t base_srate;
+  uint32_t nof_users; // Ports attached to the segment, it is unlinked and can not be attached again once it is zero
+} __attribute__((aligned(RF_SHM_CACHE_LINE))) rf_shm_hdr_t;
+
+typedef struct {
+  int32_t  owner;       // Process of the transmitter holding the slot, zero while free
+  uint32_t seq;         // Futex word, incremented every time write_ts advances or the slot is released
+  uint32_t nof_waiters; // Receivers sleeping on seq
+  uint64_t start_ts;    // Timestamp of the first sample, RF_SHM_TS_NONE until the transmitter starts
+  uint64_t write_ts;    // Timestamp following the last published sample
+} __attribute__((aligned(RF_SHM_CACHE_LINE))) rf_shm_slot_t;
+
+typedef struct {
+  uint32_t nof_slots;      // Slots of the segment if this port creates it
+  uint32_t nof_samples;    // Ring length if this port creates the segment
+  uint32_t base_srate;     // Sample rate of the timeline, must match the one of the segment
+  uint32_t trx_timeout_ms; // Time a receiver waits for a late transmitter before skipping it
+  bool     transmitter;    // Claims a slot when true
+} rf_shm_port_opts_t;
+
+typedef struct {
+  char           name[64];
+  void*          base;
+  size_t         size;
+  rf_shm_hdr_t*  hdr;
+  rf_shm_slot_t* slots;
+  cf_t*          samples;
+  int32_t        slot;     // Slot owned by a transmitter, -1 for receivers
+  bool           attached; // Counted in the users of the segment
+  uint32_t       trx_timeout_ms;
+} rf_shm_port_t;
+
+/**
+ * @brief Maps the segment with the given name, creating it if it does not exist yet. A transmitter port also claims a
+ * free slot.
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR otherwise
+ */
+SRSRAN_API int rf_shm_port_open(rf_shm_port_t* q, const char* name, const rf_shm_port_opts_t* opts);
+
+SRSRAN_API void rf_shm_port_close(rf_shm_port_t* q);
+
+SRSRAN_API bool rf_shm_port_is_open(rf_shm_port_t* q);
+
+/**
+ * @brief Starts the timeline of a transmitter at ts, if it has not started yet. Receivers consider the samples before
+ * it as zeros and do not wait for them.
+ */
+SRSRAN_API void rf_shm_port_start(rf_shm_port_t* q, uint64_t ts);
+
+/**
+ * @brief Writes nsamples from ts in the transmitter slot, zeros if buffer is NULL. The gap between the last written
+ * sample and ts is filled with zeros.
+ * @return nsamples if the samples were written, SRSRAN_ERROR if ts is earlier than the last written sample
+ */
+SRSRAN_API int rf_shm_port_write(rf_shm_port_t* q, uint64_t ts, const cf_t* buffer, uint32_t nsamples);
+
+/**
+ * @brief Fills the transmitter slot with zeros up to ts, so the receivers do not wait for this transmitter
+ */
+SRSRAN_API void rf_shm_port_align(rf_shm_port_t* q, uint64_t ts);
+
+// Timestamp following the last sample written by the transmitter, RF_SHM_TS_NONE if it has not started
+SRSRAN_API uint64_t rf_shm_port_get_write_ts(rf_shm_port_t* q);
+
+// Latest timestamp published by any of the transmitters of the port, 0 if none has started
+SRSRAN_API uint64_t rf_shm_port_get_ts(rf_shm_port_t* q);
+
+/**
+ * @brief Reads nsamples from ts, adding the samples of all the active transmitters. It waits for the transmitters that
+ * did not reach ts + nsamples yet, up to trx_timeout_ms each.
+ * @return Number of transmitters added, SRSRAN_ERROR if an error occurs
+ */
+SRSRAN_API int rf_shm_port_read(rf_shm_port_t* q, uint64_t ts, cf_t* buffer, uint32_t nsamples);
+
+#endif // SRSRAN_RF_SHM_IMP_PORT_H
@@ -0,0 +1,256 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/tsan_options.h"
+#include "srsran/phy/common/timestamp.h"
+#include "srsran/phy/rf/rf.h"
+#include <complex.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <srsran/phy/common/phy_common.h>
+#include <srsran/phy/utils/vector.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define NOF_UE (2)
+#define NUM_SF (200)
+#define SF_LEN (1920)
+#define SRATE (1.92e6)
+#define TX_OFFSET_MS (4)
+
+// Samples received by every node, with the timestamp of every subframe
+static cf_t     enb_rx_buffer[NUM_SF][SF_LEN];
+static uint64_t enb_rx_ts[NUM_SF];
+static cf_t     ue_rx_buffer[NOF_UE][2 * NUM_SF][SF_LEN];
+static uint64_t ue_rx_ts[NOF_UE][2 * NUM_SF];
+static uint32_t ue_nof_sf[NOF_UE];
+
+static char              dl_port[RF_PARAM_LEN];
+static char              ul_port[RF_PARAM_LEN];
+static pthread_barrier_t barrier;
+static bool              enb_done = false;
+
+// Signal transmitted at timestamp t, the UEs transmit a multiple of it
+static cf_t signal_at(uint64_t t)
+{
+  return (float)(t % 4096) + _Complex_I * (float)((t / 4096) % 4096);
+}
+
+static srsran_rf_t* open_radio(const char* tx_port, const char* rx_port, const char* id)
+{
+  char rf_args[RF_PARAM_LEN] = {};
+  snprintf(rf_args,
+           RF_PARAM_LEN,
+           "id=%s,base_srate=%.0f,trx_timeout_ms=1000,tx_port=%s,rx_port=%s",
+           id,
+           SRATE,
+           tx_port,
+           rx_port);
+
+  srsran_rf_t* radio = calloc(1, sizeof(srsran_rf_t));
+  if (radio == NULL || srsran_rf_open_devname(radio, "shm", rf_args, 1)) {
+    fprintf(stderr, "Error opening rf\n");
+    exit(-1);
+  }
+  srsran_rf_set_rx_srate(radio, SRATE);
+  srsran_rf_set_tx_srate(radio, SRATE);
+  return radio;
+}
+
+// Receives one subframe and transmits the given multiple of the signal TX_OFFSET_MS later
+static uint64_t trx_subframe(srsran_rf_t* radio, cf_t* rx_buffer, float amplitude)
+{
+  static __thread cf_t tx_buffer[SF_LEN];
+  srsran_timestamp_t   rx_time = {}, tx_time = {};
+
+  void* data_ptr[SRSRAN_MAX_PORTS] = {rx_buffer};
+  if (srsran_rf_recv_with_time_multi(radio, data_ptr, SF_LEN, true, &rx_time.full_secs, &rx_time.frac_secs) !=
+      SF_LEN) {
+    fprintf(stderr, "Error receiving data\n");
+    exit(-1);
+  }
+  uint64_t rx_ts = srsran_timestamp_uint64(&rx_time, SRATE);
+
+  uint64_t tx_ts = rx_ts + TX_OFFSET_MS * SF_LEN;
+  for (uint32_t i = 0; i < SF_LEN; i++) {
+    tx_buffer[i] = amplitude * signal_at(tx_ts + i);
+  }
+  srsran_timestamp_init_uint64(&tx_time, tx_ts, SRATE);
+  data_ptr[0] = tx_buffer;
+  if (srsran_rf_send_timed_multi(radio, data_ptr, SF_LEN, tx_time.full_secs, tx_time.frac_secs, true, true, false) !=
+      SRSRAN_SUCCESS) {
+    fprintf(stderr, "Error sending data\n");
+    exit(-1);
+  }
+
+  return rx_ts;
+}
+
+static void* enb_thread_function(void* args)
+{
+  srsran_rf_t* radio = open_radio(dl_port, ul_port, "enb");
+  pthread_barrier_wait(&barrier);
+
+  for (uint32_t sf = 0; sf < NUM_SF; sf++) {
+    enb_rx_ts[sf] = trx_subframe(radio, enb_rx_buffer[sf], 1.0f);
+  }
+
+  srsran_rf_close(radio);
+  free(radio);
+  __atomic_store_n(&enb_done, true, __ATOMIC_RELEASE);
+  return NULL;
+}
+
+static void* ue_thread_function(void* args)
+{
+  uint32_t ue = (uint32_t)(size_t)args;
+  char     id[RF_PARAM_LEN];
+  snprintf(id, RF_PARAM_LEN, "ue%d", ue);
+
+  srsran_rf_t* radio = open_radio(ul_port, dl_port, id);
+  pthread_barrier_wait(&barrier);
+
+  uint32_t sf = 0;
+  while (!__atomic_load_n(&enb_done, __ATOMIC_ACQUIRE) && sf < 2 * NUM_SF) {
+    ue_rx_ts[ue][sf] = trx_subframe(radio, ue_rx_buffer[ue][sf], (float)(ue + 1));
+    sf++;
+  }
+  ue_nof_sf[ue] = sf;
+
+  srsran_rf_close(radio);
+  free(radio);
+  return NULL;
+}
+
+// Checks that every received sample is one of the given multiples of the transmitted signal
+static int check_samples(const char* name,
+                         cf_t*       buffer,
+                         uint64_t    ts,
+                         uint32_t    nof_amplitudes,
+                         uint32_t*   count)
+{
+  for (uint32_t i = 0; i < SF_LEN; i++) {
+    cf_t expected = signal_at(ts + i);
+    bool match    = false;
+    for (uint32_t a = 0; a < nof_amplitudes && !match; a++) {
+      if (cabsf(buffer[i] - (float)a * expected) < 1e-3f) {
+        match = true;
+        count[a]++;
+      }
+    }
+    if (!match) {
+      fprintf(stderr,
+              "%s sample %d of ts=%" PRIu64 " is %+.1f%+.1fi, expected a multiple of %+.1f%+.1fi\n",
+              name,
+              i,
+              ts,
+              __real__ buffer[i],
+              __imag__ buffer[i],
+              __real__ expected,
+              __imag__ expected);
+      return SRSRAN_ERROR;
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  int ret = SRSRAN_ERROR;
+
+  snprintf(dl_port, RF_PARAM_LEN, "/srsran_shm_test_dl_%d", getpid());
+  snprintf(ul_port, RF_PARAM_LEN, "/srsran_shm_test_ul_%d", getpid());
+
+  pthread_barrier_init(&barrier, NULL, NOF_UE + 1);
+
+  pthread_t enb_thread;
+  pthread_t ue_thread[NOF_UE];
+  pthread_create(&enb_thread, NULL, enb_thread_function, NULL);
+  for (uint32_t ue = 0; ue < NOF_UE; ue++) {
+    pthread_create(&ue_thread[ue], NULL, ue_thread_function, (void*)(size_t)ue);
+  }
+
+  pthread_join(enb_thread, NULL);
+  for (uint32_t ue = 0; ue < NOF_UE; ue++) {
+    pthread_join(ue_thread[ue], NULL);
+  }
+
+  // Every UE receives either nothing or the eNB signal, aligned with its timestamp
+  for (uint32_t ue = 0; ue < NOF_UE; ue++) {
+    uint32_t count[2] = {};
+    for (uint32_t sf = 0; sf < ue_nof_sf[ue]; sf++) {
+      if (check_samples("UE", ue_rx_buffer[ue][sf], ue_rx_ts[ue][sf], 2, count)) {
+        goto exit;
+      }
+    }
+    printf("UE %d received %d subframes, %d signal samples\n", ue, ue_nof_sf[ue], count[1]);
+    if (count[1] < (NUM_SF / 2) * SF_LEN) {
+      fprintf(stderr, "UE %d did not receive enough signal\n", ue);
+      goto exit;
+    }
+  }
+
+  // The eNB receives the sum of the UEs transmitting at the time, both of them most of the time
+  uint32_t count[NOF_UE + 2] = {};
+  for (uint32_t sf = 0; sf < NUM_SF; sf++) {
+    if (check_samples("eNB", enb_rx_buffer[sf], enb_rx_ts[sf], NOF_UE + 2, count)) {
+      goto exit;
+    }
+  }
+  printf("eNB received %d samples from both UEs\n", count[NOF_UE + 1]);
+  if (count[NOF_UE + 1] < (NUM_SF / 2) * SF_LEN) {
+    fprintf(stderr, "eNB did not receive the sum of both UEs\n");
+    goto exit;
+  }
+
+  // The last radio closing a port removes its segment
+  for (uint32_t i = 0; i < 2; i++) {
+    const char* port = (i == 0) ? dl_port : ul_port;
+    int         fd   = shm_open(port, O_RDONLY, 0);
+    if (fd >= 0 || errno != ENOENT) {
+      fprintf(stderr, "Segment %s was not removed\n", port);
+      if (fd >= 0) {
+        close(fd);
+      }
+      goto exit;
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+exit:
+  pthread_barrier_destroy(&barrier);
+  shm_unlink(dl_port);
+  shm_unlink(ul_port);
+
+  if (ret == SRSRAN_SUCCESS) {
+    printf("Test passed!\n");
+  } else {
+    printf("Test failed!\n");
+  }
+
+  return ret;
+}
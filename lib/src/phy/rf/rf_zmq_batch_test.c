@@ -0,0 +1,181 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_zmq_imp_trx.h"
+#include "srsran/common/tsan_options.h"
+#include <complex.h>
+#include <pthread.h>
+#include <srsran/phy/utils/vector.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zmq.h>
+
+#define NOF_CHANNELS (2)
+#define NOF_TX (3)
+#define TX_LEN (ZMQ_MAX_MSG_NSAMPLES + 12345) // Every transmission is split in two batches
+#define RX_LEN (23040)
+#define TOTAL_LEN (NOF_TX * TX_LEN)
+
+static rf_zmq_tx_t tx                = {};
+static rf_zmq_rx_t rx[NOF_CHANNELS] = {};
+static cf_t*       tx_buffer[NOF_CHANNELS];
+static cf_t*       rx_buffer[NOF_CHANNELS];
+
+// Sample transmitted at time t by channel ch, every channel is different so swapped blocks are detected
+static cf_t signal_at(uint32_t ch, uint32_t t)
+{
+  return (float)((t + 1000 * ch) % 2000) / 2000.0f - 0.5f + _Complex_I * (0.25f * ch - 0.4f);
+}
+
+// The second transmission leaves the last channel without buffer, the receiver gets zeros for it
+static cf_t expected_at(uint32_t ch, uint32_t t)
+{
+  return (t / TX_LEN == 1 && ch == NOF_CHANNELS - 1) ? 0.0f : signal_at(ch, t);
+}
+
+static void* tx_thread(void* arg)
+{
+  for (uint32_t i = 0; i < NOF_TX; i++) {
+    cf_t* buffers[SRSRAN_MAX_CHANNELS] = {};
+    for (uint32_t ch = 0; ch < NOF_CHANNELS; ch++) {
+      buffers[ch] = &tx_buffer[ch][i * TX_LEN];
+    }
+    if (i == 1) {
+      buffers[NOF_CHANNELS - 1] = NULL;
+    }
+    if (rf_zmq_tx_baseband(&tx, buffers, TX_LEN, 1.0f) != TX_LEN) {
+      fprintf(stderr, "Error transmitting batch %d\n", i);
+      exit(-1);
+    }
+  }
+  return NULL;
+}
+
+static int test_batch(rf_zmq_format_t format)
+{
+  int   ret = SRSRAN_ERROR;
+  void* ctx = zmq_ctx_new();
+
+  rf_zmq_opts_t opts  = {};
+  opts.id             = "batch";
+  opts.sample_format  = format;
+  opts.trx_timeout_ms = 100;
+  opts.nof_channels   = NOF_CHANNELS;
+
+  opts.socket_type = ZMQ_REP;
+  if (rf_zmq_tx_open(&tx, opts, ctx, "inproc://rf_zmq_batch_test")) {
+    fprintf(stderr, "Error opening transmitter\n");
+    return SRSRAN_ERROR;
+  }
+
+  // The carried channels have no socket, the first one writes their rings
+  opts.socket_type = ZMQ_REQ;
+  for (uint32_t ch = NOF_CHANNELS - 1; ch > 0; ch--) {
+    if (rf_zmq_rx_open(&rx[ch], opts, ctx, NULL)) {
+      fprintf(stderr, "Error opening receiver %d\n", ch);
+      return SRSRAN_ERROR;
+    }
+    opts.batch_ring[ch] = &rx[ch].ringbuffer;
+  }
+  if (rf_zmq_rx_open(&rx[0], opts, ctx, "inproc://rf_zmq_batch_test")) {
+    fprintf(stderr, "Error opening receiver 0\n");
+    return SRSRAN_ERROR;
+  }
+
+  pthread_t thread;
+  pthread_create(&thread, NULL, tx_thread, NULL);
+
+  // Read the channels in turns, so none of the rings fills up
+  for (uint32_t count = 0; count < TOTAL_LEN; count += RX_LEN) {
+    uint32_t nsamples = SRSRAN_MIN(RX_LEN, TOTAL_LEN - count);
+    for (uint32_t ch = 0; ch < NOF_CHANNELS; ch++) {
+      if (rf_zmq_rx_baseband(&rx[ch], &rx_buffer[ch][count], nsamples) < SRSRAN_SUCCESS) {
+        fprintf(stderr, "Error receiving channel %d\n", ch);
+        goto clean_exit;
+      }
+    }
+  }
+  pthread_join(thread, NULL);
+
+  // The sc16 samples are quantized
+  float tolerance = (format == ZMQ_TYPE_SC16) ? 2.0f / INT16_MAX : 0.0f;
+  for (uint32_t ch = 0; ch < NOF_CHANNELS; ch++) {
+    for (uint32_t t = 0; t < TOTAL_LEN; t++) {
+      if (cabsf(rx_buffer[ch][t] - expected_at(ch, t)) > tolerance) {
+        fprintf(stderr,
+                "Error: channel %d sample %d is %+.4f%+.4fi, expected %+.4f%+.4fi\n",
+                ch,
+                t,
+                crealf(rx_buffer[ch][t]),
+                cimagf(rx_buffer[ch][t]),
+                crealf(expected_at(ch, t)),
+                cimagf(expected_at(ch, t)));
+        goto clean_exit;
+      }
+    }
+  }
+
+  // Every batch header was received, the first one seeded the expected timestamp
+  if (rx[0].batch_ts != TOTAL_LEN) {
+    fprintf(stderr, "Error: expected batch timestamp %d, got %d\n", TOTAL_LEN, (int)rx[0].batch_ts);
+    goto clean_exit;
+  }
+
+  printf("Batch loopback of %d channels and %d samples passed for %s\n",
+         NOF_CHANNELS,
+         TOTAL_LEN,
+         (format == ZMQ_TYPE_SC16) ? "sc16" : "fc32");
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  for (uint32_t ch = 0; ch < NOF_CHANNELS; ch++) {
+    rf_zmq_rx_close(&rx[ch]);
+  }
+  rf_zmq_tx_close(&tx);
+  zmq_ctx_destroy(ctx);
+  return ret;
+}
+
+int main()
+{
+  int ret = SRSRAN_SUCCESS;
+
+  for (uint32_t ch = 0; ch < NOF_CHANNELS; ch++) {
+    tx_buffer[ch] = srsran_vec_cf_malloc(TOTAL_LEN);
+    rx_buffer[ch] = srsran_vec_cf_malloc(TOTAL_LEN);
+    for (uint32_t t = 0; t < TOTAL_LEN; t++) {
+      tx_buffer[ch][t] = signal_at(ch, t);
+    }
+  }
+
+  if (test_batch(ZMQ_TYPE_FC32) != SRSRAN_SUCCESS || test_batch(ZMQ_TYPE_SC16) != SRSRAN_SUCCESS) {
+    ret = SRSRAN_ERROR;
+  }
+
+  for (uint32_t ch = 0; ch < NOF_CHANNELS; ch++) {
+    free(tx_buffer[ch]);
+    free(rx_buffer[ch]);
+  }
+
+  printf("%s\n", (ret == SRSRAN_SUCCESS) ? "Ok" : "Failed");
+  return ret;
+}
@@ -47,6 +47,7 @@ typedef struct {
   uint32_t tx_freq_mhz[SRSRAN_MAX_CHANNELS];
   uint32_t rx_freq_mhz[SRSRAN_MAX_CHANNELS];
   bool     tx_off;
+  bool     batch; // All channels are carried in the messages of the first channel ports
   char     id[RF_PARAM_LEN];
 
   // Server
@@ -56,7 +57,7 @@ typedef struct {
 
   // Various sample buffers
   cf_t* buffer_decimation[SRSRAN_MAX_CHANNELS];
-  cf_t* buffer_tx;
+  cf_t* buffer_tx[SRSRAN_MAX_CHANNELS];
 
   // Rx timestamp
   uint64_t next_rx_ts;
@@ -288,6 +289,11 @@ int rf_zmq_open_multi(char* args, void** h, uint32_t nof_channels)
           goto clean_exit;
         }
       }
+
+      // batch
+      if (parse_string(args, "batch", -1, tmp) == SRSRAN_SUCCESS) {
+        handler->batch = (strncmp(tmp, "true", RF_PARAM_LEN) == 0 || strncmp(tmp, "yes", RF_PARAM_LEN) == 0);
+      }
     } else {
       fprintf(stderr,
               "[zmq] Error: No device 'args' option has been set. Please make sure to set this option to be able to "
@@ -304,10 +310,24 @@ int rf_zmq_open_multi(char* args, void** h, uint32_t nof_channels)
       goto clean_exit;
     }
 
-    for (int i = 0; i < handler->nof_channels; i++) {
+    if (handler->batch && handler->nof_channels > 1) {
+      rx_opts.nof_channels = handler->nof_channels;
+      tx_opts.nof_channels = handler->nof_channels;
+      for (uint32_t ch = 1; ch < handler->nof_channels; ch++) {
+        rx_opts.batch_ring[ch] = &handler->receiver[ch].ringbuffer;
+      }
+    } else {
+      handler->batch = false;
+    }
+
+    for (int k = 0; k < handler->nof_channels; k++) {
+      // In batch mode the first channel carries the others, it is open last so their rings are ready when it starts
+      int  i       = (handler->batch) ? (int)handler->nof_channels - 1 - k : k;
+      bool carried = handler->batch && i > 0;
+
       // rx_port
       char rx_port[RF_PARAM_LEN] = {};
-      parse_string(args, "rx_port", i, rx_port);
+      parse_string(args, "rx_port", carried ? 0 : i, rx_port);
 
       // rx_freq
       double rx_freq = 0.0f;
@@ -319,7 +339,7 @@ int rf_zmq_open_multi(char* args, void** h, uint32_t nof_channels)
 
       // tx_port
       char tx_port[RF_PARAM_LEN] = {};
-      parse_string(args, "tx_port", i, tx_port);
+      parse_string(args, "tx_port", carried ? 0 : i, tx_port);
 
       // tx_freq
       double tx_freq = 0.0f;
@@ -347,9 +367,10 @@ int rf_zmq_open_multi(char* args, void** h, uint32_t nof_channels)
         rx_opts.log_trx_timeout = true;
       }
 
-      // initialize transmitter
+      // initialize transmitter, carried channels are sent by the first one
       if (strlen(tx_port) != 0) {
-        if (rf_zmq_tx_open(&handler->transmitter[i], tx_opts, handler->context, tx_port) != SRSRAN_SUCCESS) {
+        if (!carried &&
+            rf_zmq_tx_open(&handler->transmitter[i], tx_opts, handler->context, tx_port) != SRSRAN_SUCCESS) {
           fprintf(stderr, "[zmq] Error: opening transmitter\n");
           goto clean_exit;
         }
@@ -360,7 +381,8 @@ int rf_zmq_open_multi(char* args, void** h, uint32_t nof_channels)
 
       // initialize receiver
       if (strlen(rx_port) != 0) {
-        if (rf_zmq_rx_open(&handler->receiver[i], rx_opts, handler->context, rx_port) != SRSRAN_SUCCESS) {
+        if (rf_zmq_rx_open(&handler->receiver[i], rx_opts, handler->context, carried ? NULL : rx_port) !=
+            SRSRAN_SUCCESS) {
           fprintf(stderr, "[zmq] Error: opening receiver\n");
           goto clean_exit;
         }
@@ -368,25 +390,25 @@ int rf_zmq_open_multi(char* args, void** h, uint32_t nof_channels)
         fprintf(stdout, "[zmq] %s Rx port not specified. Disabling receiver.\n", handler->id);
       }
 
-      if (!handler->transmitter[i].running && !handler->receiver[i].running) {
+      if (!carried && !handler->transmitter[i].running && !handler->receiver[i].running) {
         fprintf(stderr, "[zmq] Error: Neither Tx port nor Rx port specified.\n");
         goto clean_exit;
       }
     }
 
-    // Create decimation and overflow buffer
+    // Create decimation and interpolation buffers
     for (uint32_t i = 0; i < handler->nof_channels; i++) {
       handler->buffer_decimation[i] = srsran_vec_malloc(ZMQ_MAX_BUFFER_SIZE);
       if (!handler->buffer_decimation[i]) {
         fprintf(stderr, "Error: allocating decimation buffer\n");
         goto clean_exit;
       }
-    }
 
-    handler->buffer_tx = srsran_vec_malloc(ZMQ_MAX_BUFFER_SIZE);
-    if (!handler->buffer_tx) {
-      fprintf(stderr, "Error: allocating tx buffer\n");
-      goto clean_exit;
+      handler->buffer_tx[i] = srsran_vec_malloc(ZMQ_MAX_BUFFER_SIZE);
+      if (!handler->buffer_tx[i]) {
+        fprintf(stderr, "Error: allocating tx buffer\n");
+        goto clean_exit;
+      }
     }
 
     ret = SRSRAN_SUCCESS;
@@ -418,10 +440,9 @@ int rf_zmq_close(void* h)
     if (handler->buffer_decimation[i]) {
       free(handler->buffer_decimation[i]);
     }
-  }
-
-  if (handler->buffer_tx) {
-    free(handler->buffer_tx);
+    if (handler->buffer_tx[i]) {
+      free(handler->buffer_tx[i]);
+    }
   }
 
   pthread_mutex_destroy(&handler->tx_config_mutex);
@@ -779,7 +800,7 @@ int rf_zmq_recv_with_time_multi(void* h, void** data, uint32_t nsamples, bool bl
     rf_zmq_info(handler->id,
                 " - read %d samples. %d samples available\n",
                 NBYTES2NSAMPLES(nbytes),
-                NBYTES2NSAMPLES(srsran_ringbuffer_status(&handler->receiver[0].ringbuffer)));
+                NBYTES2NSAMPLES(srsran_spsc_ring_status(&handler->receiver[0].ringbuffer)));
 
     // decimate if needed
     if (decim_factor != 1) {
@@ -938,51 +959,41 @@ int rf_zmq_send_timed_multi(void*  h,
       }
     }
 
-    // Send base-band samples
+    // Interpolate if required, the gain is applied while the samples are written in the message
     for (int i = 0; i < handler->nof_channels; i++) {
-      if (buffers[i] != NULL) {
-        // Select buffer pointer depending on interpolation
-        cf_t* buf = (decim_factor != 1) ? handler->buffer_tx : buffers[i];
-
-        // Interpolate if required
-        if (decim_factor != 1) {
-          rf_zmq_info(handler->id,
-                      "  - re-adjust bytes due to %dx interpolation %d --> %d samples)\n",
-                      decim_factor,
-                      nsamples,
-                      nsamples_baseband);
-
-          int   n   = 0;
-          cf_t* src = buffers[i];
-          for (int k = 0; k < nsamples; k++) {
-            // perform zero order hold
-            for (int j = 0; j < decim_factor; j++, n++) {
-              buf[n] = src[k];
-            }
-          }
-
-          if (nsamples_baseband != n) {
-            fprintf(stderr,
-                    "Number of tx samples (%d) does not match with number of interpolated samples (%d)\n",
-                    nsamples_baseband,
-                    n);
-            goto clean_exit;
+      if (buffers[i] != NULL && decim_factor != 1) {
+        rf_zmq_info(handler->id,
+                    "  - re-adjust bytes due to %dx interpolation %d --> %d samples)\n",
+                    decim_factor,
+                    nsamples,
+                    nsamples_baseband);
+
+        int   n   = 0;
+        cf_t* buf = handler->buffer_tx[i];
+        cf_t* src = buffers[i];
+        for (int k = 0; k < nsamples; k++) {
+          // perform zero order hold
+          for (int j = 0; j < decim_factor; j++, n++) {
+            buf[n] = src[k];
           }
         }
 
-        // Scale according to current gain
-        srsran_vec_sc_prod_cfc(buf, tx_gain, buf, nsamples_baseband);
-
-        // Finally, transmit baseband
-        int n = rf_zmq_tx_baseband(&handler->transmitter[i], buf, nsamples_baseband);
-        if (n == SRSRAN_ERROR) {
-          goto clean_exit;
-        }
-      } else {
-        int n = rf_zmq_tx_zeros(&handler->transmitter[i], nsamples_baseband);
-        if (n == SRSRAN_ERROR) {
+        if (nsamples_baseband != n) {
+          fprintf(stderr,
+                  "Number of tx samples (%d) does not match with number of interpolated samples (%d)\n",
+                  nsamples_baseband,
+                  n);
           goto clean_exit;
         }
+        buffers[i] = buf;
+      }
+    }
+
+    // Send base-band samples, a single message carries all of them in batch mode
+    for (int i = 0; i < (handler->batch ? 1 : handler->nof_channels); i++) {
+      int n = rf_zmq_tx_baseband(&handler->transmitter[i], &buffers[i], nsamples_baseband, tx_gain);
+      if (n == SRSRAN_ERROR) {
+        goto clean_exit;
       }
     }
   }
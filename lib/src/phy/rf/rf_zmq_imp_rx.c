@@ -26,14 +26,152 @@
 #include <string.h>
 #include <zmq.h>
 
+// A zero trx_timeout_ms means waiting forever for the ring
+static int32_t rf_zmq_rx_ring_timeout(rf_zmq_rx_t* q)
+{
+  return (q->trx_timeout_ms > 0) ? (int32_t)q->trx_timeout_ms : -1;
+}
+
+/*
+ * Receives a message straight into a region reserved in the ring, ZMQ copies the samples once and the ring does not
+ * copy them again. Returns the number of bytes written in the ring, 0 if the message was dropped or SRSRAN_ERROR if
+ * the receiver has to stop.
+ */
+static int rf_zmq_rx_recv_ring(rf_zmq_rx_t* q, srsran_spsc_ring_t* ring)
+{
+  // Wait until the largest message fits, a message does not fit if the consumer is late
+  int n = SRSRAN_ERROR_TIMEOUT;
+  while (n == SRSRAN_ERROR_TIMEOUT && rf_zmq_rx_is_running(q)) {
+    n = srsran_spsc_ring_wait_write(ring, ZMQ_MAX_MSG_SIZE, rf_zmq_rx_ring_timeout(q));
+    if (n == SRSRAN_ERROR_TIMEOUT && q->log_trx_timeout) {
+      fprintf(stderr, "Error: timeout writing samples to ringbuffer after %dms\n", q->trx_timeout_ms);
+    }
+  }
+  if (n < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  void* ptr = srsran_spsc_ring_reserve(ring, ZMQ_MAX_MSG_SIZE);
+  if (ptr == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  for (n = -1; n < 0 && rf_zmq_rx_is_running(q);) {
+    n = zmq_recv(q->sock, ptr, ZMQ_MAX_MSG_SIZE, 0);
+    if (n < 0 && rf_zmq_handle_error(q->id, "asynchronous rx baseband receive")) {
+      return SRSRAN_ERROR;
+    }
+  }
+  if (n < 0) {
+    return SRSRAN_ERROR;
+  }
+
+  // ZMQ truncates the messages longer than the reserved region
+  if ((uint32_t)n > ZMQ_MAX_MSG_SIZE) {
+    rf_zmq_error(q->id, "[zmq] Error: received %d B, the maximum message is %zu B. Dropped.\n", n, ZMQ_MAX_MSG_SIZE);
+    return 0;
+  }
+
+  srsran_spsc_ring_commit(ring, (uint32_t)n);
+  rf_zmq_info(q->id,
+              "   - received %d baseband samples (%d B). %d samples available.\n",
+              NBYTES2NSAMPLES(n),
+              n,
+              NBYTES2NSAMPLES(srsran_spsc_ring_status(ring)));
+
+  return n;
+}
+
+// Tells whether the message being received has more parts
+static bool rf_zmq_rx_more(rf_zmq_rx_t* q)
+{
+  int    more    = 0;
+  size_t more_sz = sizeof(more);
+  return zmq_getsockopt(q->sock, ZMQ_RCVMORE, &more, &more_sz) == 0 && more;
+}
+
+// Discards the parts left of the message being received
+static void rf_zmq_rx_discard(rf_zmq_rx_t* q)
+{
+  while (rf_zmq_rx_more(q)) {
+    zmq_msg_t msg;
+    zmq_msg_init(&msg);
+    zmq_msg_recv(&msg, q->sock, 0);
+    zmq_msg_close(&msg);
+  }
+}
+
+/*
+ * Receives a batch, the header part and then one part per channel. The parts of a message are delivered together, so
+ * every block is received straight into the ring of its channel. Returns SRSRAN_ERROR if the receiver has to stop.
+ */
+static int rf_zmq_rx_recv_batch(rf_zmq_rx_t* q)
+{
+  uint32_t           sample_sz = (q->sample_format == ZMQ_TYPE_SC16) ? 2 * sizeof(int16_t) : sizeof(cf_t);
+  rf_zmq_batch_hdr_t hdr       = {};
+
+  int n = -1;
+  while (n < 0 && rf_zmq_rx_is_running(q)) {
+    n = zmq_recv(q->sock, &hdr, sizeof(hdr), 0);
+    if (n < 0 && rf_zmq_handle_error(q->id, "asynchronous rx batch header receive")) {
+      return SRSRAN_ERROR;
+    }
+  }
+  if (n < 0) {
+    return SRSRAN_ERROR;
+  }
+
+  if (n != sizeof(hdr) || hdr.nof_channels != q->nof_channels || hdr.nof_samples * sample_sz > ZMQ_MAX_MSG_SIZE) {
+    rf_zmq_error(q->id,
+                 "[zmq] Error: received %d B batch header of %d channels and %d samples, expected %d channels.\n",
+                 n,
+                 hdr.nof_channels,
+                 hdr.nof_samples,
+                 q->nof_channels);
+    rf_zmq_rx_discard(q);
+    return SRSRAN_SUCCESS;
+  }
+
+  // The first batch gives the timestamp the next ones follow
+  if (q->batch_started && hdr.timestamp != q->batch_ts) {
+    rf_zmq_error(q->id,
+                 "[zmq] Warning: batch timestamp %" PRIu64 " does not follow the previous one, expected %" PRIu64 ".\n",
+                 hdr.timestamp,
+                 q->batch_ts);
+  }
+  q->batch_started = true;
+  q->batch_ts      = hdr.timestamp + hdr.nof_samples;
+
+  for (uint32_t ch = 0; ch < q->nof_channels; ch++) {
+    if (!rf_zmq_rx_more(q)) {
+      rf_zmq_error(q->id, "[zmq] Error: batch ended after %d of %d channels.\n", ch, q->nof_channels);
+      return SRSRAN_SUCCESS;
+    }
+
+    n = rf_zmq_rx_recv_ring(q, q->batch_ring[ch]);
+    if (n < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    if (n != (int)(hdr.nof_samples * sample_sz)) {
+      rf_zmq_error(q->id,
+                   "[zmq] Error: received %d B at channel %d, the batch header announced %d samples.\n",
+                   n,
+                   ch,
+                   hdr.nof_samples);
+    }
+  }
+  rf_zmq_rx_discard(q);
+
+  return SRSRAN_SUCCESS;
+}
+
 static void* rf_zmq_async_rx_thread(void* h)
 {
   rf_zmq_rx_t* q = (rf_zmq_rx_t*)h;
 
   while (q->sock && rf_zmq_rx_is_running(q)) {
-    int     nbytes = 0;
-    int     n      = SRSRAN_ERROR;
-    uint8_t dummy  = 0xFF;
+    int     n     = SRSRAN_ERROR;
+    uint8_t dummy = 0xFF;
 
     rf_zmq_info(q->id, "-- ASYNC RX wait...\n");
 
@@ -51,47 +189,18 @@ static void* rf_zmq_async_rx_thread(void* h)
     } else {
       n = 0;
     }
-
-    // Receive baseband
-    for (n = (n < 0) ? 0 : -1; n < 0 && rf_zmq_rx_is_running(q);) {
-      n = zmq_recv(q->sock, q->temp_buffer, ZMQ_MAX_BUFFER_SIZE, 0);
-      if (n == -1) {
-        if (rf_zmq_handle_error(q->id, "asynchronous rx baseband receive")) {
-          return NULL;
-        }
-
-      } else if (n > ZMQ_MAX_BUFFER_SIZE) {
-        fprintf(stderr,
-                "[zmq] Error: receiver expected <= %zu bytes and received %d at channel %d.\n",
-                ZMQ_MAX_BUFFER_SIZE,
-                n,
-                0);
-        return NULL;
-      } else {
-        nbytes = n;
-      }
+    if (n < 0) {
+      break;
     }
 
-    // Write received data in buffer
-    if (nbytes > 0) {
-      n = -1;
-
-      // Try to write in ring buffer
-      while (n < 0 && rf_zmq_rx_is_running(q)) {
-        n = srsran_ringbuffer_write_timed(&q->ringbuffer, q->temp_buffer, nbytes, q->trx_timeout_ms);
-        if (n == SRSRAN_ERROR_TIMEOUT && q->log_trx_timeout) {
-          fprintf(stderr, "Error: timeout writing samples to ringbuffer after %dms\n", q->trx_timeout_ms);
-        }
-      }
-
-      // Check write
-      if (nbytes == n) {
-        rf_zmq_info(q->id,
-                    "   - received %d baseband samples (%d B). %d samples available.\n",
-                    NBYTES2NSAMPLES(n),
-                    n,
-                    NBYTES2NSAMPLES(srsran_ringbuffer_status(&q->ringbuffer)));
-      }
+    // Receive baseband straight into the rings
+    if (q->nof_channels > 1) {
+      n = rf_zmq_rx_recv_batch(q);
+    } else {
+      n = rf_zmq_rx_recv_ring(q, &q->ringbuffer);
+    }
+    if (n < SRSRAN_SUCCESS) {
+      return NULL;
     }
   }
 
@@ -110,12 +219,6 @@ int rf_zmq_rx_open(rf_zmq_rx_t* q, rf_zmq_opts_t opts, void* zmq_ctx, char* sock
     strncpy(q->id, opts.id, ZMQ_ID_STRLEN - 1);
     q->id[ZMQ_ID_STRLEN - 1] = '\0';
 
-    // Create socket
-    q->sock = zmq_socket(zmq_ctx, opts.socket_type);
-    if (!q->sock) {
-      fprintf(stderr, "[zmq] Error: creating transmitter socket\n");
-      goto clean_exit;
-    }
     q->socket_type        = opts.socket_type;
     q->sample_format      = opts.sample_format;
     q->frequency_mhz      = opts.frequency_mhz;
@@ -123,6 +226,32 @@ int rf_zmq_rx_open(rf_zmq_rx_t* q, rf_zmq_opts_t opts, void* zmq_ctx, char* sock
     q->sample_offset      = opts.sample_offset;
     q->trx_timeout_ms     = opts.trx_timeout_ms;
     q->log_trx_timeout    = opts.log_trx_timeout;
+    q->nof_channels       = 1;
+    q->batch_ring[0]      = &q->ringbuffer;
+
+    if (srsran_spsc_ring_init(&q->ringbuffer, ZMQ_MAX_BUFFER_SIZE, ZMQ_MAX_MSG_SIZE)) {
+      fprintf(stderr, "Error: initiating ringbuffer\n");
+      goto clean_exit;
+    }
+
+    if (pthread_mutex_init(&q->mutex, NULL)) {
+      fprintf(stderr, "Error: creating mutex\n");
+      goto clean_exit;
+    }
+
+    // Without socket the samples are written by the batch receiver that carries this channel
+    if (sock_args == NULL) {
+      q->running = true;
+      ret        = SRSRAN_SUCCESS;
+      goto clean_exit;
+    }
+
+    // Create socket
+    q->sock = zmq_socket(zmq_ctx, opts.socket_type);
+    if (!q->sock) {
+      fprintf(stderr, "[zmq] Error: creating transmitter socket\n");
+      goto clean_exit;
+    }
 
     if (opts.socket_type == ZMQ_SUB) {
       zmq_setsockopt(q->sock, ZMQ_SUBSCRIBE, "", 0);
@@ -172,26 +301,16 @@ int rf_zmq_rx_open(rf_zmq_rx_t* q, rf_zmq_opts_t opts, void* zmq_ctx, char* sock
       }
     }
 
-    if (srsran_ringbuffer_init(&q->ringbuffer, ZMQ_MAX_BUFFER_SIZE)) {
-      fprintf(stderr, "Error: initiating ringbuffer\n");
-      goto clean_exit;
-    }
-
-    q->temp_buffer = srsran_vec_malloc(ZMQ_MAX_BUFFER_SIZE);
-    if (!q->temp_buffer) {
-      fprintf(stderr, "Error: allocating rx buffer\n");
-      goto clean_exit;
-    }
-
-    q->temp_buffer_convert = srsran_vec_malloc(ZMQ_MAX_BUFFER_SIZE);
-    if (!q->temp_buffer_convert) {
-      fprintf(stderr, "Error: allocating rx buffer\n");
-      goto clean_exit;
-    }
-
-    if (pthread_mutex_init(&q->mutex, NULL)) {
-      fprintf(stderr, "Error: creating mutex\n");
-      goto clean_exit;
+    // In batch mode the messages also carry the samples of the other channels
+    if (opts.nof_channels > 1) {
+      q->nof_channels = SRSRAN_MIN(opts.nof_channels, SRSRAN_MAX_CHANNELS);
+      for (uint32_t ch = 1; ch < q->nof_channels; ch++) {
+        if (opts.batch_ring[ch] == NULL) {
+          fprintf(stderr, "Error: missing ring for batch channel %d\n", ch);
+          goto clean_exit;
+        }
+        q->batch_ring[ch] = opts.batch_ring[ch];
+      }
     }
 
     q->running = true;
@@ -209,45 +328,56 @@ clean_exit:
 
 int rf_zmq_rx_baseband(rf_zmq_rx_t* q, cf_t* buffer, uint32_t nsamples)
 {
-  void*    dst_buffer = buffer;
-  uint32_t sample_sz  = sizeof(cf_t);
+  uint32_t sample_sz = sizeof(cf_t);
   if (q->sample_format != ZMQ_TYPE_FC32) {
-    dst_buffer = q->temp_buffer_convert;
-    sample_sz  = 2 * sizeof(short);
+    sample_sz = 2 * sizeof(short);
   }
 
-  // If the read needs to be delayed
-  while (q->sample_offset > 0) {
-    uint32_t n_offset = SRSRAN_MIN(q->sample_offset, NBYTES2NSAMPLES(ZMQ_MAX_BUFFER_SIZE));
-    srsran_vec_zero(q->temp_buffer, n_offset);
-    int n = srsran_ringbuffer_write(&q->ringbuffer, q->temp_buffer, (int)(n_offset * sample_sz));
-    if (n < SRSRAN_SUCCESS) {
-      return n;
-    }
-    q->sample_offset -= n_offset;
+  // If the read needs to be delayed, the first samples are zero. Only the receive thread writes in the ring.
+  uint32_t n_delay = 0;
+  if (q->sample_offset > 0) {
+    n_delay = SRSRAN_MIN((uint32_t)q->sample_offset, nsamples);
+    srsran_vec_cf_zero(buffer, n_delay);
+    q->sample_offset -= (int32_t)n_delay;
   }
 
   // If the read needs to be advanced
   while (q->sample_offset < 0) {
     uint32_t n_offset = SRSRAN_MIN(-q->sample_offset, NBYTES2NSAMPLES(ZMQ_MAX_BUFFER_SIZE));
     int      n =
-        srsran_ringbuffer_read_timed(&q->ringbuffer, q->temp_buffer, (int)(n_offset * sample_sz), q->trx_timeout_ms);
+        srsran_spsc_ring_read_timed(&q->ringbuffer, NULL, n_offset * sample_sz, rf_zmq_rx_ring_timeout(q));
     if (n < SRSRAN_SUCCESS) {
       return n;
     }
     q->sample_offset += n_offset;
   }
 
-  int n = srsran_ringbuffer_read_timed(&q->ringbuffer, dst_buffer, sample_sz * nsamples, q->trx_timeout_ms);
-  if (n < 0) {
-    return n;
-  }
+  uint32_t nbytes = sample_sz * (nsamples - n_delay);
+  cf_t*    ptr    = &buffer[n_delay];
+  if (q->sample_format == ZMQ_TYPE_FC32) {
+    int n = srsran_spsc_ring_read_timed(&q->ringbuffer, ptr, nbytes, rf_zmq_rx_ring_timeout(q));
+    if (n < 0) {
+      return n;
+    }
+  } else {
+    int n = srsran_spsc_ring_wait_read(&q->ringbuffer, nbytes, rf_zmq_rx_ring_timeout(q));
+    if (n < 0) {
+      return n;
+    }
 
-  if (q->sample_format == ZMQ_TYPE_SC16) {
-    srsran_vec_convert_if(dst_buffer, INT16_MAX, (float*)buffer, 2 * nsamples);
+    // Convert straight from the ring, without copying the samples out first
+    uint32_t count = 0;
+    while (count < nbytes) {
+      uint32_t       len  = 0;
+      const int16_t* data = srsran_spsc_ring_peek(&q->ringbuffer, &len);
+      len                 = SRSRAN_MIN(len, nbytes - count);
+      srsran_vec_convert_if(data, INT16_MAX, (float*)ptr + count / sizeof(int16_t), len / sizeof(int16_t));
+      srsran_spsc_ring_release(&q->ringbuffer, len);
+      count += len;
+    }
   }
 
-  return n;
+  return (int)(sample_sz * nsamples);
 }
 
 bool rf_zmq_rx_match_freq(rf_zmq_rx_t* q, uint32_t freq_hz)
@@ -267,6 +397,11 @@ void rf_zmq_rx_close(rf_zmq_rx_t* q)
   q->running = false;
   pthread_mutex_unlock(&q->mutex);
 
+  // Wake up the receive thread if it is waiting for space in any of the rings it writes
+  for (uint32_t ch = 0; ch < q->nof_channels; ch++) {
+    srsran_spsc_ring_stop(q->batch_ring[ch]);
+  }
+
   if (q->thread) {
     pthread_join(q->thread, NULL);
     pthread_detach(q->thread);
@@ -274,15 +409,7 @@ void rf_zmq_rx_close(rf_zmq_rx_t* q)
 
   pthread_mutex_destroy(&q->mutex);
 
-  srsran_ringbuffer_free(&q->ringbuffer);
-
-  if (q->temp_buffer) {
-    free(q->temp_buffer);
-  }
-
-  if (q->temp_buffer_convert) {
-    free(q->temp_buffer_convert);
-  }
+  srsran_spsc_ring_free(&q->ringbuffer);
 
   if (q->sock) {
     zmq_close(q->sock);
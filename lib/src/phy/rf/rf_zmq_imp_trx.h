@@ -23,7 +23,8 @@
 #define SRSRAN_RF_ZMQ_IMP_TRX_H
 
 #include <pthread.h>
-#include <srsran/phy/utils/ringbuffer.h>
+#include <srsran/phy/common/phy_common.h>
+#include <srsran/phy/utils/spsc_ring.h>
 #include <stdbool.h>
 
 /* Definitions */
@@ -32,6 +33,8 @@
 #define NSAMPLES2NBYTES(X) (((uint32_t)(X)) * sizeof(cf_t))
 #define NBYTES2NSAMPLES(X) ((X) / sizeof(cf_t))
 #define ZMQ_MAX_BUFFER_SIZE (NSAMPLES2NBYTES(3072000)) // 10 subframes at 20 MHz
+#define ZMQ_MAX_MSG_NSAMPLES (307200) // Samples per channel and message, longer transmissions are split
+#define ZMQ_MAX_MSG_SIZE (NSAMPLES2NBYTES(ZMQ_MAX_MSG_NSAMPLES)) // Region the receiver reserves in the ring
 #define ZMQ_TIMEOUT_MS (2000)
 #define ZMQ_BASERATE_DEFAULT_HZ (23040000)
 #define ZMQ_ID_STRLEN 16
@@ -40,6 +43,16 @@
 
 typedef enum { ZMQ_TYPE_FC32 = 0, ZMQ_TYPE_SC16 } rf_zmq_format_t;
 
+/*
+ * In batch mode every message carries all the channels: this header followed by one block of nof_samples samples per
+ * channel, in channel order
+ */
+typedef struct {
+  uint64_t timestamp;    // Transmitter sample count of the first sample
+  uint32_t nof_samples;  // Number of samples per channel
+  uint32_t nof_channels; // Number of sample blocks after the header
+} rf_zmq_batch_hdr_t;
+
 typedef struct {
   char            id[ZMQ_ID_STRLEN];
   uint32_t        socket_type;
@@ -48,10 +61,9 @@ typedef struct {
   uint64_t        nsamples;
   bool            running;
   pthread_mutex_t mutex;
-  cf_t*           zeros;
-  void*           temp_buffer_convert;
   uint32_t        frequency_mhz;
   int32_t         sample_offset;
+  uint32_t        nof_channels; // Channels carried per message, more than one enables batch mode
 } rf_zmq_tx_t;
 
 typedef struct {
@@ -67,25 +79,29 @@ typedef struct {
   bool                running;
   pthread_t           thread;
   pthread_mutex_t     mutex;
-  srsran_ringbuffer_t ringbuffer;
-  cf_t*               temp_buffer;
-  void*               temp_buffer_convert;
+  srsran_spsc_ring_t  ringbuffer; // Lock-free, the receive thread writes and rf_zmq_rx_baseband() reads
   uint32_t            frequency_mhz;
   bool                fail_on_disconnect;
   uint32_t            trx_timeout_ms;
   bool                log_trx_timeout;
   int32_t             sample_offset;
+  uint32_t            nof_channels;                    // Channels carried per message
+  srsran_spsc_ring_t* batch_ring[SRSRAN_MAX_CHANNELS]; // Ring of each channel, the first one is ringbuffer
+  uint64_t            batch_ts;                        // Expected timestamp of the next batch
+  bool                batch_started;                   // Set once the first batch gave batch_ts
 } rf_zmq_rx_t;
 
 typedef struct {
-  const char*     id;
-  uint32_t        socket_type;
-  rf_zmq_format_t sample_format;
-  uint32_t        frequency_mhz;
-  bool            fail_on_disconnect;
-  uint32_t        trx_timeout_ms;
-  bool            log_trx_timeout;
-  int32_t         sample_offset; ///< offset in samples
+  const char*         id;
+  uint32_t            socket_type;
+  rf_zmq_format_t     sample_format;
+  uint32_t            frequency_mhz;
+  bool                fail_on_disconnect;
+  uint32_t            trx_timeout_ms;
+  bool                log_trx_timeout;
+  int32_t             sample_offset;                   ///< offset in samples
+  uint32_t            nof_channels;                    ///< channels carried per message, >1 enables batch mode
+  srsran_spsc_ring_t* batch_ring[SRSRAN_MAX_CHANNELS]; ///< rings of the other channels fed by a batch receiver
 } rf_zmq_opts_t;
 
 /*
@@ -104,7 +120,11 @@ SRSRAN_API int rf_zmq_tx_open(rf_zmq_tx_t* q, rf_zmq_opts_t opts, void* zmq_ctx,
 
 SRSRAN_API int rf_zmq_tx_align(rf_zmq_tx_t* q, uint64_t ts);
 
-SRSRAN_API int rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples);
+/**
+ * @brief Transmits nsamples of every channel carried by the transmitter, scaled by scale. A NULL buffer transmits
+ * zeros in its channel.
+ */
+SRSRAN_API int rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t** buffers, uint32_t nsamples, float scale);
 
 SRSRAN_API int rf_zmq_tx_get_nsamples(rf_zmq_tx_t* q);
 
@@ -119,6 +139,10 @@ SRSRAN_API bool rf_zmq_tx_is_running(rf_zmq_tx_t* q);
 /*
  * Receiver functions
  */
+/**
+ * @brief Opens a receiver. A NULL sock_args opens it without socket, its samples are then written by the batch
+ * receiver that carries its channel.
+ */
 SRSRAN_API int rf_zmq_rx_open(rf_zmq_rx_t* q, rf_zmq_opts_t opts, void* zmq_ctx, char* sock_args);
 
 SRSRAN_API int rf_zmq_rx_baseband(rf_zmq_rx_t* q, cf_t* buffer, uint32_t nsamples);
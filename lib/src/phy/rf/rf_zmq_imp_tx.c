@@ -49,6 +49,7 @@ int rf_zmq_tx_open(rf_zmq_tx_t* q, rf_zmq_opts_t opts, void* zmq_ctx, char* sock
     q->sample_format = opts.sample_format;
     q->frequency_mhz = opts.frequency_mhz;
     q->sample_offset = opts.sample_offset;
+    q->nof_channels  = SRSRAN_MAX(opts.nof_channels, 1);
 
     rf_zmq_info(q->id, "Binding transmitter: %s\n", sock_args);
 
@@ -82,19 +83,6 @@ int rf_zmq_tx_open(rf_zmq_tx_t* q, rf_zmq_opts_t opts, void* zmq_ctx, char* sock
       goto clean_exit;
     }
 
-    q->temp_buffer_convert = srsran_vec_malloc(ZMQ_MAX_BUFFER_SIZE);
-    if (!q->temp_buffer_convert) {
-      fprintf(stderr, "Error: allocating rx buffer\n");
-      goto clean_exit;
-    }
-
-    q->zeros = srsran_vec_malloc(ZMQ_MAX_BUFFER_SIZE);
-    if (!q->zeros) {
-      fprintf(stderr, "Error: allocating zeros\n");
-      goto clean_exit;
-    }
-    bzero(q->zeros, ZMQ_MAX_BUFFER_SIZE);
-
     q->running = true;
 
     ret = SRSRAN_SUCCESS;
@@ -104,59 +92,93 @@ clean_exit:
   return ret;
 }
 
-static int _rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
+// Writes one channel block: scaled and converted samples straight into the message, zeros for a NULL buffer
+static void rf_zmq_tx_pack(rf_zmq_tx_t* q, uint8_t* ptr, cf_t* buffer, uint32_t nsamples, float scale)
+{
+  size_t sample_sz = (q->sample_format == ZMQ_TYPE_SC16) ? 2 * sizeof(int16_t) : sizeof(cf_t);
+
+  if (buffer == NULL) {
+    memset(ptr, 0, sample_sz * nsamples);
+  } else if (q->sample_format == ZMQ_TYPE_SC16) {
+    srsran_vec_convert_fi((float*)buffer, INT16_MAX * scale, (int16_t*)ptr, 2 * nsamples);
+  } else {
+    srsran_vec_sc_prod_cfc(buffer, scale, (cf_t*)ptr, nsamples);
+  }
+}
+
+static int rf_zmq_tx_msg(rf_zmq_tx_t* q, cf_t** buffers, uint32_t nsamples, float scale)
 {
   int n = SRSRAN_ERROR;
 
-  while (n < 0 && q->running) {
+  size_t sample_sz = (q->sample_format == ZMQ_TYPE_SC16) ? 2 * sizeof(int16_t) : sizeof(cf_t);
+  size_t block_sz  = sample_sz * nsamples;
+
+  // A batch is a multipart message, the header followed by one part per channel. Every part is delivered
+  // together, so the receiver can take each block straight into the ring of its channel
+  zmq_msg_t msg[1 + SRSRAN_MAX_CHANNELS];
+  uint32_t  nof_parts = 0;
+  if (q->nof_channels > 1) {
+    rf_zmq_batch_hdr_t hdr = {};
+    hdr.timestamp          = q->nsamples;
+    hdr.nof_samples        = nsamples;
+    hdr.nof_channels       = q->nof_channels;
+    if (zmq_msg_init_size(&msg[nof_parts], sizeof(hdr)) == -1) {
+      rf_zmq_error(q->id, "[zmq] Error: allocating batch header. %s.\n", zmq_strerror(zmq_errno()));
+      return SRSRAN_ERROR;
+    }
+    memcpy(zmq_msg_data(&msg[nof_parts]), &hdr, sizeof(hdr));
+    nof_parts++;
+  }
+
+  // The samples are written in the messages once, ZMQ takes ownership of their data when they are sent
+  for (uint32_t ch = 0; ch < q->nof_channels; ch++) {
+    if (zmq_msg_init_size(&msg[nof_parts], block_sz) == -1) {
+      rf_zmq_error(q->id, "[zmq] Error: allocating %zu B message. %s.\n", block_sz, zmq_strerror(zmq_errno()));
+      goto clean_exit;
+    }
+    rf_zmq_tx_pack(q, zmq_msg_data(&msg[nof_parts]), (buffers) ? buffers[ch] : NULL, nsamples, scale);
+    nof_parts++;
+  }
+
+  bool     requested = (q->socket_type != ZMQ_REP);
+  uint32_t part      = 0;
+  while (part < nof_parts && q->running) {
     // Receive Transmit request is socket type is REPLY
-    if (q->socket_type == ZMQ_REP) {
+    if (!requested) {
       uint8_t dummy;
-      n = zmq_recv(q->sock, &dummy, sizeof(dummy), 0);
-      if (n < 0) {
+      if (zmq_recv(q->sock, &dummy, sizeof(dummy), 0) < 0) {
         if (rf_zmq_handle_error(q->id, "tx request receive")) {
           n = SRSRAN_ERROR;
           goto clean_exit;
         }
-      } else {
-        // Tx request received successful
-        rf_zmq_info(q->id, " - tx request received\n");
-        rf_zmq_info(q->id, " - sending %d samples (%d B)\n", nsamples, NSAMPLES2NBYTES(nsamples));
+        continue;
       }
-    } else {
-      n = 1;
-    }
 
-    // convert samples if necessary
-    void*    buf       = (buffer) ? buffer : q->zeros;
-    uint32_t sample_sz = sizeof(cf_t);
-
-    if (q->sample_format == ZMQ_TYPE_SC16) {
-      buf       = q->temp_buffer_convert;
-      sample_sz = 2 * sizeof(short);
-      srsran_vec_convert_fi((float*)buffer, INT16_MAX, (short*)q->temp_buffer_convert, 2 * nsamples);
+      // Tx request received successful
+      rf_zmq_info(q->id, " - tx request received\n");
+      rf_zmq_info(q->id, " - sending %d samples (%d B)\n", nsamples, (int)(block_sz * q->nof_channels));
+      requested = true;
     }
 
-    // Send base-band if request was received
-    if (n > 0) {
-      n = zmq_send(q->sock, buf, (size_t)sample_sz * nsamples, 0);
-      if (n < 0) {
-        if (rf_zmq_handle_error(q->id, "tx baseband send")) {
-          n = SRSRAN_ERROR;
-          goto clean_exit;
-        }
-      } else if (n != NSAMPLES2NBYTES(nsamples)) {
-        rf_zmq_error(q->id,
-                     "[zmq] Error: transmitter expected %d bytes and sent %d. %s.\n",
-                     NSAMPLES2NBYTES(nsamples),
-                     n,
-                     strerror(zmq_errno()));
+    // Send base-band once the request was received, if it fails keep trying from the same part
+    size_t part_sz = zmq_msg_size(&msg[part]);
+    n              = zmq_msg_send(&msg[part], q->sock, (part + 1 < nof_parts) ? ZMQ_SNDMORE : 0);
+    if (n < 0) {
+      if (rf_zmq_handle_error(q->id, "tx baseband send")) {
         n = SRSRAN_ERROR;
         goto clean_exit;
       }
+    } else if ((size_t)n != part_sz) {
+      rf_zmq_error(q->id,
+                   "[zmq] Error: transmitter expected %zu bytes and sent %d. %s.\n",
+                   part_sz,
+                   n,
+                   strerror(zmq_errno()));
+      n = SRSRAN_ERROR;
+      goto clean_exit;
+    } else {
+      part++;
     }
-
-    // If failed to receive request or send base-band, keep trying
   }
 
   // Increment sample counter
@@ -164,9 +186,32 @@ static int _rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
   n = nsamples;
 
 clean_exit:
+  // The messages still belong to us if they were not sent, closing a sent message does nothing
+  for (uint32_t i = 0; i < nof_parts; i++) {
+    zmq_msg_close(&msg[i]);
+  }
   return n;
 }
 
+// Longer transmissions are split, so every message fits in the region the receiver reserves in its ring
+static int _rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t** buffers, uint32_t nsamples, float scale)
+{
+  cf_t* ptr[SRSRAN_MAX_CHANNELS] = {};
+
+  for (uint32_t count = 0; count < nsamples;) {
+    uint32_t n = SRSRAN_MIN(nsamples - count, ZMQ_MAX_MSG_NSAMPLES);
+    for (uint32_t ch = 0; ch < q->nof_channels; ch++) {
+      ptr[ch] = (buffers && buffers[ch]) ? &buffers[ch][count] : NULL;
+    }
+    if (rf_zmq_tx_msg(q, ptr, n, scale) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    count += n;
+  }
+
+  return (int)nsamples;
+}
+
 int rf_zmq_tx_align(rf_zmq_tx_t* q, uint64_t ts)
 {
   pthread_mutex_lock(&q->mutex);
@@ -175,7 +220,7 @@ int rf_zmq_tx_align(rf_zmq_tx_t* q, uint64_t ts)
 
   if (nsamples > 0) {
     rf_zmq_info(q->id, " - Detected Tx gap of %d samples.\n", nsamples);
-    _rf_zmq_tx_baseband(q, q->zeros, (uint32_t)nsamples);
+    _rf_zmq_tx_baseband(q, NULL, (uint32_t)nsamples, 1.0f);
   }
 
   pthread_mutex_unlock(&q->mutex);
@@ -183,26 +228,31 @@ int rf_zmq_tx_align(rf_zmq_tx_t* q, uint64_t ts)
   return (int)nsamples;
 }
 
-int rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
+int rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t** buffers, uint32_t nsamples, float scale)
 {
-  int n;
+  int   n;
+  cf_t* ptr[SRSRAN_MAX_CHANNELS] = {};
 
   pthread_mutex_lock(&q->mutex);
 
   if (q->sample_offset > 0) {
-    _rf_zmq_tx_baseband(q, q->zeros, (uint32_t)q->sample_offset);
+    _rf_zmq_tx_baseband(q, NULL, (uint32_t)q->sample_offset, 1.0f);
     q->sample_offset = 0;
   } else if (q->sample_offset < 0) {
     n = SRSRAN_MIN(-q->sample_offset, nsamples);
-    buffer += n;
+    for (uint32_t ch = 0; ch < q->nof_channels; ch++) {
+      ptr[ch] = (buffers && buffers[ch]) ? &buffers[ch][n] : NULL;
+    }
+    buffers = ptr;
     nsamples -= n;
     q->sample_offset += n;
     if (nsamples == 0) {
+      pthread_mutex_unlock(&q->mutex);
       return n;
     }
   }
 
-  n = _rf_zmq_tx_baseband(q, buffer, nsamples);
+  n = _rf_zmq_tx_baseband(q, buffers, nsamples, scale);
 
   pthread_mutex_unlock(&q->mutex);
 
@@ -222,7 +272,7 @@ int rf_zmq_tx_zeros(rf_zmq_tx_t* q, uint32_t nsamples)
   pthread_mutex_lock(&q->mutex);
 
   rf_zmq_info(q->id, " - Tx %d Zeros.\n", nsamples);
-  _rf_zmq_tx_baseband(q, q->zeros, (uint32_t)nsamples);
+  _rf_zmq_tx_baseband(q, NULL, (uint32_t)nsamples, 1.0f);
 
   pthread_mutex_unlock(&q->mutex);
 
@@ -246,14 +296,6 @@ void rf_zmq_tx_close(rf_zmq_tx_t* q)
 
   pthread_mutex_destroy(&q->mutex);
 
-  if (q->zeros) {
-    free(q->zeros);
-  }
-
-  if (q->temp_buffer_convert) {
-    free(q->temp_buffer_convert);
-  }
-
   if (q->sock) {
     zmq_close(q->sock);
     q->sock = NULL;
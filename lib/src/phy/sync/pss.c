@@ -405,18 +405,18 @@ void srsran_pss_set_ema_alpha(srsran_pss_t* q, float alpha)
   q->ema_alpha = alpha;
 }
 
-float compute_peak_sidelobe(srsran_pss_t* q, uint32_t corr_peak_pos, uint32_t conv_output_len)
+static float compute_peak_sidelobe(const float* corr, uint32_t corr_peak_pos, uint32_t conv_output_len)
 {
   // Find end of peak lobe to the right
   int pl_ub = corr_peak_pos + 1;
-  while (q->conv_output_avg[pl_ub + 1] <= q->conv_output_avg[pl_ub] && pl_ub < conv_output_len) {
+  while (corr[pl_ub + 1] <= corr[pl_ub] && pl_ub < conv_output_len) {
     pl_ub++;
   }
   // Find end of peak lobe to the left
   int pl_lb;
   if (corr_peak_pos > 2) {
     pl_lb = corr_peak_pos - 1;
-    while (q->conv_output_avg[pl_lb - 1] <= q->conv_output_avg[pl_lb] && pl_lb > 1) {
+    while (corr[pl_lb - 1] <= corr[pl_lb] && pl_lb > 1) {
       pl_lb--;
     }
   } else {
@@ -429,70 +429,79 @@ float compute_peak_sidelobe(srsran_pss_t* q, uint32_t corr_peak_pos, uint32_t co
   }
   int sl_distance_left = pl_lb;
 
-  int   sl_right        = pl_ub + srsran_vec_max_fi(&q->conv_output_avg[pl_ub], sl_distance_right);
-  int   sl_left         = srsran_vec_max_fi(q->conv_output_avg, sl_distance_left);
-  float side_lobe_value = SRSRAN_MAX(q->conv_output_avg[sl_right], q->conv_output_avg[sl_left]);
+  int   sl_right        = pl_ub + srsran_vec_max_fi(&corr[pl_ub], sl_distance_right);
+  int   sl_left         = srsran_vec_max_fi(corr, sl_distance_left);
+  float side_lobe_value = SRSRAN_MAX(corr[sl_right], corr[sl_left]);
 
-  return q->conv_output_avg[corr_peak_pos] / side_lobe_value;
+  return corr[corr_peak_pos] / side_lobe_value;
 }
 
-/** Performs time-domain PSS correlation.
- * Returns the index of the PSS correlation peak in a subframe.
- * The frame starts at corr_peak_pos-subframe_size/2.
- * The value of the correlation is stored in corr_peak_value.
- *
- * Input buffer must be subframe_size long.
+/* Copies the input into the internal zero-padded buffer and decimates it, if enabled.
+ * Returns the signal to be correlated with the PSS.
  */
-int srsran_pss_find_pss(srsran_pss_t* q, const cf_t* input, float* corr_peak_value)
+static const cf_t* pss_prepare_input(srsran_pss_t* q, const cf_t* input)
 {
-  int ret = SRSRAN_ERROR_INVALID_INPUTS;
+  memcpy(q->tmp_input, input, (q->frame_size * q->decimate) * sizeof(cf_t));
+  if (q->decimate > 1) {
+    srsran_filt_decim_cc_execute(&(q->filter),
+                                 q->tmp_input,
+                                 q->filter.downsampled_input,
+                                 q->filter.filter_output,
+                                 (q->frame_size * q->decimate));
+    return q->filter.filter_output;
+  }
+  return q->tmp_input;
+}
 
-  if (q != NULL && input != NULL) {
-    uint32_t corr_peak_pos;
-    uint32_t conv_output_len;
+/* Correlates the input with the time-domain PSS sequence N_id_2 and stores the result in conv_output.
+ * Returns the correlation length.
+ *
+ * We do not reverse time-domain PSS signal because it's conjugate is symmetric.
+ * The conjugate operation on pss_signal_time has been done in srsran_pss_init_N_id_2
+ * This is why we can use FFT-based convolution
+ */
+static uint32_t pss_correlate(srsran_pss_t* q, const cf_t* input, uint32_t N_id_2)
+{
+  if (q->frame_size >= q->fft_size) {
+#ifdef CONVOLUTION_FFT
+    return srsran_conv_fft_cc_run_opt(
+        &q->conv_fft, pss_prepare_input(q, input), q->pss_signal_freq_full[N_id_2], q->conv_output);
+#else
+    return srsran_conv_cc(input, q->pss_signal_time[N_id_2], q->conv_output, q->frame_size, q->fft_size);
+#endif
+  }
 
-    if (!srsran_N_id_2_isvalid(q->N_id_2)) {
-      ERROR("Error finding PSS peak, Must set N_id_2 first");
-      return SRSRAN_ERROR;
-    }
+  for (int i = 0; i < q->frame_size; i++) {
+    q->conv_output[i] = srsran_vec_dot_prod_ccc(q->pss_signal_time[N_id_2], &input[i], q->fft_size);
+  }
+  return q->frame_size;
+}
 
-    /* Correlate input with PSS sequence
-     *
-     * We do not reverse time-domain PSS signal because it's conjugate is symmetric.
-     * The conjugate operation on pss_signal_time has been done in srsran_pss_init_N_id_2
-     * This is why we can use FFT-based convolution
-     */
-    if (q->frame_size >= q->fft_size) {
 #ifdef CONVOLUTION_FFT
-      memcpy(q->tmp_input, input, (q->frame_size * q->decimate) * sizeof(cf_t));
-      if (q->decimate > 1) {
-        srsran_filt_decim_cc_execute(&(q->filter),
-                                     q->tmp_input,
-                                     q->filter.downsampled_input,
-                                     q->filter.filter_output,
-                                     (q->frame_size * q->decimate));
-        conv_output_len = srsran_conv_fft_cc_run_opt(
-            &q->conv_fft, q->filter.filter_output, q->pss_signal_freq_full[q->N_id_2], q->conv_output);
-      } else {
-        conv_output_len =
-            srsran_conv_fft_cc_run_opt(&q->conv_fft, q->tmp_input, q->pss_signal_freq_full[q->N_id_2], q->conv_output);
-      }
-
-#else
-      conv_output_len =
-          srsran_conv_cc(input, q->pss_signal_time[q->N_id_2], q->conv_output, q->frame_size, q->fft_size);
+/* Multiplies the frequency-domain input, as computed by the input plan of the convolution, with a frequency-domain PSS
+ * sequence and stores the time-domain correlation in conv_output. Returns the correlation length.
+ */
+static uint32_t pss_correlate_freq(srsran_pss_t* q, const cf_t* input_fft, const cf_t* pss_freq)
+{
+  srsran_vec_prod_ccc(input_fft, pss_freq, q->conv_fft.output_fft, q->conv_fft.output_len);
+  srsran_dft_run_c(&q->conv_fft.output_plan, q->conv_fft.output_fft, q->conv_output);
+  return (q->conv_fft.output_len - 1);
+}
 #endif
-    } else {
-      for (int i = 0; i < q->frame_size; i++) {
-        q->conv_output[i] = srsran_vec_dot_prod_ccc(q->pss_signal_time[q->N_id_2], &input[i], q->fft_size);
-      }
-      conv_output_len = q->frame_size;
-    }
 
-    // Compute modulus square
-    srsran_vec_abs_square_cf(q->conv_output, q->conv_output_abs, conv_output_len - 1);
+/* Finds the maximum of the correlation stored in conv_output. If average is true, the modulus square of the
+ * correlation is averaged with the previous calls. Returns the position of the peak in the input signal.
+ */
+static int pss_find_peak(srsran_pss_t* q, uint32_t conv_output_len, bool average, float* corr_peak_value)
+{
+  float*   corr = q->conv_output_abs;
+  uint32_t corr_peak_pos;
+
+  // Compute modulus square
+  srsran_vec_abs_square_cf(q->conv_output, q->conv_output_abs, conv_output_len - 1);
 
-    // If enabled, average the absolute value from previous calls
+  // If enabled, average the absolute value from previous calls
+  if (average) {
     if (q->ema_alpha < 1.0 && q->ema_alpha > 0.0) {
       srsran_vec_sc_prod_fff(q->conv_output_abs, q->ema_alpha, q->conv_output_abs, conv_output_len - 1);
       srsran_vec_sc_prod_fff(q->conv_output_avg, 1 - q->ema_alpha, q->conv_output_avg, conv_output_len - 1);
@@ -501,36 +510,153 @@ int srsran_pss_find_pss(srsran_pss_t* q, const cf_t* input, float* corr_peak_val
     } else {
       memcpy(q->conv_output_avg, q->conv_output_abs, sizeof(float) * (conv_output_len - 1));
     }
+    corr = q->conv_output_avg;
+  }
 
-    /* Find maximum of the absolute value of the correlation */
-    corr_peak_pos = srsran_vec_max_fi(q->conv_output_avg, conv_output_len - 1);
+  /* Find maximum of the absolute value of the correlation */
+  corr_peak_pos = srsran_vec_max_fi(corr, conv_output_len - 1);
 
-    // save absolute value
-    q->peak_value = q->conv_output_avg[corr_peak_pos];
+  // save absolute value
+  if (average) {
+    q->peak_value = corr[corr_peak_pos];
+  }
 
 #ifdef SRSRAN_PSS_RETURN_PSR
-    if (corr_peak_value) {
-      *corr_peak_value = compute_peak_sidelobe(q, corr_peak_pos, conv_output_len);
-    }
+  if (corr_peak_value) {
+    *corr_peak_value = compute_peak_sidelobe(corr, corr_peak_pos, conv_output_len);
+  }
 #else
-    if (corr_peak_value) {
-      *corr_peak_value = q->conv_output_avg[corr_peak_pos];
+  if (corr_peak_value) {
+    *corr_peak_value = corr[corr_peak_pos];
+  }
+#endif
+
+  if (q->decimate > 1) {
+    int decimation_correction = (q->filter.num_taps - 2);
+    corr_peak_pos             = corr_peak_pos - decimation_correction;
+    corr_peak_pos             = corr_peak_pos * q->decimate;
+  }
+
+  if (q->frame_size >= q->fft_size) {
+    return (int)corr_peak_pos;
+  } else {
+    return (int)corr_peak_pos + q->fft_size;
+  }
+}
+
+/** Performs time-domain PSS correlation.
+ * Returns the index of the PSS correlation peak in a subframe.
+ * The frame starts at corr_peak_pos-subframe_size/2.
+ * The value of the correlation is stored in corr_peak_value.
+ *
+ * Input buffer must be subframe_size long.
+ */
+int srsran_pss_find_pss(srsran_pss_t* q, const cf_t* input, float* corr_peak_value)
+{
+  int ret = SRSRAN_ERROR_INVALID_INPUTS;
+
+  if (q != NULL && input != NULL) {
+    if (!srsran_N_id_2_isvalid(q->N_id_2)) {
+      ERROR("Error finding PSS peak, Must set N_id_2 first");
+      return SRSRAN_ERROR;
     }
+
+    /* Correlate input with PSS sequence */
+    uint32_t conv_output_len = pss_correlate(q, input, q->N_id_2);
+
+    ret = pss_find_peak(q, conv_output_len, true, corr_peak_value);
+  }
+  return ret;
+}
+
+/** Correlates the input with the PSS sequences of the three N_id_2, transforming the input into the frequency domain
+ * only once. The position and value of the correlation peak of each N_id_2 are stored in peak_pos and corr_peak_value,
+ * as returned by srsran_pss_find_pss(). The correlation is not averaged with previous calls and the N_id_2 set in the
+ * object is not used.
+ *
+ * Input buffer must be subframe_size long.
+ */
+int srsran_pss_find_pss_all(srsran_pss_t* q,
+                            const cf_t*   input,
+                            int           peak_pos[SRSRAN_NOF_NID_2],
+                            float         corr_peak_value[SRSRAN_NOF_NID_2])
+{
+  if (q == NULL || input == NULL || peak_pos == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+#ifdef CONVOLUTION_FFT
+  if (q->frame_size >= q->fft_size) {
+    srsran_dft_run_c(&q->conv_fft.input_plan, pss_prepare_input(q, input), q->conv_fft.input_fft);
+    for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+      float*   peak_value      = corr_peak_value ? &corr_peak_value[N_id_2] : NULL;
+      uint32_t conv_output_len = pss_correlate_freq(q, q->conv_fft.input_fft, q->pss_signal_freq_full[N_id_2]);
+      peak_pos[N_id_2]         = pss_find_peak(q, conv_output_len, false, peak_value);
+    }
+    return SRSRAN_SUCCESS;
+  }
 #endif
 
-    if (q->decimate > 1) {
-      int decimation_correction = (q->filter.num_taps - 2);
-      corr_peak_pos             = corr_peak_pos - decimation_correction;
-      corr_peak_pos             = corr_peak_pos * q->decimate;
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    float*   peak_value      = corr_peak_value ? &corr_peak_value[N_id_2] : NULL;
+    uint32_t conv_output_len = pss_correlate(q, input, N_id_2);
+    peak_pos[N_id_2]         = pss_find_peak(q, conv_output_len, false, peak_value);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/** Equivalent to calling srsran_pss_find_pss() for each of the nof_pss objects with the same input, e.g. the integer
+ * CFO shifted versions of the PSS. If all the objects have the same frame size, FFT size and decimation, the input is
+ * transformed into the frequency domain only once. Each object correlates with its N_id_2 and keeps its own average.
+ *
+ * peak_pos and corr_peak_value must have nof_pss elements.
+ */
+int srsran_pss_find_pss_multi(srsran_pss_t* q[],
+                              uint32_t      nof_pss,
+                              const cf_t*   input,
+                              int*          peak_pos,
+                              float*        corr_peak_value)
+{
+  if (q == NULL || nof_pss == 0 || q[0] == NULL || input == NULL || peak_pos == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  bool shared_fft = false;
+#ifdef CONVOLUTION_FFT
+  shared_fft = q[0]->frame_size >= q[0]->fft_size;
+  for (uint32_t i = 1; i < nof_pss && shared_fft; i++) {
+    shared_fft = q[i] != NULL && q[i]->frame_size == q[0]->frame_size && q[i]->fft_size == q[0]->fft_size &&
+                 q[i]->decimate == q[0]->decimate;
+  }
+#endif
+
+  if (!shared_fft) {
+    for (uint32_t i = 0; i < nof_pss; i++) {
+      peak_pos[i] = srsran_pss_find_pss(q[i], input, corr_peak_value ? &corr_peak_value[i] : NULL);
+      if (peak_pos[i] < 0) {
+        return SRSRAN_ERROR;
+      }
     }
+    return SRSRAN_SUCCESS;
+  }
 
-    if (q->frame_size >= q->fft_size) {
-      ret = (int)corr_peak_pos;
-    } else {
-      ret = (int)corr_peak_pos + q->fft_size;
+#ifdef CONVOLUTION_FFT
+  for (uint32_t i = 0; i < nof_pss; i++) {
+    if (!srsran_N_id_2_isvalid(q[i]->N_id_2)) {
+      ERROR("Error finding PSS peak, Must set N_id_2 first");
+      return SRSRAN_ERROR;
     }
   }
-  return ret;
+
+  const cf_t* input_fft = q[0]->conv_fft.input_fft;
+  srsran_dft_run_c(&q[0]->conv_fft.input_plan, pss_prepare_input(q[0], input), q[0]->conv_fft.input_fft);
+  for (uint32_t i = 0; i < nof_pss; i++) {
+    float*   peak_value      = corr_peak_value ? &corr_peak_value[i] : NULL;
+    uint32_t conv_output_len = pss_correlate_freq(q[i], input_fft, q[i]->pss_signal_freq_full[q[i]->N_id_2]);
+    peak_pos[i]              = pss_find_peak(q[i], conv_output_len, true, peak_value);
+  }
+#endif
+  return SRSRAN_SUCCESS;
 }
 
 /* Computes frequency-domain channel estimation of the PSS symbol
@@ -1267,32 +1267,15 @@ int srsran_ssb_decode_pbch(srsran_ssb_t*         q,
   return SRSRAN_SUCCESS;
 }
 
-int srsran_ssb_search(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, srsran_ssb_search_res_t* res)
+// Demodulates the SSB found by the PSS search, finds N_id_1 and decodes the PBCH. res must be initialised to zero
+static int ssb_search_decode(srsran_ssb_t*            q,
+                             const cf_t*              in,
+                             uint32_t                 nof_samples,
+                             uint32_t                 N_id_2,
+                             uint32_t                 t_offset,
+                             float                    coarse_cfo_hz,
+                             srsran_ssb_search_res_t* res)
 {
-  // Verify inputs
-  if (q == NULL || in == NULL || res == NULL || !isnormal(q->scs_hz)) {
-    return SRSRAN_ERROR_INVALID_INPUTS;
-  }
-
-  if (!q->args.enable_search || !q->args.enable_decode) {
-    ERROR("SSB is not configured to search (%c) and decode (%c)",
-          q->args.enable_search ? 'y' : 'n',
-          q->args.enable_decode ? 'y' : 'n');
-    return SRSRAN_ERROR;
-  }
-
-  // Set the SSB search result with default value with PBCH CRC unmatched, meaning no cell is found
-  SRSRAN_MEM_ZERO(res, srsran_ssb_search_res_t, 1);
-
-  // Search for PSS in time domain
-  uint32_t N_id_2        = 0;
-  uint32_t t_offset      = 0;
-  float    coarse_cfo_hz = 0.0f;
-  if (ssb_pss_search(q, in, nof_samples, &N_id_2, &t_offset, &coarse_cfo_hz) < SRSRAN_SUCCESS) {
-    ERROR("Error searching for N_id_2");
-    return SRSRAN_ERROR;
-  }
-
   // Remove CP offset prior demodulation
   if (t_offset >= q->cp_sz) {
     t_offset -= q->cp_sz;
@@ -1366,6 +1349,35 @@ int srsran_ssb_search(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, srs
   return SRSRAN_SUCCESS;
 }
 
+int srsran_ssb_search(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, srsran_ssb_search_res_t* res)
+{
+  // Verify inputs
+  if (q == NULL || in == NULL || res == NULL || !isnormal(q->scs_hz)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (!q->args.enable_search || !q->args.enable_decode) {
+    ERROR("SSB is not configured to search (%c) and decode (%c)",
+          q->args.enable_search ? 'y' : 'n',
+          q->args.enable_decode ? 'y' : 'n');
+    return SRSRAN_ERROR;
+  }
+
+  // Set the SSB search result with default value with PBCH CRC unmatched, meaning no cell is found
+  SRSRAN_MEM_ZERO(res, srsran_ssb_search_res_t, 1);
+
+  // Search for PSS in time domain
+  uint32_t N_id_2        = 0;
+  uint32_t t_offset      = 0;
+  float    coarse_cfo_hz = 0.0f;
+  if (ssb_pss_search(q, in, nof_samples, &N_id_2, &t_offset, &coarse_cfo_hz) < SRSRAN_SUCCESS) {
+    ERROR("Error searching for N_id_2");
+    return SRSRAN_ERROR;
+  }
+
+  return ssb_search_decode(q, in, nof_samples, N_id_2, t_offset, coarse_cfo_hz, res);
+}
+
 static int ssb_pss_find(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, uint32_t N_id_2, uint32_t* found_delay)
 {
   // verify it is initialised
@@ -1613,3 +1625,290 @@ uint32_t srsran_ssb_cfg_to_str(const srsran_ssb_cfg_t* cfg, char* str, uint32_t
 
   return n;
 }
+
+// Returns the SSB object of the given hypothesis, initialising it on first use
+static srsran_ssb_t* ssb_multi_get_ssb(srsran_ssb_multi_t* q, uint32_t hyp)
+{
+  if (!q->ssb_initiated[hyp]) {
+    if (srsran_ssb_init(&q->ssb[hyp], &q->args) < SRSRAN_SUCCESS) {
+      ERROR("Error initialising SSB for hypothesis %d", hyp);
+      srsran_ssb_free(&q->ssb[hyp]);
+      return NULL;
+    }
+    q->ssb_initiated[hyp] = true;
+  }
+
+  return &q->ssb[hyp];
+}
+
+int srsran_ssb_multi_init(srsran_ssb_multi_t* q, const srsran_ssb_args_t* args)
+{
+  // Verify input parameters
+  if (q == NULL || args == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_ssb_multi_t, 1);
+
+  // Copy arguments, the searcher always needs search and decode
+  q->args               = *args;
+  q->args.max_srate_hz  = (!isnormal(q->args.max_srate_hz)) ? SRSRAN_SSB_DEFAULT_MAX_SRATE_HZ : q->args.max_srate_hz;
+  q->args.enable_search = true;
+  q->args.enable_decode = true;
+
+  // The largest correlation is given by the minimum subcarrier spacing
+  uint32_t max_symbol_sz = (uint32_t)round(q->args.max_srate_hz / SRSRAN_SUBC_SPACING_NR(q->args.min_scs));
+  q->max_corr_sz         = SSB_CORR_SZ(max_symbol_sz);
+
+  // Allocate temporal data
+  q->tmp_time = srsran_vec_cf_malloc(q->max_corr_sz);
+  q->tmp_freq = srsran_vec_cf_malloc(q->max_corr_sz);
+  q->tmp_corr = srsran_vec_cf_malloc(q->max_corr_sz);
+  if (q->tmp_time == NULL || q->tmp_freq == NULL || q->tmp_corr == NULL) {
+    ERROR("Malloc");
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_ssb_multi_free(srsran_ssb_multi_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  for (uint32_t hyp = 0; hyp < SRSRAN_SSB_MULTI_MAX_NOF_HYP; hyp++) {
+    if (q->ssb_initiated[hyp]) {
+      srsran_ssb_free(&q->ssb[hyp]);
+    }
+
+    for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2_NR; N_id_2++) {
+      if (q->pss_seq[hyp][N_id_2] != NULL) {
+        free(q->pss_seq[hyp][N_id_2]);
+      }
+    }
+  }
+
+  if (q->tmp_time != NULL) {
+    free(q->tmp_time);
+  }
+
+  if (q->tmp_freq != NULL) {
+    free(q->tmp_freq);
+  }
+
+  if (q->tmp_corr != NULL) {
+    free(q->tmp_corr);
+  }
+
+  srsran_dft_plan_free(&q->fft_corr);
+  srsran_dft_plan_free(&q->ifft_corr);
+
+  SRSRAN_MEM_ZERO(q, srsran_ssb_multi_t, 1);
+}
+
+int srsran_ssb_multi_set_cfg(srsran_ssb_multi_t* q, const srsran_ssb_cfg_t* cfg, uint32_t nof_cfg)
+{
+  // Verify input parameters
+  if (q == NULL || cfg == NULL || nof_cfg == 0 || nof_cfg > SRSRAN_SSB_MULTI_MAX_NOF_HYP) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // All the hypotheses share the input signal, select the largest symbol size
+  uint32_t symbol_sz = 0;
+  for (uint32_t hyp = 0; hyp < nof_cfg; hyp++) {
+    if (cfg[hyp].srate_hz != cfg[0].srate_hz || cfg[hyp].center_freq_hz != cfg[0].center_freq_hz) {
+      ERROR("All SSB hypotheses must have the same sampling rate and center frequency");
+      return SRSRAN_ERROR;
+    }
+    if (cfg[hyp].scs >= srsran_subcarrier_spacing_invalid) {
+      return SRSRAN_ERROR_INVALID_INPUTS;
+    }
+    symbol_sz = SRSRAN_MAX(symbol_sz, (uint32_t)round(cfg[hyp].srate_hz / SRSRAN_SUBC_SPACING_NR(cfg[hyp].scs)));
+  }
+
+  // Compute new correlation size
+  uint32_t corr_sz = SSB_CORR_SZ(symbol_sz);
+  if (corr_sz > q->max_corr_sz || corr_sz < 2 * symbol_sz) {
+    ERROR("Correlation size (%d) is not valid for symbol size %d (max. %d)", corr_sz, symbol_sz, q->max_corr_sz);
+    return SRSRAN_ERROR;
+  }
+
+  // Replan correlation only if the size changed
+  if (q->corr_sz != corr_sz) {
+    srsran_dft_plan_free(&q->fft_corr);
+    srsran_dft_plan_free(&q->ifft_corr);
+
+    if (srsran_dft_plan_guru_c(
+            &q->fft_corr, (int)corr_sz, SRSRAN_DFT_FORWARD, q->tmp_time, q->tmp_freq, 1, 1, 1, 1, 1) < SRSRAN_SUCCESS) {
+      ERROR("Error planning correlation DFT");
+      return SRSRAN_ERROR;
+    }
+    if (srsran_dft_plan_guru_c(
+            &q->ifft_corr, (int)corr_sz, SRSRAN_DFT_BACKWARD, q->tmp_corr, q->tmp_time, 1, 1, 1, 1, 1) <
+        SRSRAN_SUCCESS) {
+      ERROR("Error planning correlation DFT");
+      return SRSRAN_ERROR;
+    }
+  }
+  q->corr_sz     = corr_sz;
+  q->corr_window = corr_sz - symbol_sz;
+  q->symbol_sz   = symbol_sz;
+  q->nof_hyp     = 0;
+
+  // Generate the frequency domain PSS of each hypothesis with the common correlation size
+  for (uint32_t hyp = 0; hyp < nof_cfg; hyp++) {
+    srsran_ssb_t* ssb = ssb_multi_get_ssb(q, hyp);
+    if (ssb == NULL || srsran_ssb_set_cfg(ssb, &cfg[hyp]) < SRSRAN_SUCCESS) {
+      ERROR("Error setting SSB hypothesis %d", hyp);
+      return SRSRAN_ERROR;
+    }
+
+    for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2_NR; N_id_2++) {
+      if (q->pss_seq[hyp][N_id_2] == NULL) {
+        q->pss_seq[hyp][N_id_2] = srsran_vec_cf_malloc(q->max_corr_sz);
+        if (q->pss_seq[hyp][N_id_2] == NULL) {
+          ERROR("Malloc");
+          return SRSRAN_ERROR;
+        }
+      }
+
+      // Put the PSS in SSB grid and modulate it with the hypothesis frequency offset and symbol size
+      cf_t ssb_grid[SRSRAN_SSB_NOF_RE] = {};
+      if (srsran_pss_nr_put(ssb_grid, N_id_2, 1.0f) < SRSRAN_SUCCESS) {
+        ERROR("Error putting PDD N_id_2=%d", N_id_2);
+        return SRSRAN_ERROR;
+      }
+      ssb_modulate_symbol(ssb, ssb_grid, SRSRAN_PSS_NR_SYMBOL_IDX);
+
+      // Convert to frequency domain with the common correlation size
+      srsran_vec_cf_copy(q->tmp_time, ssb->tmp_time, ssb->symbol_sz);
+      srsran_vec_cf_zero(&q->tmp_time[ssb->symbol_sz], q->corr_sz - ssb->symbol_sz);
+      srsran_dft_run_guru_c(&q->fft_corr);
+      srsran_vec_cf_copy(q->pss_seq[hyp][N_id_2], q->tmp_freq, q->corr_sz);
+    }
+  }
+  q->nof_hyp = nof_cfg;
+
+  return SRSRAN_SUCCESS;
+}
+
+// Copies a correlation window of the input starting at t_offset, zero pads it and converts it to frequency domain
+static void ssb_multi_window_fft(srsran_ssb_multi_t* q, const cf_t* in, uint32_t nof_samples, uint32_t t_offset)
+{
+  // Detect if the correlation input exceeds the input length, take the maximum amount of samples
+  uint32_t n = SRSRAN_MIN(q->corr_sz, nof_samples - t_offset);
+
+  srsran_vec_cf_copy(q->tmp_time, &in[t_offset], n);
+  if (n < q->corr_sz) {
+    srsran_vec_cf_zero(&q->tmp_time[n], q->corr_sz - n);
+  }
+
+  srsran_dft_run_guru_c(&q->fft_corr);
+}
+
+int srsran_ssb_multi_search(srsran_ssb_multi_t* q, const cf_t* in, uint32_t nof_samples, srsran_ssb_search_res_t* res)
+{
+  // Verify inputs
+  if (q == NULL || in == NULL || res == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (q->nof_hyp == 0 || q->corr_sz == 0) {
+    ERROR("SSB hypotheses are not configured");
+    return SRSRAN_ERROR;
+  }
+
+  // Calculate correlation CFO coarse precision, common to all hypotheses
+  double coarse_cfo_ref_hz = (q->ssb[0].cfg.srate_hz / q->corr_sz);
+
+  // Correlation best sequence of each hypothesis
+  float    best_corr[SRSRAN_SSB_MULTI_MAX_NOF_HYP]   = {};
+  uint32_t best_delay[SRSRAN_SSB_MULTI_MAX_NOF_HYP]  = {};
+  uint32_t best_N_id_2[SRSRAN_SSB_MULTI_MAX_NOF_HYP] = {};
+  int      best_shift[SRSRAN_SSB_MULTI_MAX_NOF_HYP]  = {};
+  int      shift_range[SRSRAN_SSB_MULTI_MAX_NOF_HYP] = {};
+
+  // Calculate shift integer range to detect the signal with a maximum CFO equal to the SSB subcarrier spacing
+  for (uint32_t hyp = 0; hyp < q->nof_hyp; hyp++) {
+    shift_range[hyp] = (int)ceil(SRSRAN_SUBC_SPACING_NR(q->ssb[hyp].cfg.scs) / coarse_cfo_ref_hz);
+  }
+
+  // Delay in correlation window
+  uint32_t t_offset = 0;
+  while ((t_offset + q->symbol_sz) < nof_samples) {
+    // Convert to frequency domain once for all the hypotheses
+    ssb_multi_window_fft(q, in, nof_samples, t_offset);
+
+    for (uint32_t hyp = 0; hyp < q->nof_hyp; hyp++) {
+      // Calculate the coarse shift increment for half of the subcarrier spacing
+      int shift_coarse_inc = SRSRAN_MAX(shift_range[hyp] / 2, 1);
+
+      // Try each N_id_2 sequence
+      for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2_NR; N_id_2++) {
+        // Steer coarse frequency offset
+        for (int shift = -shift_range[hyp]; shift <= shift_range[hyp]; shift += shift_coarse_inc) {
+          // Actual correlation in frequency domain
+          ssb_vec_prod_conj_circ_shift(q->tmp_freq, q->pss_seq[hyp][N_id_2], q->tmp_corr, q->corr_sz, shift);
+
+          // Convert to time domain
+          srsran_dft_run_guru_c(&q->ifft_corr);
+
+          // Find maximum
+          uint32_t peak_idx = srsran_vec_max_abs_ci(q->tmp_time, q->corr_window);
+
+          // Average power, skip if value is invalid (0.0, nan or inf)
+          float avg_pwr_corr = srsran_vec_avg_power_cf(q->tmp_corr, q->corr_sz);
+          if (!isnormal(avg_pwr_corr)) {
+            continue;
+          }
+
+          // Normalise correlation
+          float corr = SRSRAN_CSQABS(q->tmp_time[peak_idx]) / avg_pwr_corr / sqrtf(SRSRAN_PSS_NR_LEN);
+
+          // Update if the correlation is better than the current best
+          if (best_corr[hyp] < corr) {
+            best_corr[hyp]   = corr;
+            best_delay[hyp]  = peak_idx + t_offset;
+            best_N_id_2[hyp] = N_id_2;
+            best_shift[hyp]  = shift;
+          }
+        }
+      }
+    }
+
+    // Advance time
+    t_offset += q->corr_window;
+  }
+
+  for (uint32_t hyp = 0; hyp < q->nof_hyp; hyp++) {
+    // From the best sequence correlate in frequency domain
+    ssb_multi_window_fft(q, in, nof_samples, best_delay[hyp]);
+
+    float fine_corr = 0.0f;
+    for (int shift = -shift_range[hyp]; shift <= shift_range[hyp]; shift++) {
+      // Actual correlation in frequency domain
+      ssb_vec_prod_conj_circ_shift(q->tmp_freq, q->pss_seq[hyp][best_N_id_2[hyp]], q->tmp_corr, q->corr_sz, shift);
+
+      // Calculate correlation assuming the peak is in the first sample
+      float corr = SRSRAN_CSQABS(srsran_vec_acc_cc(q->tmp_corr, q->corr_sz));
+
+      // Update if the correlation is better than the current best
+      if (fine_corr < corr) {
+        fine_corr       = corr;
+        best_shift[hyp] = shift;
+      }
+    }
+
+    // Demodulate and decode the hypothesis with its own SSB object, already configured
+    SRSRAN_MEM_ZERO(&res[hyp], srsran_ssb_search_res_t, 1);
+    float coarse_cfo_hz = -(float)best_shift[hyp] * coarse_cfo_ref_hz;
+    if (ssb_search_decode(&q->ssb[hyp], in, nof_samples, best_N_id_2[hyp], best_delay[hyp], coarse_cfo_hz, &res[hyp]) <
+        SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
@@ -591,22 +591,28 @@ static float cfo_cp_estimate(srsran_sync_t* q, const cf_t* input)
 
 static int cfo_i_estimate(srsran_sync_t* q, const cf_t* input, int find_offset, int* peak_pos, int* cfo_i)
 {
-  float         peak_value;
+  int           p[3];
+  float         peak_value[3];
   float         max_peak_value = -99;
   int           max_cfo_i      = 0;
   srsran_pss_t* pss_obj[3]     = {&q->pss_i[0], &q->pss, &q->pss_i[1]};
   for (int cfo = 0; cfo < 3; cfo++) {
     srsran_pss_set_N_id_2(pss_obj[cfo], q->N_id_2);
-    int p = srsran_pss_find_pss(pss_obj[cfo], &input[find_offset], &peak_value);
-    if (p < 0) {
+  }
+  // The input is transformed once and correlated with the three shifted PSS in the frequency domain
+  if (srsran_pss_find_pss_multi(pss_obj, 3, &input[find_offset], p, peak_value) < 0) {
+    return -1;
+  }
+  for (int cfo = 0; cfo < 3; cfo++) {
+    if (p[cfo] < 0) {
       return -1;
     }
-    if (peak_value > max_peak_value) {
-      max_peak_value = peak_value;
+    if (peak_value[cfo] > max_peak_value) {
+      max_peak_value = peak_value[cfo];
       if (peak_pos) {
-        *peak_pos = p;
+        *peak_pos = p[cfo];
       }
-      q->peak_value = peak_value;
+      q->peak_value = peak_value[cfo];
       max_cfo_i     = cfo - 1;
     }
   }
@@ -0,0 +1,207 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/srsran.h"
+#include <complex.h>
+#include <getopt.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#define NOF_PRB 6
+#define FFT_SIZE 128
+#define FLEN SRSRAN_SF_LEN(FFT_SIZE)
+
+static uint32_t N_id_2          = 1;
+static int      cfo_i           = 1;
+static uint32_t nof_repetitions = 1000;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [ncRv]\n", prog);
+  printf("\t-n N_id_2 [Default %d]\n", N_id_2);
+  printf("\t-c Integer CFO in subcarriers [Default %d]\n", cfo_i);
+  printf("\t-R Number of repetitions of the benchmark [Default %d]\n", nof_repetitions);
+  printf("\t-v srsran_verbose\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "ncRv")) != -1) {
+    switch (opt) {
+      case 'n':
+        N_id_2 = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'c':
+        cfo_i = (int)strtol(argv[optind], NULL, 10);
+        break;
+      case 'R':
+        nof_repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+// Generates a subframe carrying the PSS of N_id_2, shifted by cfo_i subcarriers
+static int generate_signal(cf_t* signal)
+{
+  cf_t                  pss_signal[SRSRAN_PSS_LEN];
+  cf_t*                 sf_symbols = srsran_vec_cf_malloc(FLEN);
+  srsran_ofdm_t         ifft       = {};
+  srsran_channel_awgn_t awgn       = {};
+
+  TESTASSERT(sf_symbols != NULL);
+  TESTASSERT(srsran_ofdm_tx_init(&ifft, SRSRAN_CP_NORM, sf_symbols, signal, NOF_PRB) == SRSRAN_SUCCESS);
+  srsran_ofdm_set_normalize(&ifft, true);
+
+  srsran_vec_cf_zero(sf_symbols, FLEN);
+  srsran_pss_generate(pss_signal, N_id_2);
+  srsran_pss_put_slot(pss_signal, sf_symbols, NOF_PRB, SRSRAN_CP_NORM);
+  srsran_ofdm_tx_sf(&ifft);
+
+  for (uint32_t t = 0; t < FLEN; t++) {
+    signal[t] *= cexpf(2 * _Complex_I * M_PI * cfo_i * (float)t / FFT_SIZE);
+  }
+
+  TESTASSERT(srsran_channel_awgn_init(&awgn, 1234) == SRSRAN_SUCCESS);
+  srsran_channel_awgn_set_n0(&awgn, srsran_convert_power_to_dB(srsran_vec_avg_power_cf(signal, FLEN)) - 10.0f);
+  srsran_channel_awgn_run_c(&awgn, signal, signal, FLEN);
+
+  srsran_channel_awgn_free(&awgn);
+  srsran_ofdm_tx_free(&ifft);
+  free(sf_symbols);
+  return SRSRAN_SUCCESS;
+}
+
+// The three N_id_2 correlated in one pass must give the same result as correlating them one by one
+static int test_find_pss_all(const cf_t* signal)
+{
+  srsran_pss_t   pss = {};
+  int            peak_pos[SRSRAN_NOF_NID_2];
+  float          peak_value[SRSRAN_NOF_NID_2];
+  struct timeval t[3];
+
+  TESTASSERT(srsran_pss_init_fft_offset(&pss, FLEN, FFT_SIZE, cfo_i) == SRSRAN_SUCCESS);
+  srsran_pss_set_ema_alpha(&pss, 1.0f);
+
+  TESTASSERT(srsran_pss_find_pss_all(&pss, signal, peak_pos, peak_value) == SRSRAN_SUCCESS);
+  uint32_t max_N_id_2 = 0;
+  for (uint32_t n = 0; n < SRSRAN_NOF_NID_2; n++) {
+    float value = 0.0f;
+    srsran_pss_set_N_id_2(&pss, n);
+    int pos = srsran_pss_find_pss(&pss, signal, &value);
+    INFO("N_id_2=%d; pos=%d/%d; value=%.2f/%.2f", n, pos, peak_pos[n], value, peak_value[n]);
+    TESTASSERT(pos == peak_pos[n]);
+    TESTASSERT(fabsf(value - peak_value[n]) <= 1e-3f * value);
+    if (peak_value[n] > peak_value[max_N_id_2]) {
+      max_N_id_2 = n;
+    }
+  }
+  TESTASSERT(max_N_id_2 == N_id_2);
+
+  // Measure the correlation of the three N_id_2, one by one and in one pass
+  gettimeofday(&t[1], NULL);
+  for (uint32_t i = 0; i < nof_repetitions; i++) {
+    for (uint32_t n = 0; n < SRSRAN_NOF_NID_2; n++) {
+      srsran_pss_set_N_id_2(&pss, n);
+      srsran_pss_find_pss(&pss, signal, NULL);
+    }
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  double serial_us = (t[0].tv_sec * 1e6 + t[0].tv_usec) / nof_repetitions;
+
+  gettimeofday(&t[1], NULL);
+  for (uint32_t i = 0; i < nof_repetitions; i++) {
+    srsran_pss_find_pss_all(&pss, signal, peak_pos, NULL);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  double all_us = (t[0].tv_sec * 1e6 + t[0].tv_usec) / nof_repetitions;
+
+  printf("N_id_2=%d found at %d. Correlating all N_id_2: one by one %.1f us, in one pass %.1f us\n",
+         max_N_id_2,
+         peak_pos[max_N_id_2],
+         serial_us,
+         all_us);
+
+  srsran_pss_free(&pss);
+  return SRSRAN_SUCCESS;
+}
+
+// The integer CFO shifted PSS correlated in one pass must give the same result as correlating them one by one
+static int test_find_pss_multi(const cf_t* signal)
+{
+  srsran_pss_t  pss_multi[3]     = {};
+  srsran_pss_t  pss_single[3]    = {};
+  srsran_pss_t* pss_multi_ptr[3] = {&pss_multi[0], &pss_multi[1], &pss_multi[2]};
+  int           peak_pos[3];
+  float         peak_value[3];
+
+  for (int i = 0; i < 3; i++) {
+    TESTASSERT(srsran_pss_init_fft_offset(&pss_multi[i], FLEN, FFT_SIZE, i - 1) == SRSRAN_SUCCESS);
+    TESTASSERT(srsran_pss_init_fft_offset(&pss_single[i], FLEN, FFT_SIZE, i - 1) == SRSRAN_SUCCESS);
+    srsran_pss_set_N_id_2(&pss_multi[i], N_id_2);
+    srsran_pss_set_N_id_2(&pss_single[i], N_id_2);
+  }
+
+  // Run a few times, so that the correlation averages are also compared
+  for (uint32_t k = 0; k < 4; k++) {
+    TESTASSERT(srsran_pss_find_pss_multi(pss_multi_ptr, 3, signal, peak_pos, peak_value) == SRSRAN_SUCCESS);
+    for (int i = 0; i < 3; i++) {
+      float value = 0.0f;
+      int   pos   = srsran_pss_find_pss(&pss_single[i], signal, &value);
+      INFO("cfo_i=%d; pos=%d/%d; value=%.2f/%.2f", i - 1, pos, peak_pos[i], value, peak_value[i]);
+      TESTASSERT(pos == peak_pos[i]);
+      TESTASSERT(fabsf(value - peak_value[i]) <= 1e-3f * value);
+    }
+  }
+
+  for (int i = 0; i < 3; i++) {
+    srsran_pss_free(&pss_multi[i]);
+    srsran_pss_free(&pss_single[i]);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  cf_t* signal = srsran_vec_cf_malloc(FLEN);
+  TESTASSERT(signal != NULL);
+  TESTASSERT(generate_signal(signal) == SRSRAN_SUCCESS);
+
+  TESTASSERT(test_find_pss_all(signal) == SRSRAN_SUCCESS);
+  TESTASSERT(test_find_pss_multi(signal) == SRSRAN_SUCCESS);
+
+  free(signal);
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
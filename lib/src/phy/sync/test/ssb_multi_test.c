@@ -0,0 +1,280 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/sync/ssb.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <getopt.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#define NOF_CELLS 2
+#define NOF_HYP 5
+
+// Base-band parameters
+static double srate_hz  = 15.36e6;
+static double center_hz = 3.5e9;
+
+// Cells transmitted in the base-band, each of them in a different SSB frequency and subcarrier spacing
+static const uint32_t                    cell_pci[NOF_CELLS]     = {500, 123};
+static const double                      cell_offset[NOF_CELLS]  = {-3.0e6, 3.0e6};
+static const srsran_subcarrier_spacing_t cell_scs[NOF_CELLS]     = {srsran_subcarrier_spacing_15kHz,
+                                                                srsran_subcarrier_spacing_30kHz};
+static const srsran_ssb_pattern_t        cell_pattern[NOF_CELLS] = {SRSRAN_SSB_PATTERN_A, SRSRAN_SSB_PATTERN_C};
+
+// Channel parameters
+static float cfo_hz = 500.0f;
+static float n0_dB  = -15.0f;
+
+// Test context
+static srsran_random_t       random_gen = NULL;
+static srsran_channel_awgn_t awgn       = {};
+static uint32_t              sf_len     = 0;
+static cf_t*                 buffer     = NULL;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [rnv]\n", prog);
+  printf("\t-r sampling rate in Hz [default, %.2f MHz]\n", srate_hz / 1e6);
+  printf("\t-n noise power in dB [default, %.1f dB]\n", n0_dB);
+  printf("\t-v [set srsran_verbose to debug, default none]\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "rnv")) != -1) {
+    switch (opt) {
+      case 'r':
+        srate_hz = strtod(argv[optind], NULL);
+        break;
+      case 'n':
+        n0_dB = strtof(argv[optind], NULL);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static void set_ssb_cfg(srsran_ssb_cfg_t*           cfg,
+                        double                      offset_hz,
+                        srsran_subcarrier_spacing_t scs,
+                        srsran_ssb_pattern_t        pattern)
+{
+  SRSRAN_MEM_ZERO(cfg, srsran_ssb_cfg_t, 1);
+  cfg->srate_hz       = srate_hz;
+  cfg->center_freq_hz = center_hz;
+  cfg->ssb_freq_hz    = center_hz + offset_hz;
+  cfg->scs            = scs;
+  cfg->pattern        = pattern;
+  cfg->duplex_mode    = SRSRAN_DUPLEX_MODE_TDD;
+}
+
+// Adds the first SSB candidate of every cell to the buffer
+static int gen_signal(srsran_pbch_msg_nr_t pbch_msg[NOF_CELLS])
+{
+  srsran_ssb_args_t ssb_args = {};
+  ssb_args.max_srate_hz      = srate_hz;
+  ssb_args.enable_encode     = true;
+
+  srsran_vec_cf_zero(buffer, sf_len);
+  for (uint32_t c = 0; c < NOF_CELLS; c++) {
+    srsran_ssb_t     ssb = {};
+    srsran_ssb_cfg_t cfg = {};
+    ssb_args.min_scs     = cell_scs[c];
+    set_ssb_cfg(&cfg, cell_offset[c], cell_scs[c], cell_pattern[c]);
+    TESTASSERT(srsran_ssb_init(&ssb, &ssb_args) == SRSRAN_SUCCESS);
+    TESTASSERT(srsran_ssb_set_cfg(&ssb, &cfg) == SRSRAN_SUCCESS);
+
+    SRSRAN_MEM_ZERO(&pbch_msg[c], srsran_pbch_msg_nr_t, 1);
+    srsran_random_bit_vector(random_gen, pbch_msg[c].payload, SRSRAN_PBCH_MSG_NR_SZ);
+    pbch_msg[c].crc = true;
+    TESTASSERT(srsran_ssb_add(&ssb, cell_pci[c], &pbch_msg[c], buffer, buffer) == SRSRAN_SUCCESS);
+
+    srsran_ssb_free(&ssb);
+  }
+
+  // Channel
+  srsran_vec_apply_cfo(buffer, -cfo_hz / srate_hz, buffer, sf_len);
+  srsran_channel_awgn_run_c(&awgn, buffer, buffer, sf_len);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  int                     ret = SRSRAN_ERROR;
+  srsran_ssb_multi_t      ssb_multi           = {};
+  srsran_ssb_t            ssb_single[NOF_HYP] = {};
+  srsran_ssb_cfg_t        hyp[NOF_HYP];
+  srsran_ssb_search_res_t res_multi[NOF_HYP];
+  srsran_ssb_search_res_t res_again[NOF_HYP];
+  srsran_pbch_msg_nr_t    pbch_msg[NOF_CELLS];
+  struct timeval          t[3];
+
+  parse_args(argc, argv);
+
+  random_gen = srsran_random_init(1234);
+  sf_len     = (uint32_t)round(srate_hz / 1000.0);
+  buffer     = srsran_vec_cf_malloc(sf_len);
+  if (random_gen == NULL || buffer == NULL) {
+    ERROR("Malloc");
+    goto clean_exit;
+  }
+
+  if (srsran_channel_awgn_init(&awgn, 0x0) < SRSRAN_SUCCESS) {
+    ERROR("AWGN");
+    goto clean_exit;
+  }
+  if (srsran_channel_awgn_set_n0(&awgn, n0_dB) < SRSRAN_SUCCESS) {
+    ERROR("AWGN");
+    goto clean_exit;
+  }
+
+  // Hypotheses: both cells with both subcarrier spacing and an empty SSB frequency
+  set_ssb_cfg(&hyp[0], cell_offset[0], srsran_subcarrier_spacing_15kHz, SRSRAN_SSB_PATTERN_A);
+  set_ssb_cfg(&hyp[1], cell_offset[0], srsran_subcarrier_spacing_30kHz, SRSRAN_SSB_PATTERN_C);
+  set_ssb_cfg(&hyp[2], cell_offset[1], srsran_subcarrier_spacing_15kHz, SRSRAN_SSB_PATTERN_A);
+  set_ssb_cfg(&hyp[3], cell_offset[1], srsran_subcarrier_spacing_30kHz, SRSRAN_SSB_PATTERN_C);
+  set_ssb_cfg(&hyp[4], 0.0, srsran_subcarrier_spacing_15kHz, SRSRAN_SSB_PATTERN_A);
+
+  srsran_ssb_args_t ssb_args = {};
+  ssb_args.max_srate_hz      = srate_hz;
+  ssb_args.min_scs           = srsran_subcarrier_spacing_15kHz;
+  ssb_args.enable_search     = true;
+  ssb_args.enable_decode     = true;
+  if (srsran_ssb_multi_init(&ssb_multi, &ssb_args) < SRSRAN_SUCCESS) {
+    ERROR("Init");
+    goto clean_exit;
+  }
+  if (srsran_ssb_multi_set_cfg(&ssb_multi, hyp, NOF_HYP) < SRSRAN_SUCCESS) {
+    ERROR("Setting hypotheses");
+    goto clean_exit;
+  }
+  for (uint32_t h = 0; h < NOF_HYP; h++) {
+    if (srsran_ssb_init(&ssb_single[h], &ssb_args) < SRSRAN_SUCCESS ||
+        srsran_ssb_set_cfg(&ssb_single[h], &hyp[h]) < SRSRAN_SUCCESS) {
+      ERROR("Init");
+      goto clean_exit;
+    }
+  }
+
+  if (gen_signal(pbch_msg) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  // Search all the hypotheses together
+  gettimeofday(&t[1], NULL);
+  if (srsran_ssb_multi_search(&ssb_multi, buffer, sf_len, res_multi) < SRSRAN_SUCCESS) {
+    ERROR("Error searching");
+    goto clean_exit;
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  uint64_t t_multi_usec = t[0].tv_usec + t[0].tv_sec * 1000000UL;
+
+  // Search each hypothesis separately
+  uint64_t t_single_usec = 0;
+  for (uint32_t h = 0; h < NOF_HYP; h++) {
+    srsran_ssb_search_res_t res_single = {};
+    gettimeofday(&t[1], NULL);
+    if (srsran_ssb_search(&ssb_single[h], buffer, sf_len, &res_single) < SRSRAN_SUCCESS) {
+      ERROR("Error searching");
+      goto clean_exit;
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    t_single_usec += t[0].tv_usec + t[0].tv_sec * 1000000UL;
+
+    char str[512] = {};
+    srsran_ssb_cfg_to_str(&hyp[h], str, (uint32_t)sizeof(str));
+    printf("Hypothesis %d (%s) pci=%d/%d; crc=%c/%c;\n",
+           h,
+           str,
+           res_multi[h].N_id,
+           res_single.N_id,
+           res_multi[h].pbch_msg.crc ? 'y' : 'n',
+           res_single.pbch_msg.crc ? 'y' : 'n');
+
+    // The hypotheses searched together must give the same result as searched separately
+    if (res_multi[h].pbch_msg.crc != res_single.pbch_msg.crc ||
+        (res_single.pbch_msg.crc && res_multi[h].N_id != res_single.N_id)) {
+      ERROR("Hypothesis %d result does not match the single hypothesis search", h);
+      goto clean_exit;
+    }
+  }
+
+  // Check every cell is found in its own hypothesis
+  for (uint32_t c = 0; c < NOF_CELLS; c++) {
+    const srsran_ssb_search_res_t* res = &res_multi[c == 0 ? 0 : 3];
+    if (!res->pbch_msg.crc || res->N_id != cell_pci[c] ||
+        memcmp(res->pbch_msg.payload, pbch_msg[c].payload, SRSRAN_PBCH_MSG_NR_SZ) != 0) {
+      ERROR("Cell pci=%d not found", cell_pci[c]);
+      goto clean_exit;
+    }
+  }
+  if (res_multi[4].pbch_msg.crc) {
+    ERROR("Found a cell in an empty SSB frequency");
+    goto clean_exit;
+  }
+
+  // Searching again uses the hypotheses as they were configured and gives the same result
+  if (srsran_ssb_multi_search(&ssb_multi, buffer, sf_len, res_again) < SRSRAN_SUCCESS) {
+    ERROR("Error searching");
+    goto clean_exit;
+  }
+  for (uint32_t h = 0; h < NOF_HYP; h++) {
+    if (res_again[h].pbch_msg.crc != res_multi[h].pbch_msg.crc ||
+        (res_multi[h].pbch_msg.crc && res_again[h].N_id != res_multi[h].N_id)) {
+      ERROR("Hypothesis %d result changed in the second search", h);
+      goto clean_exit;
+    }
+  }
+
+  printf("Searched %d hypotheses: %.1f usec together; %.1f usec separately;\n",
+         NOF_HYP,
+         (double)t_multi_usec,
+         (double)t_single_usec);
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_ssb_multi_free(&ssb_multi);
+  for (uint32_t h = 0; h < NOF_HYP; h++) {
+    srsran_ssb_free(&ssb_single[h]);
+  }
+  srsran_random_free(random_gen);
+  srsran_channel_awgn_free(&awgn);
+  if (buffer) {
+    free(buffer);
+  }
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Failed");
+  return ret;
+}
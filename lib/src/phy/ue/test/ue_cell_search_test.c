@@ -0,0 +1,232 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/ue/ue_cell_search.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include "srsran/srsran.h"
+#include <getopt.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NOF_CELLS 2
+#define SF_LEN SRSRAN_SF_LEN(srsran_symbol_sz(SRSRAN_CS_NOF_PRB))
+#define FRAME_LEN (10 * SF_LEN)
+
+static uint32_t cell_ids[NOF_CELLS]      = {150, 223};
+static uint32_t cell_delays[NOF_CELLS]   = {0, 1234};
+static float    cell_gains_dB[NOF_CELLS] = {0.0f, -6.0f};
+static float    snr_dB                   = 20.0f;
+
+// Simulated radio stream, it repeats the generated frame
+typedef struct {
+  cf_t*    frame;
+  uint32_t offset;
+  uint64_t nof_samples;
+} stream_t;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [sv]\n", prog);
+  printf("\t-s SNR in dB [Default %.1f]\n", snr_dB);
+  printf("\t-v srsran_verbose\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "sv")) != -1) {
+    switch (opt) {
+      case 's':
+        snr_dB = strtof(argv[optind], NULL);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static int recv_callback(void* h, cf_t* data[SRSRAN_MAX_CHANNELS], uint32_t nsamples, srsran_timestamp_t* t)
+{
+  stream_t* stream = (stream_t*)h;
+
+  if (t != NULL) {
+    srsran_timestamp_init_uint64(t, stream->nof_samples, SRSRAN_CS_SAMP_FREQ);
+  }
+  for (uint32_t i = 0; i < nsamples;) {
+    uint32_t n = SRSRAN_MIN(nsamples - i, FRAME_LEN - stream->offset);
+    if (data[0] != NULL) {
+      srsran_vec_cf_copy(&data[0][i], &stream->frame[stream->offset], n);
+    }
+    stream->offset = (stream->offset + n) % FRAME_LEN;
+    i += n;
+  }
+  stream->nof_samples += nsamples;
+
+  return (int)nsamples;
+}
+
+// Generates a radio frame with the PSS/SSS of every cell
+static int generate_frame(cf_t* frame)
+{
+  int                   ret        = SRSRAN_ERROR;
+  cf_t*                 sf_symbols = srsran_vec_cf_malloc(SF_LEN);
+  cf_t*                 sf_buffer  = srsran_vec_cf_malloc(SF_LEN);
+  cf_t                  pss_signal[SRSRAN_PSS_LEN];
+  float                 sss_signal0[SRSRAN_SSS_LEN];
+  float                 sss_signal5[SRSRAN_SSS_LEN];
+  srsran_ofdm_t         ifft = {};
+  srsran_channel_awgn_t awgn = {};
+
+  if (sf_symbols == NULL || sf_buffer == NULL) {
+    goto clean_exit;
+  }
+  if (srsran_ofdm_tx_init(&ifft, SRSRAN_CP_NORM, sf_symbols, sf_buffer, SRSRAN_CS_NOF_PRB)) {
+    ERROR("Error creating iFFT object");
+    goto clean_exit;
+  }
+  srsran_ofdm_set_normalize(&ifft, true);
+
+  srsran_vec_cf_zero(frame, FRAME_LEN);
+  for (uint32_t c = 0; c < NOF_CELLS; c++) {
+    srsran_pss_generate(pss_signal, cell_ids[c] % SRSRAN_NOF_NID_2);
+    srsran_sss_generate(sss_signal0, sss_signal5, cell_ids[c]);
+
+    for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx += 5) {
+      srsran_vec_cf_zero(sf_symbols, SF_LEN);
+      srsran_pss_put_slot(pss_signal, sf_symbols, SRSRAN_CS_NOF_PRB, SRSRAN_CP_NORM);
+      srsran_sss_put_slot(sf_idx ? sss_signal5 : sss_signal0, sf_symbols, SRSRAN_CS_NOF_PRB, SRSRAN_CP_NORM);
+      srsran_ofdm_tx_sf(&ifft);
+      srsran_vec_sc_prod_cfc(sf_buffer, srsran_convert_dB_to_amplitude(cell_gains_dB[c]), sf_buffer, SF_LEN);
+
+      // Add the subframe to the frame with the cell delay
+      for (uint32_t i = 0; i < SF_LEN; i++) {
+        frame[(sf_idx * SF_LEN + cell_delays[c] + i) % FRAME_LEN] += sf_buffer[i];
+      }
+    }
+  }
+
+  // Add noise relative to the power of the first subframe
+  if (srsran_channel_awgn_init(&awgn, 1234)) {
+    ERROR("Error initiating AWGN");
+    goto clean_exit;
+  }
+  float sync_power_dB = srsran_convert_power_to_dB(srsran_vec_avg_power_cf(frame, SF_LEN));
+  srsran_channel_awgn_set_n0(&awgn, sync_power_dB - snr_dB);
+  srsran_channel_awgn_run_c(&awgn, frame, frame, FRAME_LEN);
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_channel_awgn_free(&awgn);
+  srsran_ofdm_tx_free(&ifft);
+  if (sf_symbols) {
+    free(sf_symbols);
+  }
+  if (sf_buffer) {
+    free(sf_buffer);
+  }
+  return ret;
+}
+
+static int run_scan(srsran_ue_cellsearch_t* cs, srsran_ue_cellsearch_result_t found_cells[3], uint32_t* max_N_id_2)
+{
+  memset(found_cells, 0, sizeof(srsran_ue_cellsearch_result_t) * 3);
+  int nof_cells = srsran_ue_cellsearch_scan(cs, found_cells, max_N_id_2);
+  if (nof_cells < NOF_CELLS) {
+    ERROR("Found %d cells, expected at least %d", nof_cells, NOF_CELLS);
+    return SRSRAN_ERROR;
+  }
+  for (uint32_t c = 0; c < NOF_CELLS; c++) {
+    const srsran_ue_cellsearch_result_t* found = &found_cells[cell_ids[c] % SRSRAN_NOF_NID_2];
+    printf("Found cell_id=%d, peak=%.2f, psr=%.2f, cp=%s\n",
+           found->cell_id,
+           found->peak,
+           found->psr,
+           srsran_cp_string(found->cp));
+    if (found->cell_id != cell_ids[c] || found->cp != SRSRAN_CP_NORM || found->frame_type != SRSRAN_FDD) {
+      ERROR("Expected cell_id=%d", cell_ids[c]);
+      return SRSRAN_ERROR;
+    }
+  }
+  if (*max_N_id_2 != cell_ids[0] % SRSRAN_NOF_NID_2) {
+    ERROR("The strongest cell has N_id_2=%d, detected %d", cell_ids[0] % SRSRAN_NOF_NID_2, *max_N_id_2);
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  int                           ret = SRSRAN_ERROR;
+  srsran_ue_cellsearch_t        cs  = {};
+  srsran_ue_cellsearch_result_t found_cells[3];
+  uint32_t                      max_N_id_2 = 0;
+  stream_t                      stream     = {};
+
+  parse_args(argc, argv);
+
+  stream.frame = srsran_vec_cf_malloc(FRAME_LEN);
+  if (stream.frame == NULL || generate_frame(stream.frame)) {
+    ERROR("Error generating frame");
+    goto clean_exit;
+  }
+
+  if (srsran_ue_cellsearch_init_multi(&cs, 8, recv_callback, 1, &stream)) {
+    ERROR("Error initiating cell search");
+    goto clean_exit;
+  }
+  srsran_ue_cellsearch_set_nof_valid_frames(&cs, 4);
+
+  // Search the N_id_2 hypotheses one after another
+  uint64_t nof_samples = stream.nof_samples;
+  if (run_scan(&cs, found_cells, &max_N_id_2)) {
+    goto clean_exit;
+  }
+  printf("Serial scan received %" PRIu64 " samples\n", stream.nof_samples - nof_samples);
+
+  // Search the N_id_2 hypotheses in parallel over the same samples
+  if (srsran_ue_cellsearch_enable_parallel(&cs, true)) {
+    ERROR("Error enabling parallel cell search");
+    goto clean_exit;
+  }
+  for (uint32_t i = 0; i < 2; i++) {
+    nof_samples = stream.nof_samples;
+    if (run_scan(&cs, found_cells, &max_N_id_2)) {
+      goto clean_exit;
+    }
+    printf("Parallel scan received %" PRIu64 " samples\n", stream.nof_samples - nof_samples);
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_ue_cellsearch_free(&cs);
+  if (stream.frame) {
+    free(stream.frame);
+  }
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Failed");
+  return ret;
+}
@@ -21,6 +21,7 @@
 
 #include "srsran/srsran.h"
 #include <assert.h>
+#include <pthread.h>
 #include <stdlib.h>
 #include <string.h>
 #include <strings.h>
@@ -33,6 +34,34 @@
 
 #define CELL_SEARCH_BUFFER_MAX_SAMPLES (3 * SRSRAN_SF_LEN_MAX)
 
+/* Samples received once from the parent stream and replayed to every N_id_2 hypothesis. The capture grows on demand,
+ * as the hypotheses request samples past its end.
+ */
+typedef struct {
+  srsran_ue_cellsearch_t* parent;
+  cf_t*                   buffer[SRSRAN_MAX_CHANNELS];
+  uint32_t                len;
+  uint32_t                max_len;
+  srsran_timestamp_t      timestamp;
+  pthread_mutex_t         mutex;
+} cellsearch_capture_t;
+
+typedef struct {
+  srsran_ue_cellsearch_t        cs;
+  cellsearch_capture_t*         capture;
+  uint32_t                      N_id_2;
+  uint32_t                      read_idx;
+  srsran_ue_cellsearch_result_t found_cell;
+  int                           ret;
+  pthread_t                     pthread;
+  bool                          pthread_running;
+} cellsearch_hyp_t;
+
+typedef struct {
+  cellsearch_capture_t capture;
+  cellsearch_hyp_t     hyp[SRSRAN_NOF_NID_2];
+} cellsearch_parallel_t;
+
 int srsran_ue_cellsearch_init(srsran_ue_cellsearch_t* q,
                               uint32_t                max_frames,
                               int(recv_callback)(void*, void*, uint32_t, srsran_timestamp_t*),
@@ -159,6 +188,8 @@ clean_exit:
 
 void srsran_ue_cellsearch_free(srsran_ue_cellsearch_t* q)
 {
+  srsran_ue_cellsearch_enable_parallel(q, false);
+
   for (int i = 0; i < q->nof_rx_antennas; i++) {
     if (q->sf_buffer[i]) {
       free(q->sf_buffer[i]);
@@ -191,6 +222,200 @@ int srsran_ue_cellsearch_set_nof_valid_frames(srsran_ue_cellsearch_t* q, uint32_
 void srsran_set_detect_cp(srsran_ue_cellsearch_t* q, bool enable)
 {
   srsran_ue_sync_cp_en(&q->ue_sync, enable);
+
+  cellsearch_parallel_t* h = (cellsearch_parallel_t*)q->parallel_ptr;
+  if (h) {
+    for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+      srsran_ue_sync_cp_en(&h->hyp[N_id_2].cs.ue_sync, enable);
+    }
+  }
+}
+
+/* Makes sure the capture holds at least nof_samples, receiving more samples from the parent stream otherwise */
+static int capture_extend(cellsearch_capture_t* c, uint32_t nof_samples)
+{
+  int ret = SRSRAN_SUCCESS;
+
+  pthread_mutex_lock(&c->mutex);
+  while (c->len < nof_samples && ret == SRSRAN_SUCCESS) {
+    srsran_ue_sync_t* ue_sync  = &c->parent->ue_sync;
+    uint32_t          nsamples = SRSRAN_MIN(ue_sync->frame_len, c->max_len - c->len);
+    if (nsamples == 0) {
+      ERROR("Cell search capture of %d samples exceeded", c->max_len);
+      ret = SRSRAN_ERROR;
+      break;
+    }
+
+    cf_t* ptr[SRSRAN_MAX_CHANNELS] = {NULL};
+    for (uint32_t i = 0; i < c->parent->nof_rx_antennas; i++) {
+      ptr[i] = &c->buffer[i][c->len];
+    }
+    srsran_timestamp_t timestamp = {0};
+    if (ue_sync->recv_callback(ue_sync->stream, ptr, nsamples, &timestamp) < 0) {
+      ERROR("Error receiving samples for cell search");
+      ret = SRSRAN_ERROR;
+      break;
+    }
+    if (c->len == 0) {
+      srsran_timestamp_copy(&c->timestamp, &timestamp);
+    }
+    c->len += nsamples;
+  }
+  pthread_mutex_unlock(&c->mutex);
+
+  return ret;
+}
+
+/* Receive callback of the hypotheses' ue_sync objects, reads the captured samples */
+static int capture_recv_callback(void* h, cf_t* data[SRSRAN_MAX_CHANNELS], uint32_t nsamples, srsran_timestamp_t* t)
+{
+  cellsearch_hyp_t*     hyp = (cellsearch_hyp_t*)h;
+  cellsearch_capture_t* c   = hyp->capture;
+
+  if (capture_extend(c, hyp->read_idx + nsamples) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  // Samples below the capture length are never written again, so they can be read without holding the mutex
+  for (uint32_t i = 0; i < c->parent->nof_rx_antennas; i++) {
+    if (data[i] != NULL) {
+      srsran_vec_cf_copy(data[i], &c->buffer[i][hyp->read_idx], nsamples);
+    }
+  }
+  if (t != NULL) {
+    srsran_timestamp_copy(t, &c->timestamp);
+    srsran_timestamp_add(t, 0, hyp->read_idx / SRSRAN_CS_SAMP_FREQ);
+  }
+  hyp->read_idx += nsamples;
+
+  return (int)nsamples;
+}
+
+static void* hyp_scan_thread(void* arg)
+{
+  cellsearch_hyp_t* hyp = (cellsearch_hyp_t*)arg;
+
+  hyp->ret = srsran_ue_cellsearch_scan_N_id_2(&hyp->cs, hyp->N_id_2, &hyp->found_cell);
+
+  return NULL;
+}
+
+int srsran_ue_cellsearch_enable_parallel(srsran_ue_cellsearch_t* q, bool enable)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  cellsearch_parallel_t* h = (cellsearch_parallel_t*)q->parallel_ptr;
+  if (enable == (h != NULL)) {
+    return SRSRAN_SUCCESS;
+  }
+
+  if (!enable) {
+    for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+      srsran_ue_cellsearch_free(&h->hyp[N_id_2].cs);
+    }
+    for (uint32_t i = 0; i < SRSRAN_MAX_CHANNELS; i++) {
+      if (h->capture.buffer[i]) {
+        free(h->capture.buffer[i]);
+      }
+    }
+    pthread_mutex_destroy(&h->capture.mutex);
+    free(h);
+    q->parallel_ptr = NULL;
+    return SRSRAN_SUCCESS;
+  }
+
+  h = calloc(sizeof(cellsearch_parallel_t), 1);
+  if (!h) {
+    perror("calloc");
+    return SRSRAN_ERROR;
+  }
+  q->parallel_ptr = h;
+  pthread_mutex_init(&h->capture.mutex, NULL);
+
+  // Each ue_sync call reads at most a frame and a half, leave room for the alignment reads after a peak is found
+  h->capture.parent  = q;
+  h->capture.max_len = 2 * (q->max_frames + 1) * q->ue_sync.frame_len;
+  for (uint32_t i = 0; i < q->nof_rx_antennas; i++) {
+    h->capture.buffer[i] = srsran_vec_cf_malloc(h->capture.max_len);
+    if (!h->capture.buffer[i]) {
+      perror("malloc");
+      srsran_ue_cellsearch_enable_parallel(q, false);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    cellsearch_hyp_t* hyp = &h->hyp[N_id_2];
+    hyp->capture          = &h->capture;
+    hyp->N_id_2           = N_id_2;
+    if (srsran_ue_cellsearch_init_multi(
+            &hyp->cs, q->max_frames, capture_recv_callback, q->nof_rx_antennas, (void*)hyp)) {
+      ERROR("Error initiating cell search for N_id_2=%d", N_id_2);
+      srsran_ue_cellsearch_enable_parallel(q, false);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+srsran_ue_sync_t* srsran_ue_cellsearch_get_ue_sync(srsran_ue_cellsearch_t* q, uint32_t N_id_2)
+{
+  cellsearch_parallel_t* h = (cellsearch_parallel_t*)q->parallel_ptr;
+  if (h != NULL && N_id_2 < SRSRAN_NOF_NID_2) {
+    return &h->hyp[N_id_2].cs.ue_sync;
+  }
+  return &q->ue_sync;
+}
+
+/* Captures the samples once and searches the 3 N_id_2 hypotheses over them in parallel threads */
+static int cellsearch_scan_parallel(srsran_ue_cellsearch_t*       q,
+                                    srsran_ue_cellsearch_result_t found_cells[3],
+                                    uint32_t*                     max_N_id_2)
+{
+  cellsearch_parallel_t* h = (cellsearch_parallel_t*)q->parallel_ptr;
+
+  h->capture.len = 0;
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    cellsearch_hyp_t* hyp    = &h->hyp[N_id_2];
+    hyp->read_idx            = 0;
+    hyp->ret                 = SRSRAN_ERROR;
+    hyp->cs.nof_valid_frames = q->nof_valid_frames;
+    hyp->pthread_running     = pthread_create(&hyp->pthread, NULL, hyp_scan_thread, (void*)hyp) == 0;
+    if (!hyp->pthread_running) {
+      // Fall back to searching the hypothesis in the calling thread
+      hyp_scan_thread(hyp);
+    }
+  }
+
+  int      ret                = 0;
+  float    max_peak_value     = -1.0;
+  uint32_t nof_detected_cells = 0;
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    cellsearch_hyp_t* hyp = &h->hyp[N_id_2];
+    if (hyp->pthread_running) {
+      pthread_join(hyp->pthread, NULL);
+    }
+    if (hyp->ret < 0) {
+      ERROR("Error searching cell");
+      ret = hyp->ret;
+      continue;
+    }
+    nof_detected_cells += hyp->ret;
+    if (hyp->ret > 0) {
+      found_cells[N_id_2] = hyp->found_cell;
+    }
+    if (max_N_id_2) {
+      if (found_cells[N_id_2].peak > max_peak_value) {
+        max_peak_value = found_cells[N_id_2].peak;
+        *max_N_id_2    = N_id_2;
+      }
+    }
+  }
+
+  return ret < 0 ? ret : (int)nof_detected_cells;
 }
 
 /* Decide the most likely cell based on the mode */
@@ -266,6 +491,10 @@ int srsran_ue_cellsearch_scan(srsran_ue_cellsearch_t*       q,
                               srsran_ue_cellsearch_result_t found_cells[3],
                               uint32_t*                     max_N_id_2)
 {
+  if (q->parallel_ptr) {
+    return cellsearch_scan_parallel(q, found_cells, max_N_id_2);
+  }
+
   int      ret                = 0;
   float    max_peak_value     = -1.0;
   uint32_t nof_detected_cells = 0;
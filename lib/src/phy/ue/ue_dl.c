@@ -413,6 +413,37 @@ static bool dci_location_is_allocated(srsran_ue_dl_t* q, srsran_dci_location_t n
   return false;
 }
 
+// Checks if all the DCIs that can be expected in the subframe have been found
+static bool dci_blind_search_is_complete(srsran_ue_dl_t* q, uint16_t rnti, const srsran_dci_cfg_t* dci_cfg)
+{
+  // With cross-carrier scheduling, several DL DCIs can be transmitted to the same RNTI
+  if (!q->dci_early_abort || dci_cfg->cif_enabled) {
+    return false;
+  }
+
+  // SI/P/RA-RNTI are only used for DL assignments, whereas C-RNTI may also receive an UL grant
+  bool ul_expected = !(rnti == SRSRAN_SIRNTI || rnti == SRSRAN_PRNTI || SRSRAN_RNTI_ISRAR(rnti));
+
+  return q->nof_allocated_locations > 0 && (!ul_expected || q->pending_ul_dci_count > 0);
+}
+
+// Sorts the search space locations by decreasing candidate energy
+static void dci_blind_search_rank(srsran_ue_dl_t*     q,
+                                  dci_blind_search_t* search_space,
+                                  uint32_t            order[SRSRAN_MAX_CANDIDATES],
+                                  float               energy[SRSRAN_MAX_CANDIDATES])
+{
+  for (uint32_t i = 0; i < search_space->nof_locations; i++) {
+    float    e = srsran_pdcch_candidate_energy(&q->pdcch, &search_space->loc[i]);
+    uint32_t j = i;
+    for (; j > 0 && energy[order[j - 1]] < e; j--) {
+      order[j] = order[j - 1];
+    }
+    order[j]  = i;
+    energy[i] = e;
+  }
+}
+
 static int dci_blind_search(srsran_ue_dl_t*     q,
                             srsran_dl_sf_cfg_t* sf,
                             uint16_t            rnti,
@@ -422,12 +453,29 @@ static int dci_blind_search(srsran_ue_dl_t*     q,
                             bool                search_in_common)
 {
   uint32_t nof_dci = 0;
+  uint32_t order[SRSRAN_MAX_CANDIDATES];
+  float    energy[SRSRAN_MAX_CANDIDATES];
   if (rnti) {
-    for (int l = 0; l < search_space->nof_locations; l++) {
+    // Search first the candidates with more energy
+    if (q->dci_early_abort) {
+      dci_blind_search_rank(q, search_space, order, energy);
+    }
+
+    for (int i = 0; i < search_space->nof_locations; i++) {
+      int l = q->dci_early_abort ? (int)order[i] : i;
       if (nof_dci >= SRSRAN_MAX_DCI_MSG) {
         ERROR("Can't store more DCIs in buffer");
         return nof_dci;
       }
+      if (dci_blind_search_is_complete(q, rnti, dci_cfg)) {
+        INFO("Finishing search after %d/%d locations. All DCIs found", i, search_space->nof_locations);
+        break;
+      }
+      // The remaining locations do not have enough energy for being decoded
+      if (q->dci_early_abort && energy[l] <= SRSRAN_PDCCH_MIN_LLR_MEAN) {
+        INFO("Finishing search after %d/%d locations. Not enough energy", i, search_space->nof_locations);
+        break;
+      }
       if (dci_location_is_allocated(q, search_space->loc[l])) {
         INFO("Skipping location L=%d, ncce=%d. Already allocated", search_space->loc[l].L, search_space->loc[l].ncce);
         continue;
@@ -437,7 +485,7 @@ static int dci_blind_search(srsran_ue_dl_t*     q,
              srsran_dci_format_string(search_space->formats[f]),
              search_space->loc[l].ncce,
              search_space->loc[l].L,
-             l,
+             i,
              search_space->nof_locations);
 
         // Try to decode a valid DCI msg
@@ -0,0 +1,57 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/cpu.h"
+
+// Detected level, negative until the first query
+static int cpu_isa = -1;
+
+srsran_cpu_isa_t srsran_cpu_get_isa()
+{
+  // Detecting it concurrently is harmless, all the threads obtain the same value
+  int isa = __atomic_load_n(&cpu_isa, __ATOMIC_RELAXED);
+  if (isa < 0) {
+    isa = (int)srsran_cpu_detect_isa();
+    __atomic_store_n(&cpu_isa, isa, __ATOMIC_RELAXED);
+  }
+  return (srsran_cpu_isa_t)isa;
+}
+
+bool srsran_cpu_has_avx512()
+{
+  return srsran_cpu_get_isa() >= SRSRAN_CPU_ISA_AVX512;
+}
+
+const char* srsran_cpu_isa_string(srsran_cpu_isa_t isa)
+{
+  switch (isa) {
+    case SRSRAN_CPU_ISA_SSE:
+      return "sse4.1";
+    case SRSRAN_CPU_ISA_AVX:
+      return "avx";
+    case SRSRAN_CPU_ISA_AVX2:
+      return "avx2";
+    case SRSRAN_CPU_ISA_AVX512:
+      return "avx512";
+    default:
+      return "generic";
+  }
+}
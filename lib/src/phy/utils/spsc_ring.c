@@ -0,0 +1,249 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/spsc_ring.h"
+#include "srsran/phy/utils/vector.h"
+
+// Number of times a waiting thread yields before it starts sleeping
+#define SPSC_RING_SPIN_COUNT 64
+
+// Sleep period of a waiting thread once it stopped spinning
+#define SPSC_RING_SLEEP_NS 10000
+
+int srsran_spsc_ring_init(srsran_spsc_ring_t* q, uint32_t capacity, uint32_t max_reserve)
+{
+  if (q == NULL || capacity == 0 || max_reserve > capacity) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_spsc_ring_t, 1);
+
+  // The overrun area holds the part of a reserved region that goes beyond the end of the ring
+  q->buffer = srsran_vec_u8_malloc(capacity + max_reserve);
+  if (!q->buffer) {
+    return SRSRAN_ERROR;
+  }
+  q->capacity    = capacity;
+  q->max_reserve = max_reserve;
+  q->active      = true;
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_spsc_ring_free(srsran_spsc_ring_t* q)
+{
+  if (q) {
+    srsran_spsc_ring_stop(q);
+    if (q->buffer) {
+      free(q->buffer);
+      q->buffer = NULL;
+    }
+  }
+}
+
+void srsran_spsc_ring_reset(srsran_spsc_ring_t* q)
+{
+  if (q) {
+    q->read_idx_cache  = 0;
+    q->write_idx_cache = 0;
+    __atomic_store_n(&q->write_idx, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&q->read_idx, 0, __ATOMIC_RELEASE);
+  }
+}
+
+void srsran_spsc_ring_stop(srsran_spsc_ring_t* q)
+{
+  if (q) {
+    __atomic_store_n(&q->active, false, __ATOMIC_RELEASE);
+  }
+}
+
+uint32_t srsran_spsc_ring_status(srsran_spsc_ring_t* q)
+{
+  uint64_t w = __atomic_load_n(&q->write_idx, __ATOMIC_ACQUIRE);
+  uint64_t r = __atomic_load_n(&q->read_idx, __ATOMIC_ACQUIRE);
+  return (uint32_t)(w - r);
+}
+
+uint32_t srsran_spsc_ring_space(srsran_spsc_ring_t* q)
+{
+  return q->capacity - srsran_spsc_ring_status(q);
+}
+
+static int spsc_ring_wait(srsran_spsc_ring_t* q, bool write, uint32_t nof_bytes, int32_t timeout_ms)
+{
+  struct timespec deadline = {};
+  uint32_t        count    = 0;
+
+  if (q == NULL || q->buffer == NULL || nof_bytes > q->capacity) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  while ((write ? srsran_spsc_ring_space(q) : srsran_spsc_ring_status(q)) < nof_bytes) {
+    if (!__atomic_load_n(&q->active, __ATOMIC_ACQUIRE)) {
+      return SRSRAN_ERROR;
+    }
+    if (timeout_ms == 0) {
+      return SRSRAN_ERROR_TIMEOUT;
+    }
+
+    // Yield first, the other side usually catches up within a few microseconds
+    if (count < SPSC_RING_SPIN_COUNT) {
+      if (count == 0 && timeout_ms > 0) {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += timeout_ms / 1000;
+        deadline.tv_nsec += (timeout_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+          deadline.tv_sec++;
+          deadline.tv_nsec -= 1000000000L;
+        }
+      }
+      count++;
+      sched_yield();
+      continue;
+    }
+
+    if (timeout_ms > 0) {
+      struct timespec now;
+      clock_gettime(CLOCK_MONOTONIC, &now);
+      if (now.tv_sec > deadline.tv_sec || (now.tv_sec == deadline.tv_sec && now.tv_nsec >= deadline.tv_nsec)) {
+        return SRSRAN_ERROR_TIMEOUT;
+      }
+    }
+
+    struct timespec sleep_time = {0, SPSC_RING_SLEEP_NS};
+    nanosleep(&sleep_time, NULL);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_spsc_ring_wait_write(srsran_spsc_ring_t* q, uint32_t nof_bytes, int32_t timeout_ms)
+{
+  return spsc_ring_wait(q, true, nof_bytes, timeout_ms);
+}
+
+int srsran_spsc_ring_wait_read(srsran_spsc_ring_t* q, uint32_t nof_bytes, int32_t timeout_ms)
+{
+  return spsc_ring_wait(q, false, nof_bytes, timeout_ms);
+}
+
+void* srsran_spsc_ring_reserve(srsran_spsc_ring_t* q, uint32_t nof_bytes)
+{
+  uint64_t w   = q->write_idx;
+  uint32_t pos = (uint32_t)(w % q->capacity);
+
+  // The overrun area bounds the size of a region wrapping around the end of the ring
+  if (nof_bytes > q->max_reserve) {
+    return NULL;
+  }
+
+  // Refresh the read index only when the cached one does not leave enough space
+  if (w + nof_bytes - q->read_idx_cache > q->capacity) {
+    q->read_idx_cache = __atomic_load_n(&q->read_idx, __ATOMIC_ACQUIRE);
+    if (w + nof_bytes - q->read_idx_cache > q->capacity) {
+      return NULL;
+    }
+  }
+
+  return &q->buffer[pos];
+}
+
+void srsran_spsc_ring_commit(srsran_spsc_ring_t* q, uint32_t nof_bytes)
+{
+  uint64_t w   = q->write_idx;
+  uint32_t pos = (uint32_t)(w % q->capacity);
+
+  // Move the part written in the overrun area to the beginning of the ring
+  if (pos + nof_bytes > q->capacity) {
+    memcpy(q->buffer, &q->buffer[q->capacity], pos + nof_bytes - q->capacity);
+  }
+
+  __atomic_store_n(&q->write_idx, w + nof_bytes, __ATOMIC_RELEASE);
+}
+
+int srsran_spsc_ring_write_timed(srsran_spsc_ring_t* q, const void* ptr, uint32_t nof_bytes, int32_t timeout_ms)
+{
+  int ret = spsc_ring_wait(q, true, nof_bytes, timeout_ms);
+  if (ret < SRSRAN_SUCCESS) {
+    return ret;
+  }
+
+  uint64_t w     = q->write_idx;
+  uint32_t pos   = (uint32_t)(w % q->capacity);
+  uint32_t first = SRSRAN_MIN(nof_bytes, q->capacity - pos);
+  memcpy(&q->buffer[pos], ptr, first);
+  memcpy(q->buffer, (const uint8_t*)ptr + first, nof_bytes - first);
+
+  __atomic_store_n(&q->write_idx, w + nof_bytes, __ATOMIC_RELEASE);
+
+  return (int)nof_bytes;
+}
+
+const void* srsran_spsc_ring_peek(srsran_spsc_ring_t* q, uint32_t* nof_bytes)
+{
+  uint64_t r = q->read_idx;
+
+  // Refresh the write index only when the cached one says the ring is empty
+  if (r == q->write_idx_cache) {
+    q->write_idx_cache = __atomic_load_n(&q->write_idx, __ATOMIC_ACQUIRE);
+    if (r == q->write_idx_cache) {
+      *nof_bytes = 0;
+      return NULL;
+    }
+  }
+
+  uint32_t pos = (uint32_t)(r % q->capacity);
+  *nof_bytes   = (uint32_t)SRSRAN_MIN(q->write_idx_cache - r, (uint64_t)(q->capacity - pos));
+
+  return &q->buffer[pos];
+}
+
+void srsran_spsc_ring_release(srsran_spsc_ring_t* q, uint32_t nof_bytes)
+{
+  __atomic_store_n(&q->read_idx, q->read_idx + nof_bytes, __ATOMIC_RELEASE);
+}
+
+int srsran_spsc_ring_read_timed(srsran_spsc_ring_t* q, void* ptr, uint32_t nof_bytes, int32_t timeout_ms)
+{
+  int ret = spsc_ring_wait(q, false, nof_bytes, timeout_ms);
+  if (ret < SRSRAN_SUCCESS) {
+    return ret;
+  }
+
+  uint64_t r = q->read_idx;
+  if (ptr != NULL) {
+    uint32_t pos   = (uint32_t)(r % q->capacity);
+    uint32_t first = SRSRAN_MIN(nof_bytes, q->capacity - pos);
+    memcpy(ptr, &q->buffer[pos], first);
+    memcpy((uint8_t*)ptr + first, q->buffer, nof_bytes - first);
+  }
+
+  __atomic_store_n(&q->read_idx, r + nof_bytes, __ATOMIC_RELEASE);
+
+  return (int)nof_bytes;
+}
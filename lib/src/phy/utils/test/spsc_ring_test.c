@@ -0,0 +1,252 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/support/srsran_test.h"
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/spsc_ring.h"
+#include "srsran/phy/utils/vector.h"
+
+static uint32_t capacity  = 1000;
+static uint32_t nof_bytes = 10000000;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [cn]\n", prog);
+  printf("\t-c ring capacity in bytes [Default %d]\n", capacity);
+  printf("\t-n number of bytes streamed in the threaded test [Default %d]\n", nof_bytes);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "cn")) != -1) {
+    switch (opt) {
+      case 'c':
+        capacity = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        nof_bytes = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+// Byte expected at the given position of the stream
+static inline uint8_t pattern(uint64_t i)
+{
+  return (uint8_t)((i * 7) ^ (i >> 8));
+}
+
+static int test_read_write(srsran_spsc_ring_t* q)
+{
+  uint8_t in[64];
+  uint8_t out[64];
+  for (uint32_t i = 0; i < 64; i++) {
+    in[i] = (uint8_t)i;
+  }
+
+  // Move the indexes close to the end so the writes wrap around
+  for (uint32_t i = 0; i < capacity / 64; i++) {
+    TESTASSERT(srsran_spsc_ring_write_timed(q, in, 64, 0) == 64);
+    TESTASSERT(srsran_spsc_ring_read_timed(q, out, 64, 0) == 64);
+    TESTASSERT(memcmp(in, out, 64) == 0);
+  }
+  TESTASSERT(srsran_spsc_ring_write_timed(q, in, 64, 0) == 64);
+  TESTASSERT(srsran_spsc_ring_status(q) == 64);
+  TESTASSERT(srsran_spsc_ring_read_timed(q, out, 32, 0) == 32);
+  TESTASSERT(srsran_spsc_ring_read_timed(q, &out[32], 32, 0) == 32);
+  TESTASSERT(memcmp(in, out, 64) == 0);
+
+  // Reading from an empty ring and writing into a full ring must not block
+  TESTASSERT(srsran_spsc_ring_read_timed(q, out, 1, 0) == SRSRAN_ERROR_TIMEOUT);
+  TESTASSERT(srsran_spsc_ring_read_timed(q, out, 1, 10) == SRSRAN_ERROR_TIMEOUT);
+  for (uint32_t i = 0; i < capacity; i++) {
+    TESTASSERT(srsran_spsc_ring_write_timed(q, in, 1, 0) == 1);
+  }
+  TESTASSERT(srsran_spsc_ring_space(q) == 0);
+  TESTASSERT(srsran_spsc_ring_write_timed(q, in, 1, 0) == SRSRAN_ERROR_TIMEOUT);
+  TESTASSERT(srsran_spsc_ring_reserve(q, 1) == NULL);
+
+  return SRSRAN_SUCCESS;
+}
+
+static int test_reserve_peek(srsran_spsc_ring_t* q)
+{
+  uint64_t wr = 0;
+  uint64_t rd = 0;
+
+  // Reserve, commit, peek and release blocks of varying size, checking the contents wrap around correctly
+  for (uint32_t n = 1; n < 10 * capacity; n = n + 1 + n / 7) {
+    uint32_t len = n % q->max_reserve + 1;
+
+    uint8_t* ptr = srsran_spsc_ring_reserve(q, len);
+    TESTASSERT(ptr != NULL);
+    for (uint32_t i = 0; i < len; i++) {
+      ptr[i] = pattern(wr++);
+    }
+    srsran_spsc_ring_commit(q, len);
+
+    while (rd < wr) {
+      uint32_t       count = 0;
+      const uint8_t* data  = srsran_spsc_ring_peek(q, &count);
+      TESTASSERT(data != NULL && count > 0 && count <= wr - rd);
+      for (uint32_t i = 0; i < count; i++) {
+        TESTASSERT(data[i] == pattern(rd++));
+      }
+      srsran_spsc_ring_release(q, count);
+    }
+  }
+
+  uint32_t count = 0;
+  TESTASSERT(srsran_spsc_ring_peek(q, &count) == NULL && count == 0);
+
+  // Reserving more than the maximum must fail
+  TESTASSERT(srsran_spsc_ring_reserve(q, capacity) == NULL);
+
+  return SRSRAN_SUCCESS;
+}
+
+static void* producer_thread(void* arg)
+{
+  srsran_spsc_ring_t* q   = (srsran_spsc_ring_t*)arg;
+  uint64_t            wr  = 0;
+  uint32_t            len = 1;
+
+  while (wr < nof_bytes) {
+    len = SRSRAN_MIN(len % q->max_reserve + 1, nof_bytes - wr);
+
+    // Alternate zero-copy and copying writes
+    if (wr % 2) {
+      if (srsran_spsc_ring_wait_write(q, len, -1) < SRSRAN_SUCCESS) {
+        return NULL;
+      }
+      uint8_t* ptr = srsran_spsc_ring_reserve(q, len);
+      if (ptr == NULL) {
+        return NULL;
+      }
+      for (uint32_t i = 0; i < len; i++) {
+        ptr[i] = pattern(wr + i);
+      }
+      srsran_spsc_ring_commit(q, len);
+    } else {
+      uint8_t buffer[256];
+      len = SRSRAN_MIN(len, sizeof(buffer));
+      for (uint32_t i = 0; i < len; i++) {
+        buffer[i] = pattern(wr + i);
+      }
+      if (srsran_spsc_ring_write_timed(q, buffer, len, -1) < SRSRAN_SUCCESS) {
+        return NULL;
+      }
+    }
+    wr += len;
+    len = len * 3 + 1;
+  }
+  return NULL;
+}
+
+static int test_threaded(srsran_spsc_ring_t* q)
+{
+  pthread_t      thread;
+  uint64_t       rd  = 0;
+  uint32_t       len = 1;
+  uint8_t        buffer[256];
+  struct timeval t[3];
+
+  gettimeofday(&t[1], NULL);
+  if (pthread_create(&thread, NULL, producer_thread, q)) {
+    ERROR("Error creating thread");
+    return SRSRAN_ERROR;
+  }
+
+  while (rd < nof_bytes) {
+    // Alternate zero-copy and copying reads
+    if (rd % 2) {
+      if (srsran_spsc_ring_wait_read(q, 1, 1000) < SRSRAN_SUCCESS) {
+        break;
+      }
+      uint32_t       count = 0;
+      const uint8_t* data  = srsran_spsc_ring_peek(q, &count);
+      TESTASSERT(data != NULL);
+      for (uint32_t i = 0; i < count; i++) {
+        TESTASSERT(data[i] == pattern(rd + i));
+      }
+      srsran_spsc_ring_release(q, count);
+      rd += count;
+    } else {
+      // Leave room for the largest write, otherwise both sides could wait for each other
+      len = SRSRAN_MIN(SRSRAN_MIN(len % sizeof(buffer) + 1, nof_bytes - rd), capacity - q->max_reserve);
+      if (srsran_spsc_ring_read_timed(q, buffer, len, 1000) < SRSRAN_SUCCESS) {
+        break;
+      }
+      for (uint32_t i = 0; i < len; i++) {
+        TESTASSERT(buffer[i] == pattern(rd + i));
+      }
+      rd += len;
+      len = len * 5 + 3;
+    }
+  }
+
+  srsran_spsc_ring_stop(q);
+  pthread_join(thread, NULL);
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+
+  printf("Streamed %" PRIu64 " bytes in %.1f ms\n", rd, (t[0].tv_sec * 1e3 + t[0].tv_usec / 1e3));
+  TESTASSERT(rd == nof_bytes);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srsran_spsc_ring_t q;
+
+  parse_args(argc, argv);
+
+  if (srsran_spsc_ring_init(&q, capacity, capacity / 4)) {
+    ERROR("Error initiating ring");
+    return SRSRAN_ERROR;
+  }
+
+  TESTASSERT(test_read_write(&q) == SRSRAN_SUCCESS);
+  srsran_spsc_ring_reset(&q);
+  TESTASSERT(srsran_spsc_ring_status(&q) == 0);
+
+  TESTASSERT(test_reserve_peek(&q) == SRSRAN_SUCCESS);
+  srsran_spsc_ring_reset(&q);
+
+  TESTASSERT(test_threaded(&q) == SRSRAN_SUCCESS);
+
+  srsran_spsc_ring_free(&q);
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
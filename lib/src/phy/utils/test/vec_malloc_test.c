@@ -0,0 +1,59 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/support/srsran_test.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "srsran/phy/utils/simd.h"
+#include "srsran/phy/utils/vector.h"
+
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+#define LARGE_SIZE (4 * 1024 * 1024)
+
+int main(int argc, char** argv)
+{
+  // Without huge pages the allocations keep the SIMD alignment
+  uint8_t* large_default = srsran_vec_u8_malloc(LARGE_SIZE);
+  TESTASSERT(large_default != NULL);
+  TESTASSERT(((uintptr_t)large_default % SRSRAN_SIMD_BIT_ALIGN) == 0);
+  memset(large_default, 0, LARGE_SIZE);
+
+  // Huge pages only change the alignment of the allocations of at least a huge page, the kernel decides whether it
+  // backs the memory with them
+  srsran_vec_malloc_set_huge_pages(true);
+  uint8_t* small = srsran_vec_u8_malloc(64);
+  uint8_t* huge  = srsran_vec_u8_malloc(LARGE_SIZE);
+  srsran_vec_malloc_set_huge_pages(false);
+  TESTASSERT(small != NULL && huge != NULL);
+  TESTASSERT(((uintptr_t)small % SRSRAN_SIMD_BIT_ALIGN) == 0);
+  TESTASSERT(((uintptr_t)huge % HUGE_PAGE_SIZE) == 0);
+  memset(small, 1, 64);
+  memset(huge, 1, LARGE_SIZE);
+
+  // The buffers are released with free() like any other
+  free(large_default);
+  free(small);
+  free(huge);
+
+  return SRSRAN_SUCCESS;
+}
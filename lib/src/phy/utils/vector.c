@@ -24,6 +24,7 @@
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
@@ -151,14 +152,32 @@ void srsran_vec_lut_sis(const short* x, const unsigned int* lut, short* y, const
   }
 }
 
+#define VEC_MALLOC_HUGE_PAGE_SIZE (2UL * 1024UL * 1024UL)
+
+// Huge pages for the memory allocated by the calling thread, see srsran_vec_malloc_set_huge_pages()
+static __thread bool vec_malloc_huge_pages = false;
+
+void srsran_vec_malloc_set_huge_pages(bool enable)
+{
+  vec_malloc_huge_pages = enable;
+}
+
 void* srsran_vec_malloc(uint32_t size)
 {
   void* ptr;
-  if (posix_memalign(&ptr, SRSRAN_SIMD_BIT_ALIGN, size)) {
+  bool  huge = vec_malloc_huge_pages && size >= VEC_MALLOC_HUGE_PAGE_SIZE;
+
+  if (posix_memalign(&ptr, huge ? VEC_MALLOC_HUGE_PAGE_SIZE : SRSRAN_SIMD_BIT_ALIGN, size)) {
     return NULL;
-  } else {
-    return ptr;
   }
+
+#ifdef MADV_HUGEPAGE
+  if (huge) {
+    // Only a hint, the kernel falls back to regular pages if transparent huge pages are disabled
+    madvise(ptr, size & ~(VEC_MALLOC_HUGE_PAGE_SIZE - 1), MADV_HUGEPAGE);
+  }
+#endif /* MADV_HUGEPAGE */
+  return ptr;
 }
 
 cf_t* srsran_vec_cf_malloc(uint32_t nsamples)
@@ -862,12 +881,9 @@ float srsran_vec_estimate_frequency(const cf_t* x, int len)
   return srsran_vec_estimate_frequency_simd(x, len);
 }
 
-// TODO: implement with SIMD
 void srsran_vec_gen_clip_env(const float* x_abs, const float thres, const float alpha, float* env, const int len)
 {
-  for (int i = 0; i < len; i++) {
-    env[i] = (x_abs[i] > thres) ? (1 - alpha) + alpha * thres / x_abs[i] : 1;
-  }
+  srsran_vec_gen_clip_env_simd(x_abs, thres, alpha, env, len);
 }
 
 float srsran_vec_papr_c(const cf_t* in, const int len)
@@ -27,6 +27,16 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef SRSRAN_MULTI_ISA_AVX512
+// This file is built once per ISA, the kernels are selected at runtime by vector_simd_dispatch.c
+#ifdef LV_HAVE_AVX512
+#define VECTOR_SIMD_ISA_SUFFIX _avx512
+#else /* LV_HAVE_AVX512 */
+#define VECTOR_SIMD_ISA_SUFFIX _base
+#endif /* LV_HAVE_AVX512 */
+#include "vector_simd_isa.h"
+#endif /* SRSRAN_MULTI_ISA_AVX512 */
+
 #include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector_simd.h"
 
@@ -407,26 +417,26 @@ void srsran_vec_convert_if_simd(const int16_t* x, float* z, const float scale, c
   int         i    = 0;
   const float gain = 1.0f / scale;
 
-#ifdef LV_HAVE_SSE
-  __m128 s = _mm_set1_ps(gain);
-  if (SRSRAN_IS_ALIGNED(z)) {
-    for (; i < len - 3; i += 4) {
-      __m64* ptr = (__m64*)&x[i];
-      __m128 fl  = _mm_cvtpi16_ps(*ptr);
-      __m128 v   = _mm_mul_ps(fl, s);
+#if SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_S_SIZE
+  simd_f_t s = srsran_simd_f_set1(gain);
+  if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(z)) {
+    for (; i < len - SRSRAN_SIMD_S_SIZE + 1; i += SRSRAN_SIMD_S_SIZE) {
+      simd_f_t a, b;
+      srsran_simd_convert_s_2f(srsran_simd_s_load(&x[i]), &a, &b);
 
-      _mm_store_ps(&z[i], v);
+      srsran_simd_f_store(&z[i], srsran_simd_f_mul(a, s));
+      srsran_simd_f_store(&z[i + SRSRAN_SIMD_F_SIZE], srsran_simd_f_mul(b, s));
     }
   } else {
-    for (; i < len - 3; i += 4) {
-      __m64* ptr = (__m64*)&x[i];
-      __m128 fl  = _mm_cvtpi16_ps(*ptr);
-      __m128 v   = _mm_mul_ps(fl, s);
+    for (; i < len - SRSRAN_SIMD_S_SIZE + 1; i += SRSRAN_SIMD_S_SIZE) {
+      simd_f_t a, b;
+      srsran_simd_convert_s_2f(srsran_simd_s_loadu(&x[i]), &a, &b);
 
-      _mm_storeu_ps(&z[i], v);
+      srsran_simd_f_storeu(&z[i], srsran_simd_f_mul(a, s));
+      srsran_simd_f_storeu(&z[i + SRSRAN_SIMD_F_SIZE], srsran_simd_f_mul(b, s));
     }
   }
-#endif /* LV_HAVE_SSE */
+#endif /* SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_S_SIZE */
 
   for (; i < len; i++) {
     z[i] = ((float)x[i]) * gain;
@@ -1817,3 +1827,32 @@ float srsran_vec_estimate_frequency_simd(const cf_t* x, int len)
   // Extract argument and divide by (-2·PI)
   return -cargf(sum) * M_1_PI * 0.5f;
 }
+
+void srsran_vec_gen_clip_env_simd(const float* x_abs, const float thres, const float alpha, float* env, const int len)
+{
+  int i = 0;
+
+#if SRSRAN_SIMD_F_SIZE
+  const simd_f_t _one   = srsran_simd_f_set1(1.0f);
+  const simd_f_t _two   = srsran_simd_f_set1(2.0f);
+  const simd_f_t _thres = srsran_simd_f_set1(thres);
+  const simd_f_t _base  = srsran_simd_f_set1(1.0f - alpha);
+  const simd_f_t _scale = srsran_simd_f_set1(alpha * thres);
+
+  for (; i < len - SRSRAN_SIMD_F_SIZE + 1; i += SRSRAN_SIMD_F_SIZE) {
+    simd_f_t a = srsran_simd_f_loadu(&x_abs[i]);
+
+    // Reciprocal refined with one Newton-Raphson iteration
+    simd_f_t r = srsran_simd_f_rcp(a);
+    r          = srsran_simd_f_mul(r, srsran_simd_f_sub(_two, srsran_simd_f_mul(a, r)));
+
+    simd_f_t   clip = srsran_simd_f_add(_base, srsran_simd_f_mul(_scale, r));
+    simd_sel_t sel  = srsran_simd_f_max(a, _thres);
+    srsran_simd_f_storeu(&env[i], srsran_simd_f_select(_one, clip, sel));
+  }
+#endif /* SRSRAN_SIMD_F_SIZE */
+
+  for (; i < len; i++) {
+    env[i] = (x_abs[i] > thres) ? (1 - alpha) + alpha * thres / x_abs[i] : 1;
+  }
+}
@@ -0,0 +1,44 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/cpu.h"
+#include "srsran/phy/utils/vector_simd.h"
+#include "vector_simd_isa.h"
+
+#ifdef SRSRAN_MULTI_ISA_AVX512
+
+/*
+ * Every kernel is an ifunc: the dynamic loader calls its resolver once, when the program is loaded, and binds the
+ * kernel to the returned version. Calls have no overhead compared to a build for a single ISA.
+ */
+#define VECTOR_SIMD_DISPATCH(NAME)                                                                                     \
+  extern __typeof__(NAME) NAME##_base;                                                                                 \
+  extern __typeof__(NAME) NAME##_avx512;                                                                               \
+  static __typeof__(NAME)* NAME##_resolve(void)                                                                        \
+  {                                                                                                                    \
+    return (srsran_cpu_detect_isa() >= SRSRAN_CPU_ISA_AVX512) ? NAME##_avx512 : NAME##_base;                           \
+  }                                                                                                                    \
+  __typeof__(NAME) NAME __attribute__((ifunc(#NAME "_resolve")));
+
+VECTOR_SIMD_FUNCTIONS(VECTOR_SIMD_DISPATCH)
+VECTOR_SIMD_FUNCTIONS_C16(VECTOR_SIMD_DISPATCH)
+
+#endif /* SRSRAN_MULTI_ISA_AVX512 */
@@ -0,0 +1,141 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * With runtime ISA selection, vector_simd.c is built once for the baseline ISA and once for AVX512. Every build appends
+ * its ISA to the kernel names, and vector_simd_dispatch.c provides the public names, bound to the best version the CPU
+ * supports when the program is loaded.
+ */
+
+#ifndef SRSRAN_VECTOR_SIMD_ISA_H
+#define SRSRAN_VECTOR_SIMD_ISA_H
+
+// Applies X to every kernel declared in vector_simd.h
+#define VECTOR_SIMD_FUNCTIONS(X)                                                                                       \
+  X(srsran_vec_xor_bbb_simd)                                                                                           \
+  X(srsran_vec_sum_sss_simd)                                                                                           \
+  X(srsran_vec_sub_sss_simd)                                                                                           \
+  X(srsran_vec_sub_bbb_simd)                                                                                           \
+  X(srsran_vec_acc_ff_simd)                                                                                            \
+  X(srsran_vec_acc_cc_simd)                                                                                            \
+  X(srsran_vec_add_fff_simd)                                                                                           \
+  X(srsran_vec_sub_fff_simd)                                                                                           \
+  X(srsran_vec_sc_sum_fff_simd)                                                                                        \
+  X(srsran_vec_sc_prod_cfc_simd)                                                                                       \
+  X(srsran_vec_sc_prod_fcc_simd)                                                                                       \
+  X(srsran_vec_sc_prod_fff_simd)                                                                                       \
+  X(srsran_vec_sc_prod_ccc_simd)                                                                                       \
+  X(srsran_vec_sc_prod_ccc_simd2)                                                                                      \
+  X(srsran_vec_prod_ccc_split_simd)                                                                                    \
+  X(srsran_vec_prod_sss_simd)                                                                                          \
+  X(srsran_vec_neg_sss_simd)                                                                                           \
+  X(srsran_vec_neg_bbb_simd)                                                                                           \
+  X(srsran_vec_prod_cfc_simd)                                                                                          \
+  X(srsran_vec_prod_fff_simd)                                                                                          \
+  X(srsran_vec_prod_ccc_simd)                                                                                          \
+  X(srsran_vec_prod_conj_ccc_simd)                                                                                     \
+  X(srsran_vec_div_ccc_simd)                                                                                           \
+  X(srsran_vec_div_cfc_simd)                                                                                           \
+  X(srsran_vec_div_fff_simd)                                                                                           \
+  X(srsran_vec_dot_prod_conj_ccc_simd)                                                                                 \
+  X(srsran_vec_dot_prod_ccc_simd)                                                                                      \
+  X(srsran_vec_dot_prod_sss_simd)                                                                                      \
+  X(srsran_vec_abs_cf_simd)                                                                                            \
+  X(srsran_vec_abs_square_cf_simd)                                                                                     \
+  X(srsran_vec_lut_sss_simd)                                                                                           \
+  X(srsran_vec_lut_bbb_simd)                                                                                           \
+  X(srsran_vec_convert_if_simd)                                                                                        \
+  X(srsran_vec_convert_fi_simd)                                                                                        \
+  X(srsran_vec_convert_conj_cs_simd)                                                                                   \
+  X(srsran_vec_convert_fb_simd)                                                                                        \
+  X(srsran_vec_interleave_simd)                                                                                        \
+  X(srsran_vec_interleave_add_simd)                                                                                    \
+  X(srsran_vec_gen_sine_simd)                                                                                          \
+  X(srsran_vec_apply_cfo_simd)                                                                                         \
+  X(srsran_vec_estimate_frequency_simd)                                                                                \
+  X(srsran_vec_gen_clip_env_simd)                                                                                      \
+  X(srsran_vec_max_fi_simd)                                                                                            \
+  X(srsran_vec_max_abs_fi_simd)                                                                                        \
+  X(srsran_vec_max_ci_simd)
+
+#ifdef ENABLE_C16
+#define VECTOR_SIMD_FUNCTIONS_C16(X)                                                                                   \
+  X(srsran_vec_prod_ccc_c16_simd)                                                                                      \
+  X(srsran_vec_dot_prod_ccc_c16i_simd)
+#else /* ENABLE_C16 */
+#define VECTOR_SIMD_FUNCTIONS_C16(X)
+#endif /* ENABLE_C16 */
+
+#endif // SRSRAN_VECTOR_SIMD_ISA_H
+
+#ifdef VECTOR_SIMD_ISA_SUFFIX
+#define VECTOR_SIMD_ISA_CAT(NAME, SUFFIX) NAME##SUFFIX
+#define VECTOR_SIMD_ISA_NAME(NAME, SUFFIX) VECTOR_SIMD_ISA_CAT(NAME, SUFFIX)
+#define VECTOR_SIMD_ISA(NAME) VECTOR_SIMD_ISA_NAME(NAME, VECTOR_SIMD_ISA_SUFFIX)
+
+#define srsran_vec_xor_bbb_simd VECTOR_SIMD_ISA(srsran_vec_xor_bbb_simd)
+#define srsran_vec_sum_sss_simd VECTOR_SIMD_ISA(srsran_vec_sum_sss_simd)
+#define srsran_vec_sub_sss_simd VECTOR_SIMD_ISA(srsran_vec_sub_sss_simd)
+#define srsran_vec_sub_bbb_simd VECTOR_SIMD_ISA(srsran_vec_sub_bbb_simd)
+#define srsran_vec_acc_ff_simd VECTOR_SIMD_ISA(srsran_vec_acc_ff_simd)
+#define srsran_vec_acc_cc_simd VECTOR_SIMD_ISA(srsran_vec_acc_cc_simd)
+#define srsran_vec_add_fff_simd VECTOR_SIMD_ISA(srsran_vec_add_fff_simd)
+#define srsran_vec_sub_fff_simd VECTOR_SIMD_ISA(srsran_vec_sub_fff_simd)
+#define srsran_vec_sc_sum_fff_simd VECTOR_SIMD_ISA(srsran_vec_sc_sum_fff_simd)
+#define srsran_vec_sc_prod_cfc_simd VECTOR_SIMD_ISA(srsran_vec_sc_prod_cfc_simd)
+#define srsran_vec_sc_prod_fcc_simd VECTOR_SIMD_ISA(srsran_vec_sc_prod_fcc_simd)
+#define srsran_vec_sc_prod_fff_simd VECTOR_SIMD_ISA(srsran_vec_sc_prod_fff_simd)
+#define srsran_vec_sc_prod_ccc_simd VECTOR_SIMD_ISA(srsran_vec_sc_prod_ccc_simd)
+#define srsran_vec_sc_prod_ccc_simd2 VECTOR_SIMD_ISA(srsran_vec_sc_prod_ccc_simd2)
+#define srsran_vec_prod_ccc_split_simd VECTOR_SIMD_ISA(srsran_vec_prod_ccc_split_simd)
+#define srsran_vec_prod_sss_simd VECTOR_SIMD_ISA(srsran_vec_prod_sss_simd)
+#define srsran_vec_neg_sss_simd VECTOR_SIMD_ISA(srsran_vec_neg_sss_simd)
+#define srsran_vec_neg_bbb_simd VECTOR_SIMD_ISA(srsran_vec_neg_bbb_simd)
+#define srsran_vec_prod_cfc_simd VECTOR_SIMD_ISA(srsran_vec_prod_cfc_simd)
+#define srsran_vec_prod_fff_simd VECTOR_SIMD_ISA(srsran_vec_prod_fff_simd)
+#define srsran_vec_prod_ccc_simd VECTOR_SIMD_ISA(srsran_vec_prod_ccc_simd)
+#define srsran_vec_prod_conj_ccc_simd VECTOR_SIMD_ISA(srsran_vec_prod_conj_ccc_simd)
+#define srsran_vec_div_ccc_simd VECTOR_SIMD_ISA(srsran_vec_div_ccc_simd)
+#define srsran_vec_div_cfc_simd VECTOR_SIMD_ISA(srsran_vec_div_cfc_simd)
+#define srsran_vec_div_fff_simd VECTOR_SIMD_ISA(srsran_vec_div_fff_simd)
+#define srsran_vec_dot_prod_conj_ccc_simd VECTOR_SIMD_ISA(srsran_vec_dot_prod_conj_ccc_simd)
+#define srsran_vec_dot_prod_ccc_simd VECTOR_SIMD_ISA(srsran_vec_dot_prod_ccc_simd)
+#define srsran_vec_dot_prod_sss_simd VECTOR_SIMD_ISA(srsran_vec_dot_prod_sss_simd)
+#define srsran_vec_abs_cf_simd VECTOR_SIMD_ISA(srsran_vec_abs_cf_simd)
+#define srsran_vec_abs_square_cf_simd VECTOR_SIMD_ISA(srsran_vec_abs_square_cf_simd)
+#define srsran_vec_lut_sss_simd VECTOR_SIMD_ISA(srsran_vec_lut_sss_simd)
+#define srsran_vec_lut_bbb_simd VECTOR_SIMD_ISA(srsran_vec_lut_bbb_simd)
+#define srsran_vec_convert_if_simd VECTOR_SIMD_ISA(srsran_vec_convert_if_simd)
+#define srsran_vec_convert_fi_simd VECTOR_SIMD_ISA(srsran_vec_convert_fi_simd)
+#define srsran_vec_convert_conj_cs_simd VECTOR_SIMD_ISA(srsran_vec_convert_conj_cs_simd)
+#define srsran_vec_convert_fb_simd VECTOR_SIMD_ISA(srsran_vec_convert_fb_simd)
+#define srsran_vec_interleave_simd VECTOR_SIMD_ISA(srsran_vec_interleave_simd)
+#define srsran_vec_interleave_add_simd VECTOR_SIMD_ISA(srsran_vec_interleave_add_simd)
+#define srsran_vec_gen_sine_simd VECTOR_SIMD_ISA(srsran_vec_gen_sine_simd)
+#define srsran_vec_apply_cfo_simd VECTOR_SIMD_ISA(srsran_vec_apply_cfo_simd)
+#define srsran_vec_estimate_frequency_simd VECTOR_SIMD_ISA(srsran_vec_estimate_frequency_simd)
+#define srsran_vec_gen_clip_env_simd VECTOR_SIMD_ISA(srsran_vec_gen_clip_env_simd)
+#define srsran_vec_max_fi_simd VECTOR_SIMD_ISA(srsran_vec_max_fi_simd)
+#define srsran_vec_max_abs_fi_simd VECTOR_SIMD_ISA(srsran_vec_max_abs_fi_simd)
+#define srsran_vec_max_ci_simd VECTOR_SIMD_ISA(srsran_vec_max_ci_simd)
+#define srsran_vec_prod_ccc_c16_simd VECTOR_SIMD_ISA(srsran_vec_prod_ccc_c16_simd)
+#define srsran_vec_dot_prod_ccc_c16i_simd VECTOR_SIMD_ISA(srsran_vec_dot_prod_ccc_c16i_simd)
+#endif /* VECTOR_SIMD_ISA_SUFFIX */
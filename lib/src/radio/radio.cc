@@ -47,6 +47,14 @@ radio::~radio()
   for (srsran_resampler_fft_t& q : decimators) {
     srsran_resampler_fft_free(&q);
   }
+
+  for (srsran_resampler_poly_t& q : tx_resamplers) {
+    srsran_resampler_poly_free(&q);
+  }
+
+  for (srsran_resampler_poly_t& q : rx_resamplers) {
+    srsran_resampler_poly_free(&q);
+  }
 }
 
 int radio::init(const rf_args_t& args, phy_interface_radio* phy_)
@@ -296,24 +304,29 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
   // Extract decimation ratio. As the decimation may take some time to set a new ratio, deactivate the decimation and
   // keep receiving samples to avoid stalling the RX stream
   uint32_t ratio = 1; // No decimation by default
+  bool     poly  = false;
   if (decimator_busy) {
     lock.unlock();
   } else if (decimators[0].ratio > 1) {
     ratio = decimators[0].ratio;
+  } else if (rx_resamplers[0].filter != nullptr) {
+    poly = true;
   }
+  bool decimate = ratio > 1 || poly;
 
   // Calculate number of samples, considering the decimation ratio
-  uint32_t nof_samples = buffer.get_nof_samples() * ratio;
+  uint32_t nof_samples = poly ? srsran_resampler_poly_nof_input(&rx_resamplers[0], buffer.get_nof_samples())
+                              : buffer.get_nof_samples() * ratio;
 
   // Check decimation buffer protection
-  if (ratio > 1 && nof_samples > rx_buffer[0].size()) {
+  if (decimate && nof_samples > rx_buffer[0].size()) {
     // This is a corner case that could happen during sample rate change transitions, as it does not have a negative
     // impact, log it as info.
     fmt::memory_buffer buff;
     fmt::format_to(buff,
                    "Rx number of samples ({}/{}) exceeds buffer size ({})",
                    buffer.get_nof_samples(),
-                   buffer.get_nof_samples() * ratio,
+                   nof_samples,
                    rx_buffer[0].size());
     logger.info("%s", to_c_str(buff));
 
@@ -327,7 +340,7 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
   // If the interpolator have been set, interpolate
   for (uint32_t ch = 0; ch < nof_channels; ch++) {
     // Use rx buffer if decimator is required
-    buffer_rx.set(ch, ratio > 1 ? rx_buffer[ch].data() : buffer.get(ch));
+    buffer_rx.set(ch, decimate ? rx_buffer[ch].data() : buffer.get(ch));
   }
 
   if (not radio_is_streaming) {
@@ -355,6 +368,11 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
         srsran_resampler_fft_run(&decimators[ch], buffer_rx.get(ch), buffer.get(ch), buffer_rx.get_nof_samples());
       }
     }
+  } else if (poly) {
+    // All channels are resampled, even if the output is not used, to keep their states aligned
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      srsran_resampler_poly_run(&rx_resamplers[ch], buffer_rx.get(ch), buffer.get(ch), buffer_rx.get_nof_samples());
+    }
   }
 
   return ret;
@@ -422,24 +440,28 @@ bool radio::tx(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_tim
   bool                         ret = true;
   std::unique_lock<std::mutex> lock(tx_mutex);
   uint32_t                     ratio = interpolators[0].ratio;
+  srsran_resampler_poly_t*     poly  = tx_resamplers[0].filter != nullptr ? &tx_resamplers[0] : nullptr;
 
   // Get number of samples at the low rate
   uint32_t nof_samples = buffer.get_nof_samples();
 
   // Check that number of the interpolated samples does not exceed the buffer size
-  if (ratio > 1 && (size_t)nof_samples * (size_t)ratio > tx_buffer[0].size()) {
+  size_t nof_interpolated =
+      (poly != nullptr) ? srsran_resampler_poly_nof_output(poly, nof_samples) : (size_t)nof_samples * (size_t)ratio;
+  if ((ratio > 1 || poly != nullptr) && nof_interpolated > tx_buffer[0].size()) {
     // This is a corner case that could happen during sample rate change transitions, as it does not have a negative
     // impact, log it as info.
     fmt::memory_buffer buff;
     fmt::format_to(buff,
                    "Tx number of samples ({}/{}) exceeds buffer size ({})\n",
                    buffer.get_nof_samples(),
-                   buffer.get_nof_samples() * ratio,
+                   nof_interpolated,
                    tx_buffer[0].size());
     logger.info("%s", to_c_str(buff));
 
     // Limit number of samples to transmit
-    nof_samples = tx_buffer[0].size() / ratio;
+    nof_samples = (poly != nullptr) ? (uint32_t)((uint64_t)tx_buffer[0].size() * poly->decim / poly->interp)
+                                    : tx_buffer[0].size() / ratio;
   }
 
   // If the interpolator have been set, interpolate
@@ -454,6 +476,18 @@ bool radio::tx(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_tim
 
     // Set buffer size after applying the interpolation
     buffer.set_nof_samples(nof_samples * ratio);
+  } else if (poly != nullptr) {
+    uint32_t nof_resampled = 0;
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      // Perform actual resampling, all the channels produce the same number of samples
+      nof_resampled = srsran_resampler_poly_run(&tx_resamplers[ch], buffer.get(ch), tx_buffer[ch].data(), nof_samples);
+
+      // Set the buffer pointer
+      buffer.set(ch, tx_buffer[ch].data());
+    }
+
+    // Set buffer size after applying the resampling
+    buffer.set_nof_samples(nof_resampled);
   }
 
   for (uint32_t device_idx = 0; device_idx < (uint32_t)rf_devices.size(); device_idx++) {
@@ -746,17 +780,29 @@ void radio::set_rx_srate(const double& srate)
       }
     }
 
-    // Assert ratio is integer
-    srsran_assert(((uint32_t)cur_rx_srate % (uint32_t)srate) == 0,
-                  "The sampling rate ratio is not integer (%.2f MHz / %.2f MHz = %.3f)",
+    // Assert the device rate is not lower
+    srsran_assert(cur_rx_srate >= srate,
+                  "The sampling rate cannot be decimated (%.2f MHz / %.2f MHz = %.3f)",
                   cur_rx_srate / 1e6,
                   srate / 1e6,
                   cur_rx_srate / srate);
 
-    // Update decimators
-    uint32_t ratio = (uint32_t)ceil(cur_rx_srate / srate);
-    for (uint32_t ch = 0; ch < nof_channels; ch++) {
-      srsran_resampler_fft_init(&decimators[ch], SRSRAN_RESAMPLER_MODE_DECIMATE, ratio);
+    if (((uint32_t)cur_rx_srate % (uint32_t)srate) == 0) {
+      // Update decimators
+      uint32_t ratio = (uint32_t)ceil(cur_rx_srate / srate);
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_poly_free(&rx_resamplers[ch]);
+        srsran_resampler_fft_init(&decimators[ch], SRSRAN_RESAMPLER_MODE_DECIMATE, ratio);
+      }
+    } else {
+      // Non-integer ratios use the polyphase resamplers
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_fft_free(&decimators[ch]);
+        if (srsran_resampler_poly_init(&rx_resamplers[ch], (uint32_t)srate, (uint32_t)cur_rx_srate) <
+            SRSRAN_SUCCESS) {
+          logger.error("Error initialising Rx resampler %.2f MHz / %.2f MHz", cur_rx_srate / 1e6, srate / 1e6);
+        }
+      }
     }
 
     decimator_busy = false;
@@ -1002,17 +1048,29 @@ void radio::set_tx_srate(const double& srate)
       }
     }
 
-    // Assert ratio is integer
-    srsran_assert(((uint32_t)cur_tx_srate % (uint32_t)srate) == 0,
-                  "The sampling rate ratio is not integer (%.2f MHz / %.2f MHz = %.3f)",
-                  cur_rx_srate / 1e6,
+    // Assert the device rate is not lower
+    srsran_assert(cur_tx_srate >= srate,
+                  "The sampling rate cannot be interpolated (%.2f MHz / %.2f MHz = %.3f)",
+                  cur_tx_srate / 1e6,
                   srate / 1e6,
-                  cur_rx_srate / srate);
-
-    // Update interpolators
-    uint32_t ratio = (uint32_t)ceil(cur_tx_srate / srate);
-    for (uint32_t ch = 0; ch < nof_channels; ch++) {
-      srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, ratio);
+                  cur_tx_srate / srate);
+
+    if (((uint32_t)cur_tx_srate % (uint32_t)srate) == 0) {
+      // Update interpolators
+      uint32_t ratio = (uint32_t)ceil(cur_tx_srate / srate);
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_poly_free(&tx_resamplers[ch]);
+        srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, ratio);
+      }
+    } else {
+      // Non-integer ratios use the polyphase resamplers
+      for (uint32_t ch = 0; ch < nof_channels; ch++) {
+        srsran_resampler_fft_free(&interpolators[ch]);
+        if (srsran_resampler_poly_init(&tx_resamplers[ch], (uint32_t)cur_tx_srate, (uint32_t)srate) <
+            SRSRAN_SUCCESS) {
+          logger.error("Error initialising Tx resampler %.2f MHz / %.2f MHz", cur_tx_srate / 1e6, srate / 1e6);
+        }
+      }
     }
   } else {
     for (srsran_rf_t& rf_device : rf_devices) {
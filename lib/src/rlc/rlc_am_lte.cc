@@ -1673,8 +1673,13 @@ int rlc_am_lte_rx::get_status_pdu(rlc_status_pdu_t* status, const uint32_t max_p
   // We don't use segment NACKs - just NACK the full PDU
   uint32_t i = vr_r;
   while (RX_MOD_BASE(i) <= RX_MOD_BASE(vr_ms) && status->N_nack < RLC_AM_WINDOW_SIZE) {
-    if (rx_window.has_sn(i) || i == vr_ms) {
-      // only update ACK_SN if this SN has been received, or if we reached the maximum possible SN
+    if (rx_window.has_sn(i)) {
+      // only update ACK_SN if this SN has been received, skipping the whole run of received SNs at once
+      uint32_t run   = rx_window.sn_run_length(i, RX_MOD_BASE(vr_ms) - RX_MOD_BASE(i), true);
+      i              = (i + SRSRAN_MAX(run, 1) - 1) % MOD;
+      status->ack_sn = i;
+    } else if (i == vr_ms) {
+      // or if we reached the maximum possible SN
       status->ack_sn = i;
     } else {
       status->nacks[status->N_nack].nack_sn = i;
@@ -1719,15 +1724,11 @@ int rlc_am_lte_rx::get_status_pdu_length()
   if (not lock.owns_lock()) {
     return 0;
   }
-  rlc_status_pdu_t status = {};
-  status.ack_sn           = vr_ms;
-  uint32_t i              = vr_r;
-  while (RX_MOD_BASE(i) < RX_MOD_BASE(vr_ms) && status.N_nack < RLC_AM_WINDOW_SIZE) {
-    if (not rx_window.has_sn(i)) {
-      status.N_nack++;
-    }
-    i = (i + 1) % MOD;
-  }
+  // Count the missing SNs in [VR(R), VR(MS)) a bitmap word at a time
+  uint32_t         nof_missing = rx_window.count_sn(vr_r, RX_MOD_BASE(vr_ms), false);
+  rlc_status_pdu_t status      = {};
+  status.ack_sn                = vr_ms;
+  status.N_nack                = SRSRAN_MIN(nof_missing, (uint32_t)RLC_AM_WINDOW_SIZE);
   return rlc_am_packed_length(&status);
 }
 
@@ -1734,18 +1734,33 @@ uint32_t rlc_am_nr_rx::get_status_pdu(rlc_am_nr_status_pdu_t* status, uint32_t m
    *   PDU(s) indicated by lower layer:
    */
   RlcDebug("Generating status PDU");
-  for (uint32_t i = st.rx_next; rx_mod_base_nr(i) < rx_mod_base_nr(st.rx_highest_status); i = (i + 1) % mod_nr) {
-    if ((rx_window->has_sn(i) && (*rx_window)[i].fully_received)) {
-      RlcDebug("SDU SN=%d is fully received", i);
-    } else {
-      if (not rx_window->has_sn(i)) {
-        // No segment received, NACK the whole SDU
-        RlcDebug("Adding NACK for full SDU. NACK SN=%d", i);
-        rlc_status_nack_t nack;
-        nack.nack_sn = i;
-        nack.has_so  = false;
-        status->push_nack(nack);
-      } else if (not(*rx_window)[i].fully_received) {
+  uint32_t i         = st.rx_next;
+  uint32_t remaining = rx_mod_base_nr(st.rx_highest_status);
+  while (remaining > 0) {
+    // Skip SDUs that have never been received with a word-wide scan of the window bitmap and NACK them as a range
+    uint32_t nof_missing = rx_window->sn_run_length(i, remaining, false);
+    while (nof_missing > 0) {
+      rlc_status_nack_t nack;
+      nack.nack_sn = i;
+      nack.has_so  = false;
+      if (nof_missing > 1) {
+        nack.has_nack_range = true;
+        nack.nack_range     = std::min(nof_missing, rlc_am_nr_status_pdu_max_nack_range);
+      }
+      uint32_t nof_nacked = nack.has_nack_range ? nack.nack_range : 1;
+      RlcDebug("Adding NACK for %d full SDU(s). NACK SN=%d", nof_nacked, i);
+      status->push_nack(nack);
+      i = (i + nof_nacked) % mod_nr;
+      remaining -= nof_nacked;
+      nof_missing -= nof_nacked;
+    }
+
+    // Walk the SDUs present in the window, NACKing the missing segments of the ones not fully received
+    uint32_t nof_present = rx_window->sn_run_length(i, remaining, true);
+    for (; nof_present > 0; nof_present--, remaining--, i = (i + 1) % mod_nr) {
+      if ((*rx_window)[i].fully_received) {
+        RlcDebug("SDU SN=%d is fully received", i);
+      } else {
         // Some segments were received, but not all.
         // NACK non consecutive missing bytes
         RlcDebug("Adding NACKs for segmented SDU. NACK SN=%d", i);
@@ -49,6 +49,13 @@ bool rlc_am_nr_status_pdu_t::is_continuous_sequence(const rlc_status_nack_t& lef
     return false;
   }
 
+  // Merged range must still fit into the 8 bit NACK range field
+  uint32_t left_range  = left.has_nack_range ? left.nack_range : 1;
+  uint32_t right_range = right.has_nack_range ? right.nack_range : 1;
+  if (left_range + right_range > rlc_am_nr_status_pdu_max_nack_range) {
+    return false;
+  }
+
   // Segments on left side (if present) must reach the end of sdu
   if (left.has_so && left.so_end != rlc_status_nack_t::so_end_of_sdu) {
     return false;
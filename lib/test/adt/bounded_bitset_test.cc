@@ -278,6 +278,67 @@ void test_bitset_find()
   }
 }
 
+template <bool reversed>
+void test_bitset_range_ops()
+{
+  // Ranges crossing word boundaries
+  srsran::bounded_bitset<275, reversed> bitset(273);
+  bitset.fill(60, 130);
+  TESTASSERT(bitset.count() == 70);
+  TESTASSERT(bitset.count(0, 60) == 0);
+  TESTASSERT(bitset.count(60, 130) == 70);
+  TESTASSERT(bitset.count(50, 70) == 10);
+  TESTASSERT(bitset.count(129, 273) == 1);
+  TESTASSERT(not bitset.test(59) and bitset.test(60) and bitset.test(129) and not bitset.test(130));
+  TESTASSERT(not bitset.any(0, 60));
+  TESTASSERT(bitset.any(0, 61));
+  TESTASSERT(bitset.any(129, 273));
+  TESTASSERT(not bitset.any(130, 273));
+  TESTASSERT(not bitset.any(100, 100));
+
+  bitset.fill(64, 128, false);
+  TESTASSERT(bitset.count() == 6);
+  TESTASSERT(bitset.count(60, 64) == 4 and bitset.count(128, 130) == 2);
+  TESTASSERT(not bitset.any(64, 128));
+  bitset.fill(272, 273);
+  TESTASSERT(bitset.test(272) and bitset.count() == 7);
+
+  // 0-runs: [0, 60), [64, 128), [130, 272)
+  srsran::interval<uint32_t> run = bitset.find_lowest_run(0, bitset.size(), 20);
+  TESTASSERT(run.start() == 0 and run.stop() == 20);
+  run = bitset.find_lowest_run(0, bitset.size(), 64);
+  TESTASSERT(run.start() == 64 and run.stop() == 128);
+  run = bitset.find_lowest_run(0, bitset.size(), 100);
+  TESTASSERT(run.start() == 130 and run.stop() == 230);
+  // No run of the requested length. The longest run is returned
+  run = bitset.find_lowest_run(0, bitset.size(), 200);
+  TESTASSERT(run.start() == 130 and run.stop() == 272);
+  run = bitset.find_lowest_run(10, 62, 200);
+  TESTASSERT(run.start() == 10 and run.stop() == 60);
+  // 1-runs
+  run = bitset.find_lowest_run(0, bitset.size(), 3, true);
+  TESTASSERT(run.start() == 60 and run.stop() == 63);
+  run = bitset.find_lowest_run(0, 61, 3, true);
+  TESTASSERT(run.start() == 60 and run.stop() == 61);
+  TESTASSERT(bitset.find_lowest_run(130, 272, 3, true).empty());
+
+  // Compare against bit-by-bit computation
+  srsran::bounded_bitset<275, reversed> bitset2(bitset.size());
+  for (size_t i = 0; i < bitset2.size(); i += 3) {
+    bitset2.fill(i, std::min(i + i % 7, bitset2.size()));
+  }
+  for (size_t start = 0; start < bitset2.size(); start += 11) {
+    for (size_t stop = start; stop <= bitset2.size(); stop += 13) {
+      size_t nof_ones = 0;
+      for (size_t i = start; i < stop; ++i) {
+        nof_ones += bitset2.test(i) ? 1 : 0;
+      }
+      TESTASSERT(bitset2.count(start, stop) == nof_ones);
+      TESTASSERT(bitset2.any(start, stop) == (nof_ones > 0));
+    }
+  }
+}
+
 int main()
 {
   test_bit_operations();
@@ -289,6 +350,8 @@ int main()
   TESTASSERT(test_bitset_resize() == SRSRAN_SUCCESS);
   test_bitset_find<false>();
   test_bitset_find<true>();
+  test_bitset_range_ops<false>();
+  test_bitset_range_ops<true>();
   printf("Success\n");
   return 0;
 }
@@ -0,0 +1,284 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/cpu_affinity.h"
+#include "srsran/support/srsran_test.h"
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <sched.h>
+#include <thread>
+
+using namespace srsran;
+
+static const std::string sysfs_root = "/tmp/cpu_affinity_test_sysfs";
+
+static void write_file(const std::string& path, const std::string& content)
+{
+  std::string dir = path.substr(0, path.rfind('/'));
+  TESTASSERT(system(("mkdir -p " + dir).c_str()) == 0);
+  std::ofstream f(path);
+  f << content << "\n";
+}
+
+/// Fake sysfs tree of two sockets with four cores and two threads per core, numbered as Linux does on x86: the first
+/// thread of every core comes first and the SMT siblings afterwards.
+static void create_sysfs(const std::string& isolated)
+{
+  TESTASSERT(system(("rm -rf " + sysfs_root).c_str()) == 0);
+
+  write_file(sysfs_root + "/cpu/online", "0-15");
+  write_file(sysfs_root + "/cpu/isolated", isolated);
+  for (uint32_t cpu = 0; cpu < 16; cpu++) {
+    std::string topology_dir = sysfs_root + "/cpu/cpu" + std::to_string(cpu) + "/topology/";
+    write_file(topology_dir + "physical_package_id", std::to_string((cpu % 8) / 4));
+    write_file(topology_dir + "core_id", std::to_string(cpu % 4));
+  }
+  write_file(sysfs_root + "/node/node0/cpulist", "0-3,8-11");
+  write_file(sysfs_root + "/node/node1/cpulist", "4-7,12-15");
+}
+
+static std::string class_cpus(cpu_thread_class c)
+{
+  return cpu_list_to_string(cpu_affinity_policy::get_instance()->get_cpus(c));
+}
+
+static std::string housekeeping_cpus()
+{
+  return cpu_list_to_string(cpu_affinity_policy::get_instance()->get_housekeeping_cpus());
+}
+
+void test_cpu_list()
+{
+  std::vector<uint32_t> cpus;
+
+  TESTASSERT(parse_cpu_list("0-3,8,10-11\n", cpus));
+  TESTASSERT(cpus == std::vector<uint32_t>({0, 1, 2, 3, 8, 10, 11}));
+  TESTASSERT(cpu_list_to_string(cpus) == "0-3,8,10-11");
+
+  TESTASSERT(parse_cpu_list("", cpus));
+  TESTASSERT(cpus.empty());
+  TESTASSERT(cpu_list_to_string(cpus).empty());
+
+  TESTASSERT(parse_cpu_list("5,1,1", cpus));
+  TESTASSERT(cpu_list_to_string(cpus) == "1,5");
+
+  TESTASSERT(not parse_cpu_list("3-1", cpus));
+  TESTASSERT(not parse_cpu_list("a", cpus));
+  TESTASSERT(not parse_cpu_list("1-", cpus));
+  TESTASSERT(not parse_cpu_list("1;2", cpus));
+
+  // Worker masks of the thread pool
+  TESTASSERT(get_cpu_mask_cpus(0x0d) == std::vector<uint32_t>({0, 2, 3}));
+  TESTASSERT(get_cpu_mask_cpus(255).empty());
+  TESTASSERT(get_cpu_mask_cpus(-1).empty());
+}
+
+void test_topology()
+{
+  create_sysfs("4-7,12-15");
+
+  cpu_topology topology;
+  TESTASSERT(topology.detect(sysfs_root));
+  TESTASSERT(topology.cpus.size() == 16);
+  TESTASSERT(topology.find(9)->package_id == 0);
+  TESTASSERT(topology.find(9)->core_id == 1);
+  TESTASSERT(topology.find(9)->node_id == 0);
+  TESTASSERT(topology.find(13)->package_id == 1);
+  TESTASSERT(topology.find(13)->node_id == 1);
+  TESTASSERT(topology.find(16) == nullptr);
+  TESTASSERT(cpu_list_to_string(topology.isolated) == "4-7,12-15");
+
+  // TEST: a missing tree is an error
+  TESTASSERT(not topology.detect(sysfs_root + "/missing"));
+}
+
+void test_auto()
+{
+  cpu_affinity_policy* policy = cpu_affinity_policy::get_instance();
+  cpu_affinity_args_t  args;
+  cpu_topology         topology;
+  args.mode = "auto";
+
+  // TEST: without isolated CPUs the first core is left to the OS and the SMT siblings are not used
+  create_sysfs("");
+  TESTASSERT(topology.detect(sysfs_root));
+  TESTASSERT(policy->init(args, topology));
+  TESTASSERT(policy->is_enabled());
+  TESTASSERT(class_cpus(cpu_thread_class::radio) == "1");
+  TESTASSERT(class_cpus(cpu_thread_class::phy) == "2");
+  TESTASSERT(class_cpus(cpu_thread_class::stack) == "3");
+  TESTASSERT(housekeeping_cpus() == "0,4-8,12-15");
+
+  // TEST: the NUMA node can be selected
+  args.numa_node = 1;
+  TESTASSERT(policy->init(args, topology));
+  TESTASSERT(class_cpus(cpu_thread_class::radio) == "5");
+  TESTASSERT(class_cpus(cpu_thread_class::phy) == "6");
+  TESTASSERT(class_cpus(cpu_thread_class::stack) == "7");
+  TESTASSERT(housekeeping_cpus() == "0-4,8-12");
+
+  // TEST: the isolated CPUs select the node and are all used
+  args.numa_node = -1;
+  create_sysfs("4-7,12-15");
+  TESTASSERT(topology.detect(sysfs_root));
+  TESTASSERT(policy->init(args, topology));
+  TESTASSERT(class_cpus(cpu_thread_class::radio) == "4");
+  TESTASSERT(class_cpus(cpu_thread_class::phy) == "5-6");
+  TESTASSERT(class_cpus(cpu_thread_class::stack) == "7");
+  TESTASSERT(housekeeping_cpus() == "0-3,8-11");
+
+  // TEST: a node without CPUs is an error
+  args.numa_node = 2;
+  TESTASSERT(not policy->init(args, topology));
+  TESTASSERT(not policy->is_enabled());
+
+  // TEST: a single core is not enough, the policy is left disabled
+  args.numa_node = -1;
+  topology.cpus.resize(1);
+  topology.isolated.clear();
+  TESTASSERT(policy->init(args, topology));
+  TESTASSERT(not policy->is_enabled());
+
+  TESTASSERT(system(("rm -rf " + sysfs_root).c_str()) == 0);
+}
+
+void test_manual()
+{
+  cpu_affinity_policy* policy = cpu_affinity_policy::get_instance();
+  cpu_affinity_args_t  args;
+  cpu_topology         topology;
+
+  create_sysfs("");
+  TESTASSERT(topology.detect(sysfs_root));
+  TESTASSERT(system(("rm -rf " + sysfs_root).c_str()) == 0);
+
+  args.mode       = "manual";
+  args.radio_cpus = "2";
+  args.phy_cpus   = "3-5";
+  args.stack_cpus = "6";
+  TESTASSERT(policy->init(args, topology));
+  TESTASSERT(class_cpus(cpu_thread_class::phy) == "3-5");
+  TESTASSERT(housekeeping_cpus() == "0-1,7-15");
+
+  args.housekeeping_cpus = "0";
+  TESTASSERT(policy->init(args, topology));
+  TESTASSERT(housekeeping_cpus() == "0");
+
+  // TEST: invalid lists and CPUs which are not online
+  args.phy_cpus = "";
+  TESTASSERT(not policy->init(args, topology));
+  args.phy_cpus = "3-x";
+  TESTASSERT(not policy->init(args, topology));
+  args.phy_cpus = "3,16";
+  TESTASSERT(not policy->init(args, topology));
+
+  // TEST: invalid mode
+  args.mode = "fast";
+  TESTASSERT(not policy->init(args, topology));
+
+  // TEST: disabled
+  args.mode = "none";
+  TESTASSERT(policy->init(args, topology));
+  TESTASSERT(not policy->is_enabled());
+  TESTASSERT(policy->to_string() == "disabled");
+
+  // TEST: tasks run in the calling thread while the policy is disabled
+  std::thread::id task_thread;
+  TESTASSERT(policy->run_on_next_cpu(cpu_thread_class::phy, [&task_thread]() {
+    task_thread = std::this_thread::get_id();
+  }));
+  TESTASSERT(task_thread == std::this_thread::get_id());
+}
+
+class affinity_thread : public thread
+{
+public:
+  affinity_thread() : thread("AFFINITY_TEST") {}
+  std::atomic<bool> running = {true};
+  cpu_set_t         cpuset  = {};
+
+protected:
+  void run_thread() override
+  {
+    while (running) {
+      usleep(1000);
+    }
+    pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+  }
+};
+
+void test_pin()
+{
+  // Use any CPU this process may run on
+  cpu_set_t allowed;
+  TESTASSERT(sched_getaffinity(0, sizeof(cpu_set_t), &allowed) == 0);
+  uint32_t cpu = 0;
+  while (not CPU_ISSET(cpu, &allowed)) {
+    cpu++;
+  }
+
+  cpu_topology topology;
+  topology.cpus.push_back({cpu, 0, 0, 0});
+
+  cpu_affinity_policy* policy = cpu_affinity_policy::get_instance();
+  cpu_affinity_args_t  args;
+  args.mode       = "manual";
+  args.radio_cpus = std::to_string(cpu);
+  args.phy_cpus   = std::to_string(cpu);
+  args.stack_cpus = std::to_string(cpu);
+  TESTASSERT(policy->init(args, topology));
+
+  // Tasks run in the CPU the next thread of the class is pinned to
+  std::thread::id task_thread;
+  int             task_cpu = -1;
+  TESTASSERT(policy->run_on_next_cpu(cpu_thread_class::phy, [&task_thread, &task_cpu]() {
+    task_thread = std::this_thread::get_id();
+    task_cpu    = sched_getcpu();
+  }));
+  TESTASSERT(task_thread != std::this_thread::get_id());
+  TESTASSERT(task_cpu == (int)cpu);
+
+  affinity_thread t;
+  TESTASSERT(t.start());
+  TESTASSERT(policy->pin(t, cpu_thread_class::phy));
+  t.running = false;
+  t.wait_thread_finish();
+  TESTASSERT(CPU_COUNT(&t.cpuset) == 1);
+  TESTASSERT(CPU_ISSET(cpu, &t.cpuset));
+
+  args.mode = "none";
+  TESTASSERT(policy->init(args, topology));
+}
+
+int main()
+{
+  srslog::init();
+
+  test_cpu_list();
+  test_topology();
+  test_auto();
+  test_manual();
+  test_pin();
+
+  printf("Success\n");
+  return 0;
+}
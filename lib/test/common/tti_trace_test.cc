@@ -0,0 +1,139 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/tti_trace.h"
+#include "srsran/support/srsran_test.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+using namespace srsran;
+
+void test_ring()
+{
+  tti_trace_ring   ring(5);
+  tti_trace_record record = {};
+
+  // TEST: the capacity is rounded up to a power of two
+  for (uint32_t i = 0; i < 8; i++) {
+    record.tti = i;
+    TESTASSERT(ring.push(record));
+  }
+  TESTASSERT(not ring.push(record));
+  TESTASSERT(ring.get_nof_dropped() == 1);
+
+  // TEST: records are popped in order
+  for (uint32_t i = 0; i < 8; i++) {
+    TESTASSERT(ring.pop(record));
+    TESTASSERT(record.tti == i);
+  }
+  TESTASSERT(not ring.pop(record));
+
+  // TEST: concurrent producer and consumer
+  const uint32_t nof_records = 100000;
+  std::thread    producer([&ring]() {
+    tti_trace_record r = {};
+    for (uint32_t i = 0; i < nof_records; i++) {
+      r.tti = i;
+      while (not ring.push(r)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  for (uint32_t i = 0; i < nof_records; i++) {
+    while (not ring.pop(record)) {
+      std::this_thread::yield();
+    }
+    TESTASSERT(record.tti == i);
+  }
+  producer.join();
+}
+
+void test_trace_file()
+{
+  const char*              filename    = "/tmp/tti_trace_test.bin";
+  std::vector<std::string> stage_names = {"stage_a", "stage_b", "stage_c"};
+  const uint32_t           nof_workers = 2;
+  const uint32_t           nof_ttis    = 50;
+
+  {
+    // Every ring can hold all the records, so none is dropped however late the export thread runs
+    tti_trace trace;
+    TESTASSERT(trace.init(filename, stage_names, nof_workers, nof_ttis, 1));
+
+    // TEST: a tracer out of range does nothing
+    tti_tracer& disabled = trace.get_tracer(nof_workers);
+    disabled.begin(0);
+    disabled.stage(0);
+    disabled.end();
+
+    for (uint32_t tti = 0; tti < nof_ttis; tti++) {
+      tti_tracer& tracer = trace.get_tracer(tti % nof_workers);
+      tracer.begin(tti);
+      for (uint32_t s = 0; s < stage_names.size(); s++) {
+        tracer.stage(s);
+      }
+      tracer.end();
+    }
+    trace.stop();
+    TESTASSERT(trace.get_nof_dropped() == 0);
+  }
+
+  // TEST: the file contains the header and all the records
+  FILE* f = fopen(filename, "rb");
+  TESTASSERT(f != nullptr);
+
+  tti_trace_file_header header = {};
+  TESTASSERT(fread(&header, sizeof(header), 1, f) == 1);
+  TESTASSERT(memcmp(header.magic, tti_trace_file_magic, sizeof(header.magic)) == 0);
+  TESTASSERT(header.version == tti_trace_file_version);
+  TESTASSERT(header.nof_stages == stage_names.size());
+  for (uint32_t s = 0; s < stage_names.size(); s++) {
+    TESTASSERT(stage_names[s] == header.stage_names[s]);
+  }
+
+  std::vector<bool> found(nof_ttis, false);
+  tti_trace_record  record;
+  uint32_t          count = 0;
+  while (fread(&record, sizeof(record), 1, f) == 1) {
+    TESTASSERT(record.tti < nof_ttis);
+    TESTASSERT(record.worker_id == record.tti % nof_workers);
+    TESTASSERT(record.start_ns > 0);
+    found[record.tti] = true;
+    count++;
+  }
+  fclose(f);
+  remove(filename);
+
+  TESTASSERT(count == nof_ttis);
+  TESTASSERT(std::all_of(found.begin(), found.end(), [](bool b) { return b; }));
+}
+
+int main()
+{
+  srslog::init();
+
+  test_ring();
+  test_trace_file();
+
+  printf("Success\n");
+  return 0;
+}
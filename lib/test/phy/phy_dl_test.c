@@ -45,6 +45,7 @@ static uint32_t mcs                     = 20;
 static int      cross_carrier_indicator = -1;
 static bool     enable_256qam           = false;
 static float    snr_db                  = NAN; // SNR in dB
+static bool     pdcch_early_abort       = false;
 
 void usage(char* prog)
 {
@@ -66,6 +67,7 @@ void usage(char* prog)
   }
   printf("\t-v [set srsran_verbose to debug, default none]\n");
   printf("\t-q Enable/Disable 256QAM modulation (default %s)\n", enable_256qam ? "enabled" : "disabled");
+  printf("\t-A Enable/Disable PDCCH early abort (default %s)\n", pdcch_early_abort ? "enabled" : "disabled");
 }
 
 void parse_extensive_param(char* param, char* arg)
@@ -96,7 +98,7 @@ void parse_args(int argc, char** argv)
     nof_rx_ant     = 2;
   }
 
-  while ((opt = getopt(argc, argv, "cfapndvqstmES")) != -1) {
+  while ((opt = getopt(argc, argv, "cfapndvqstmESA")) != -1) {
     switch (opt) {
       case 't':
         transmission_mode = (uint32_t)strtol(argv[optind], NULL, 10) - 1;
@@ -142,6 +144,9 @@ void parse_args(int argc, char** argv)
       case 'q':
         enable_256qam = (enable_256qam) ? false : true;
         break;
+      case 'A':
+        pdcch_early_abort = !pdcch_early_abort;
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -427,6 +432,7 @@ int main(int argc, char** argv)
     ERROR("Error setting UE downlink cell");
     goto quit;
   }
+  ue_dl->dci_early_abort = pdcch_early_abort;
 
   /*
    * Create PDCCH Allocations
@@ -3249,6 +3249,102 @@ bool status_pdu_test()
   return SRSRAN_SUCCESS;
 }
 
+// This test checks the status PDU of a receive window with runs of received and missing PDUs that cross the
+// boundaries of the bitmap words and the SN wraparound. The NACK list must contain exactly the missing SNs and the
+// estimated status PDU length must match the length of the generated one.
+bool status_pdu_runs_test()
+{
+  rlc_am_tester         tester(true, nullptr);
+  srsran::timer_handler timers(8);
+
+  rlc_am rlc1(srsran_rat_t::lte, srslog::fetch_basic_logger("RLC_AM_1"), 1, &tester, &tester, &timers);
+  rlc_am rlc2(srsran_rat_t::lte, srslog::fetch_basic_logger("RLC_AM_2"), 1, &tester, &tester, &timers);
+
+  if (not rlc1.configure(rlc_config_t::default_rlc_am_config())) {
+    return -1;
+  }
+
+  if (not rlc2.configure(rlc_config_t::default_rlc_am_config())) {
+    return -1;
+  }
+
+  rlc_am_lte_rx* rx2 = dynamic_cast<rlc_am_lte_rx*>(rlc2.get_rx());
+  TESTASSERT(rx2 != nullptr);
+
+  // Transmits a PDU from RLC1 and passes it to RLC2 unless it is lost
+  auto tx_pdu = [&rlc1, &rlc2](bool lost) {
+    unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+    TESTASSERT(sdu != nullptr);
+    sdu->N_bytes = 1;
+    sdu->msg[0]  = 0;
+    rlc1.write_sdu(std::move(sdu));
+
+    byte_buffer_t pdu;
+    pdu.N_bytes = rlc1.read_pdu(pdu.msg, 3); // 2 byte header + 1 byte payload
+    TESTASSERT(pdu.N_bytes == 3);
+    if (not lost) {
+      rlc2.write_pdu(pdu.msg, pdu.N_bytes);
+    }
+  };
+
+  // Advance the RX window of RLC2 to VR(R)=900, ACK'ing RLC1 on the way to keep its TX window open
+  const uint32_t start_sn = 900;
+  for (uint32_t sn = 0; sn < start_sn; ++sn) {
+    tx_pdu(false);
+    if ((sn + 1) % (RLC_AM_WINDOW_SIZE / 2) == 0 || sn + 1 == start_sn) {
+      rlc_status_pdu_t status = {};
+      status.ack_sn           = sn + 1;
+      byte_buffer_t status_buf;
+      rlc_am_write_status_pdu(&status, &status_buf);
+      rlc1.write_pdu(status_buf.msg, status_buf.N_bytes);
+    }
+  }
+
+  // Lose a few runs of PDUs. The run of received PDUs [110, 150) contains the wraparound of the SN at offset 124.
+  const uint32_t        nof_pdus = 300;
+  std::vector<uint32_t> lost_sns;
+  for (uint32_t i = 0; i < nof_pdus; ++i) {
+    bool lost = i == 1 || i == 2 || (i >= 70 && i < 110) || (i >= 150 && i < 200) || i == 250;
+    if (lost) {
+      lost_sns.push_back((start_sn + i) % 1024);
+    }
+    tx_pdu(lost);
+  }
+
+  // Step timers until reordering timeout expires
+  for (int cnt = 0; cnt < 100; cnt++) {
+    timers.step_all();
+  }
+
+  int              expected_len = rx2->get_status_pdu_length();
+  rlc_status_pdu_t status       = {};
+  int              len          = rx2->get_status_pdu(&status, 1000);
+  TESTASSERT(len > 0);
+  TESTASSERT(expected_len == len);
+
+  TESTASSERT(status.ack_sn == (start_sn + nof_pdus) % 1024);
+  TESTASSERT(status.N_nack == lost_sns.size());
+  for (uint32_t i = 0; i < status.N_nack; ++i) {
+    TESTASSERT(status.nacks[i].nack_sn == lost_sns[i]);
+    TESTASSERT(not status.nacks[i].has_so);
+  }
+  TESTASSERT(rlc_am_is_valid_status_pdu(status));
+
+  // The packed PDU carries the same status
+  byte_buffer_t status_buf;
+  rlc_am_write_status_pdu(&status, &status_buf);
+  TESTASSERT(status_buf.N_bytes == (uint32_t)len);
+  rlc_status_pdu_t status_check = {};
+  rlc_am_read_status_pdu(status_buf.msg, status_buf.N_bytes, &status_check);
+  TESTASSERT(status_check.ack_sn == status.ack_sn);
+  TESTASSERT(status_check.N_nack == status.N_nack);
+  for (uint32_t i = 0; i < status_check.N_nack; ++i) {
+    TESTASSERT(status_check.nacks[i] == status.nacks[i]);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 // This test checks the correct handling of a sending RLC entity when an incorrect status PDU is injected.
 // In this test, the receiver requests the retransmission of a SN that he has acknowledeged before.
 // The incidence is reported to the upper layers.
@@ -4272,6 +4368,11 @@ int main(int argc, char** argv)
     exit(-1);
   };
 
+  if (status_pdu_runs_test()) {
+    printf("status_pdu_runs_test failed\n");
+    exit(-1);
+  };
+
   if (incorrect_status_pdu_test()) {
     printf("incorrect_status_pdu_test failed\n");
     exit(-1);
@@ -0,0 +1,126 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rlc_test_common.h"
+#include "srsran/common/test_common.h"
+#include "srsran/rlc/rlc_am_nr.h"
+#include <chrono>
+#include <random>
+#include <set>
+
+using namespace srsue;
+using namespace srsran;
+
+/*
+ * Fills the RX window of an NR AM entity while dropping PDUs with the given loss probability, and then measures the
+ * time it takes to generate the resulting status PDU. The NACKed SNs are checked against the set of dropped SNs.
+ */
+int status_pdu_heavy_loss_benchmark(rlc_am_nr_sn_size_t sn_size, float loss_prob, uint32_t nof_repetitions)
+{
+  rlc_am_tester tester(false, nullptr);
+  timer_handler timers(8);
+
+  rlc_am rlc1(srsran_rat_t::nr, srslog::fetch_basic_logger("RLC_AM_1"), 1, &tester, &tester, &timers);
+  rlc_am rlc2(srsran_rat_t::nr, srslog::fetch_basic_logger("RLC_AM_2"), 1, &tester, &tester, &timers);
+
+  rlc_am_nr_rx* rx2 = dynamic_cast<rlc_am_nr_rx*>(rlc2.get_rx());
+
+  auto cfg               = rlc_config_t::default_rlc_am_nr_config(to_number(sn_size));
+  cfg.am_nr.t_poll_retx  = -1;
+  cfg.am_nr.poll_pdu     = -1;
+  cfg.am_nr.poll_byte    = -1;
+  cfg.am_nr.t_reassembly = 5;
+  TESTASSERT(rlc1.configure(cfg));
+  TESTASSERT(rlc2.configure(cfg));
+
+  // Fill the window, dropping PDUs randomly. The last PDU is always delivered to span the whole window.
+  std::mt19937                          rgen(1234);
+  std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+  std::set<uint32_t>                    lost_sns;
+  uint32_t                              window_size = am_window_size(sn_size);
+  for (uint32_t sn = 0; sn < window_size; ++sn) {
+    unique_byte_buffer_t sdu_buf = srsran::make_byte_buffer();
+    sdu_buf->msg[0]              = sn;
+    sdu_buf->N_bytes             = 3;
+    sdu_buf->md.pdcp_sn          = sn;
+    rlc1.write_sdu(std::move(sdu_buf));
+
+    unique_byte_buffer_t pdu_buf = srsran::make_byte_buffer();
+    pdu_buf->N_bytes             = rlc1.read_pdu(pdu_buf->msg, 100);
+    if (sn + 1 < window_size and dist(rgen) < loss_prob) {
+      lost_sns.insert(sn);
+      continue;
+    }
+    rlc2.write_pdu(pdu_buf->msg, pdu_buf->N_bytes);
+  }
+
+  // Let t-Reassembly expire, so that RX_Highest_Status covers the whole window
+  for (int cnt = 0; cnt < 10; cnt++) {
+    timers.step_all();
+  }
+
+  // Check the NACKed SNs match the dropped ones
+  rlc_am_nr_status_pdu_t status(sn_size);
+  rx2->get_status_pdu(&status, UINT32_MAX);
+  std::set<uint32_t> nacked_sns;
+  for (const rlc_status_nack_t& nack : status.nacks) {
+    TESTASSERT(not nack.has_so);
+    uint32_t range = nack.has_nack_range ? nack.nack_range : 1;
+    for (uint32_t sn = nack.nack_sn; sn < nack.nack_sn + range; ++sn) {
+      nacked_sns.insert(sn);
+    }
+  }
+  TESTASSERT(nacked_sns == lost_sns);
+  TESTASSERT_EQ(window_size, status.ack_sn);
+
+  // Measure status PDU generation
+  auto tp_start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < nof_repetitions; ++i) {
+    rx2->get_status_pdu(&status, UINT32_MAX);
+  }
+  auto     tp_end = std::chrono::steady_clock::now();
+  uint64_t nsecs  = std::chrono::duration_cast<std::chrono::nanoseconds>(tp_end - tp_start).count();
+
+  fmt::print("SN size={} bits, window={}, loss={:.0f}%: {} NACKs ({} lost SDUs), packed_size={} B, "
+             "{:.2f} usec/status PDU\n",
+             to_number(sn_size),
+             window_size,
+             loss_prob * 100,
+             status.nacks.size(),
+             lost_sns.size(),
+             status.packed_size,
+             nsecs / (1000.0 * nof_repetitions));
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::fetch_basic_logger("RLC_AM_1", false).set_level(srslog::basic_levels::error);
+  srslog::fetch_basic_logger("RLC_AM_2", false).set_level(srslog::basic_levels::error);
+  srslog::init();
+
+  TESTASSERT(status_pdu_heavy_loss_benchmark(rlc_am_nr_sn_size_t::size12bits, 0.1, 1000) == SRSRAN_SUCCESS);
+  TESTASSERT(status_pdu_heavy_loss_benchmark(rlc_am_nr_sn_size_t::size12bits, 0.5, 1000) == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
@@ -901,6 +901,87 @@ int lost_pdus_trimmed_nack_test(rlc_am_nr_sn_size_t sn_size)
   return SRSRAN_SUCCESS;
 }
 
+/*
+ * Test that a run of lost SDUs longer than the largest NACK range is split into several NACK ranges.
+ */
+int lost_pdus_long_nack_range_test(rlc_am_nr_sn_size_t sn_size)
+{
+  rlc_am_tester tester(true, nullptr);
+  timer_handler timers(8);
+
+  auto&               test_logger = srslog::fetch_basic_logger("TESTER  ");
+  rlc_am              rlc1(srsran_rat_t::nr, srslog::fetch_basic_logger("RLC_AM_1"), 1, &tester, &tester, &timers);
+  rlc_am              rlc2(srsran_rat_t::nr, srslog::fetch_basic_logger("RLC_AM_2"), 1, &tester, &tester, &timers);
+  test_delimit_logger delimiter("lost PDUs with long NACK range ({} bit SN)", to_number(sn_size));
+
+  rlc_am_nr_tx* tx1 = dynamic_cast<rlc_am_nr_tx*>(rlc1.get_tx());
+
+  if (not rlc1.configure(rlc_config_t::default_rlc_am_nr_config(to_number(sn_size)))) {
+    return -1;
+  }
+  if (not rlc2.configure(rlc_config_t::default_rlc_am_nr_config(to_number(sn_size)))) {
+    return -1;
+  }
+
+  // SN=0 is received, SN=1..600 are lost, SN=601 and SN=602 are received, SN=603 is lost and SN=604 is received
+  constexpr uint32_t nof_pdus     = 605;
+  constexpr uint32_t lost_run     = 600;
+  constexpr uint32_t payload_size = 1;
+  uint32_t           header_size  = sn_size == rlc_am_nr_sn_size_t::size12bits ? 2 : 3;
+  for (uint32_t sn = 0; sn < nof_pdus; ++sn) {
+    unique_byte_buffer_t sdu_buf = srsran::make_byte_buffer();
+    sdu_buf->msg[0]              = sn;           // Write the index into the buffer
+    sdu_buf->N_bytes             = payload_size; // Give each buffer a size of 1 byte
+    sdu_buf->md.pdcp_sn          = sn;           // PDCP SN for notifications
+    rlc1.write_sdu(std::move(sdu_buf));
+
+    unique_byte_buffer_t pdu_buf = srsran::make_byte_buffer();
+    pdu_buf->N_bytes             = rlc1.read_pdu(pdu_buf->msg, header_size + payload_size);
+    TESTASSERT_EQ(header_size + payload_size, pdu_buf->N_bytes);
+
+    bool lost = (sn >= 1 && sn <= lost_run) || sn == 603;
+    if (not lost) {
+      rlc2.write_pdu(pdu_buf->msg, pdu_buf->N_bytes);
+    }
+  }
+
+  // Step timers until t-reassembly expires twice, the first expiry restarts it for SN=603
+  for (int cnt = 0; cnt < 2 * 35; cnt++) {
+    timers.step_all();
+  }
+
+  {
+    // Read status PDU from RLC2
+    byte_buffer_t status_buf;
+    status_buf.N_bytes = rlc2.read_pdu(status_buf.msg, 1000);
+    TESTASSERT(status_buf.N_bytes != 0);
+
+    rlc_am_nr_status_pdu_t status_check(sn_size);
+    rlc_am_nr_read_status_pdu(&status_buf, sn_size, &status_check);
+    TESTASSERT_EQ(nof_pdus, status_check.ack_sn);
+
+    // The lost run is NACK'ed with the largest ranges, the single lost SDU after the received run without a range
+    TESTASSERT_EQ(4, status_check.nacks.size());
+    TESTASSERT_EQ(1, status_check.nacks[0].nack_sn);
+    TESTASSERT_EQ(true, status_check.nacks[0].has_nack_range);
+    TESTASSERT_EQ(rlc_am_nr_status_pdu_max_nack_range, status_check.nacks[0].nack_range);
+    TESTASSERT_EQ(1 + rlc_am_nr_status_pdu_max_nack_range, status_check.nacks[1].nack_sn);
+    TESTASSERT_EQ(true, status_check.nacks[1].has_nack_range);
+    TESTASSERT_EQ(rlc_am_nr_status_pdu_max_nack_range, status_check.nacks[1].nack_range);
+    TESTASSERT_EQ(1 + 2 * rlc_am_nr_status_pdu_max_nack_range, status_check.nacks[2].nack_sn);
+    TESTASSERT_EQ(true, status_check.nacks[2].has_nack_range);
+    TESTASSERT_EQ(lost_run - 2 * rlc_am_nr_status_pdu_max_nack_range, status_check.nacks[2].nack_range);
+    TESTASSERT_EQ(603, status_check.nacks[3].nack_sn);
+    TESTASSERT_EQ(false, status_check.nacks[3].has_nack_range);
+    TESTASSERT_EQ(false, status_check.nacks[3].has_so);
+
+    // Write status PDU to RLC1 and check that every lost SDU is retransmitted
+    rlc1.write_pdu(status_buf.msg, status_buf.N_bytes);
+    TESTASSERT_EQ(lost_run + 1, tx1->get_retx_queue_size());
+  }
+  return SRSRAN_SUCCESS;
+}
+
 /*
  * Test if retx queue is cleared of SDUs that are ACK'ed by a late/delayed ACK.
  */
@@ -3468,6 +3549,7 @@ int main()
     TESTASSERT(lost_pdu_test(sn_size) == SRSRAN_SUCCESS);
     TESTASSERT(lost_pdu_duplicated_nack_test(sn_size) == SRSRAN_SUCCESS);
     TESTASSERT(lost_pdus_trimmed_nack_test(sn_size) == SRSRAN_SUCCESS);
+    TESTASSERT(lost_pdus_long_nack_range_test(sn_size) == SRSRAN_SUCCESS);
     TESTASSERT(clean_retx_queue_of_acked_sdus_test(sn_size) == SRSRAN_SUCCESS);
     TESTASSERT(basic_segmentation_test(sn_size) == SRSRAN_SUCCESS);
     TESTASSERT(segment_retx_test(sn_size) == SRSRAN_SUCCESS);
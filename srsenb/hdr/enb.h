@@ -46,6 +46,7 @@
 #include "srsgnb/hdr/stack/ric/e2ap_ric_subscription.h"
 #include "srsran/common/bcd_helpers.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/cpu_affinity.h"
 #include "srsran/common/interfaces_common.h"
 #include "srsran/common/mac_pcap.h"
 #include "srsran/common/security.h"
@@ -112,6 +113,8 @@ struct general_args_t {
   uint32_t    max_mac_ul_kos;
   uint32_t    gtpu_indirect_tunnel_timeout;
   uint32_t    rlf_release_timer_ms;
+
+  srsran::cpu_affinity_args_t cpu_affinity;
 };
 
 struct all_args_t {
@@ -47,6 +47,7 @@ public:
 
 private:
   void set_metrics_helper(uint32_t num_ue, const mac_metrics_t& mac, const std::vector<phy_metrics_t>& phy, bool is_nr);
+  void print_softbuffer_pool(const char* rat, const srsran_softbuffer_pool_metrics_t& pool);
   std::string float_to_string(float f, int digits, int field_width = 6);
   std::string float_to_eng_string(float f, int digits);
 
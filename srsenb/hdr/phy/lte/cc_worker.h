@@ -55,11 +55,14 @@ public:
   int  read_pucch_d(cf_t* pusch_d);
   void start_plot();
 
-  void work_ul(const srsran_ul_sf_cfg_t& ul_sf, stack_interface_phy_lte::ul_sched_t& ul_grants);
+  void work_ul(const srsran_ul_sf_cfg_t&            ul_sf,
+               stack_interface_phy_lte::ul_sched_t& ul_grants,
+               srsran::tti_tracer&                  tracer);
   void work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
                stack_interface_phy_lte::dl_sched_t& dl_grants,
                stack_interface_phy_lte::ul_sched_t& ul_grants,
-               srsran_mbsfn_cfg_t*                  mbsfn_cfg);
+               srsran_mbsfn_cfg_t*                  mbsfn_cfg,
+               srsran::tti_tracer&                  tracer);
 
   uint32_t get_metrics(std::vector<phy_metrics_t>& metrics);
 
@@ -108,7 +111,9 @@ private:
 
     void     metrics_read(phy_metrics_t* metrics);
     void     metrics_dl(uint32_t mcs);
+    void     metrics_dl_seq_cache(uint32_t hits, uint32_t misses);
     void     metrics_ul(uint32_t mcs, float rssi, float sinr, float turbo_iters);
+    void     metrics_ul_seq_cache(uint32_t hits, uint32_t misses);
     void     metrics_ul_pucch(float rssi, float ni, float sinr);
     uint32_t get_rnti() const { return rnti; }
 
@@ -30,6 +30,11 @@ namespace lte {
 
 class worker_pool
 {
+  /// Number of TTIs over which the load is measured before deactivating a worker
+  static constexpr uint32_t adaptive_window_nof_tti = 1000;
+  /// Time the radio thread waits for a busy active worker before activating another one
+  static constexpr uint32_t adaptive_max_wait_us    = 100;
+
   srsran::thread_pool                      pool;
   std::vector<std::unique_ptr<sf_worker> > workers;
 
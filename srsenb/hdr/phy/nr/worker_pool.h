@@ -36,6 +36,11 @@ namespace nr {
 class worker_pool final : private slot_worker::sync_interface
 {
 private:
+  /// Number of slots over which the load is measured before deactivating a worker
+  static constexpr uint32_t adaptive_window_nof_slots = 1000;
+  /// Time the radio thread waits for a busy active worker before activating another one
+  static constexpr uint32_t adaptive_max_wait_us      = 100;
+
   srsran::tti_semaphore<slot_worker*> slot_sync; ///< Slot synchronization semaphore
   void                                wait(slot_worker* w) override { slot_sync.wait(w); }
   void                                release() override { slot_sync.release(); }
@@ -101,13 +106,15 @@ private:
 
 public:
   struct args_t {
-    double                 srate_hz          = 0.0;
-    uint32_t               nof_phy_threads   = 3;
-    uint32_t               nof_prach_workers = 0;
-    uint32_t               prio              = 52;
-    uint32_t               pusch_max_its     = 10;
-    float                  pusch_min_snr_dB  = -10;
-    srsran::phy_log_args_t log               = {};
+    double                 srate_hz            = 0.0;
+    uint32_t               nof_phy_threads     = 3;
+    uint32_t               nof_phy_threads_min = 0; ///< Minimum number of active workers, 0 keeps all of them active
+    uint32_t               nof_prach_workers   = 0;
+    uint32_t               prio                = 52;
+    uint32_t               pusch_max_its       = 10;
+    float                  pusch_min_snr_dB    = -10;
+    bool                   huge_pages          = false; ///< Back the large worker buffers with huge pages
+    srsran::phy_log_args_t log                 = {};
   };
   slot_worker* operator[](std::size_t pos) { return workers.at(pos).get(); }
 
@@ -29,6 +29,7 @@
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/thread_pool.h"
 #include "srsran/common/threads.h"
+#include "srsran/common/tti_trace.h"
 #include "srsran/interfaces/enb_metrics_interface.h"
 #include "srsran/interfaces/phy_common_interface.h"
 #include "srsran/interfaces/radio_interfaces.h"
@@ -41,6 +42,20 @@
 
 namespace srsenb {
 
+/**
+ * Processing stages of the LTE workers recorded by the TTI trace
+ */
+enum lte_tti_stage_t : uint32_t {
+  LTE_TTI_STAGE_UL_FFT = 0,
+  LTE_TTI_STAGE_PUSCH,
+  LTE_TTI_STAGE_PUCCH,
+  LTE_TTI_STAGE_MAC_SCHED,
+  LTE_TTI_STAGE_DL_ENCODE,
+  LTE_TTI_STAGE_DL_OFDM,
+  LTE_TTI_STAGE_RADIO_TX,
+  LTE_TTI_STAGE_NOF
+};
+
 class phy_common : public srsran::phy_common_interface
 {
 public:
@@ -288,6 +303,11 @@ public:
    */
   phy_ue_db ue_db;
 
+  /**
+   * Per-stage TTI timing of the LTE workers, every worker writes into its own tracer
+   */
+  srsran::tti_trace tti_trace;
+
   void configure_mbsfn(srsran::phy_cfg_mbsfn_t* cfg);
   void build_mch_table();
   void build_mcch_table();
@@ -22,6 +22,7 @@
 #ifndef SRSENB_PHY_INTERFACES_H_
 #define SRSENB_PHY_INTERFACES_H_
 
+#include "srsenb/hdr/common/common_enb.h"
 #include "srsgnb/hdr/phy/phy_nr_interfaces.h"
 #include "srsran/asn1/rrc/rr_common.h"
 #include "srsran/common/interfaces_common.h"
@@ -53,6 +54,8 @@ struct cfr_args_t {
   float             strength         = 1.0f;
   float             auto_target_papr = 8.0f;
   float             ema_alpha        = 1.0f / (float)SRSRAN_CP_NORM_NSYMB;
+  uint32_t          iterations       = 1;
+  float             max_evm          = 0.0f;
 };
 
 struct phy_args_t {
@@ -66,6 +69,8 @@ struct phy_args_t {
   bool                    pusch_8bit_decoder  = false;
   float                   tx_amplitude        = 1.0f;
   uint32_t                nof_phy_threads     = 1;
+  uint32_t                nof_phy_threads_min = 0;
+  bool                    huge_pages          = false;
   std::string             equalizer_mode      = "mmse";
   float                   estimator_fil_w     = 1.0f;
   bool                    pusch_meas_epre     = true;
@@ -74,10 +79,14 @@ struct phy_args_t {
   bool                    pucch_meas_ta       = true;
   bool                    use_cedron_alg      = false;
   uint32_t                nof_prach_threads   = 1;
+  bool                    prach_batch_detect  = true;
+  uint32_t                seq_cache_nof_ue    = SRSENB_MAX_UES;
   bool                    extended_cp         = false;
   srsran::channel::args_t dl_channel_args;
   srsran::channel::args_t ul_channel_args;
   cfr_args_t              cfr_args;
+  bool                    tti_trace_enable = false;
+  std::string             tti_trace_filename;
 };
 
 struct phy_cfg_t {
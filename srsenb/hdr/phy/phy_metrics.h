@@ -23,29 +23,34 @@
 #define SRSENB_PHY_METRICS_H
 
 #include <limits>
+#include <stdint.h>
 
 namespace srsenb {
 
 // PHY metrics per user
 
 struct ul_metrics_t {
-  float   n;
-  float   pusch_sinr;
-  float   pusch_rssi;
-  int64_t pusch_tpc;
-  float   pucch_sinr;
-  float   pucch_rssi;
-  float   pucch_ni;
-  float   turbo_iters;
-  float   mcs;
-  int     n_samples;
-  int     n_samples_pucch;
+  float    n;
+  float    pusch_sinr;
+  float    pusch_rssi;
+  int64_t  pusch_tpc;
+  float    pucch_sinr;
+  float    pucch_rssi;
+  float    pucch_ni;
+  float    turbo_iters;
+  float    mcs;
+  int      n_samples;
+  int      n_samples_pucch;
+  uint32_t seq_cache_hits;   ///< PUSCH scrambling sequences found in the cache
+  uint32_t seq_cache_misses; ///< PUSCH scrambling sequences generated
 };
 
 struct dl_metrics_t {
-  float mcs;
-  int64_t pucch_tpc;
-  int     n_samples;
+  float    mcs;
+  int64_t  pucch_tpc;
+  int      n_samples;
+  uint32_t seq_cache_hits;   ///< PDSCH scrambling sequences found in the cache
+  uint32_t seq_cache_misses; ///< PDSCH scrambling sequences generated
 };
 
 struct phy_metrics_t {
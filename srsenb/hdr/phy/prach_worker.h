@@ -40,11 +40,10 @@ namespace srsenb {
 
 class stack_interface_phy_lte;
 
-class prach_worker : srsran::thread
+class prach_worker
 {
 public:
-  prach_worker(uint32_t cc_idx_, srslog::basic_logger& logger) :
-    buffer_pool(8), thread("PRACH_WORKER"), logger(logger), running(false)
+  prach_worker(uint32_t cc_idx_, srslog::basic_logger& logger) : buffer_pool(8), logger(logger), running(false)
   {
     cc_idx = cc_idx_;
   }
@@ -61,13 +60,8 @@ public:
 private:
   uint32_t cc_idx = 0;
 
-  uint32_t prach_indices[165] = {};
-  float    prach_offsets[165] = {};
-  float    prach_p2avg[165]   = {};
-
   srsran_cell_t      cell      = {};
   srsran_prach_cfg_t prach_cfg = {};
-  srsran_prach_t     prach     = {};
 
 #if defined(ENABLE_GUI) and ENABLE_PRACH_GUI
   plot_real_t                              plot_real;
@@ -94,6 +88,25 @@ private:
   srsran::buffer_pool<sf_buffer>  buffer_pool;
   srsran::block_queue<sf_buffer*> pending_buffers;
 
+  // Each detector owns a PRACH object and its results. With several PRACH threads, every thread runs its own
+  // detector and pops the next pending buffer, so consecutive PRACH occasions are processed concurrently.
+  class detector : public srsran::thread
+  {
+  public:
+    explicit detector(prach_worker* parent_) : thread("PRACH_WORKER"), parent(parent_) {}
+
+    srsran_prach_t prach              = {};
+    uint32_t       prach_indices[165] = {};
+    float          prach_offsets[165] = {};
+    float          prach_p2avg[165]   = {};
+
+  private:
+    prach_worker* parent = nullptr;
+
+    void run_thread() final { parent->run_thread(*this); }
+  };
+  std::vector<std::unique_ptr<detector> > detectors;
+
   srslog::basic_logger&    logger;
   sf_buffer*               current_buffer      = nullptr;
   stack_interface_phy_lte* stack               = nullptr;
@@ -104,8 +117,8 @@ private:
   uint32_t                 sf_cnt      = 0;
   uint32_t                 nof_workers = 0;
 
-  void run_thread() final;
-  int  run_tti(sf_buffer* b);
+  void run_thread(detector& d);
+  int  run_tti(detector& d, sf_buffer* b);
 };
 
 class prach_worker_pool
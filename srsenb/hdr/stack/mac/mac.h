@@ -26,11 +26,13 @@
 #include "sched_interface.h"
 #include "srsenb/hdr/common/rnti_pool.h"
 #include "srsenb/hdr/stack/mac/schedulers/sched_time_rr.h"
+#include "srsran/adt/circular_array.h"
 #include "srsran/adt/circular_map.h"
 #include "srsran/adt/pool/batch_mem_pool.h"
 #include "srsran/common/mac_pcap.h"
 #include "srsran/common/mac_pcap_net.h"
 #include "srsran/common/task_scheduler.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/common/threads.h"
 #include "srsran/common/tti_sync_cv.h"
 #include "srsran/interfaces/enb_mac_interfaces.h"
@@ -129,6 +131,46 @@ private:
    */
   bool is_pending_pdcch_order_prach(const uint32_t preamble_idx, uint16_t& rnti);
 
+  /// DL MAC PDU to be assembled for a TB of a UE data grant
+  struct dl_pdu_job_t {
+    uint32_t grant_idx; ///< Index of the data grant in the scheduler result
+    uint32_t pdsch_idx; ///< Index of the PDSCH grant passed to the PHY
+    uint32_t tb_idx;
+  };
+  using dl_pdu_job_list_t = srsran::bounded_vector<dl_pdu_job_t, sched_interface::MAX_DATA_LIST * SRSRAN_MAX_TB>;
+
+  /// DL MAC PDUs of a carrier shared with the PDU workers. There is one preallocated batch per TTI, so the task pushed
+  /// to the workers only carries the batch and its generation. A task that starts after the batch is closed returns.
+  struct dl_pdu_batch_t {
+    std::mutex              mutex;
+    std::condition_variable cvar;
+    uint64_t                generation = 0;
+    bool                    closed     = true;
+    uint32_t                nof_active = 0; ///< Workers that joined the batch before it was closed
+    std::atomic<uint32_t>   next_job{0};
+
+    uint32_t                               enb_cc_idx   = 0;
+    const sched_interface::dl_sched_res_t* sched_result = nullptr;
+    const dl_pdu_job_list_t*               jobs         = nullptr;
+    dl_sched_t*                            dl_sched_res = nullptr;
+  };
+
+  /**
+   * @brief Assembles the DL MAC PDUs of a carrier. If PDU workers are enabled, the PDUs of different UEs are
+   * assembled concurrently by the workers and the calling thread, and the function returns once all PDUs are ready.
+   */
+  void generate_dl_pdus(uint32_t                               tti_tx_dl,
+                        uint32_t                               enb_cc_idx,
+                        const sched_interface::dl_sched_res_t& sched_result,
+                        const dl_pdu_job_list_t&               jobs,
+                        dl_sched_t&                            dl_sched_res);
+  void generate_dl_pdu(uint32_t                               enb_cc_idx,
+                       const sched_interface::dl_sched_res_t& sched_result,
+                       const dl_pdu_job_t&                    job,
+                       dl_sched_t&                            dl_sched_res);
+  void run_dl_pdu_jobs(dl_pdu_batch_t& batch);
+  void run_dl_pdu_worker(dl_pdu_batch_t* batch, uint64_t generation);
+
   srslog::basic_logger& logger;
 
   // We use a rwlock in MAC to allow multiple workers to access MAC simultaneously. No conflicts will happen since
@@ -147,6 +189,11 @@ private:
   // derived from args
   srsran::task_multiqueue::queue_handle stack_task_queue;
 
+  // Workers assembling the DL MAC PDUs of different UEs in parallel. The batches outlive the workers, as a pending
+  // task may still reference one of them
+  srsran::circular_array<dl_pdu_batch_t, TTIMOD_SZ> dl_pdu_batches;
+  std::unique_ptr<srsran::task_thread_pool>         pdu_workers;
+
   bool started = false;
 
   /* Scheduler unit */
@@ -205,6 +252,9 @@ private:
 
   // Softbuffer pool
   std::unique_ptr<srsran::obj_pool_itf<ue_cc_softbuffers> > softbuffer_pool;
+  // Code blocks shared by the UL softbuffers of all the UEs, only used if ul_softbuffer_pool_mb is set
+  srsran_softbuffer_pool_t  ul_cb_pool     = {};
+  srsran_softbuffer_pool_t* ul_cb_pool_ptr = nullptr;
 };
 
 } // namespace srsenb
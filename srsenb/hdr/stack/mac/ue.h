@@ -57,7 +57,11 @@ struct ue_cc_softbuffers {
   cc_softbuffer_tx_list_t softbuffer_tx_list;
   cc_softbuffer_rx_list_t softbuffer_rx_list;
 
-  ue_cc_softbuffers(uint32_t nof_prb, uint32_t nof_tx_harq_proc_, uint32_t nof_rx_harq_proc_);
+  ue_cc_softbuffers(uint32_t                  nof_prb,
+                    uint32_t                  nof_tx_harq_proc_,
+                    uint32_t                  nof_rx_harq_proc_,
+                    srsran_softbuffer_pool_t* rx_cb_pool    = nullptr,
+                    srsran_softbuffer_llr_t   rx_llr_format = SRSRAN_SOFTBUFFER_LLR_16BIT);
   ue_cc_softbuffers(ue_cc_softbuffers&&) noexcept = default;
   ~ue_cc_softbuffers();
   void clear();
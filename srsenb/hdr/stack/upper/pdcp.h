@@ -19,6 +19,7 @@
  *
  */
 
+#include "srsenb/hdr/common/common_enb.h"
 #include "srsenb/hdr/common/rnti_pool.h"
 #include "srsran/common/timers.h"
 #include "srsran/interfaces/enb_metrics_interface.h"
@@ -125,7 +126,8 @@ private:
 
   void clear_user(user_interface* ue);
 
-  std::map<uint32_t, user_interface> users;
+  // RNTI-indexed table. Entries are stored in place, so the interface addresses handed to srsran::pdcp stay valid
+  rnti_map_t<user_interface> users;
 
   rlc_interface_pdcp*       rlc  = nullptr;
   rrc_interface_pdcp*       rrc  = nullptr;
@@ -19,13 +19,16 @@
  *
  */
 
+#include "srsenb/hdr/common/common_enb.h"
 #include "srsenb/hdr/common/rnti_pool.h"
+#include "srsran/common/rwlock_guard.h"
 #include "srsran/interfaces/enb_metrics_interface.h"
 #include "srsran/interfaces/enb_rlc_interfaces.h"
 #include "srsran/interfaces/ue_interfaces.h"
 #include "srsran/rlc/rlc.h"
 #include "srsran/srslog/srslog.h"
-#include <map>
+#include <array>
+#include <mutex>
 
 #ifndef SRSENB_RLC_H
 #define SRSENB_RLC_H
@@ -100,10 +103,15 @@ private:
 
   void update_bsr(uint32_t rnti, uint32_t lcid, uint32_t tx_queue, uint32_t retx_queue);
 
-  pthread_rwlock_t rwlock;
+  pthread_rwlock_t& ue_rwlock(uint16_t rnti) { return ue_rwlocks[rnti % SRSENB_MAX_UES]; }
 
-  std::map<uint32_t, user_interface> users;
-  std::vector<mch_service_t>         mch_services;
+  // Each UE is protected by the rwlock of its slot in the RNTI table, so that calls for different UEs, e.g. from
+  // concurrent MAC workers, do not contend. Adding, removing and iterating over UEs is serialized by users_mutex.
+  std::array<pthread_rwlock_t, SRSENB_MAX_UES> ue_rwlocks;
+  std::mutex                                   users_mutex;
+
+  rnti_map_t<user_interface> users;
+  std::vector<mch_service_t> mch_services;
 
   mac_interface_rlc*     mac  = nullptr;
   pdcp_interface_rlc*    pdcp = nullptr;
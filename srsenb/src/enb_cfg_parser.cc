@@ -1715,22 +1715,25 @@ int parse_cell_cfg(all_args_t* args_, srsran_cell_t* cell)
 // Parse the relevant CFR configuration params
 int parse_cfr_args(all_args_t* args, srsran_cfr_cfg_t* cfr_config)
 {
-  cfr_config->cfr_enable  = args->phy.cfr_args.enable;
-  cfr_config->cfr_mode    = args->phy.cfr_args.mode;
-  cfr_config->alpha       = args->phy.cfr_args.strength;
-  cfr_config->manual_thr  = args->phy.cfr_args.manual_thres;
-  cfr_config->max_papr_db = args->phy.cfr_args.auto_target_papr;
-  cfr_config->ema_alpha   = args->phy.cfr_args.ema_alpha;
+  cfr_config->cfr_enable     = args->phy.cfr_args.enable;
+  cfr_config->cfr_mode       = args->phy.cfr_args.mode;
+  cfr_config->alpha          = args->phy.cfr_args.strength;
+  cfr_config->manual_thr     = args->phy.cfr_args.manual_thres;
+  cfr_config->max_papr_db    = args->phy.cfr_args.auto_target_papr;
+  cfr_config->ema_alpha      = args->phy.cfr_args.ema_alpha;
+  cfr_config->nof_iterations = args->phy.cfr_args.iterations;
+  cfr_config->max_evm        = args->phy.cfr_args.max_evm;
 
   if (!srsran_cfr_params_valid(cfr_config)) {
     fprintf(stderr,
             "Invalid CFR parameters: cfr_mode=%d, alpha=%.2f, manual_thr=%.2f, \n "
-            "max_papr_db=%.2f, ema_alpha=%.2f\n",
+            "max_papr_db=%.2f, ema_alpha=%.2f, max_evm=%.2f\n",
             cfr_config->cfr_mode,
             cfr_config->alpha,
             cfr_config->manual_thr,
             cfr_config->max_papr_db,
-            cfr_config->ema_alpha);
+            cfr_config->ema_alpha,
+            cfr_config->max_evm);
     return SRSRAN_ERROR;
   }
   return SRSRAN_SUCCESS;
@@ -1871,6 +1874,10 @@ int set_derived_args(all_args_t* args_, rrc_cfg_t* rrc_cfg_, phy_cfg_t* phy_cfg_
                    "mac.nof_prealloc_ues=%d must be within [0, %d]",
                    args_->stack.mac.nof_prealloc_ues,
                    SRSENB_MAX_UES);
+  ASSERT_VALID_CFG(args_->phy.seq_cache_nof_ue > 0 and args_->phy.seq_cache_nof_ue <= SRSENB_MAX_UES,
+                   "expert.seq_cache_nof_ue=%d must be within [1, %d]",
+                   args_->phy.seq_cache_nof_ue,
+                   SRSENB_MAX_UES);
 
   // Check for a forced  DL EARFCN or frequency (only valid for a single cell config
   if (rrc_cfg_->cell_list.size() > 0) {
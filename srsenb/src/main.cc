@@ -28,6 +28,7 @@
 
 #include "srsran/common/common_helper.h"
 #include "srsran/common/config_file.h"
+#include "srsran/common/cpu_affinity.h"
 #include "srsran/common/crash_handler.h"
 #include "srsran/common/tsan_options.h"
 #include "srsran/srslog/event_trace.h"
@@ -192,6 +193,8 @@ void parse_args(all_args_t* args, int argc, char* argv[])
 
     /* Downlink Channel emulator section */
     ("channel.dl.enable",            bpo::value<bool>(&args->phy.dl_channel_args.enable)->default_value(false),               "Enable/Disable internal Downlink channel emulator")
+    ("channel.dl.nof_threads",       bpo::value<uint32_t>(&args->phy.dl_channel_args.nof_threads)->default_value(1),          "Threads running the emulator, antennas and fading segments are split among them")
+    ("channel.dl.seed",              bpo::value<uint32_t>(&args->phy.dl_channel_args.seed)->default_value(0),                 "Offset to the random seeds of the emulator")
     ("channel.dl.awgn.enable",       bpo::value<bool>(&args->phy.dl_channel_args.awgn_enable)->default_value(false),          "Enable/Disable AWGN simulator")
     ("channel.dl.awgn.snr",          bpo::value<float>(&args->phy.dl_channel_args.awgn_snr_dB)->default_value(30.0f),         "Target SNR in dB")
     ("channel.dl.fading.enable",     bpo::value<bool>(&args->phy.dl_channel_args.fading_enable)->default_value(false),        "Enable/Disable Fading model")
@@ -211,6 +214,8 @@ void parse_args(all_args_t* args, int argc, char* argv[])
 
     /* Uplink Channel emulator section */
     ("channel.ul.enable",            bpo::value<bool>(&args->phy.ul_channel_args.enable)->default_value(false),                  "Enable/Disable internal Downlink channel emulator")
+    ("channel.ul.nof_threads",       bpo::value<uint32_t>(&args->phy.ul_channel_args.nof_threads)->default_value(1),             "Threads running the emulator, antennas and fading segments are split among them")
+    ("channel.ul.seed",              bpo::value<uint32_t>(&args->phy.ul_channel_args.seed)->default_value(0),                    "Offset to the random seeds of the emulator")
     ("channel.ul.awgn.enable",       bpo::value<bool>(&args->phy.ul_channel_args.awgn_enable)->default_value(false),             "Enable/Disable AWGN simulator")
     ("channel.ul.awgn.signal_power", bpo::value<float>(&args->phy.ul_channel_args.awgn_signal_power_dBfs)->default_value(30.0f), "Received signal power in decibels full scale (dBfs)")
     ("channel.ul.awgn.snr",          bpo::value<float>(&args->phy.ul_channel_args.awgn_snr_dB)->default_value(30.0f),            "Noise level in decibels full scale (dBfs)")
@@ -236,6 +241,8 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("cfr.strength", bpo::value<float>(&args->phy.cfr_args.strength)->default_value(args->phy.cfr_args.strength), "CFR ratio between amplitude-limited vs original signal (0 to 1)")
     ("cfr.auto_target_papr", bpo::value<float>(&args->phy.cfr_args.auto_target_papr)->default_value(args->phy.cfr_args.auto_target_papr), "Signal PAPR target (in dB) in CFR auto modes")
     ("cfr.ema_alpha", bpo::value<float>(&args->phy.cfr_args.ema_alpha)->default_value(args->phy.cfr_args.ema_alpha), "Alpha coefficient for the power average in auto_ema mode (0 to 1)")
+    ("cfr.iterations", bpo::value<uint32_t>(&args->phy.cfr_args.iterations)->default_value(args->phy.cfr_args.iterations), "Number of clipping and filtering iterations")
+    ("cfr.max_evm", bpo::value<float>(&args->phy.cfr_args.max_evm)->default_value(args->phy.cfr_args.max_evm), "Maximum EVM introduced by the CFR in every OFDM symbol (0 to 1), 0 for no limit")
 
     /* RIC section */
     ("e2_agent.enable",   bpo::value<bool>(&args->e2_agent.enable)->default_value(false), "Enables the E2 agent")
@@ -255,8 +262,12 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.pusch_meas_evm", bpo::value<bool>(&args->phy.pusch_meas_evm)->default_value(false), "Enable/Disable PUSCH EVM measure.")
     ("expert.tx_amplitude", bpo::value<float>(&args->phy.tx_amplitude)->default_value(0.6), "Transmit amplitude factor.")
     ("expert.nof_phy_threads", bpo::value<uint32_t>(&args->phy.nof_phy_threads)->default_value(3), "Number of PHY threads.")
-    ("expert.nof_prach_threads", bpo::value<uint32_t>(&args->phy.nof_prach_threads)->default_value(1), "Number of PRACH workers per carrier. Only 1 or 0 is supported.")
+    ("expert.phy_huge_pages", bpo::value<bool>(&args->phy.huge_pages)->default_value(false), "Back the large PHY worker buffers with transparent huge pages.")
+    ("expert.nof_phy_threads_min", bpo::value<uint32_t>(&args->phy.nof_phy_threads_min)->default_value(0), "Minimum number of active PHY threads, the rest are activated on load (0 keeps all of them active).")
+    ("expert.nof_prach_threads", bpo::value<uint32_t>(&args->phy.nof_prach_threads)->default_value(1), "Number of PRACH workers per carrier. Several workers process consecutive PRACH occasions concurrently.")
+    ("expert.seq_cache_nof_ue", bpo::value<uint32_t>(&args->phy.seq_cache_nof_ue)->default_value(SRSENB_MAX_UES), "Number of UEs whose PDSCH/PUSCH scrambling sequences are cached by every PHY worker.")
     ("expert.max_prach_offset_us", bpo::value<float>(&args->phy.max_prach_offset_us)->default_value(30), "Maximum allowed RACH offset (in us).")
+    ("expert.prach_batch_detection", bpo::value<bool>(&args->phy.prach_batch_detect)->default_value(true), "Correlate all the PRACH root sequences with a single batched IFFT instead of one IFFT per root sequence.")
     ("expert.equalizer_mode", bpo::value<string>(&args->phy.equalizer_mode)->default_value("mmse"), "Equalizer mode.")
     ("expert.estimator_fil_w", bpo::value<float>(&args->phy.estimator_fil_w)->default_value(0.1), "Chooses the coefficients for the 3-tap channel estimator centered filter.")
     ("expert.lte_sample_rates", bpo::value<bool>(&use_standard_lte_rates)->default_value(false), "Whether to use default LTE sample rates instead of shorter variants.")
@@ -268,12 +279,25 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.tracing_enable",  bpo::value<bool>(&args->general.tracing_enable)->default_value(false), "Events tracing.")
     ("expert.tracing_filename", bpo::value<string>(&args->general.tracing_filename)->default_value("/tmp/enb_tracing.log"), "Tracing events filename.")
     ("expert.tracing_buffcapacity", bpo::value<std::size_t>(&args->general.tracing_buffcapacity)->default_value(1000000), "Tracing buffer capcity.")
+    ("expert.tti_trace_enable", bpo::value<bool>(&args->phy.tti_trace_enable)->default_value(false), "Write the per-stage processing time of every PHY worker TTI to a binary file.")
+    ("expert.tti_trace_filename", bpo::value<string>(&args->phy.tti_trace_filename)->default_value("/tmp/enb_tti_trace.bin"), "TTI trace filename.")
+    ("expert.cpu_affinity", bpo::value<string>(&args->general.cpu_affinity.mode)->default_value("none"), "CPU affinity of the real-time threads: none, auto (NUMA and SMT aware) or manual.")
+    ("expert.cpu_numa_node", bpo::value<int32_t>(&args->general.cpu_affinity.numa_node)->default_value(-1), "NUMA node of the real-time threads in auto CPU affinity (-1 for the node of the isolated CPUs).")
+    ("expert.radio_cpus", bpo::value<string>(&args->general.cpu_affinity.radio_cpus)->default_value(""), "CPU list of the radio thread in manual CPU affinity, e.g. 2.")
+    ("expert.phy_cpus", bpo::value<string>(&args->general.cpu_affinity.phy_cpus)->default_value(""), "CPU list of the PHY workers in manual CPU affinity, e.g. 3-6.")
+    ("expert.stack_cpus", bpo::value<string>(&args->general.cpu_affinity.stack_cpus)->default_value(""), "CPU list of the stack thread in manual CPU affinity, e.g. 7.")
+    ("expert.housekeeping_cpus", bpo::value<string>(&args->general.cpu_affinity.housekeeping_cpus)->default_value(""), "CPU list of the remaining threads in manual CPU affinity (empty for all the other CPUs).")
     ("expert.stdout_ts_enable", bpo::value<bool>(&stdout_ts_enable)->default_value(false), "Prints once per second the timestamp into stdout.")
     ("expert.rrc_inactivity_timer", bpo::value<uint32_t>(&args->general.rrc_inactivity_timer)->default_value(30000), "Inactivity timer in ms.")
     ("expert.print_buffer_state", bpo::value<bool>(&args->general.print_buffer_state)->default_value(false), "Prints on the console the buffer state every 10 seconds.")
     ("expert.eea_pref_list", bpo::value<string>(&args->general.eea_pref_list)->default_value("EEA0, EEA2, EEA1"), "Ordered preference list for the selection of encryption algorithm (EEA) (default: EEA0, EEA2, EEA1).")
     ("expert.eia_pref_list", bpo::value<string>(&args->general.eia_pref_list)->default_value("EIA2, EIA1, EIA0"), "Ordered preference list for the selection of integrity algorithm (EIA) (default: EIA2, EIA1, EIA0).")
     ("expert.nof_prealloc_ues", bpo::value<uint32_t>(&args->stack.mac.nof_prealloc_ues)->default_value(8), "Number of UE resources to preallocate during eNB initialization.")
+    ("expert.ul_softbuffer_pool_mb", bpo::value<uint32_t>(&args->stack.mac.ul_softbuffer_pool_mb)->default_value(0), "Memory in MB of the huge page backed pool shared by the UL softbuffers (0 to give every HARQ process its own buffers).")
+    ("expert.nr_ul_softbuffer_pool_mb", bpo::value<uint32_t>(&args->nr_stack.mac.ul_softbuffer_pool_mb)->default_value(0), "Memory in MB of the huge page backed pool shared by the NR UL softbuffers (0 to give every HARQ process its own buffers).")
+    ("expert.ul_softbuffer_llr_bits", bpo::value<uint32_t>(&args->stack.mac.ul_softbuffer_llr_bits)->default_value(16), "Bits of every soft bit stored by the UL softbuffers: 16, 8 or 4. 8 and 4 need pusch_8bit_decoder.")
+    ("expert.nr_ul_softbuffer_llr_bits", bpo::value<uint32_t>(&args->nr_stack.mac.ul_softbuffer_llr_bits)->default_value(8), "Bits of every soft bit stored by the NR UL softbuffers: 8 or 4.")
+    ("expert.nof_mac_pdu_workers", bpo::value<uint32_t>(&args->stack.mac.nof_pdu_workers)->default_value(0), "Number of threads assembling the DL MAC PDUs of different UEs in parallel (0 to assemble them in the PHY worker).")
     ("expert.lcid_padding", bpo::value<int>(&args->stack.mac.lcid_padding)->default_value(3), "LCID on which to put MAC padding")
     ("expert.max_mac_dl_kos", bpo::value<uint32_t>(&args->general.max_mac_dl_kos)->default_value(100), "Maximum number of consecutive KOs in DL before triggering the UE's release (default 100).")
     ("expert.max_mac_ul_kos", bpo::value<uint32_t>(&args->general.max_mac_ul_kos)->default_value(100), "Maximum number of consecutive KOs in UL before triggering the UE's release (default 100).")
@@ -303,6 +327,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     // NR section
     ("scheduler.nr_pdsch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_dl_mcs)->default_value(28), "Fixed NR DL MCS (-1 for dynamic).")
     ("scheduler.nr_pusch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_ul_mcs)->default_value(28), "Fixed NR UL MCS (-1 for dynamic).")
+    ("scheduler.nr_pipeline_slots", bpo::value<uint32_t>(&args->nr_stack.mac.sched_cfg.nof_pipeline_slots)->default_value(0), "Number of NR slots scheduled ahead of the PHY in per-carrier threads (0 to schedule in the PHY thread).")
     ("expert.nr_pusch_max_its", bpo::value<uint32_t>(&args->phy.nr_pusch_max_its)->default_value(10),     "Maximum number of LDPC iterations for NR.")
   ;
 
@@ -391,14 +416,6 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     }
   }
 
-  // Check PRACH workers
-  if (args->phy.nof_prach_threads > 1) {
-    fprintf(stderr,
-            "nof_prach_workers = %d. Value is not supported, only 0 or 1 are allowed\n",
-            args->phy.nof_prach_threads);
-    exit(1);
-  }
-
   // Convert eNB Id
   std::size_t pos = {};
   try {
@@ -419,6 +436,13 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     exit(1);
   }
 
+  // Soft bits stored in less than 16 bit can only be combined by the 8-bit turbo decoder
+  if (args->stack.mac.ul_softbuffer_llr_bits != 16 && !args->phy.pusch_8bit_decoder) {
+    cout << "Error, expert.ul_softbuffer_llr_bits=" << args->stack.mac.ul_softbuffer_llr_bits
+         << " requires expert.pusch_8bit_decoder" << endl;
+    exit(1);
+  }
+
   // Apply all_level to any unset layers
   if (vm.count("log.all_level")) {
     if (!vm.count("log.rf_level")) {
@@ -649,6 +673,17 @@ int main(int argc, char* argv[])
   }
 #endif
 
+  // Configure the CPU affinity before any thread is created, so that they all inherit the housekeeping CPUs.
+  srsran::cpu_affinity_policy* cpu_affinity = srsran::cpu_affinity_policy::get_instance();
+  if (not cpu_affinity->init(args.general.cpu_affinity)) {
+    srsran::console("Error configuring the CPU affinity\n");
+    return SRSRAN_ERROR;
+  }
+  if (cpu_affinity->is_enabled()) {
+    cpu_affinity->apply_housekeeping();
+    srsran::console("CPU affinity: {}\n", cpu_affinity->to_string());
+  }
+
   // Start the log backend.
   srslog::init();
 
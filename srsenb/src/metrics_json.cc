@@ -65,6 +65,10 @@ DECLARE_METRIC("ul_bitrate", metric_ul_bitrate, float, "");
 DECLARE_METRIC("ul_bler", metric_ul_bler, float, "");
 DECLARE_METRIC("ul_phr", metric_ul_phr, float, "");
 DECLARE_METRIC("ul_bsr", metric_bsr, uint32_t, "");
+DECLARE_METRIC("dl_seq_cache_hits", metric_dl_seq_cache_hits, uint32_t, "");
+DECLARE_METRIC("dl_seq_cache_misses", metric_dl_seq_cache_misses, uint32_t, "");
+DECLARE_METRIC("ul_seq_cache_hits", metric_ul_seq_cache_hits, uint32_t, "");
+DECLARE_METRIC("ul_seq_cache_misses", metric_ul_seq_cache_misses, uint32_t, "");
 DECLARE_METRIC_LIST("bearer_list", mlist_bearers, std::vector<mset_bearer_container>);
 DECLARE_METRIC_SET("ue_container",
                    mset_ue_container,
@@ -86,6 +90,10 @@ DECLARE_METRIC_SET("ue_container",
                    metric_ul_bler,
                    metric_ul_phr,
                    metric_bsr,
+                   metric_dl_seq_cache_hits,
+                   metric_dl_seq_cache_misses,
+                   metric_ul_seq_cache_hits,
+                   metric_ul_seq_cache_misses,
                    mlist_bearers);
 
 /// Cell container metrics.
@@ -95,13 +103,35 @@ DECLARE_METRIC("nof_rach", metric_nof_rach, uint32_t, "");
 DECLARE_METRIC_LIST("ue_list", mlist_ues, std::vector<mset_ue_container>);
 DECLARE_METRIC_SET("cell_container", mset_cell_container, metric_carrier_id, metric_pci, metric_nof_rach, mlist_ues);
 
+/// UL softbuffer code block pool metrics, all zero if the pool is disabled.
+DECLARE_METRIC("cb_used", metric_cb_used, uint32_t, "");
+DECLARE_METRIC("max_cb_used", metric_max_cb_used, uint32_t, "");
+DECLARE_METRIC("bytes", metric_pool_bytes, uint64_t, "");
+DECLARE_METRIC("failures", metric_pool_failures, uint64_t, "");
+DECLARE_METRIC_SET("ul_softbuffer_pool",
+                   mset_ul_softbuffer_pool,
+                   metric_cb_used,
+                   metric_max_cb_used,
+                   metric_pool_bytes,
+                   metric_pool_failures);
+DECLARE_METRIC_SET("nr_ul_softbuffer_pool",
+                   mset_nr_ul_softbuffer_pool,
+                   metric_cb_used,
+                   metric_max_cb_used,
+                   metric_pool_bytes,
+                   metric_pool_failures);
+
 /// Metrics root object.
 DECLARE_METRIC("type", metric_type_tag, std::string, "");
 DECLARE_METRIC("timestamp", metric_timestamp_tag, double, "");
 DECLARE_METRIC_LIST("cell_list", mlist_cell, std::vector<mset_cell_container>);
 
 /// Metrics context.
-using metric_context_t = srslog::build_context_type<metric_type_tag, metric_timestamp_tag, mlist_cell>;
+using metric_context_t = srslog::build_context_type<metric_type_tag,
+                                                    metric_timestamp_tag,
+                                                    mlist_cell,
+                                                    mset_ul_softbuffer_pool,
+                                                    mset_nr_ul_softbuffer_pool>;
 
 } // namespace
 
@@ -151,6 +181,10 @@ static void fill_ue_metrics(mset_ue_container& ue, const enb_metrics_t& m, unsig
   }
   ue.write<metric_ul_phr>(m.stack.mac.ues[i].phr);
   ue.write<metric_bsr>(m.stack.mac.ues[i].ul_buffer);
+  ue.write<metric_dl_seq_cache_hits>(m.phy[i].dl.seq_cache_hits);
+  ue.write<metric_dl_seq_cache_misses>(m.phy[i].dl.seq_cache_misses);
+  ue.write<metric_ul_seq_cache_hits>(m.phy[i].ul.seq_cache_hits);
+  ue.write<metric_ul_seq_cache_misses>(m.phy[i].ul.seq_cache_misses);
 
   // For each data bearer of this UE...
   auto& bearer_list = ue.get<mlist_bearers>();
@@ -174,6 +208,16 @@ static void fill_ue_metrics(mset_ue_container& ue, const enb_metrics_t& m, unsig
   }
 }
 
+/// Fill the metrics of a UL softbuffer code block pool.
+template <typename T>
+static void fill_softbuffer_pool_metrics(T& pool, const srsran_softbuffer_pool_metrics_t& m)
+{
+  pool.template write<metric_cb_used>(m.nof_cb_used);
+  pool.template write<metric_max_cb_used>(m.max_cb_used);
+  pool.template write<metric_pool_bytes>(m.nof_bytes);
+  pool.template write<metric_pool_failures>(m.nof_failures);
+}
+
 /// Returns the current time in seconds with ms precision since UNIX epoch.
 static double get_time_stamp()
 {
@@ -238,6 +282,9 @@ void metrics_json::set_metrics(const enb_metrics_t& m, const uint32_t period_use
     }
   }
 
+  fill_softbuffer_pool_metrics(ctx.get<mset_ul_softbuffer_pool>(), m.stack.mac.ul_softbuffer_pool);
+  fill_softbuffer_pool_metrics(ctx.get<mset_nr_ul_softbuffer_pool>(), m.nr_stack.mac.ul_softbuffer_pool);
+
   // Log the context.
   ctx.write<metric_timestamp_tag>(get_time_stamp());
   log_c(ctx);
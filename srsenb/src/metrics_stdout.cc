@@ -195,6 +195,8 @@ void metrics_stdout::set_metrics(const enb_metrics_t& metrics, const uint32_t pe
   if (++n_reports > 10) {
     n_reports = 0;
     fmt::print("\n");
+    print_softbuffer_pool("lte", metrics.stack.mac.ul_softbuffer_pool);
+    print_softbuffer_pool("nr", metrics.nr_stack.mac.ul_softbuffer_pool);
     fmt::print(
         "               -----------------DL----------------|-------------------------UL-------------------------\n");
     fmt::print(
@@ -205,6 +207,20 @@ void metrics_stdout::set_metrics(const enb_metrics_t& metrics, const uint32_t pe
   set_metrics_helper(metrics.nr_stack.mac.ues.size(), metrics.nr_stack.mac, metrics.phy, true);
 }
 
+void metrics_stdout::print_softbuffer_pool(const char* rat, const srsran_softbuffer_pool_metrics_t& pool)
+{
+  // Nothing to print if the pool is disabled
+  if (pool.nof_bytes == 0) {
+    return;
+  }
+  fmt::print("{} UL softbuffer pool: cb={} max_cb={} mem={:.1f}MB failures={}\n",
+             rat,
+             pool.nof_cb_used,
+             pool.max_cb_used,
+             pool.nof_bytes / (1024.0 * 1024.0),
+             pool.nof_failures);
+}
+
 std::string metrics_stdout::float_to_string(float f, int digits, int field_width)
 {
   std::ostringstream os;
@@ -86,6 +86,24 @@ cc_worker::~cc_worker()
 FILE* f;
 #endif
 
+static uint64_t pdsch_seq_cache_hits(const srsran_pdsch_t& pdsch)
+{
+  uint64_t hits = 0;
+  for (const srsran_sequence_cache_t& c : pdsch.seq_cache) {
+    hits += c.nof_hits;
+  }
+  return hits;
+}
+
+static uint64_t pdsch_seq_cache_misses(const srsran_pdsch_t& pdsch)
+{
+  uint64_t misses = 0;
+  for (const srsran_sequence_cache_t& c : pdsch.seq_cache) {
+    misses += c.nof_misses;
+  }
+  return misses;
+}
+
 void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
 {
   phy                         = phy_;
@@ -132,6 +150,13 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
     return;
   }
 
+  // Cache the scrambling sequences of every UE, plus SI-RNTI, P-RNTI and RA-RNTI in DL
+  if (srsran_pdsch_set_seq_cache_nof_rnti(&enb_dl.pdsch, phy->params.seq_cache_nof_ue + 3) < SRSRAN_SUCCESS ||
+      srsran_pusch_set_seq_cache_nof_rnti(&enb_ul.pusch, phy->params.seq_cache_nof_ue) < SRSRAN_SUCCESS) {
+    ERROR("Error sizing the scrambling sequence caches");
+    return;
+  }
+
   /* Setup SI-RNTI in PHY */
   add_rnti(SRSRAN_SIRNTI);
 
@@ -212,7 +237,9 @@ uint32_t cc_worker::get_nof_rnti()
   return ue_db.size();
 }
 
-void cc_worker::work_ul(const srsran_ul_sf_cfg_t& ul_sf_cfg, stack_interface_phy_lte::ul_sched_t& ul_grants)
+void cc_worker::work_ul(const srsran_ul_sf_cfg_t&            ul_sf_cfg,
+                        stack_interface_phy_lte::ul_sched_t& ul_grants,
+                        srsran::tti_tracer&                  tracer)
 {
   std::lock_guard<std::mutex> lock(mutex);
   ul_sf = ul_sf_cfg;
@@ -220,18 +247,22 @@ void cc_worker::work_ul(const srsran_ul_sf_cfg_t& ul_sf_cfg, stack_interface_phy
 
   // Process UL signal
   srsran_enb_ul_fft(&enb_ul);
+  tracer.stage(LTE_TTI_STAGE_UL_FFT);
 
   // Decode pending UL grants for the tti they were scheduled
   decode_pusch(ul_grants.pusch, ul_grants.nof_grants);
+  tracer.stage(LTE_TTI_STAGE_PUSCH);
 
   // Decode remaining PUCCH ACKs not associated with PUSCH transmission and SR signals
   decode_pucch();
+  tracer.stage(LTE_TTI_STAGE_PUCCH);
 }
 
 void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
                         stack_interface_phy_lte::dl_sched_t& dl_grants,
                         stack_interface_phy_lte::ul_sched_t& ul_grants,
-                        srsran_mbsfn_cfg_t*                  mbsfn_cfg)
+                        srsran_mbsfn_cfg_t*                  mbsfn_cfg,
+                        srsran::tti_tracer&                  tracer)
 {
   std::lock_guard<std::mutex> lock(mutex);
   dl_sf = dl_sf_cfg;
@@ -254,6 +285,7 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
 
   // Put pending PHICH HARQ ACK/NACK indications into subframe
   encode_phich(ul_grants.phich, ul_grants.nof_phich);
+  tracer.stage(LTE_TTI_STAGE_DL_ENCODE);
 
   // Generate signal and transmit
   srsran_enb_dl_gen_signal(&enb_dl);
@@ -281,6 +313,7 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
     // clear measurement flag on cell
     phy->clear_cell_measure_trigger(cc_idx);
   }
+  tracer.stage(LTE_TTI_STAGE_DL_OFDM);
 }
 
 bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
@@ -342,10 +375,14 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
   ul_cfg.pusch.softbuffers.rx = ul_grant.softbuffer_rx;
   pusch_res.data              = ul_grant.data;
   if (pusch_res.data) {
+    uint64_t seq_cache_hits   = enb_ul.pusch.seq_cache.nof_hits;
+    uint64_t seq_cache_misses = enb_ul.pusch.seq_cache.nof_misses;
     if (srsran_enb_ul_get_pusch(&enb_ul, &ul_sf, &ul_cfg.pusch, &pusch_res)) {
       Error("Decoding PUSCH for RNTI %x", rnti);
       return false;
     }
+    ue_db[rnti]->metrics_ul_seq_cache(enb_ul.pusch.seq_cache.nof_hits - seq_cache_hits,
+                                      enb_ul.pusch.seq_cache.nof_misses - seq_cache_misses);
   }
   // Save PHICH scheduling for this user. Each user can have just 1 PUSCH dci per TTI
   ue_db[rnti]->phich_grant.n_prb_lowest = grant.n_prb_tilde[0];
@@ -621,10 +658,14 @@ int cc_worker::encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, u
       }
 
       // Encode PDSCH
+      uint64_t seq_cache_hits   = pdsch_seq_cache_hits(enb_dl.pdsch);
+      uint64_t seq_cache_misses = pdsch_seq_cache_misses(enb_dl.pdsch);
       if (srsran_enb_dl_put_pdsch(&enb_dl, &dl_cfg.pdsch, grants[i].data)) {
         Error("Error putting PDSCH %d", i);
         return SRSRAN_ERROR;
       }
+      seq_cache_hits   = pdsch_seq_cache_hits(enb_dl.pdsch) - seq_cache_hits;
+      seq_cache_misses = pdsch_seq_cache_misses(enb_dl.pdsch) - seq_cache_misses;
 
       // Save pending ACK
       if (SRSRAN_RNTI_ISUSER(rnti)) {
@@ -641,6 +682,7 @@ int cc_worker::encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, u
 
       // Save metrics stats
       ue_db[rnti]->metrics_dl(grants[i].dci.tb[0].mcs_idx);
+      ue_db[rnti]->metrics_dl_seq_cache(seq_cache_hits, seq_cache_misses);
     } else {
       Error("User rnti=0x%x not found in cc_worker=%d", rnti, cc_idx);
     }
@@ -680,6 +722,12 @@ void cc_worker::ue::metrics_dl(uint32_t mcs)
   metrics.dl.n_samples++;
 }
 
+void cc_worker::ue::metrics_dl_seq_cache(uint32_t hits, uint32_t misses)
+{
+  metrics.dl.seq_cache_hits += hits;
+  metrics.dl.seq_cache_misses += misses;
+}
+
 void cc_worker::ue::metrics_ul(uint32_t mcs, float rssi, float sinr, float turbo_iters)
 {
   if (isnan(rssi)) {
@@ -692,6 +740,12 @@ void cc_worker::ue::metrics_ul(uint32_t mcs, float rssi, float sinr, float turbo
   metrics.ul.n_samples++;
 }
 
+void cc_worker::ue::metrics_ul_seq_cache(uint32_t hits, uint32_t misses)
+{
+  metrics.ul.seq_cache_hits += hits;
+  metrics.ul.seq_cache_misses += misses;
+}
+
 void cc_worker::ue::metrics_ul_pucch(float rssi, float ni, float sinr)
 {
   if (isnan(rssi)) {
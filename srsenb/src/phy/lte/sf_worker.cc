@@ -19,6 +19,7 @@
  *
  */
 
+#include "srsran/adt/scope_exit.h"
 #include "srsran/common/threads.h"
 #include "srsran/srsran.h"
 
@@ -163,6 +164,11 @@ void sf_worker::work_imp()
     return;
   }
 
+  srsran::tti_tracer& tracer = phy->tti_trace.get_tracer(get_id());
+  tracer.begin(tti_rx);
+  // Push the record on every return path
+  auto trace_end = srsran::make_scope_exit([&tracer]() { tracer.end(); });
+
   srsran_mbsfn_cfg_t mbsfn_cfg;
   srsran_sf_t        sf_type = phy->is_mbsfn_sf(&mbsfn_cfg, tti_tx_dl) ? SRSRAN_SF_MBSFN : SRSRAN_SF_NORM;
 
@@ -190,7 +196,7 @@ void sf_worker::work_imp()
 
   // Process UL
   for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
-    cc_workers[cc]->work_ul(ul_sf, ul_grants[cc]);
+    cc_workers[cc]->work_ul(ul_sf, ul_grants[cc], tracer);
   }
 
   // Get DL scheduling for the TX TTI from MAC
@@ -215,6 +221,7 @@ void sf_worker::work_imp()
     phy->worker_end(context, true, tx_buffer);
     return;
   }
+  tracer.stage(LTE_TTI_STAGE_MAC_SCHED);
 
   // Configure DL subframe
   dl_sf.tti              = tti_tx_dl;
@@ -231,7 +238,7 @@ void sf_worker::work_imp()
     dl_sf.cfi = SRSRAN_MAX(dl_sf.cfi, 1);
     dl_sf.cfi = SRSRAN_MIN(dl_sf.cfi, 3);
 
-    cc_workers[cc]->work_dl(dl_sf, dl_grants[cc], ul_grants_tx[cc], &mbsfn_cfg);
+    cc_workers[cc]->work_dl(dl_sf, dl_grants[cc], ul_grants_tx[cc], &mbsfn_cfg, tracer);
   }
 
   // Save grants
@@ -246,6 +253,7 @@ void sf_worker::work_imp()
 
   Debug("Sending to radio");
   phy->worker_end(context, true, tx_buffer);
+  tracer.stage(LTE_TTI_STAGE_RADIO_TX);
 
 #ifdef DEBUG_WRITE_FILE
   fwrite(signal_buffer_tx, SRSRAN_SF_LEN_PRB(phy->cell.nof_prb) * sizeof(cf_t), 1, f);
@@ -279,6 +287,8 @@ uint32_t sf_worker::get_metrics(std::vector<phy_metrics_t>& metrics)
       phy_metrics_t* m_ = &metrics_[r];
       m->dl.mcs         = SRSRAN_VEC_SAFE_PMA(m->dl.mcs, m->dl.n_samples, m_->dl.mcs, m_->dl.n_samples);
       m->dl.n_samples += m_->dl.n_samples;
+      m->dl.seq_cache_hits += m_->dl.seq_cache_hits;
+      m->dl.seq_cache_misses += m_->dl.seq_cache_misses;
       m->ul.n          = SRSRAN_VEC_SAFE_PMA(m->ul.n, m->ul.n_samples, m_->ul.n, m_->ul.n_samples);
       m->ul.pusch_sinr = SRSRAN_VEC_SAFE_PMA(m->ul.pusch_sinr, m->ul.n_samples, m_->ul.pusch_sinr, m_->ul.n_samples);
       m->ul.pucch_sinr =
@@ -292,6 +302,8 @@ uint32_t sf_worker::get_metrics(std::vector<phy_metrics_t>& metrics)
       m->ul.turbo_iters = SRSRAN_VEC_SAFE_PMA(m->ul.turbo_iters, m->ul.n_samples, m_->ul.turbo_iters, m_->ul.n_samples);
       m->ul.n_samples += m_->ul.n_samples;
       m->ul.n_samples_pucch += m_->ul.n_samples_pucch;
+      m->ul.seq_cache_hits += m_->ul.seq_cache_hits;
+      m->ul.seq_cache_misses += m_->ul.seq_cache_misses;
     }
   }
   return cnt;
@@ -19,6 +19,8 @@
  *
  */
 #include "srsenb/hdr/phy/lte/worker_pool.h"
+#include "srsran/common/cpu_affinity.h"
+#include "srsran/phy/utils/vector.h"
 
 namespace srsenb {
 namespace lte {
@@ -27,6 +29,8 @@ worker_pool::worker_pool(uint32_t max_workers) : pool(max_workers) {}
 
 bool worker_pool::init(const phy_args_t& args, phy_common* common, srslog::sink& log_sink, int prio)
 {
+  srsran::cpu_affinity_policy* cpu_affinity = srsran::cpu_affinity_policy::get_instance();
+
   // Add workers to workers pool and start threads.
   srslog::basic_levels log_level = srslog::str_to_basic_level(args.log.phy_level);
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
@@ -34,12 +38,22 @@ bool worker_pool::init(const phy_args_t& args, phy_common* common, srslog::sink&
     log.set_level(log_level);
     log.set_hex_dump_max_size(args.log.phy_hex_limit);
 
+    // Initialise the worker in the CPU it will be pinned to, so its buffers are allocated in that NUMA node
     auto w = std::unique_ptr<lte::sf_worker>(new sf_worker(log));
-    w->init(common);
+    cpu_affinity->run_on_next_cpu(srsran::cpu_thread_class::phy, [&args, &w, common]() {
+      srsran_vec_malloc_set_huge_pages(args.huge_pages);
+      w->init(common);
+      srsran_vec_malloc_set_huge_pages(false);
+    });
     pool.init_worker(i, w.get(), prio);
+    cpu_affinity->pin(*w, srsran::cpu_thread_class::phy);
     workers.push_back(std::move(w));
   }
 
+  if (args.nof_phy_threads_min > 0) {
+    pool.set_adaptive(args.nof_phy_threads_min, adaptive_window_nof_tti, adaptive_max_wait_us);
+  }
+
   return true;
 }
 
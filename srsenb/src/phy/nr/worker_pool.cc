@@ -20,6 +20,8 @@
  */
 #include "srsenb/hdr/phy/nr/worker_pool.h"
 #include "srsran/common/band_helper.h"
+#include "srsran/common/cpu_affinity.h"
+#include "srsran/phy/utils/vector.h"
 
 namespace srsenb {
 namespace nr {
@@ -53,16 +55,14 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
   srslog::basic_levels log_level = srslog::str_to_basic_level(args.log.phy_level);
   logger.set_level(log_level);
 
+  srsran::cpu_affinity_policy* cpu_affinity = srsran::cpu_affinity_policy::get_instance();
+
   // Add workers to workers pool and start threads
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
     auto& log = srslog::fetch_basic_logger(fmt::format("{}PHY{}-NR", args.log.id_preamble, i), log_sink);
     log.set_level(log_level);
     log.set_hex_dump_max_size(args.log.phy_hex_limit);
 
-    auto w = new slot_worker(common, stack, *this, log);
-    pool.init_worker(i, w, args.prio);
-    workers.push_back(std::unique_ptr<slot_worker>(w));
-
     slot_worker::args_t w_args     = {};
     uint32_t            cell_index = 0;
     w_args.cell_index              = cell_index;
@@ -74,11 +74,27 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
     w_args.pusch_max_its           = args.pusch_max_its;
     w_args.pusch_min_snr_dB        = args.pusch_min_snr_dB;
 
-    if (not w->init(w_args)) {
+    // Initialise the worker in the CPU it will be pinned to, so its buffers are allocated in that NUMA node
+    auto w   = new slot_worker(common, stack, *this, log);
+    bool ret = false;
+    cpu_affinity->run_on_next_cpu(srsran::cpu_thread_class::phy, [&args, &w_args, w, &ret]() {
+      srsran_vec_malloc_set_huge_pages(args.huge_pages);
+      ret = w->init(w_args);
+      srsran_vec_malloc_set_huge_pages(false);
+    });
+    pool.init_worker(i, w, args.prio);
+    cpu_affinity->pin(*w, srsran::cpu_thread_class::phy);
+    workers.push_back(std::unique_ptr<slot_worker>(w));
+
+    if (not ret) {
       return false;
     }
   }
 
+  if (args.nof_phy_threads_min > 0) {
+    pool.set_adaptive(args.nof_phy_threads_min, adaptive_window_nof_slots, adaptive_max_wait_us);
+  }
+
   return true;
 }
 
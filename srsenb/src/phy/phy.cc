@@ -180,12 +180,23 @@ int phy::init_lte(const phy_args_t&            args,
 
   parse_common_config(cfg);
 
+  // Start tracing the workers before they process any TTI
+  if (args.tti_trace_enable && not cfg.phy_cell_cfg.empty()) {
+    // Stage names in lte_tti_stage_t order
+    std::vector<std::string> stage_names = {"ul_fft", "pusch", "pucch", "mac_sched", "dl_encode", "dl_ofdm", "radio_tx"};
+    if (not workers_common.tti_trace.init(args.tti_trace_filename, stage_names, args.nof_phy_threads)) {
+      phy_log.error("Error initialising TTI trace");
+      return SRSRAN_ERROR;
+    }
+  }
+
   // Add workers to workers pool and start threads
   if (not cfg.phy_cell_cfg.empty()) {
     lte_workers.init(args, &workers_common, log_sink, WORKERS_THREAD_PRIO);
   }
 
   // For each carrier, initialise PRACH worker
+  prach_cfg.enable_batch_detection = args.prach_batch_detect;
   for (uint32_t cc = 0; cc < cfg.phy_cell_cfg.size(); cc++) {
     prach_cfg.root_seq_idx = cfg.phy_cell_cfg[cc].root_seq_idx;
     prach.init(cc,
@@ -207,6 +218,7 @@ void phy::stop()
     tx_rx.stop();
     workers_common.stop();
     lte_workers.stop();
+    workers_common.tti_trace.stop();
     if (nr_workers != nullptr) {
       nr_workers->stop();
     }
@@ -256,6 +268,8 @@ void phy::get_metrics(std::vector<phy_metrics_t>& metrics)
     for (uint32_t j = 0; j < metrics_tmp.size(); j++) {
       metrics[j].dl.n_samples += metrics_tmp[j].dl.n_samples;
       metrics[j].dl.mcs += metrics_tmp[j].dl.n_samples * metrics_tmp[j].dl.mcs;
+      metrics[j].dl.seq_cache_hits += metrics_tmp[j].dl.seq_cache_hits;
+      metrics[j].dl.seq_cache_misses += metrics_tmp[j].dl.seq_cache_misses;
 
       metrics[j].ul.n_samples += metrics_tmp[j].ul.n_samples;
       metrics[j].ul.n_samples_pucch += metrics_tmp[j].ul.n_samples_pucch;
@@ -267,6 +281,8 @@ void phy::get_metrics(std::vector<phy_metrics_t>& metrics)
       metrics[j].ul.pucch_ni += metrics_tmp[j].ul.n_samples_pucch * metrics_tmp[j].ul.pucch_ni;
       metrics[j].ul.pucch_sinr += metrics_tmp[j].ul.n_samples_pucch * metrics_tmp[j].ul.pucch_sinr;
       metrics[j].ul.turbo_iters += metrics_tmp[j].ul.n_samples * metrics_tmp[j].ul.turbo_iters;
+      metrics[j].ul.seq_cache_hits += metrics_tmp[j].ul.seq_cache_hits;
+      metrics[j].ul.seq_cache_misses += metrics_tmp[j].ul.seq_cache_misses;
     }
   }
   for (uint32_t j = 0; j < metrics.size(); j++) {
@@ -373,6 +389,8 @@ int phy::init_nr(const phy_args_t& args, const phy_cfg_t& cfg, stack_interface_p
 
   nr::worker_pool::args_t worker_args = {};
   worker_args.nof_phy_threads         = args.nof_phy_threads;
+  worker_args.nof_phy_threads_min     = args.nof_phy_threads_min;
+  worker_args.huge_pages              = args.huge_pages;
   worker_args.log.phy_level           = args.log.phy_level;
   worker_args.log.phy_hex_limit       = args.log.phy_hex_limit;
   worker_args.pusch_max_its           = args.nr_pusch_max_its;
@@ -20,6 +20,7 @@
  */
 
 #include "srsenb/hdr/phy/prach_worker.h"
+#include "srsran/common/cpu_affinity.h"
 #include "srsran/interfaces/enb_mac_interfaces.h"
 #include "srsran/srsran.h"
 
@@ -38,21 +39,32 @@ int prach_worker::init(const srsran_cell_t&      cell_,
 
   max_prach_offset_us = 50;
 
-  if (srsran_prach_init(&prach, srsran_symbol_sz(cell.nof_prb))) {
-    return -1;
-  }
+  // Without PRACH threads, a single detector runs in the calling thread
+  uint32_t nof_detectors = SRSRAN_MAX(nof_workers, 1);
+  for (uint32_t i = 0; i < nof_detectors; i++) {
+    std::unique_ptr<detector> d(new detector(this));
+    if (srsran_prach_init(&d->prach, srsran_symbol_sz(cell.nof_prb))) {
+      return -1;
+    }
 
-  if (srsran_prach_set_cfg(&prach, &prach_cfg, cell.nof_prb)) {
-    ERROR("Error initiating PRACH");
-    return -1;
-  }
+    if (srsran_prach_set_cfg(&d->prach, &prach_cfg, cell.nof_prb)) {
+      ERROR("Error initiating PRACH");
+      srsran_prach_free(&d->prach);
+      return -1;
+    }
 
-  srsran_prach_set_detect_factor(&prach, 60);
+    srsran_prach_set_detect_factor(&d->prach, 60);
+    detectors.push_back(std::move(d));
+  }
 
-  nof_sf = (uint32_t)ceilf(prach.T_tot * 1000);
+  srsran_prach_t& prach = detectors.front()->prach;
+  nof_sf                = (uint32_t)ceilf(prach.T_tot * 1000);
 
-  if (nof_workers > 0) {
-    start(priority);
+  running = true;
+  for (uint32_t i = 0; i < nof_workers; i++) {
+    detectors[i]->start(priority);
+    // The detectors run sporadically, they may use any of the PHY CPUs
+    srsran::cpu_affinity_policy::get_instance()->pin_class(*detectors[i], srsran::cpu_thread_class::phy);
   }
 
   initiated = true;
@@ -80,15 +92,22 @@ int prach_worker::init(const srsran_cell_t&      cell_,
 
 void prach_worker::stop()
 {
-  running      = false;
-  sf_buffer* s = nullptr;
-  pending_buffers.push(s);
+  running = false;
 
-  if (nof_workers > 0) {
-    wait_thread_finish();
+  // Wake up every detector thread
+  uint32_t nof_threads = SRSRAN_MIN(nof_workers, (uint32_t)detectors.size());
+  for (uint32_t i = 0; i < nof_threads; i++) {
+    sf_buffer* s = nullptr;
+    pending_buffers.push(s);
+  }
+  for (uint32_t i = 0; i < nof_threads; i++) {
+    detectors[i]->wait_thread_finish();
   }
 
-  srsran_prach_free(&prach);
+  for (auto& d : detectors) {
+    srsran_prach_free(&d->prach);
+  }
+  detectors.clear();
 }
 
 void prach_worker::set_max_prach_offset_us(float delay_us)
@@ -99,7 +118,7 @@ void prach_worker::set_max_prach_offset_us(float delay_us)
 int prach_worker::new_tti(uint32_t tti_rx, cf_t* buffer_rx)
 {
   // Save buffer only if it's a PRACH TTI
-  if (srsran_prach_tti_opportunity(&prach, tti_rx, -1) || sf_cnt) {
+  if (srsran_prach_tti_opportunity(&detectors.front()->prach, tti_rx, -1) || sf_cnt) {
     if (sf_cnt == 0) {
       current_buffer = buffer_pool.allocate();
       if (!current_buffer) {
@@ -127,7 +146,7 @@ int prach_worker::new_tti(uint32_t tti_rx, cf_t* buffer_rx)
     if (sf_cnt == nof_sf) {
       sf_cnt = 0;
       if (nof_workers == 0) {
-        run_tti(current_buffer);
+        run_tti(*detectors.front(), current_buffer);
         current_buffer->reset();
         buffer_pool.deallocate(current_buffer);
       } else {
@@ -138,9 +157,13 @@ int prach_worker::new_tti(uint32_t tti_rx, cf_t* buffer_rx)
   return 0;
 }
 
-int prach_worker::run_tti(sf_buffer* b)
+int prach_worker::run_tti(detector& d, sf_buffer* b)
 {
-  uint32_t prach_nof_det = 0;
+  srsran_prach_t& prach         = d.prach;
+  uint32_t*       prach_indices = d.prach_indices;
+  float*          prach_offsets = d.prach_offsets;
+  float*          prach_p2avg   = d.prach_p2avg;
+  uint32_t        prach_nof_det = 0;
   if (srsran_prach_tti_opportunity(&prach, b->tti, -1)) {
     // Detect possible PRACHs
     if (srsran_prach_detect_offset(&prach,
@@ -184,13 +207,12 @@ int prach_worker::run_tti(sf_buffer* b)
   return 0;
 }
 
-void prach_worker::run_thread()
+void prach_worker::run_thread(detector& d)
 {
-  running = true;
   while (running) {
     sf_buffer* b = pending_buffers.wait_pop();
     if (running && b) {
-      int ret = run_tti(b);
+      int ret = run_tti(d, b);
       b->reset();
       buffer_pool.deallocate(b);
       if (ret) {
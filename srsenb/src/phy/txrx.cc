@@ -23,6 +23,7 @@
 
 #include "srsenb/hdr/phy/txrx.h"
 #include "srsran/common/band_helper.h"
+#include "srsran/common/cpu_affinity.h"
 #include "srsran/common/threads.h"
 #include "srsran/srsran.h"
 
@@ -69,6 +70,7 @@ bool txrx::init(enb_time_interface*          enb_,
   }
 
   start(prio_);
+  srsran::cpu_affinity_policy::get_instance()->pin(*this, srsran::cpu_thread_class::radio);
   return true;
 }
 
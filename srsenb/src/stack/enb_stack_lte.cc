@@ -23,6 +23,7 @@
 #include "srsenb/hdr/common/rnti_pool.h"
 #include "srsenb/hdr/enb.h"
 #include "srsenb/hdr/stack/upper/gtpu_pdcp_adapter.h"
+#include "srsran/common/cpu_affinity.h"
 #include "srsran/interfaces/enb_metrics_interface.h"
 #include "srsran/interfaces/enb_x2_interfaces.h"
 #include "srsran/rlc/bearer_mem_pool.h"
@@ -158,6 +159,7 @@ int enb_stack_lte::init(const stack_args_t&      args_,
 
   started = true;
   start(STACK_MAIN_THREAD_PRIO);
+  srsran::cpu_affinity_policy::get_instance()->pin(*this, srsran::cpu_thread_class::stack);
 
   return SRSRAN_SUCCESS;
 }
@@ -47,6 +47,9 @@ mac::mac(srsran::ext_task_sched_handle task_sched_, srslog::basic_logger& logger
 mac::~mac()
 {
   stop();
+  // The UE softbuffers return their code blocks to the pool when they are destroyed
+  softbuffer_pool.reset();
+  srsran_softbuffer_pool_free(&ul_cb_pool);
   pthread_rwlock_destroy(&rwlock);
 }
 
@@ -79,10 +82,29 @@ bool mac::init(const mac_args_t&        args_,
     srsran_softbuffer_tx_init(&cc.rar_softbuffer_tx, args.nof_prb);
   }
 
+  // Width of the stored UL soft bits, 8 and 4 bit need the 8-bit turbo decoder
+  srsran_softbuffer_llr_t ul_llr_format = SRSRAN_SOFTBUFFER_LLR_16BIT;
+  if (srsran_softbuffer_llr_from_nof_bits(args.ul_softbuffer_llr_bits, &ul_llr_format) < SRSRAN_SUCCESS) {
+    logger.error("Invalid UL softbuffer soft bit width %d", args.ul_softbuffer_llr_bits);
+    return false;
+  }
+
+  // Initiate the pool of UL code blocks, the memory is requested as the HARQ processes need it
+  if (args.ul_softbuffer_pool_mb > 0) {
+    if (srsran_softbuffer_pool_init(
+            &ul_cb_pool, SOFTBUFFER_SIZE, ul_llr_format, (uint64_t)args.ul_softbuffer_pool_mb << 20U) <
+        SRSRAN_SUCCESS) {
+      logger.error("Error initialising the UL softbuffer pool");
+      return false;
+    }
+    ul_cb_pool_ptr = &ul_cb_pool;
+  }
+
   // Initiate common pool of softbuffers
-  uint32_t nof_prb          = args.nof_prb;
-  auto     init_softbuffers = [nof_prb](void* ptr) {
-    new (ptr) ue_cc_softbuffers(nof_prb, SRSRAN_FDD_NOF_HARQ, SRSRAN_FDD_NOF_HARQ);
+  uint32_t                  nof_prb          = args.nof_prb;
+  srsran_softbuffer_pool_t* rx_cb_pool       = ul_cb_pool_ptr;
+  auto                      init_softbuffers = [nof_prb, rx_cb_pool, ul_llr_format](void* ptr) {
+    new (ptr) ue_cc_softbuffers(nof_prb, SRSRAN_FDD_NOF_HARQ, SRSRAN_FDD_NOF_HARQ, rx_cb_pool, ul_llr_format);
   };
   auto recycle_softbuffers = [](ue_cc_softbuffers& softbuffers) { softbuffers.clear(); };
   softbuffer_pool.reset(new srsran::background_obj_pool<ue_cc_softbuffers>(
@@ -90,6 +112,10 @@ bool mac::init(const mac_args_t&        args_,
 
   detected_rachs.resize(cells.size());
 
+  if (args.nof_pdu_workers > 0) {
+    pdu_workers.reset(new srsran::task_thread_pool(args.nof_pdu_workers));
+  }
+
   started = true;
   return true;
 }
@@ -100,6 +126,10 @@ void mac::stop()
   if (started) {
     started = false;
 
+    if (pdu_workers != nullptr) {
+      pdu_workers->stop();
+    }
+
     ue_db.clear();
     for (auto& cc : common_buffers) {
       for (int i = 0; i < NOF_BCCH_DLSCH_MSG; i++) {
@@ -264,6 +294,10 @@ void mac::get_metrics(mac_metrics_t& metrics)
     metrics.cc_info[cc].cc_rach_counter = detected_rachs[cc];
     metrics.cc_info[cc].pci             = (cc < cell_config.size()) ? cell_config[cc].cell.id : 0;
   }
+  metrics.ul_softbuffer_pool = {};
+  if (ul_cb_pool_ptr != nullptr) {
+    srsran_softbuffer_pool_get_metrics(ul_cb_pool_ptr, &metrics.ul_softbuffer_pool);
+  }
 }
 
 void mac::toggle_padding()
@@ -317,6 +351,11 @@ int mac::crc_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t
   ue_db[rnti]->set_tti(tti_rx);
   ue_db[rnti]->metrics_rx(crc, nof_bytes);
 
+  // The HARQ process stays idle until its next new transmission, its code blocks can go back to the pool
+  if (crc) {
+    srsran_softbuffer_rx_release(ue_db[rnti]->get_rx_softbuffer(enb_cc_idx, tti_rx));
+  }
+
   rrc_h->set_radiolink_ul_state(rnti, crc);
 
   // Scheduler uses eNB's CC mapping
@@ -658,8 +697,9 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
       return SRSRAN_ERROR;
     }
 
-    int         n            = 0;
-    dl_sched_t* dl_sched_res = &dl_sched_res_list[enb_cc_idx];
+    int               n            = 0;
+    dl_sched_t*       dl_sched_res = &dl_sched_res_list[enb_cc_idx];
+    dl_pdu_job_list_t pdu_jobs;
 
     // Copy data grants
     for (uint32_t i = 0; i < sched_result.data.size(); i++) {
@@ -682,26 +722,8 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
           }
 
           if (sched_result.data[i].nof_pdu_elems[tb] > 0) {
-            /* Get PDU if it's a new transmission */
-            dl_sched_res->pdsch[n].data[tb] = ue_db[rnti]->generate_pdu(enb_cc_idx,
-                                                                        sched_result.data[i].dci.pid,
-                                                                        tb,
-                                                                        sched_result.data[i].pdu[tb],
-                                                                        sched_result.data[i].nof_pdu_elems[tb],
-                                                                        sched_result.data[i].tbs[tb]);
-
-            if (!dl_sched_res->pdsch[n].data[tb]) {
-              logger.error("Error! PDU was not generated (rnti=0x%04x, tb=%d)", rnti, tb);
-            }
-
-            if (pcap) {
-              pcap->write_dl_crnti(
-                  dl_sched_res->pdsch[n].data[tb], sched_result.data[i].tbs[tb], rnti, true, tti_tx_dl, enb_cc_idx);
-            }
-            if (pcap_net) {
-              pcap_net->write_dl_crnti(
-                  dl_sched_res->pdsch[n].data[tb], sched_result.data[i].tbs[tb], rnti, true, tti_tx_dl, enb_cc_idx);
-            }
+            /* Get PDU if it's a new transmission. PDUs are assembled once all data grants are copied */
+            pdu_jobs.push_back({i, (uint32_t)n, tb});
           } else {
             /* TB not enabled OR no data to send: set pointers to NULL  */
             dl_sched_res->pdsch[n].data[tb] = nullptr;
@@ -719,6 +741,25 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
       }
     }
 
+    // Assemble the PDUs of the data grants
+    generate_dl_pdus(tti_tx_dl, enb_cc_idx, sched_result, pdu_jobs, *dl_sched_res);
+    for (const dl_pdu_job_t& job : pdu_jobs) {
+      uint16_t rnti = sched_result.data[job.grant_idx].dci.rnti;
+      uint32_t tbs  = sched_result.data[job.grant_idx].tbs[job.tb_idx];
+      uint8_t* pdu  = dl_sched_res->pdsch[job.pdsch_idx].data[job.tb_idx];
+
+      if (pdu == nullptr) {
+        logger.error("Error! PDU was not generated (rnti=0x%04x, tb=%d)", rnti, job.tb_idx);
+      }
+
+      if (pcap) {
+        pcap->write_dl_crnti(pdu, tbs, rnti, true, tti_tx_dl, enb_cc_idx);
+      }
+      if (pcap_net) {
+        pcap_net->write_dl_crnti(pdu, tbs, rnti, true, tti_tx_dl, enb_cc_idx);
+      }
+    }
+
     // Copy RAR grants
     for (uint32_t i = 0; i < sched_result.rar.size(); i++) {
       // Copy dci info
@@ -821,6 +862,95 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
   return SRSRAN_SUCCESS;
 }
 
+void mac::generate_dl_pdu(uint32_t                               enb_cc_idx,
+                          const sched_interface::dl_sched_res_t& sched_result,
+                          const dl_pdu_job_t&                    job,
+                          dl_sched_t&                            dl_sched_res)
+{
+  const sched_interface::dl_sched_data_t& data = sched_result.data[job.grant_idx];
+
+  dl_sched_res.pdsch[job.pdsch_idx].data[job.tb_idx] =
+      ue_db[data.dci.rnti]->generate_pdu(enb_cc_idx,
+                                         data.dci.pid,
+                                         job.tb_idx,
+                                         data.pdu[job.tb_idx],
+                                         data.nof_pdu_elems[job.tb_idx],
+                                         data.tbs[job.tb_idx]);
+}
+
+void mac::generate_dl_pdus(uint32_t                               tti_tx_dl,
+                           uint32_t                               enb_cc_idx,
+                           const sched_interface::dl_sched_res_t& sched_result,
+                           const dl_pdu_job_list_t&               jobs,
+                           dl_sched_t&                            dl_sched_res)
+{
+  if (pdu_workers == nullptr or jobs.size() < 2) {
+    for (const dl_pdu_job_t& job : jobs) {
+      generate_dl_pdu(enb_cc_idx, sched_result, job, dl_sched_res);
+    }
+    return;
+  }
+
+  // Open the batch of this TTI. A task left in the queue by an earlier TTI sees a different generation and returns
+  dl_pdu_batch_t& batch = dl_pdu_batches[tti_tx_dl];
+  uint64_t        generation;
+  {
+    std::lock_guard<std::mutex> lock(batch.mutex);
+    generation         = ++batch.generation;
+    batch.closed       = false;
+    batch.nof_active   = 0;
+    batch.next_job     = 0;
+    batch.enb_cc_idx   = enb_cc_idx;
+    batch.sched_result = &sched_result;
+    batch.jobs         = &jobs;
+    batch.dl_sched_res = &dl_sched_res;
+  }
+
+  // The task only carries the batch, so it fits in the task storage without an allocation
+  uint32_t nof_helpers = std::min((uint32_t)pdu_workers->nof_workers(), (uint32_t)jobs.size() - 1);
+  for (uint32_t i = 0; i < nof_helpers; ++i) {
+    dl_pdu_batch_t* batch_ptr = &batch;
+    pdu_workers->push_task([this, batch_ptr, generation]() { run_dl_pdu_worker(batch_ptr, generation); });
+  }
+
+  // The calling thread claims jobs until none is left, so all PDUs are assembled even if no worker ever runs
+  run_dl_pdu_jobs(batch);
+
+  // Close the batch and wait only for the workers that joined it, as they reference the scheduler result and the job
+  // list. Workers that have not started yet, or never will because the pool is stopped, return without joining it.
+  std::unique_lock<std::mutex> lock(batch.mutex);
+  batch.closed = true;
+  batch.cvar.wait(lock, [&batch]() { return batch.nof_active == 0; });
+}
+
+void mac::run_dl_pdu_jobs(dl_pdu_batch_t& batch)
+{
+  // Jobs are claimed through a shared index, both by the pool workers and by the calling thread. ue::generate_pdu()
+  // locks the UE, so the TBs of a UE are serialized while the PDUs of different UEs are assembled concurrently.
+  const dl_pdu_job_list_t& jobs = *batch.jobs;
+  for (uint32_t idx = batch.next_job++; idx < jobs.size(); idx = batch.next_job++) {
+    generate_dl_pdu(batch.enb_cc_idx, *batch.sched_result, jobs[idx], *batch.dl_sched_res);
+  }
+}
+
+void mac::run_dl_pdu_worker(dl_pdu_batch_t* batch, uint64_t generation)
+{
+  {
+    std::lock_guard<std::mutex> lock(batch->mutex);
+    if (batch->closed or batch->generation != generation) {
+      return;
+    }
+    batch->nof_active++;
+  }
+
+  run_dl_pdu_jobs(*batch);
+
+  std::lock_guard<std::mutex> lock(batch->mutex);
+  if (--batch->nof_active == 0) {
+    batch->cvar.notify_one();
+  }
+}
+
 void mac::build_mch_sched(uint32_t tbs)
 {
   int sfs_per_sched_period = mcch.pmch_info_list[0].sf_alloc_end;
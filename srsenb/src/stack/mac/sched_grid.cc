@@ -281,20 +281,16 @@ alloc_result sf_grid_t::reserve_ul_prbs(const prbmask_t& prbmask, bool strict)
 bool sf_grid_t::find_ul_alloc(uint32_t L, prb_interval* alloc) const
 {
   *alloc = {};
-  for (uint32_t n = 0; n < ul_mask.size() && alloc->length() < L; n++) {
-    if (not ul_mask.test(n) && alloc->length() == 0) {
-      alloc->displace_to(n);
-    }
-    if (not ul_mask.test(n)) {
-      alloc->resize_by(1);
-    } else if (alloc->length() > 0) {
-      // avoid edges
-      if (n < 3) {
-        *alloc = {};
-      } else {
-        break;
-      }
+  int pos = L > 0 ? ul_mask.find_lowest(0, ul_mask.size(), false) : -1;
+  while (pos >= 0) {
+    uint32_t max_pos = std::min((uint32_t)ul_mask.size(), pos + L);
+    int      pos2    = ul_mask.find_lowest(pos + 1, max_pos, true);
+    if (pos2 < 0 or pos2 >= 3) {
+      *alloc = {(uint32_t)pos, pos2 < 0 ? max_pos : (uint32_t)pos2};
+      break;
     }
+    // avoid edges
+    pos = ul_mask.find_lowest(pos2, ul_mask.size(), false);
   }
   if (alloc->length() == 0) {
     return false;
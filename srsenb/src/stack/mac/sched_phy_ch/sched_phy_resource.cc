@@ -51,26 +51,8 @@ template <typename RBMask,
               typename std::conditional<std::is_same<RBMask, prbmask_t>::value, prb_interval, rbg_interval>::type>
 RBInterval find_contiguous_interval(const RBMask& in_mask, uint32_t max_size)
 {
-  RBInterval max_interv;
-
-  for (size_t n = 0; n < in_mask.size();) {
-    int pos = in_mask.find_lowest(n, in_mask.size(), false);
-    if (pos < 0) {
-      break;
-    }
-
-    size_t     max_pos = std::min(in_mask.size(), (size_t)pos + max_size);
-    int        pos2    = in_mask.find_lowest(pos + 1, max_pos, true);
-    RBInterval interv(pos, pos2 < 0 ? max_pos : pos2);
-    if (interv.length() >= max_size) {
-      return interv;
-    }
-    if (interv.length() > max_interv.length()) {
-      max_interv = interv;
-    }
-    n = interv.stop();
-  }
-  return max_interv;
+  srsran::interval<uint32_t> interv = in_mask.find_lowest_run(0, in_mask.size(), max_size, false);
+  return RBInterval{interv.start(), interv.stop()};
 }
 
 rbgmask_t find_available_rbgmask(const rbgmask_t& in_mask, uint32_t max_size)
@@ -83,13 +65,11 @@ rbgmask_t find_available_rbgmask(const rbgmask_t& in_mask, uint32_t max_size)
     return localmask;
   }
 
-  uint32_t i = 0, nof_alloc = 0;
-  for (; i < localmask.size() and nof_alloc < max_size; ++i) {
-    if (localmask.test(i)) {
-      nof_alloc++;
-    }
+  int i = -1;
+  for (uint32_t nof_alloc = 0; nof_alloc < max_size; ++nof_alloc) {
+    i = localmask.find_lowest(i + 1, localmask.size(), true);
   }
-  localmask.fill(i, localmask.size(), false);
+  localmask.fill(i + 1, localmask.size(), false);
   return localmask;
 }
 
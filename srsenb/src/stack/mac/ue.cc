@@ -32,13 +32,24 @@
 
 namespace srsenb {
 
-ue_cc_softbuffers::ue_cc_softbuffers(uint32_t nof_prb, uint32_t nof_tx_harq_proc_, uint32_t nof_rx_harq_proc_) :
+ue_cc_softbuffers::ue_cc_softbuffers(uint32_t                  nof_prb,
+                                     uint32_t                  nof_tx_harq_proc_,
+                                     uint32_t                  nof_rx_harq_proc_,
+                                     srsran_softbuffer_pool_t* rx_cb_pool,
+                                     srsran_softbuffer_llr_t   rx_llr_format) :
   nof_tx_harq_proc(nof_tx_harq_proc_), nof_rx_harq_proc(nof_rx_harq_proc_)
 {
-  // Create and init Rx buffers
+  // Create and init Rx buffers. With a code block pool, they only hold memory while their HARQ process is active and
+  // store the soft bits with the width of the pool.
   softbuffer_rx_list.resize(nof_rx_harq_proc);
+  uint32_t max_tbs = (uint32_t)srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, nof_prb);
+  uint32_t max_cb  = max_tbs / (SRSRAN_TCOD_MAX_LEN_CB - 24) + 1;
   for (srsran_softbuffer_rx_t& buffer : softbuffer_rx_list) {
-    srsran_softbuffer_rx_init(&buffer, nof_prb);
+    if (rx_cb_pool != nullptr) {
+      srsran_softbuffer_rx_init_pool(&buffer, max_cb, rx_cb_pool);
+    } else {
+      srsran_softbuffer_rx_init_guru_llr(&buffer, max_cb, SOFTBUFFER_SIZE, rx_llr_format);
+    }
   }
 
   // Create and init Tx buffers
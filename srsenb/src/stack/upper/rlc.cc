@@ -37,25 +37,31 @@ void rlc::init(pdcp_interface_rlc*    pdcp_,
   mac    = mac_;
   timers = timers_;
 
-  pthread_rwlock_init(&rwlock, nullptr);
+  for (pthread_rwlock_t& ue_lock : ue_rwlocks) {
+    pthread_rwlock_init(&ue_lock, nullptr);
+  }
 }
 
 void rlc::stop()
 {
-  pthread_rwlock_wrlock(&rwlock);
+  std::lock_guard<std::mutex> lock(users_mutex);
   for (auto& user : users) {
+    srsran::rwlock_write_guard ue_lock(ue_rwlock(user.first));
     user.second.rlc->stop();
   }
   users.clear();
-  pthread_rwlock_unlock(&rwlock);
-  pthread_rwlock_destroy(&rwlock);
+  for (pthread_rwlock_t& ue_lock : ue_rwlocks) {
+    pthread_rwlock_destroy(&ue_lock);
+  }
 }
 
 void rlc::get_metrics(rlc_metrics_t& m, const uint32_t nof_tti)
 {
+  std::lock_guard<std::mutex> lock(users_mutex);
   m.ues.resize(users.size());
   size_t count = 0;
   for (auto& user : users) {
+    srsran::rwlock_read_guard ue_lock(ue_rwlock(user.first));
     user.second.rlc->get_metrics(m.ues[count], nof_tti);
     count++;
   }
@@ -63,44 +69,51 @@ void rlc::get_metrics(rlc_metrics_t& m, const uint32_t nof_tti)
 
 void rlc::add_user(uint16_t rnti)
 {
-  pthread_rwlock_wrlock(&rwlock);
-  if (users.count(rnti) == 0) {
-    auto obj = make_rnti_obj<srsran::rlc>(rnti, logger.id().c_str());
-    obj->init(&users[rnti],
-              &users[rnti],
-              timers,
-              srb_to_lcid(lte_srb::srb0),
-              [rnti, this](uint32_t lcid, uint32_t tx_queue, uint32_t retx_queue) {
-                update_bsr(rnti, lcid, tx_queue, retx_queue);
-              });
-    users[rnti].rnti   = rnti;
-    users[rnti].pdcp   = pdcp;
-    users[rnti].rrc    = rrc;
-    users[rnti].rlc    = std::move(obj);
-    users[rnti].parent = this;
+  std::lock_guard<std::mutex> lock(users_mutex);
+  srsran::rwlock_write_guard  ue_lock(ue_rwlock(rnti));
+  if (users.contains(rnti)) {
+    return;
+  }
+  if (not users.insert(rnti, user_interface{})) {
+    logger.error("Failed to add rnti=0x%x. Slot of the RNTI table is already in use", rnti);
+    return;
   }
-  pthread_rwlock_unlock(&rwlock);
+  user_interface& user = users[rnti];
+  auto            obj  = make_rnti_obj<srsran::rlc>(rnti, logger.id().c_str());
+  obj->init(&user,
+            &user,
+            timers,
+            srb_to_lcid(lte_srb::srb0),
+            [rnti, this](uint32_t lcid, uint32_t tx_queue, uint32_t retx_queue) {
+              update_bsr(rnti, lcid, tx_queue, retx_queue);
+            });
+  user.rnti   = rnti;
+  user.pdcp   = pdcp;
+  user.rrc    = rrc;
+  user.rlc    = std::move(obj);
+  user.parent = this;
 }
 
 void rlc::rem_user(uint16_t rnti)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  std::lock_guard<std::mutex> lock(users_mutex);
+  {
+    srsran::rwlock_read_guard ue_lock(ue_rwlock(rnti));
+    if (not users.contains(rnti)) {
+      logger.error("Removing rnti=0x%x. Already removed", rnti);
+      return;
+    }
     users[rnti].rlc->stop();
-  } else {
-    logger.error("Removing rnti=0x%x. Already removed", rnti);
   }
-  pthread_rwlock_unlock(&rwlock);
 
-  pthread_rwlock_wrlock(&rwlock);
+  srsran::rwlock_write_guard ue_lock(ue_rwlock(rnti));
   users.erase(rnti);
-  pthread_rwlock_unlock(&rwlock);
 }
 
 void rlc::clear_buffer(uint16_t rnti)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  srsran::rwlock_read_guard lock(ue_rwlock(rnti));
+  if (users.contains(rnti)) {
     users[rnti].rlc->empty_queue();
     for (int i = 0; i < SRSRAN_N_RADIO_BEARERS; i++) {
       if (users[rnti].rlc->has_bearer(i)) {
@@ -109,89 +122,80 @@ void rlc::clear_buffer(uint16_t rnti)
     }
     logger.info("Cleared buffer rnti=0x%x", rnti);
   }
-  pthread_rwlock_unlock(&rwlock);
 }
 
 void rlc::add_bearer(uint16_t rnti, uint32_t lcid, const srsran::rlc_config_t& cnfg)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  srsran::rwlock_read_guard lock(ue_rwlock(rnti));
+  if (users.contains(rnti)) {
     users[rnti].rlc->add_bearer(lcid, cnfg);
   }
-  pthread_rwlock_unlock(&rwlock);
 }
 
 void rlc::add_bearer_mrb(uint16_t rnti, uint32_t lcid)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  srsran::rwlock_read_guard lock(ue_rwlock(rnti));
+  if (users.contains(rnti)) {
     users[rnti].rlc->add_bearer_mrb(lcid);
   }
-  pthread_rwlock_unlock(&rwlock);
 }
 
 bool rlc::has_bearer(uint16_t rnti, uint32_t lcid)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  bool result = false;
-  if (users.count(rnti)) {
+  srsran::rwlock_read_guard lock(ue_rwlock(rnti));
+  bool                      result = false;
+  if (users.contains(rnti)) {
     result = users[rnti].rlc->has_bearer(lcid);
   }
-  pthread_rwlock_unlock(&rwlock);
   return result;
 }
 
 void rlc::del_bearer(uint16_t rnti, uint32_t lcid)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  srsran::rwlock_read_guard lock(ue_rwlock(rnti));
+  if (users.contains(rnti)) {
     users[rnti].rlc->del_bearer(lcid);
   }
-  pthread_rwlock_unlock(&rwlock);
 }
 
 bool rlc::suspend_bearer(uint16_t rnti, uint32_t lcid)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  bool result = false;
-  if (users.count(rnti)) {
+  srsran::rwlock_read_guard lock(ue_rwlock(rnti));
+  bool                      result = false;
+  if (users.contains(rnti)) {
     users[rnti].rlc->suspend_bearer(lcid);
     result = true;
   }
-  pthread_rwlock_unlock(&rwlock);
   return result;
 }
 
 bool rlc::is_suspended(uint16_t rnti, uint32_t lcid)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  bool result = false;
-  if (users.count(rnti)) {
+  srsran::rwlock_read_guard lock(ue_rwlock(rnti));
+  bool                      result = false;
+  if (users.contains(rnti)) {
     result = users[rnti].rlc->is_suspended(lcid);
   }
-  pthread_rwlock_unlock(&rwlock);
   return result;
 }
 
 bool rlc::resume_bearer(uint16_t rnti, uint32_t lcid)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  bool result = false;
-  if (users.count(rnti)) {
+  srsran::rwlock_read_guard lock(ue_rwlock(rnti));
+  bool                      result = false;
+  if (users.contains(rnti)) {
     users[rnti].rlc->resume_bearer(lcid);
     result = true;
   }
-  pthread_rwlock_unlock(&rwlock);
   return result;
 }
 
 void rlc::reestablish(uint16_t rnti)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  srsran::rwlock_read_guard lock(ue_rwlock(rnti));
+  if (users.contains(rnti)) {
     users[rnti].rlc->reestablish();
   }
-  pthread_rwlock_unlock(&rwlock);
 }
 
 // In the eNodeB, there is no polling for buffer state from the scheduler.
@@ -206,8 +210,8 @@ int rlc::read_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_b
 {
   int ret;
 
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  srsran::rwlock_read_guard lock(ue_rwlock(rnti));
+  if (users.contains(rnti)) {
     if (rnti != SRSRAN_MRNTI) {
       ret = users[rnti].rlc->read_pdu(lcid, payload, nof_bytes);
     } else {
@@ -216,60 +220,54 @@ int rlc::read_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_b
   } else {
     ret = SRSRAN_ERROR;
   }
-  pthread_rwlock_unlock(&rwlock);
   return ret;
 }
 
 void rlc::write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  srsran::rwlock_read_guard lock(ue_rwlock(rnti));
+  if (users.contains(rnti)) {
     users[rnti].rlc->write_pdu(lcid, payload, nof_bytes);
   }
-  pthread_rwlock_unlock(&rwlock);
 }
 
 void rlc::write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  srsran::rwlock_read_guard lock(ue_rwlock(rnti));
+  if (users.contains(rnti)) {
     if (rnti != SRSRAN_MRNTI) {
       users[rnti].rlc->write_sdu(lcid, std::move(sdu));
     } else {
       users[rnti].rlc->write_sdu_mch(lcid, std::move(sdu));
     }
   }
-  pthread_rwlock_unlock(&rwlock);
 }
 
 void rlc::discard_sdu(uint16_t rnti, uint32_t lcid, uint32_t discard_sn)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  srsran::rwlock_read_guard lock(ue_rwlock(rnti));
+  if (users.contains(rnti)) {
     users[rnti].rlc->discard_sdu(lcid, discard_sn);
   }
-  pthread_rwlock_unlock(&rwlock);
 }
 
 bool rlc::rb_is_um(uint16_t rnti, uint32_t lcid)
 {
-  bool ret = false;
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  bool                      ret = false;
+  srsran::rwlock_read_guard lock(ue_rwlock(rnti));
+  if (users.contains(rnti)) {
     ret = users[rnti].rlc->rb_is_um(lcid);
   }
-  pthread_rwlock_unlock(&rwlock);
   return ret;
 }
 
 bool rlc::sdu_queue_is_full(uint16_t rnti, uint32_t lcid)
 {
-  bool ret = false;
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  bool                      ret = false;
+  srsran::rwlock_read_guard lock(ue_rwlock(rnti));
+  if (users.contains(rnti)) {
     ret = users[rnti].rlc->sdu_queue_is_full(lcid);
   }
-  pthread_rwlock_unlock(&rwlock);
   return ret;
 }
 
@@ -67,6 +67,12 @@ public:
     metrics[0].phy[0].ul.pucch_sinr = 14.2;
     metrics[0].phy[0].ul.pusch_sinr = 14.2;
 
+    metrics[0].stack.mac.ul_softbuffer_pool.nof_cb_used  = 120;
+    metrics[0].stack.mac.ul_softbuffer_pool.max_cb_used  = 512;
+    metrics[0].stack.mac.ul_softbuffer_pool.nof_bytes    = 64 << 20;
+    metrics[0].stack.mac.ul_softbuffer_pool.nof_chunks   = 32;
+    metrics[0].stack.mac.ul_softbuffer_pool.nof_failures = 3;
+
     metrics[0].rf.rf_o = 10;
     metrics[0].nr_stack.mac.ues.resize(1);
     metrics[0].nr_stack.mac.ues[0].rnti       = 0x4601;
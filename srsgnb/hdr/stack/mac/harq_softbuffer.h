@@ -79,10 +79,18 @@ class rx_harq_softbuffer
 {
 public:
   rx_harq_softbuffer() { bzero(&buffer, sizeof(buffer)); }
-  explicit rx_harq_softbuffer(uint32_t nof_prb_)
+  explicit rx_harq_softbuffer(uint32_t                  nof_prb_,
+                              srsran_softbuffer_pool_t* cb_pool    = nullptr,
+                              srsran_softbuffer_llr_t   llr_format = SRSRAN_SOFTBUFFER_LLR_8BIT)
   {
-    // Note: for now we use same size regardless of nof_prb_
-    srsran_softbuffer_rx_init_guru(&buffer, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB);
+    // Note: for now we use same size regardless of nof_prb_. The LDPC decoder works in 8-bit, there is no point in
+    // storing 16-bit soft bits.
+    if (cb_pool != nullptr) {
+      srsran_softbuffer_rx_init_pool(&buffer, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, cb_pool);
+    } else {
+      srsran_softbuffer_rx_init_guru_llr(
+          &buffer, SRSRAN_SCH_NR_MAX_NOF_CB_LDPC, SRSRAN_LDPC_MAX_LEN_ENCODED_CB, llr_format);
+    }
   }
   rx_harq_softbuffer(const rx_harq_softbuffer&) = delete;
   rx_harq_softbuffer(rx_harq_softbuffer&& other) noexcept
@@ -104,6 +112,7 @@ public:
 
   void reset() { srsran_softbuffer_rx_reset(&buffer); }
   void reset(uint32_t tbs_bits) { srsran_softbuffer_rx_reset_tbs(&buffer, tbs_bits); }
+  void release() { srsran_softbuffer_rx_release(&buffer); }
 
   srsran_softbuffer_rx_t&       operator*() { return buffer; }
   const srsran_softbuffer_rx_t& operator*() const { return buffer; }
@@ -128,6 +137,14 @@ public:
 
   void init_pool(uint32_t nof_prb, uint32_t batch_size = MAX_HARQ * 4, uint32_t thres = 0, uint32_t init_size = 0);
 
+  /// Makes the Rx softbuffers created from now on take their code blocks from a shared pool of huge pages, so they only
+  /// hold memory while their HARQ process is active.
+  bool init_rx_cb_pool(uint64_t max_bytes);
+  void get_rx_cb_pool_metrics(srsran_softbuffer_pool_metrics_t& metrics);
+
+  /// Sets the width of the soft bits stored by the Rx softbuffers, it must be called before any of them is created.
+  bool set_rx_llr_format(srsran_softbuffer_llr_t llr_format);
+
   srsran::unique_pool_ptr<tx_harq_softbuffer> get_tx(uint32_t nof_prb);
   srsran::unique_pool_ptr<rx_harq_softbuffer> get_rx(uint32_t nof_prb);
 
@@ -141,9 +158,13 @@ private:
   const static uint32_t MAX_HARQ = 16;
 
   harq_softbuffer_pool() = default;
+  ~harq_softbuffer_pool();
 
   std::array<std::unique_ptr<srsran::obj_pool_itf<tx_harq_softbuffer> >, SRSRAN_MAX_PRB_NR> tx_pool;
   std::array<std::unique_ptr<srsran::obj_pool_itf<rx_harq_softbuffer> >, SRSRAN_MAX_PRB_NR> rx_pool;
+  srsran_softbuffer_pool_t                                                                 rx_cb_pool     = {};
+  srsran_softbuffer_pool_t*                                                                rx_cb_pool_ptr = nullptr;
+  srsran_softbuffer_llr_t rx_llr_format = SRSRAN_SOFTBUFFER_LLR_8BIT;
 };
 
 } // namespace srsenb
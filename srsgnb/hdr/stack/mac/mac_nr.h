@@ -41,6 +41,8 @@ struct mac_nr_args_t {
   int                              fixed_ul_mcs = -1;
   sched_nr_interface::sched_args_t sched_cfg    = {};
   srsenb::pcap_args_t              pcap;
+  uint32_t                         ul_softbuffer_pool_mb  = 0; ///< Memory of the shared UL code block pool, 0 disables it
+  uint32_t                         ul_softbuffer_llr_bits = 8; ///< Width of the stored UL soft bits, 8 or 4
 };
 
 class sched_nr;
@@ -73,6 +73,10 @@ private:
   int ue_cfg_impl(uint16_t rnti, const ue_cfg_t& cfg);
   int add_ue_impl(uint16_t rnti, sched_nr_impl::unique_ue_ptr u);
 
+  /// Processes the events that are not carrier-specific and prepares CA-enabled UEs for a new slot
+  void      start_slot(slot_point slot_tx);
+  dl_res_t* run_cc_slot(slot_point slot_tx, uint32_t cc);
+
   // args
   sched_nr_impl::sched_params_t cfg;
   srslog::basic_logger*         logger = nullptr;
@@ -96,6 +100,10 @@ private:
   // metrics extraction
   class ue_metrics_manager;
   std::unique_ptr<ue_metrics_manager> metrics_handler;
+
+  // scheduling of slots ahead of the PHY in per-carrier threads
+  class slot_pipeline;
+  std::unique_ptr<slot_pipeline> pipeline;
 };
 
 } // namespace srsenb
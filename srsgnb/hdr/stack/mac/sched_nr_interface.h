@@ -35,14 +35,15 @@
 
 namespace srsenb {
 
-const static size_t   SCHED_NR_MAX_CARRIERS     = 4;
-const static uint16_t SCHED_NR_INVALID_RNTI     = 0;
-const static size_t   SCHED_NR_MAX_NOF_RBGS     = 18;
-const static size_t   SCHED_NR_MAX_TB           = 1;
-const static size_t   SCHED_NR_MAX_HARQ         = SRSRAN_DEFAULT_HARQ_PROC_DL_NR;
-const static size_t   SCHED_NR_MAX_BWP_PER_CELL = 2;
-const static size_t   SCHED_NR_MAX_LCID         = srsran::MAX_NR_NOF_BEARERS;
-const static size_t   SCHED_NR_MAX_LC_GROUP     = 7;
+const static size_t   SCHED_NR_MAX_CARRIERS       = 4;
+const static uint16_t SCHED_NR_INVALID_RNTI       = 0;
+const static size_t   SCHED_NR_MAX_NOF_RBGS       = 18;
+const static size_t   SCHED_NR_MAX_TB             = 1;
+const static size_t   SCHED_NR_MAX_HARQ           = SRSRAN_DEFAULT_HARQ_PROC_DL_NR;
+const static size_t   SCHED_NR_MAX_BWP_PER_CELL   = 2;
+const static size_t   SCHED_NR_MAX_PIPELINE_SLOTS = 4;
+const static size_t   SCHED_NR_MAX_LCID           = srsran::MAX_NR_NOF_BEARERS;
+const static size_t   SCHED_NR_MAX_LC_GROUP       = 7;
 
 struct sched_nr_ue_cc_cfg_t {
   bool     active = false;
@@ -122,6 +123,7 @@ public:
     bool        auto_refill_buffer = false;
     int         fixed_dl_mcs       = 28;
     int         fixed_ul_mcs       = 28;
+    uint32_t    nof_pipeline_slots = 0; ///< Slots scheduled ahead of the PHY in per-carrier threads (0 to disable)
     std::string logger_name        = "MAC-NR";
   };
 
@@ -253,24 +253,11 @@ find_next_empty_interval(const prb_bitmap& mask, size_t start_prb_idx = 0, size_
   return {};
 }
 
+/// Finds the lowest interval of "nof_prbs" empty PRBs. If no such interval exists, the longest one is returned
 inline prb_interval find_empty_interval_of_length(const prb_bitmap& mask, size_t nof_prbs, uint32_t start_prb_idx = 0)
 {
-  prb_interval max_interv;
-  do {
-    prb_interval interv = find_next_empty_interval(mask, start_prb_idx, mask.size());
-    if (interv.empty()) {
-      break;
-    }
-    if (interv.length() >= nof_prbs) {
-      max_interv.set(interv.start(), interv.start() + nof_prbs);
-      break;
-    }
-    if (interv.length() > max_interv.length()) {
-      max_interv = interv;
-    }
-    start_prb_idx = interv.stop() + 1;
-  } while (start_prb_idx < mask.size());
-  return max_interv;
+  srsran::interval<uint32_t> interv = mask.find_lowest_run(start_prb_idx, mask.size(), nof_prbs, false);
+  return {interv.start(), interv.stop()};
 }
 
 } // namespace sched_nr_impl
@@ -21,6 +21,7 @@
 
 #include "srsgnb/hdr/stack/mac/harq_softbuffer.h"
 #include "srsran/adt/pool/obj_pool.h"
+#include "srsran/srslog/srslog.h"
 
 namespace srsenb {
 
@@ -42,12 +43,70 @@ void harq_softbuffer_pool::init_pool(uint32_t nof_prb, uint32_t batch_size, uint
   tx_pool[idx].reset(new srsran::background_obj_pool<tx_harq_softbuffer>(
       batch_size, thres, init_size, init_tx_softbuffers, recycle_tx_softbuffers));
 
-  auto init_rx_softbuffers    = [nof_prb](void* ptr) { new (ptr) rx_harq_softbuffer(nof_prb); };
-  auto recycle_rx_softbuffers = [](rx_harq_softbuffer& softbuffer) { softbuffer.reset(); };
+  srsran_softbuffer_pool_t* cb_pool                = rx_cb_pool_ptr;
+  srsran_softbuffer_llr_t   llr_format             = rx_llr_format;
+  auto                      init_rx_softbuffers    = [nof_prb, cb_pool, llr_format](void* ptr) {
+    new (ptr) rx_harq_softbuffer(nof_prb, cb_pool, llr_format);
+  };
+  auto                      recycle_rx_softbuffers = [](rx_harq_softbuffer& softbuffer) { softbuffer.reset(); };
   rx_pool[idx].reset(new srsran::background_obj_pool<rx_harq_softbuffer>(
       batch_size, thres, init_size, init_rx_softbuffers, recycle_rx_softbuffers));
 }
 
+harq_softbuffer_pool::~harq_softbuffer_pool()
+{
+  // The softbuffers return their code blocks to the pool when they are destroyed
+  for (auto& pool : rx_pool) {
+    pool.reset();
+  }
+  srsran_softbuffer_pool_free(&rx_cb_pool);
+}
+
+bool harq_softbuffer_pool::init_rx_cb_pool(uint64_t max_bytes)
+{
+  if (rx_cb_pool_ptr != nullptr) {
+    return true;
+  }
+  for (auto& pool : rx_pool) {
+    if (pool != nullptr) {
+      srslog::fetch_basic_logger("MAC-NR").warning("The Rx softbuffers already exist, they do not use the pool");
+      return false;
+    }
+  }
+  if (srsran_softbuffer_pool_init(&rx_cb_pool, SRSRAN_LDPC_MAX_LEN_ENCODED_CB, rx_llr_format, max_bytes) <
+      SRSRAN_SUCCESS) {
+    return false;
+  }
+  rx_cb_pool_ptr = &rx_cb_pool;
+  return true;
+}
+
+bool harq_softbuffer_pool::set_rx_llr_format(srsran_softbuffer_llr_t llr_format)
+{
+  if (llr_format == rx_llr_format) {
+    return true;
+  }
+  if (llr_format == SRSRAN_SOFTBUFFER_LLR_16BIT or rx_cb_pool_ptr != nullptr) {
+    return false;
+  }
+  for (auto& pool : rx_pool) {
+    if (pool != nullptr) {
+      srslog::fetch_basic_logger("MAC-NR").warning("The Rx softbuffers already exist, they keep their soft bit width");
+      return false;
+    }
+  }
+  rx_llr_format = llr_format;
+  return true;
+}
+
+void harq_softbuffer_pool::get_rx_cb_pool_metrics(srsran_softbuffer_pool_metrics_t& metrics)
+{
+  metrics = {};
+  if (rx_cb_pool_ptr != nullptr) {
+    srsran_softbuffer_pool_get_metrics(rx_cb_pool_ptr, &metrics);
+  }
+}
+
 srsran::unique_pool_ptr<tx_harq_softbuffer> harq_softbuffer_pool::get_tx(uint32_t nof_prb)
 {
   srsran_assert(nof_prb <= SRSRAN_MAX_PRB_NR, "Invalid Nprb=%d", nof_prb);
@@ -245,6 +245,20 @@ int mac_nr::init(const mac_nr_args_t&    args_,
     pcap->open(args.pcap.filename);
   }
 
+  // The soft bit width must be set before the pool, which inherits it
+  srsran_softbuffer_llr_t ul_llr_format = SRSRAN_SOFTBUFFER_LLR_8BIT;
+  if (srsran_softbuffer_llr_from_nof_bits(args.ul_softbuffer_llr_bits, &ul_llr_format) < SRSRAN_SUCCESS or
+      not harq_softbuffer_pool::get_instance().set_rx_llr_format(ul_llr_format)) {
+    logger.error("Invalid UL softbuffer soft bit width %d", args.ul_softbuffer_llr_bits);
+    return SRSRAN_ERROR;
+  }
+
+  if (args.ul_softbuffer_pool_mb > 0 and
+      not harq_softbuffer_pool::get_instance().init_rx_cb_pool((uint64_t)args.ul_softbuffer_pool_mb << 20U)) {
+    logger.error("Error initialising the UL softbuffer pool");
+    return SRSRAN_ERROR;
+  }
+
   logger.info("Started");
 
   started = true;
@@ -287,6 +301,7 @@ void mac_nr::get_metrics_nolock(srsenb::mac_metrics_t& metrics)
     metrics.cc_info[cc].cc_rach_counter = detected_rachs[cc];
     metrics.cc_info[cc].pci             = (cc < cell_config.size()) ? cell_config[cc].pci : 0;
   }
+  harq_softbuffer_pool::get_instance().get_rx_cb_pool_metrics(metrics.ul_softbuffer_pool);
 }
 
 int mac_nr::cell_cfg(const std::vector<srsenb::sched_nr_cell_cfg_t>& nr_cells)
@@ -292,6 +292,122 @@ private:
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Class that schedules slots ahead of the PHY in dedicated per-carrier threads. The {slot, cc} results are handed off
+/// to the PHY through a ring of atomic slot tags, so fetching a result that is already available does not lock
+class sched_nr::slot_pipeline
+{
+public:
+  slot_pipeline(sched_nr& parent_, uint32_t nof_slots_ahead_) :
+    parent(parent_), nof_slots_ahead(nof_slots_ahead_), carriers(parent_.cfg.cells.size())
+  {
+    for (uint32_t cc = 0; cc < carriers.size(); ++cc) {
+      carriers[cc].reset(new carrier_t{});
+      carriers[cc]->worker.reset(new srsran::task_worker(fmt::format("SCHED_CC{}", cc), TTIMOD_SZ));
+    }
+  }
+
+  void stop()
+  {
+    for (std::unique_ptr<carrier_t>& c : carriers) {
+      c->worker->stop();
+    }
+  }
+
+  /// Launches the scheduling of all the slots up to slot_tx + nof_slots_ahead that were not launched yet
+  void slot_indication(slot_point slot_tx)
+  {
+    slot_point last_slot = slot_tx + nof_slots_ahead;
+    slot_point slot;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (not next_slot.valid() or last_slot < next_slot - 1 or next_slot + TTIMOD_SZ <= slot_tx) {
+        // First slot or discontinuity in the slot indications. The earlier slots are never scheduled
+        first_slot = slot_tx;
+        next_slot  = slot_tx;
+      }
+      slot = next_slot;
+    }
+    for (; slot <= last_slot; ++slot) {
+      launch_slot(slot);
+    }
+  }
+
+  /// Blocks until the {slot_tx, cc} DL result is available. The UL result for slot_tx is complete at the same time
+  dl_res_t* get_dl_sched(slot_point slot_tx, uint32_t cc)
+  {
+    slot_result_t& res = carriers[cc]->results[slot_tx.to_uint()];
+    if (res.slot_idx.load(std::memory_order_acquire) != slot_tx.to_uint()) {
+      // The carrier thread did not finish the slot yet
+      std::unique_lock<std::mutex> lock(mutex);
+      cvar.wait(lock, [&res, slot_tx]() { return res.slot_idx.load(std::memory_order_acquire) == slot_tx.to_uint(); });
+    }
+    return res.dl_res;
+  }
+
+  /// Blocks until the {slot_ul, cc} UL result is available. A slot that was not launched since the pipeline start, or
+  /// whose result was already overwritten, is never going to be produced, so an empty UL result is returned instead
+  ul_res_t* get_ul_sched(slot_point slot_ul, uint32_t cc)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (not first_slot.valid() or slot_ul < first_slot or slot_ul >= next_slot or slot_ul + TTIMOD_SZ < next_slot) {
+        return &carriers[cc]->empty_ul_res;
+      }
+    }
+    get_dl_sched(slot_ul, cc);
+    return parent.cc_workers[cc]->get_ul_sched(slot_ul);
+  }
+
+private:
+  struct slot_result_t {
+    std::atomic<uint32_t> slot_idx{std::numeric_limits<uint32_t>::max()};
+    dl_res_t*             dl_res = nullptr;
+  };
+  struct carrier_t {
+    std::unique_ptr<srsran::task_worker>             worker;
+    srsran::circular_array<slot_result_t, TTIMOD_SZ> results;
+    ul_res_t                                         empty_ul_res = {};
+  };
+
+  void launch_slot(slot_point slot_tx)
+  {
+    // The UE database and the common UE state can only be updated once all carriers completed the previous slot
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cvar.wait(lock, [this]() { return nof_cc_pending == 0; });
+      nof_cc_pending = carriers.size();
+      next_slot      = slot_tx + 1;
+    }
+    parent.start_slot(slot_tx);
+
+    for (uint32_t cc = 0; cc < carriers.size(); ++cc) {
+      carriers[cc]->worker->push_task([this, slot_tx, cc]() {
+        slot_result_t& res = carriers[cc]->results[slot_tx.to_uint()];
+        res.dl_res         = parent.run_cc_slot(slot_tx, cc);
+        res.slot_idx.store(slot_tx.to_uint(), std::memory_order_release);
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          nof_cc_pending--;
+        }
+        cvar.notify_all();
+      });
+    }
+  }
+
+  sched_nr&      parent;
+  const uint32_t nof_slots_ahead;
+  slot_point     first_slot; ///< First slot launched since the start of the pipeline
+  slot_point     next_slot;  ///< Next slot to be launched
+
+  std::vector<std::unique_ptr<carrier_t> > carriers;
+
+  std::mutex              mutex;
+  std::condition_variable cvar;
+  uint32_t                nof_cc_pending = 0;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 sched_nr::sched_nr() : logger(&srslog::fetch_basic_logger("MAC-NR")), metrics_handler(new ue_metrics_manager{ue_db}) {}
 
 sched_nr::~sched_nr()
@@ -301,6 +417,9 @@ sched_nr::~sched_nr()
 
 void sched_nr::stop()
 {
+  if (pipeline != nullptr) {
+    pipeline->stop();
+  }
   metrics_handler->stop();
 }
 
@@ -326,6 +445,17 @@ int sched_nr::config(const sched_args_t& sched_cfg, srsran::const_span<sched_nr_
     cc_workers[cc].reset(new slot_cc_worker{cfg.cells[cc]});
   }
 
+  // Initiate per-carrier threads that schedule slots ahead of the PHY
+  if (cfg.sched_cfg.nof_pipeline_slots > SCHED_NR_MAX_PIPELINE_SLOTS) {
+    logger->error("Invalid number of pipelined slots=%d (max=%zd)",
+                  cfg.sched_cfg.nof_pipeline_slots,
+                  SCHED_NR_MAX_PIPELINE_SLOTS);
+    return SRSRAN_ERROR;
+  }
+  if (cfg.sched_cfg.nof_pipeline_slots > 0) {
+    pipeline.reset(new slot_pipeline{*this, cfg.sched_cfg.nof_pipeline_slots});
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -370,12 +500,24 @@ int sched_nr::ue_cfg_impl(uint16_t rnti, const ue_cfg_t& uecfg)
 // NOTE: there is no parallelism in these operations
 void sched_nr::slot_indication(slot_point slot_tx)
 {
+  current_slot_tx = slot_tx;
+
+  if (pipeline != nullptr) {
+    // slot_tx was already scheduled. Launch the scheduling of the following slots in the carrier threads
+    pipeline->slot_indication(slot_tx);
+    return;
+  }
+
   srsran_assert(worker_count.load(std::memory_order_relaxed) == 0,
                 "Call of sched slot_indication when previous TTI has not been completed");
   // mark the start of slot.
-  current_slot_tx = slot_tx;
   worker_count.store(static_cast<int>(cfg.cells.size()), std::memory_order_relaxed);
 
+  start_slot(slot_tx);
+}
+
+void sched_nr::start_slot(slot_point slot_tx)
+{
   // process non-cc specific feedback if pending (e.g. SRs, buffer state updates, UE config) for CA-enabled UEs
   // Note: non-CA UEs are updated later in get_dl_sched, to leverage parallelism
   pending_events->process_common(ue_db);
@@ -397,18 +539,11 @@ sched_nr::dl_res_t* sched_nr::get_dl_sched(slot_point pdsch_tti, uint32_t cc)
 {
   srsran_assert(pdsch_tti == current_slot_tx, "Unexpected pdsch_tti slot received");
 
-  // process non-cc specific feedback if pending (e.g. SRs, buffer state updates, UE config) for non-CA UEs
-  pending_events->process_cc_events(ue_db, cc);
-
-  // prepare non-CA UEs internal state for new slot
-  for (auto& u : ue_db) {
-    if (not u.second->has_ca() and u.second->carriers[cc] != nullptr) {
-      u.second->new_slot(current_slot_tx);
-    }
+  if (pipeline != nullptr) {
+    return pipeline->get_dl_sched(pdsch_tti, cc);
   }
 
-  // Process pending CC-specific feedback, generate {slot_idx,cc} scheduling decision
-  sched_nr::dl_res_t* ret = cc_workers[cc]->run_slot(pdsch_tti, ue_db);
+  sched_nr::dl_res_t* ret = run_cc_slot(pdsch_tti, cc);
 
   // decrement the number of active workers
   int rem_workers = worker_count.fetch_sub(1, std::memory_order_release) - 1;
@@ -421,9 +556,29 @@ sched_nr::dl_res_t* sched_nr::get_dl_sched(slot_point pdsch_tti, uint32_t cc)
   return ret;
 }
 
+sched_nr::dl_res_t* sched_nr::run_cc_slot(slot_point slot_tx, uint32_t cc)
+{
+  // process non-cc specific feedback if pending (e.g. SRs, buffer state updates, UE config) for non-CA UEs
+  pending_events->process_cc_events(ue_db, cc);
+
+  // prepare non-CA UEs internal state for new slot
+  for (auto& u : ue_db) {
+    if (not u.second->has_ca() and u.second->carriers[cc] != nullptr) {
+      u.second->new_slot(slot_tx);
+    }
+  }
+
+  // Process pending CC-specific feedback, generate {slot_idx,cc} scheduling decision
+  return cc_workers[cc]->run_slot(slot_tx, ue_db);
+}
+
 /// Fetch {ul_slot,cc} UL scheduling decision
 sched_nr::ul_res_t* sched_nr::get_ul_sched(slot_point slot_ul, uint32_t cc)
 {
+  if (pipeline != nullptr) {
+    // Wait for the carrier thread to finish the slot
+    return pipeline->get_ul_sched(slot_ul, cc);
+  }
   return cc_workers[cc]->get_ul_sched(slot_ul);
 }
 
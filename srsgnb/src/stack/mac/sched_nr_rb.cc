@@ -76,16 +76,14 @@ uint32_t bwp_rb_bitmap::prb_to_rbg_idx(uint32_t prb_idx) const
 
 void bwp_rb_bitmap::add_prbs_to_rbgs(const prb_bitmap& grant)
 {
-  int idx = 0;
-  do {
-    idx = grant.find_lowest(idx, grant.size(), true);
-    if (idx < 0) {
-      return;
-    }
-    uint32_t rbg_idx = prb_to_rbg_idx(idx);
-    rbgs_.set(rbg_idx, true);
-    idx++;
-  } while (idx != (int)prbs_.size());
+  // Mark the RBGs overlapping each contiguous run of PRBs of the grant
+  int start = grant.find_lowest(0, grant.size(), true);
+  while (start >= 0) {
+    int          stop = grant.find_lowest(start + 1, grant.size(), false);
+    prb_interval run(start, (uint32_t)(stop < 0 ? grant.size() : stop));
+    add_prbs_to_rbgs(run);
+    start = stop < 0 ? -1 : grant.find_lowest(stop, grant.size(), true);
+  }
 }
 
 void bwp_rb_bitmap::add_prbs_to_rbgs(const prb_interval& grant)
@@ -97,17 +95,16 @@ void bwp_rb_bitmap::add_prbs_to_rbgs(const prb_interval& grant)
 
 void bwp_rb_bitmap::add_rbgs_to_prbs(const rbg_bitmap& grant)
 {
-  int idx = 0;
-  do {
-    idx = grant.find_lowest(idx, grant.size(), true);
-    if (idx < 0) {
-      return;
-    }
-    uint32_t prb_idx = (idx - 1) * P_ + first_rbg_size;
-    uint32_t prb_end = std::min(prb_idx + ((idx == 0) ? first_rbg_size : P_), (uint32_t)prbs_.size());
+  // Mark the PRBs of each contiguous run of RBGs of the grant
+  int start = grant.find_lowest(0, grant.size(), true);
+  while (start >= 0) {
+    int      stop    = grant.find_lowest(start + 1, grant.size(), false);
+    uint32_t rbg_end = (uint32_t)(stop < 0 ? grant.size() : stop);
+    uint32_t prb_idx = start == 0 ? 0 : (start - 1) * P_ + first_rbg_size;
+    uint32_t prb_end = std::min((rbg_end - 1) * P_ + first_rbg_size, (uint32_t)prbs_.size());
     prbs_.fill(prb_idx, prb_end);
-    idx++;
-  } while (idx != (int)prbs_.size());
+    start = stop < 0 ? -1 : grant.find_lowest(stop, grant.size(), true);
+  }
 }
 
 } // namespace sched_nr_impl
@@ -53,7 +53,8 @@ dl_sched_res_t* cc_worker::run_slot(slot_point tx_sl, ue_map_t& ue_db)
   }
   while (last_tx_sl != tx_sl) {
     last_tx_sl++;
-    slot_point old_slot = last_tx_sl - TX_ENB_DELAY - 1;
+    // Results of slots scheduled ahead of the PHY must be kept until the PHY consumes them
+    slot_point old_slot = last_tx_sl - TX_ENB_DELAY - 1 - cfg.sched_args.nof_pipeline_slots;
     for (bwp_manager& bwp : bwps) {
       bwp.grid[old_slot].reset();
     }
@@ -73,7 +73,7 @@ public:
   uint32_t pdsch_count          = 0;
 };
 
-void run_sched_nr_test(uint32_t nof_workers)
+void run_sched_nr_test(uint32_t nof_workers, uint32_t nof_pipeline_slots = 0)
 {
   srsran_assert(nof_workers > 0, "There must be at least one worker");
   uint32_t max_nof_ttis = 1000, nof_sectors = 4;
@@ -81,6 +81,7 @@ void run_sched_nr_test(uint32_t nof_workers)
 
   sched_nr_interface::sched_args_t cfg;
   cfg.auto_refill_buffer = true;
+  cfg.nof_pipeline_slots = nof_pipeline_slots;
 
   std::vector<sched_nr_cell_cfg_t> cells_cfg = get_default_cells_cfg(nof_sectors);
 
@@ -88,12 +89,19 @@ void run_sched_nr_test(uint32_t nof_workers)
   if (nof_workers > 1) {
     test_name = fmt::format("Parallel Test with {} workers", nof_workers);
   }
+  if (nof_pipeline_slots > 0) {
+    test_name = fmt::format("Pipelined Test with {} workers and {} slots ahead", nof_workers, nof_pipeline_slots);
+  }
   sched_nr_tester tester(cfg, cells_cfg, test_name, nof_workers);
 
+  // The scheduler only sees a new UE in the slots launched after its configuration. In pipelined mode, the UE is
+  // configured before the pipeline starts, so that every slot checked with the UE was scheduled with it
+  uint32_t ue_cfg_slot = nof_pipeline_slots > 0 ? 0 : 9;
+
   for (uint32_t nof_slots = 0; nof_slots < max_nof_ttis; ++nof_slots) {
     slot_point slot_rx(0, nof_slots % 10240);
     slot_point slot_tx = slot_rx + TX_ENB_DELAY;
-    if (nof_slots == 9) {
+    if (nof_slots == ue_cfg_slot) {
       sched_nr_interface::ue_cfg_t uecfg = get_default_ue_cfg(nof_sectors);
       uecfg.lc_ch_to_add.emplace_back();
       uecfg.lc_ch_to_add.back().lcid          = 1;
@@ -113,6 +121,42 @@ void run_sched_nr_test(uint32_t nof_workers)
   printf("Total time taken per slot: %f usec\n", final_avg_usec);
 }
 
+/// The PHY fetches the UL result of the RX slot right after indicating the TX slot. The RX slot precedes the start of
+/// the pipeline, so it is never scheduled and an empty result must be returned without waiting for it
+void test_pipeline_start_ul_sched()
+{
+  srsran::test_delimit_logger delimiter{"Pipelined UL result of slots before the pipeline start"};
+
+  sched_nr_interface::sched_args_t cfg;
+  cfg.nof_pipeline_slots = 2;
+
+  std::vector<sched_nr_cell_cfg_t> cells_cfg = get_default_cells_cfg(1);
+
+  sched_nr sched;
+  TESTASSERT(sched.config(cfg, cells_cfg) == SRSRAN_SUCCESS);
+
+  // First slot indication
+  slot_point slot_rx(0, 0);
+  slot_point slot_tx = slot_rx + TX_ENB_DELAY;
+  sched.slot_indication(slot_tx);
+  sched_nr_interface::ul_res_t* ul_res = sched.get_ul_sched(slot_rx, 0);
+  TESTASSERT(ul_res != nullptr);
+  TESTASSERT(ul_res->pusch.empty() and ul_res->pucch.empty());
+  TESTASSERT(sched.get_dl_sched(slot_tx, 0) != nullptr);
+  TESTASSERT(sched.get_ul_sched(slot_tx, 0) != nullptr);
+
+  // Discontinuity in the slot indications restarts the pipeline
+  slot_rx += 100;
+  slot_tx = slot_rx + TX_ENB_DELAY;
+  sched.slot_indication(slot_tx);
+  ul_res = sched.get_ul_sched(slot_rx, 0);
+  TESTASSERT(ul_res != nullptr);
+  TESTASSERT(ul_res->pusch.empty() and ul_res->pucch.empty());
+  TESTASSERT(sched.get_dl_sched(slot_tx, 0) != nullptr);
+
+  sched.stop();
+}
+
 } // namespace srsenb
 
 int main()
@@ -130,4 +174,7 @@ int main()
   srsenb::run_sched_nr_test(1);
   srsenb::run_sched_nr_test(2);
   srsenb::run_sched_nr_test(4);
+  srsenb::run_sched_nr_test(1, 2);
+  srsenb::run_sched_nr_test(4, 2);
+  srsenb::test_pipeline_start_ul_sched();
 }
@@ -109,6 +109,28 @@ void test_bwp_rb_bitmap()
   TESTASSERT(rb_bitmap.collides(prb_interval{0, 2}));
 }
 
+void test_bwp_rb_bitmap_unaligned()
+{
+  // BWP start not aligned with RBG boundaries. The first RBG has 1 PRB and the last RBG has 3 PRBs
+  bwp_rb_bitmap rb_bitmap(52, 3, true);
+  TESTASSERT(rb_bitmap.P() == 4 and rb_bitmap.nof_rbgs() == 14);
+
+  rbg_bitmap rbgs(rb_bitmap.nof_rbgs());
+  rbgs.fill(0, 2);
+  rbgs.set(13);
+  rb_bitmap |= rbgs;
+  TESTASSERT(rb_bitmap.prbs().count() == 1 + 4 + 3);
+  TESTASSERT(rb_bitmap.prbs().count(0, 5) == 5 and rb_bitmap.prbs().count(49, 52) == 3);
+
+  // PRBs spanning several RBGs
+  prb_bitmap prbs(rb_bitmap.nof_prbs());
+  prbs.fill(10, 20);
+  prbs.set(30);
+  rb_bitmap |= prbs;
+  TESTASSERT(rb_bitmap.rbgs().count() == 3 + 3 + 1);
+  TESTASSERT(rb_bitmap.rbgs().count(3, 6) == 3 and rb_bitmap.rbgs().test(8));
+}
+
 void test_bwp_rb_bitmap_search()
 {
   bwp_rb_bitmap rb_bitmap(275, 0, true);
@@ -139,5 +161,6 @@ int main()
 {
   test_bwp_prb_grant();
   test_bwp_rb_bitmap();
+  test_bwp_rb_bitmap_unaligned();
   test_bwp_rb_bitmap_search();
 }
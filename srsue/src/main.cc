@@ -215,6 +215,8 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
 
     /* Downlink Channel emulator section */
     ("channel.dl.enable",            bpo::value<bool>(&args->phy.dl_channel_args.enable)->default_value(false),                 "Enable/Disable internal Downlink channel emulator")
+    ("channel.dl.nof_threads",       bpo::value<uint32_t>(&args->phy.dl_channel_args.nof_threads)->default_value(1),            "Threads running the emulator, antennas and fading segments are split among them")
+    ("channel.dl.seed",              bpo::value<uint32_t>(&args->phy.dl_channel_args.seed)->default_value(0),                   "Offset to the random seeds, use a different one in every UE")
     ("channel.dl.awgn.enable",       bpo::value<bool>(&args->phy.dl_channel_args.awgn_enable)->default_value(false),            "Enable/Disable AWGN simulator")
     ("channel.dl.awgn.snr",          bpo::value<float>(&args->phy.dl_channel_args.awgn_snr_dB)->default_value(30.0f),           "SNR in dB")
     ("channel.dl.awgn.signal_power", bpo::value<float>(&args->phy.dl_channel_args.awgn_signal_power_dBfs)->default_value(0.0f), "Received signal power in decibels full scale (dBfs)")
@@ -235,6 +237,8 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
 
     /* Uplink Channel emulator section */
     ("channel.ul.enable",            bpo::value<bool>(&args->phy.ul_channel_args.enable)->default_value(false),                  "Enable/Disable internal Downlink channel emulator")
+    ("channel.ul.nof_threads",       bpo::value<uint32_t>(&args->phy.ul_channel_args.nof_threads)->default_value(1),             "Threads running the emulator, antennas and fading segments are split among them")
+    ("channel.ul.seed",              bpo::value<uint32_t>(&args->phy.ul_channel_args.seed)->default_value(0),                    "Offset to the random seeds, use a different one in every UE")
     ("channel.ul.awgn.enable",       bpo::value<bool>(&args->phy.ul_channel_args.awgn_enable)->default_value(false),             "Enable/Disable AWGN simulator")
     ("channel.ul.awgn.snr",          bpo::value<float>(&args->phy.ul_channel_args.awgn_snr_dB)->default_value(30.0f),            "Noise level in decibels full scale (dBfs)")
     ("channel.ul.awgn.signal_power", bpo::value<float>(&args->phy.ul_channel_args.awgn_signal_power_dBfs)->default_value(30.0f), "Transmitted signal power in decibels full scale (dBfs)")
@@ -260,6 +264,8 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     ("cfr.strength", bpo::value<float>(&args->phy.cfr_args.strength)->default_value(args->phy.cfr_args.strength), "CFR ratio between amplitude-limited vs original signal (0 to 1)")
     ("cfr.auto_target_papr", bpo::value<float>(&args->phy.cfr_args.auto_target_papr)->default_value(args->phy.cfr_args.auto_target_papr), "Signal PAPR target (in dB) in CFR auto modes")
     ("cfr.ema_alpha", bpo::value<float>(&args->phy.cfr_args.ema_alpha)->default_value(args->phy.cfr_args.ema_alpha), "Alpha coefficient for the power average in auto_ema mode (0 to 1)")
+    ("cfr.iterations", bpo::value<uint32_t>(&args->phy.cfr_args.iterations)->default_value(args->phy.cfr_args.iterations), "Number of clipping and filtering iterations")
+    ("cfr.max_evm", bpo::value<float>(&args->phy.cfr_args.max_evm)->default_value(args->phy.cfr_args.max_evm), "Maximum EVM introduced by the CFR in every OFDM symbol (0 to 1), 0 for no limit")
 
     /* PHY section */
     ("phy.worker_cpu_mask",
@@ -405,6 +411,10 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
        bpo::value<bool>(&args->phy.pdsch_8bit_decoder)->default_value(false),
        "Use 8-bit for LLR representation and turbo decoder trellis computation (Experimental)")
 
+    ("phy.pdcch_early_abort",
+       bpo::value<bool>(&args->phy.pdcch_early_abort)->default_value(false),
+       "Searches the PDCCH candidates by decreasing energy and stops once the expected DCIs are found")
+
     ("phy.force_ul_amplitude",
        bpo::value<float>(&args->phy.force_ul_amplitude)->default_value(0.0),
        "Forces the peak amplitude in the PUCCH, PUSCH and SRS (set 0.0 to 1.0, set to 0 or negative for disabling)")
@@ -441,6 +451,10 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
      bpo::value<int>(&args->phy.force_N_id_1)->default_value(-1),
      "Force using a specific SSS (set to -1 to allow all SSSs).")
 
+    ("phy.cell_search_parallel",
+     bpo::value<bool>(&args->phy.cell_search_parallel)->default_value(false),
+     "Search all PSSs in parallel threads over the same received samples.")
+
     // PHY NR args
     ("phy.nr.store_pdsch_ko",
       bpo::value<bool>(&args->phy.nr_store_pdsch_ko)->default_value(false),
@@ -109,6 +109,8 @@ cc_worker::cc_worker(uint32_t cc_idx_, uint32_t max_prb, srsue::phy_common* phy_
     ue_dl.pdsch.llr_is_8bit        = true;
     ue_dl.pdsch.dl_sch.llr_is_8bit = true;
   }
+
+  ue_dl.dci_early_abort = phy->args->pdcch_early_abort;
 }
 
 cc_worker::~cc_worker()
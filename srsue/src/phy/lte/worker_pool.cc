@@ -19,6 +19,7 @@
  *
  */
 #include "srsue/hdr/phy/lte/worker_pool.h"
+#include "srsran/common/cpu_affinity.h"
 
 namespace srsue {
 namespace lte {
@@ -54,13 +55,18 @@ worker_pool::worker_pool(uint32_t max_workers) :
 
 bool worker_pool::init(phy_common* common, int prio)
 {
+  // Create the workers in the worker CPUs, so their buffers are allocated in the NUMA node of those CPUs
+  std::vector<uint32_t> worker_cpus = srsran::get_cpu_mask_cpus(common->args->worker_cpu_mask);
+
   // Add workers to workers pool and start threads
   for (uint32_t i = 0; i < common->args->nof_phy_threads; i++) {
     srslog::basic_logger& log = srslog::fetch_basic_logger(fmt::format("PHY{}", i));
     log.set_level(srslog::str_to_basic_level(common->args->log.phy_level));
     log.set_hex_dump_max_size(common->args->log.phy_hex_limit);
 
-    auto w = std::unique_ptr<lte::sf_worker>(new lte::sf_worker(SRSRAN_MAX_PRB, common, log));
+    std::unique_ptr<lte::sf_worker> w;
+    srsran::run_on_cpus(worker_cpus,
+                        [&w, common, &log]() { w.reset(new lte::sf_worker(SRSRAN_MAX_PRB, common, log)); });
     pool.init_worker(i, w.get(), prio, common->args->worker_cpu_mask);
     workers.push_back(std::move(w));
   }
@@ -20,6 +20,7 @@
  */
 #include "srsue/hdr/phy/nr/worker_pool.h"
 #include "srsran/common/band_helper.h"
+#include "srsran/common/cpu_affinity.h"
 
 namespace srsue {
 namespace nr {
@@ -54,6 +55,9 @@ bool worker_pool::init(const phy_args_nr_t& args, srsran::phy_common_interface&
     return true;
   }
 
+  // Create the workers in the worker CPUs, so their buffers are allocated in the NUMA node of those CPUs
+  std::vector<uint32_t> worker_cpus = srsran::get_cpu_mask_cpus(args.worker_cpu_mask);
+
   // Add workers to workers pool and start threads
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
     auto& log = srslog::fetch_basic_logger(fmt::format("{}PHY{}-NR", args.log.id_preamble, i));
@@ -61,10 +65,10 @@ bool worker_pool::init(const phy_args_nr_t& args, srsran::phy_common_interface&
     log.set_hex_dump_max_size(args.log.phy_hex_limit);
 
     sf_worker* w = nullptr;
-    {
+    srsran::run_on_cpus(worker_cpus, [this, &common, &w, &log]() {
       std::lock_guard<std::mutex> lock(cfg_mutex);
       w = new sf_worker(common, phy_state, cfg, log);
-    }
+    });
     pool.init_worker(i, w, args.workers_thread_prio, args.worker_cpu_mask);
     workers.push_back(std::unique_ptr<sf_worker>(w));
   }
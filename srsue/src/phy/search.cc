@@ -82,6 +82,21 @@ void search::set_cp_en(bool enable)
   srsran_set_detect_cp(&cs, enable);
 }
 
+void search::set_parallel(bool enable)
+{
+  if (srsran_ue_cellsearch_enable_parallel(&cs, enable)) {
+    Error("SYNC:  Enabling parallel cell search");
+    return;
+  }
+
+  // Each PSS is searched with its own ue_sync object, set the expert options in all of them
+  if (enable) {
+    for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+      p->set_ue_sync_opts(srsran_ue_cellsearch_get_ue_sync(&cs, N_id_2), 0);
+    }
+  }
+}
+
 void search::reset()
 {
   srsran_ue_sync_reset(&ue_mib_sync.ue_sync);
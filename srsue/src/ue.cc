@@ -303,22 +303,27 @@ int ue::parse_args(const all_args_t& args_)
   cfr_test_cfg.manual_thr       = args.phy.cfr_args.manual_thres;
   cfr_test_cfg.max_papr_db      = args.phy.cfr_args.auto_target_papr;
   cfr_test_cfg.ema_alpha        = args.phy.cfr_args.ema_alpha;
+  cfr_test_cfg.nof_iterations   = args.phy.cfr_args.iterations;
+  cfr_test_cfg.max_evm          = args.phy.cfr_args.max_evm;
 
   if (!srsran_cfr_params_valid(&cfr_test_cfg)) {
     srsran::console("Invalid CFR parameters: cfr_mode=%d, alpha=%.2f, manual_thr=%.2f, \n "
-                    "max_papr_db=%.2f, ema_alpha=%.2f\n",
+                    "max_papr_db=%.2f, ema_alpha=%.2f, max_evm=%.2f\n",
                     cfr_test_cfg.cfr_mode,
                     cfr_test_cfg.alpha,
                     cfr_test_cfg.manual_thr,
                     cfr_test_cfg.max_papr_db,
-                    cfr_test_cfg.ema_alpha);
+                    cfr_test_cfg.ema_alpha,
+                    cfr_test_cfg.max_evm);
 
-    logger.error("Invalid CFR parameters: cfr_mode=%d, alpha=%.2f, manual_thr=%.2f, max_papr_db=%.2f, ema_alpha=%.2f\n",
+    logger.error("Invalid CFR parameters: cfr_mode=%d, alpha=%.2f, manual_thr=%.2f, max_papr_db=%.2f, ema_alpha=%.2f, "
+                 "max_evm=%.2f\n",
                  cfr_test_cfg.cfr_mode,
                  cfr_test_cfg.alpha,
                  cfr_test_cfg.manual_thr,
                  cfr_test_cfg.max_papr_db,
-                 cfr_test_cfg.ema_alpha);
+                 cfr_test_cfg.ema_alpha,
+                 cfr_test_cfg.max_evm);
     return SRSRAN_ERROR;
   }
 